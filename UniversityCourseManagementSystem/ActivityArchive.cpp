@@ -0,0 +1,470 @@
+//
+//  ActivityArchive.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/9/25.
+//
+
+#include "ActivityArchive.h"
+#include "ActivityLog.h"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+static const uint32_t NO_FILTER = numeric_limits<uint32_t>::max();
+
+/**
+ @brief appends an unsigned value as a little-endian base-128 varint
+
+ @param bytes the buffer to append to
+ @param value the value to encode
+ */
+static void appendVarint(vector<unsigned char>& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<unsigned char>(value));
+}
+
+/**
+ @brief reads one varint and advances past it
+
+ @param bytes the buffer to read from
+ @param position the offset of the varint. moved past it on return
+
+ @return (uint64_t) the decoded value
+ */
+static uint64_t readVarint(const vector<unsigned char>& bytes, size_t& position) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (true) {
+        unsigned char byte = bytes[position++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+/**
+ @brief adds a code to a block's set of distinct codes the first time the block uses it
+
+ @param seen for each code, one past the number of the block that last used it
+ @param set the block's distinct codes, in first-use order
+ @param code the code used
+ @param block one past the number of the block being built
+ */
+static void noteCode(vector<uint32_t>& seen, vector<uint32_t>& set, uint32_t code, uint32_t block) {
+    if (code >= seen.size()) {
+        seen.resize(code + 1, 0);
+    }
+    if (seen[code] != block) {
+        seen[code] = block;
+        set.push_back(code);
+    }
+}
+
+/**
+ @brief constructs a dictionary whose code 0 is the empty string
+ */
+StringDictionary::StringDictionary() {
+    encode("");
+}
+
+/**
+ @brief gets the code of a string, adding it if it is new
+
+ @param value the string to encode
+
+ @return (uint32_t) the code of the string
+ */
+uint32_t StringDictionary::encode(const string& value) {
+    auto iter = codes.find(value);
+    if (iter != codes.end()) {
+        return iter->second;
+    }
+    uint32_t code = static_cast<uint32_t>(values.size());
+    values.push_back(value);
+    codes.emplace(value, code);
+    return code;
+}
+
+/**
+ @brief gets the code of a string without adding it
+
+ @param value the string to look up
+ @param code receives the code if the string is known
+
+ @return (bool) true if the string is in the dictionary, false otherwise
+ */
+bool StringDictionary::lookup(const string& value, uint32_t& code) const {
+    auto iter = codes.find(value);
+    if (iter == codes.end()) {
+        return false;
+    }
+    code = iter->second;
+    return true;
+}
+
+/**
+ @brief gets the string for a code
+
+ @param code a code returned by encode
+
+ @return (const string&) the string
+ */
+const string& StringDictionary::decode(uint32_t code) const {
+    return values[code];
+}
+
+/**
+ @brief gets the number of distinct strings
+
+ @return (size_t) the number of strings, including the empty string
+ */
+size_t StringDictionary::size() const {
+    return values.size();
+}
+
+/**
+ @brief estimates the memory used by the dictionary
+
+ @details counts the string storage plus one hash node per entry
+
+ @return (size_t) the estimated size in bytes
+ */
+size_t StringDictionary::getMemoryBytes() const {
+    size_t bytes = values.capacity() * sizeof(string) + codes.bucket_count() * sizeof(void*);
+    for (const auto& value : values) {
+        if (value.capacity() > 15) {
+            bytes += value.capacity() + 1;
+        }
+        bytes += sizeof(string) + sizeof(uint32_t) + 2 * sizeof(void*);
+    }
+    return bytes;
+}
+
+/**
+ @brief constructs an empty block
+ */
+ArchiveBlock::ArchiveBlock() {
+    firstSequence = 0;
+    count = 0;
+    firstTime = 0;
+    lastTime = 0;
+}
+
+/**
+ @brief gets the memory used by the block's columns
+
+ @return (size_t) the size in bytes
+ */
+size_t ArchiveBlock::getMemoryBytes() const {
+    return sizeof(ArchiveBlock) + timeDeltas.capacity() + detailTokens.capacity() + words.capacity() +
+           (actions.capacity() + students.capacity() + courses.capacity() + detailStarts.capacity() + wordStarts.capacity() +
+            actionSet.capacity() + studentSet.capacity() + courseSet.capacity()) * sizeof(uint32_t);
+}
+
+/**
+ @brief constructs an empty archive
+ */
+ActivityArchive::ActivityArchive() {
+    entryCount = 0;
+}
+
+/**
+ @brief gets the code of a detail word in the block being built, adding it to the block's word list if it is new
+
+ @details the words are found through an open-addressing table of codes that looks at the block's own word list, so a word costs no allocation of its own and the table is reused from block to block with a single fill
+
+ @param word the word
+
+ @return (uint32_t) the word's code within the block
+ */
+uint32_t ActivityArchive::encodeWord(string_view word) {
+    size_t wordCount = pending.wordStarts.size();
+    if (wordSlots.size() < 2 * (wordCount + 1)) {
+        // kept at most half full. codes are stored one up so that 0 marks an empty slot
+        vector<uint32_t> grown(max<size_t>(1024, 2 * wordSlots.size()), 0);
+        for (uint32_t code = 0; code < wordCount; code++) {
+            size_t end = code + 1 < wordCount ? pending.wordStarts[code + 1] : pending.words.size();
+            size_t slot = hash<string_view>()(string_view(pending.words).substr(pending.wordStarts[code], end - pending.wordStarts[code])) & (grown.size() - 1);
+            while (grown[slot] != 0) {
+                slot = (slot + 1) & (grown.size() - 1);
+            }
+            grown[slot] = code + 1;
+        }
+        wordSlots.swap(grown);
+    }
+
+    size_t slot = hash<string_view>()(word) & (wordSlots.size() - 1);
+    while (wordSlots[slot] != 0) {
+        uint32_t code = wordSlots[slot] - 1;
+        size_t end = code + 1 < wordCount ? pending.wordStarts[code + 1] : pending.words.size();
+        if (string_view(pending.words).substr(pending.wordStarts[code], end - pending.wordStarts[code]) == word) {
+            return code;
+        }
+        slot = (slot + 1) & (wordSlots.size() - 1);
+    }
+    uint32_t code = static_cast<uint32_t>(wordCount);
+    wordSlots[slot] = code + 1;
+    pending.wordStarts.push_back(static_cast<uint32_t>(pending.words.size()));
+    pending.words.append(word);
+    return code;
+}
+
+/**
+ @brief seals the oldest entries of the live log into one columnar block, a slice at a time
+
+ @details actions, student IDs and course codes become dictionary codes. times are stored as varint deltas from the previous entry. details are split on spaces and each word is stored as a varint code into the block's own word list, so names and numbers that are never logged again don't pile up in a dictionary that lives as long as the archive. the block also keeps the distinct codes of each column so queries can skip blocks that cannot match; they are collected as rows are encoded. the block is built in a pending area that queries never see, and is published only once its last row is encoded, so no single call does more than budget rows of work plus sorting the distinct codes
+
+ @param entries the live log. the first count entries are sealed and must directly follow the last archived entry; they must not change until the block is published
+ @param count the number of entries in the block
+ @param budget the most rows to encode in this call
+
+ @return (bool) true if this call published the block, false if rows are still left
+ */
+bool ActivityArchive::sealSlice(const deque<ActivityLogEntry>& entries, size_t count, size_t budget) {
+    count = min(count, entries.size());
+    if (count == 0 || budget == 0) {
+        return false;
+    }
+
+    uint32_t blockMark = static_cast<uint32_t>(blocks.size() + 1);
+    if (pending.count == 0) {
+        pending.firstSequence = entries.front().sequence;
+        pending.firstTime = entries.front().time;
+        pending.actions.reserve(count);
+        pending.students.reserve(count);
+        pending.courses.reserve(count);
+        pending.detailStarts.reserve(count + 1);
+        fill(wordSlots.begin(), wordSlots.end(), 0);
+    }
+
+    size_t end = count - pending.count > budget ? pending.count + budget : count;
+    time_t previous = pending.count == 0 ? pending.firstTime : entries[pending.count - 1].time;
+    for (size_t i = pending.count; i < end; i++) {
+        const ActivityLogEntry& entry = entries[i];
+        appendVarint(pending.timeDeltas, static_cast<uint64_t>(entry.time - previous));
+        previous = entry.time;
+
+        pending.actions.push_back(actionDictionary.encode(entry.action));
+        pending.students.push_back(studentDictionary.encode(entry.studentID));
+        pending.courses.push_back(courseDictionary.encode(entry.courseCode));
+        noteCode(actionSeen, pending.actionSet, pending.actions.back(), blockMark);
+        noteCode(studentSeen, pending.studentSet, pending.students.back(), blockMark);
+        noteCode(courseSeen, pending.courseSet, pending.courses.back(), blockMark);
+
+        pending.detailStarts.push_back(static_cast<uint32_t>(pending.detailTokens.size()));
+        string_view details(entry.details);
+        size_t start = 0;
+        while (true) {
+            size_t space = details.find(' ', start);
+            appendVarint(pending.detailTokens, encodeWord(details.substr(start, space - start)));
+            if (space == string_view::npos) {
+                break;
+            }
+            start = space + 1;
+        }
+    }
+    pending.count = static_cast<uint32_t>(end);
+    if (end < count) {
+        return false;
+    }
+
+    pending.lastTime = entries[count - 1].time;
+    pending.detailStarts.push_back(static_cast<uint32_t>(pending.detailTokens.size()));
+    pending.wordStarts.push_back(static_cast<uint32_t>(pending.words.size()));
+    for (auto* set : {&pending.actionSet, &pending.studentSet, &pending.courseSet}) {
+        sort(set->begin(), set->end());
+        set->shrink_to_fit();
+    }
+    pending.timeDeltas.shrink_to_fit();
+    pending.detailTokens.shrink_to_fit();
+    pending.words.shrink_to_fit();
+    pending.wordStarts.shrink_to_fit();
+
+    blocks.push_back(std::move(pending));
+    pending = ArchiveBlock();
+    entryCount += count;
+    return true;
+}
+
+/**
+ @brief checks if a block has been started but not yet published
+
+ @return (bool) true while sealSlice has rows left to encode
+ */
+bool ActivityArchive::isSealing() const {
+    return pending.count > 0;
+}
+
+/**
+ @brief rebuilds one archived entry
+
+ @param block the block holding the entry
+ @param row the entry's row in the block
+ @param when the entry's time, already decoded from the delta column
+ @param timestamp the last formatted timestamp, reused while rows fall in the same second
+ @param timestampTime the time timestamp was formatted from
+
+ @return (ActivityLogEntry) the entry as it was logged
+ */
+ActivityLogEntry ActivityArchive::decodeRow(const ArchiveBlock& block, uint32_t row, time_t when, string& timestamp, time_t& timestampTime) const {
+    if (timestamp.empty() || when != timestampTime) {
+        tm tm{};
+        localtime_r(&when, &tm);
+        ostringstream oss;
+        oss << put_time(&tm, "%Y-%m-%d %H:%M:%S");
+        timestamp = oss.str();
+        timestampTime = when;
+    }
+
+    string details;
+    size_t position = block.detailStarts[row];
+    size_t end = block.detailStarts[row + 1];
+    while (position < end) {
+        if (position != block.detailStarts[row]) {
+            details += ' ';
+        }
+        uint32_t word = static_cast<uint32_t>(readVarint(block.detailTokens, position));
+        details.append(block.words, block.wordStarts[word], block.wordStarts[word + 1] - block.wordStarts[word]);
+    }
+
+    return ActivityLogEntry(block.firstSequence + row, when, timestamp, actionDictionary.decode(block.actions[row]),
+                            studentDictionary.decode(block.students[row]), courseDictionary.decode(block.courses[row]), details);
+}
+
+/**
+ @brief checks every row of one block against a query
+
+ @details only the time, action, student and course columns are read for each row. details and timestamps are only decoded for matches
+
+ @param block the block to scan
+ @param query the time range to apply
+ @param filterCodes the action, student and course codes to match, or NO_FILTER
+ @param fromSequence rows with a lower sequence are skipped
+ @param visit called with each matching entry
+
+ @return (size_t) the number of matching entries
+ */
+size_t ActivityArchive::scanBlock(const ArchiveBlock& block, const ActivityQuery& query, const uint32_t* filterCodes, unsigned long long fromSequence, const function<void(const ActivityLogEntry&)>& visit) const {
+    size_t found = 0;
+    string timestamp;
+    time_t timestampTime = 0;
+    time_t when = block.firstTime;
+    size_t position = 0;
+    for (uint32_t row = 0; row < block.count; row++) {
+        when += static_cast<time_t>(readVarint(block.timeDeltas, position));
+        if (when > query.to) {
+            break;
+        }
+        if (when < query.from || block.firstSequence + row < fromSequence) {
+            continue;
+        }
+        if ((filterCodes[0] != NO_FILTER && block.actions[row] != filterCodes[0]) ||
+            (filterCodes[1] != NO_FILTER && block.students[row] != filterCodes[1]) ||
+            (filterCodes[2] != NO_FILTER && block.courses[row] != filterCodes[2])) {
+            continue;
+        }
+        visit(decodeRow(block, row, when, timestamp, timestampTime));
+        found++;
+    }
+    return found;
+}
+
+/**
+ @brief finds every archived entry matching a query, oldest first
+
+ @details filter strings are turned into dictionary codes once, so rows are compared as integers. blocks outside the time range, or whose distinct codes do not include a filter, are skipped without touching their rows
+
+ @param query the filters to apply. empty fields match anything
+ @param visit called with each matching entry
+
+ @return (size_t) the number of matching entries
+ */
+size_t ActivityArchive::query(const ActivityQuery& query, const function<void(const ActivityLogEntry&)>& visit) const {
+    uint32_t filterCodes[3] = {NO_FILTER, NO_FILTER, NO_FILTER};
+    const pair<const StringDictionary*, const string*> filters[] = {
+        {&actionDictionary, &query.action}, {&studentDictionary, &query.studentID}, {&courseDictionary, &query.courseCode}
+    };
+    for (int i = 0; i < 3; i++) {
+        if (!filters[i].second->empty() && !filters[i].first->lookup(*filters[i].second, filterCodes[i])) {
+            return 0;
+        }
+    }
+
+    size_t found = 0;
+    for (const auto& block : blocks) {
+        if (block.lastTime < query.from || block.firstTime > query.to) {
+            continue;
+        }
+        if ((filterCodes[0] != NO_FILTER && !binary_search(block.actionSet.begin(), block.actionSet.end(), filterCodes[0])) ||
+            (filterCodes[1] != NO_FILTER && !binary_search(block.studentSet.begin(), block.studentSet.end(), filterCodes[1])) ||
+            (filterCodes[2] != NO_FILTER && !binary_search(block.courseSet.begin(), block.courseSet.end(), filterCodes[2]))) {
+            continue;
+        }
+        found += scanBlock(block, query, filterCodes, 0, visit);
+    }
+    return found;
+}
+
+/**
+ @brief visits every archived entry from a sequence onwards, oldest first
+
+ @param sequence the first sequence to visit
+ @param visit called with each entry
+
+ @return (size_t) the number of entries visited
+ */
+size_t ActivityArchive::forEachFrom(unsigned long long sequence, const function<void(const ActivityLogEntry&)>& visit) const {
+    const uint32_t filterCodes[3] = {NO_FILTER, NO_FILTER, NO_FILTER};
+    ActivityQuery everything;
+    size_t found = 0;
+    auto first = upper_bound(blocks.begin(), blocks.end(), sequence, [](unsigned long long value, const ArchiveBlock& block) {
+        return value < block.firstSequence;
+    });
+    if (first != blocks.begin()) {
+        --first;
+    }
+    for (auto iter = first; iter != blocks.end(); ++iter) {
+        found += scanBlock(*iter, everything, filterCodes, sequence, visit);
+    }
+    return found;
+}
+
+/**
+ @brief gets the number of archived entries
+
+ @return (unsigned long long) the number of entries
+ */
+unsigned long long ActivityArchive::size() const {
+    return entryCount;
+}
+
+/**
+ @brief gets the number of sealed blocks
+
+ @return (size_t) the number of blocks
+ */
+size_t ActivityArchive::getBlockCount() const {
+    return blocks.size();
+}
+
+/**
+ @brief gets the memory used by the archive
+
+ @return (size_t) the size of every block and dictionary in bytes, including a block still being sealed
+ */
+size_t ActivityArchive::getMemoryBytes() const {
+    size_t bytes = actionDictionary.getMemoryBytes() + studentDictionary.getMemoryBytes() + courseDictionary.getMemoryBytes() +
+                   pending.getMemoryBytes() - sizeof(ArchiveBlock) +
+                   (wordSlots.capacity() + actionSeen.capacity() + studentSeen.capacity() + courseSeen.capacity()) * sizeof(uint32_t);
+    for (const auto& block : blocks) {
+        bytes += block.getMemoryBytes();
+    }
+    return bytes;
+}
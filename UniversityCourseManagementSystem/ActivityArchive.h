@@ -0,0 +1,93 @@
+//
+//  ActivityArchive.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/9/25.
+//
+
+#ifndef ACTIVITY_ARCHIVE_H
+#define ACTIVITY_ARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <string_view>
+#include <ctime>
+
+using namespace std;
+
+struct ActivityLogEntry;
+struct ActivityQuery;
+
+class StringDictionary {
+private:
+    vector<string> values;
+    unordered_map<string, uint32_t> codes;
+
+public:
+    StringDictionary();
+
+    uint32_t encode(const string& value);
+    bool lookup(const string& value, uint32_t& code) const;
+    const string& decode(uint32_t code) const;
+    size_t size() const;
+    size_t getMemoryBytes() const;
+};
+
+struct ArchiveBlock {
+    unsigned long long firstSequence;
+    uint32_t count;
+    time_t firstTime;
+    time_t lastTime;
+    vector<unsigned char> timeDeltas;
+    vector<uint32_t> actions;
+    vector<uint32_t> students;
+    vector<uint32_t> courses;
+    vector<uint32_t> detailStarts;
+    vector<unsigned char> detailTokens;
+    string words;
+    vector<uint32_t> wordStarts;
+    vector<uint32_t> actionSet;
+    vector<uint32_t> studentSet;
+    vector<uint32_t> courseSet;
+
+    ArchiveBlock();
+    size_t getMemoryBytes() const;
+};
+
+class ActivityArchive {
+private:
+    vector<ArchiveBlock> blocks;
+    StringDictionary actionDictionary;
+    StringDictionary studentDictionary;
+    StringDictionary courseDictionary;
+    unsigned long long entryCount;
+    ArchiveBlock pending;
+    vector<uint32_t> wordSlots;
+    vector<uint32_t> actionSeen;
+    vector<uint32_t> studentSeen;
+    vector<uint32_t> courseSeen;
+
+    uint32_t encodeWord(string_view word);
+
+    ActivityLogEntry decodeRow(const ArchiveBlock& block, uint32_t row, time_t when, string& timestamp, time_t& timestampTime) const;
+    size_t scanBlock(const ArchiveBlock& block, const ActivityQuery& query, const uint32_t* filterCodes, unsigned long long fromSequence, const function<void(const ActivityLogEntry&)>& visit) const;
+
+public:
+    ActivityArchive();
+
+    bool sealSlice(const deque<ActivityLogEntry>& entries, size_t count, size_t budget);
+    bool isSealing() const;
+
+    size_t query(const ActivityQuery& query, const function<void(const ActivityLogEntry&)>& visit) const;
+    size_t forEachFrom(unsigned long long sequence, const function<void(const ActivityLogEntry&)>& visit) const;
+
+    unsigned long long size() const;
+    size_t getBlockCount() const;
+    size_t getMemoryBytes() const;
+};
+
+#endif // ACTIVITY_ARCHIVE_H
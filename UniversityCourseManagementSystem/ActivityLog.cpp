@@ -0,0 +1,431 @@
+//
+//  ActivityLog.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/9/25.
+//
+
+#include "ActivityLog.h"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+// rows of archiving work done per append, so sealing a block is spread over many requests instead of stalling one
+static const size_t SEAL_SLICE_ENTRIES = 128;
+
+/**
+ @brief constructs an ActivityLogEntry with the specified details
+
+ @details initializes an activity log entry to track system operations like adding or removing students/courses
+
+ @param seq the position of the entry in the log. sequences start at 0 and are never reused
+ @param when the time of the activity in seconds since the epoch
+ @param time the timestamp of the activity as text
+ @param a the action taken
+ @param ID the student ID involved in the action
+ @param cc the course code involved in the action
+ @param d additional details about the action
+ */
+ActivityLogEntry::ActivityLogEntry(unsigned long long seq, time_t when, const string& time, const string& a, const string& ID, const string& cc, const string& d) {
+    sequence = seq;
+    this->time = when;
+    timestamp = time;
+    action = a;
+    studentID = ID;
+    courseCode = cc;
+    details = d;
+}
+
+/**
+ @brief constructs a query that matches every entry
+
+ @details empty fields match anything. the time range is inclusive at both ends
+ */
+ActivityQuery::ActivityQuery() {
+    from = numeric_limits<time_t>::min();
+    to = numeric_limits<time_t>::max();
+}
+
+/**
+ @brief constructs an empty ActivityLog
+ */
+ActivityLog::ActivityLog() {
+    firstSequence = 0;
+    liveSequence = 0;
+    lastTime = 0;
+    blockEntries = 65536;
+    liveEntries = 131072;
+}
+
+/**
+ @brief sets when older entries are sealed into the archive
+
+ @details once more than entriesKeptLive + entriesPerBlock entries are live, the oldest entriesPerBlock are sealed into one columnar block. live entries stay fully indexed; archived ones are found by scanning the blocks a query cannot rule out. a block already being sealed is finished first, and anything due under the new thresholds is sealed before returning
+
+ @param entriesPerBlock the number of entries sealed into each block
+ @param entriesKeptLive the number of recent entries always kept live
+ */
+void ActivityLog::setArchiveThresholds(size_t entriesPerBlock, size_t entriesKeptLive) {
+    while (archive.isSealing() || firstSequence < liveSequence) {
+        sealStep(numeric_limits<size_t>::max());
+    }
+    blockEntries = max<size_t>(1, entriesPerBlock);
+    liveEntries = entriesKeptLive;
+    while (sealStep(numeric_limits<size_t>::max())) {
+    }
+}
+
+/**
+ @brief does a bounded amount of the work of moving the oldest live entries into the archive
+
+ @details a block is encoded by the archive a slice at a time while its entries stay live, then published. from then on its entries count as archived, and they are dropped from the live log and the front of every posting list they appear in a slice at a time; queries skip them by starting at liveSequence. a new block isn't started until the last one is fully dropped
+
+ @param budget the most entries to encode or drop
+
+ @return (bool) true if any work was done, false if nothing is due
+ */
+bool ActivityLog::sealStep(size_t budget) {
+    if (firstSequence < liveSequence) {
+        auto dropFront = [](unordered_map<string, deque<unsigned long long>>& index, const string& key) {
+            auto iter = index.find(key);
+            iter->second.pop_front();
+            if (iter->second.empty()) {
+                index.erase(iter);
+            }
+        };
+        size_t count = static_cast<size_t>(min<unsigned long long>(budget, liveSequence - firstSequence));
+        for (size_t i = 0; i < count; i++) {
+            const ActivityLogEntry& entry = entries.front();
+            dropFront(byAction, entry.action);
+            if (!entry.studentID.empty()) {
+                dropFront(byStudent, entry.studentID);
+            }
+            if (!entry.courseCode.empty()) {
+                dropFront(byCourse, entry.courseCode);
+            }
+            entries.pop_front();
+        }
+        firstSequence += count;
+        return true;
+    }
+
+    if (!archive.isSealing() && entries.size() <= liveEntries + blockEntries) {
+        return false;
+    }
+    if (archive.sealSlice(entries, blockEntries, budget)) {
+        liveSequence += min(blockEntries, entries.size());
+        while (secondStarts.size() > 1 && secondStarts[1].second <= liveSequence) {
+            secondStarts.pop_front();
+        }
+        if (getLiveCount() == 0) {
+            secondStarts.clear();
+        } else if (!secondStarts.empty()) {
+            secondStarts.front().second = max(secondStarts.front().second, liveSequence);
+        }
+    }
+    return true;
+}
+
+/**
+ @brief formats a time the way log entries show it
+
+ @details consecutive entries usually fall in the same second, so the last formatted second is reused instead of formatting it again
+
+ @param when the time to format
+
+ @return (const string&) the timestamp text, e.g. "2025-08-09 14:03:27"
+ */
+const string& ActivityLog::formatTimestamp(time_t when) {
+    if (lastTimestamp.empty() || when != lastTime) {
+        tm tm{};
+        localtime_r(&when, &tm);
+        ostringstream oss;
+        oss << put_time(&tm, "%Y-%m-%d %H:%M:%S");
+        lastTimestamp = oss.str();
+    }
+    return lastTimestamp;
+}
+
+/**
+ @brief adds an activity to the end of the log and indexes it
+
+ @details the entry gets the next sequence number and is appended to the posting lists of its student, course and action. log times never go backwards: if the clock steps back, the entry keeps the previous entry's time so the time index stays sorted. once the live log is over its threshold, each append also does a slice of the archiving work
+
+ @param action the action taken
+ @param studentID the student involved, or empty
+ @param courseCode the course involved, or empty
+ @param details additional details about the action
+
+ @return (const ActivityLogEntry&) the new entry
+ */
+const ActivityLogEntry& ActivityLog::append(const string& action, const string& studentID, const string& courseCode, const string& details) {
+    time_t now = time(nullptr);
+    if (!entries.empty() && now < lastTime) {
+        now = lastTime;
+    }
+    const string& timestamp = formatTimestamp(now);
+    unsigned long long sequence = firstSequence + entries.size();
+
+    if (secondStarts.empty() || secondStarts.back().first != now) {
+        secondStarts.emplace_back(now, sequence);
+    }
+    lastTime = now;
+
+    entries.emplace_back(sequence, now, timestamp, action, studentID, courseCode, details);
+    byAction[action].push_back(sequence);
+    if (!studentID.empty()) {
+        byStudent[studentID].push_back(sequence);
+    }
+    if (!courseCode.empty()) {
+        byCourse[courseCode].push_back(sequence);
+    }
+
+    sealStep(SEAL_SLICE_ENTRIES);
+    return entries.back();
+}
+
+/**
+ @brief gets the number of entries in the log
+
+ @return (size_t) the number of live and archived entries
+ */
+size_t ActivityLog::size() const {
+    return archive.size() + getLiveCount();
+}
+
+/**
+ @brief checks if the log has no entries
+
+ @return (bool) true if the log is empty, false otherwise
+ */
+bool ActivityLog::empty() const {
+    return size() == 0;
+}
+
+/**
+ @brief gets the number of entries not yet archived
+
+ @return (size_t) the number of live entries
+ */
+size_t ActivityLog::getLiveCount() const {
+    return static_cast<size_t>(firstSequence + entries.size() - liveSequence);
+}
+
+/**
+ @brief gets the number of entries sealed into the archive
+
+ @return (size_t) the number of archived entries
+ */
+size_t ActivityLog::getArchivedCount() const {
+    return archive.size();
+}
+
+/**
+ @brief gets the number of sealed archive blocks
+
+ @return (size_t) the number of blocks
+ */
+size_t ActivityLog::getArchiveBlockCount() const {
+    return archive.getBlockCount();
+}
+
+/**
+ @brief gets the memory used by the archive
+
+ @return (size_t) the size of the archive in bytes
+ */
+size_t ActivityLog::getArchiveMemoryBytes() const {
+    return archive.getMemoryBytes();
+}
+
+/**
+ @brief adds rows for the live log, its indexes and the archive to a memory report
+
+ @details walks the live entries and index keys once without allocating
+
+ @param report the report to add to
+ */
+void ActivityLog::accountMemory(MemoryReport& report) const {
+    MemoryUsage& live = report.add("activity log");
+    live.elements = entries.size();
+    live.capacityBytes = dequeBytes(entries);
+    for (const auto& entry : entries) {
+        live.stringBytes += stringHeapBytes(entry.timestamp) + stringHeapBytes(entry.action) + stringHeapBytes(entry.studentID) +
+                            stringHeapBytes(entry.courseCode) + stringHeapBytes(entry.details);
+    }
+    live.capacityBytes += lastTimestamp.capacity();
+
+    MemoryUsage& indexes = report.add("activity log indexes");
+    for (const auto* index : {&byStudent, &byCourse, &byAction}) {
+        indexes.nodeBytes += hashNodeBytes(*index);
+        indexes.capacityBytes += hashBucketBytes(*index);
+        for (const auto& list : *index) {
+            indexes.elements += list.second.size();
+            indexes.stringBytes += stringHeapBytes(list.first);
+            indexes.capacityBytes += dequeBytes(list.second);
+        }
+    }
+    indexes.capacityBytes += dequeBytes(secondStarts);
+
+    MemoryUsage& archived = report.add("activity archive");
+    archived.elements = archive.size();
+    archived.capacityBytes = archive.getMemoryBytes();
+}
+
+/**
+ @brief visits the most recent entries, oldest first
+
+ @param count the number of entries to visit
+ @param visit called with each entry
+
+ @return (size_t) the number of entries visited
+ */
+size_t ActivityLog::forEachRecent(size_t count, const function<void(const ActivityLogEntry&)>& visit) const {
+    size_t visited = 0;
+    size_t live = getLiveCount();
+    if (count > live) {
+        unsigned long long wanted = count - live;
+        visited += archive.forEachFrom(liveSequence > wanted ? liveSequence - wanted : 0, visit);
+    }
+    for (size_t i = entries.size() - min(count, live); i < entries.size(); i++) {
+        visit(entries[i]);
+        visited++;
+    }
+    return visited;
+}
+
+/**
+ @brief maps a time range onto the range of sequences logged in it
+
+ @details binary search over the first sequence logged in each distinct second
+
+ @param from the earliest time, inclusive
+ @param to the latest time, inclusive
+
+ @return (pair<unsigned long long, unsigned long long>) the half-open sequence range [first, second)
+ */
+pair<unsigned long long, unsigned long long> ActivityLog::sequenceRange(time_t from, time_t to) const {
+    unsigned long long endSequence = firstSequence + entries.size();
+    if (from > to) {
+        return {endSequence, endSequence};
+    }
+
+    auto byTime = [](const pair<time_t, unsigned long long>& start, time_t when) { return start.first < when; };
+    auto low = lower_bound(secondStarts.begin(), secondStarts.end(), from, byTime);
+    auto high = to == numeric_limits<time_t>::max() ? secondStarts.end() : lower_bound(low, secondStarts.end(), to + 1, byTime);
+
+    unsigned long long first = low == secondStarts.end() ? endSequence : max(low->second, liveSequence);
+    unsigned long long last = high == secondStarts.end() ? endSequence : high->second;
+    return {first, last};
+}
+
+/**
+ @brief finds every entry matching a query, oldest first
+
+ @details archived entries are found by ActivityArchive::query. for live entries the time range is turned into a sequence range, then the shortest posting list among the requested student, course and action is walked within that range and each candidate is checked against the other filters. the cost is a few binary searches plus the number of candidates in the most selective list, not the size of the log
+
+ @param query the filters to apply. empty fields match anything
+ @param visit called with each matching entry
+
+ @return (size_t) the number of matching entries
+ */
+size_t ActivityLog::query(const ActivityQuery& query, const function<void(const ActivityLogEntry&)>& visit) const {
+    size_t found = archive.size() > 0 ? archive.query(query, visit) : 0;
+
+    pair<unsigned long long, unsigned long long> range = sequenceRange(query.from, query.to);
+    if (range.first >= range.second) {
+        return found;
+    }
+
+    vector<const deque<unsigned long long>*> lists;
+    const pair<const unordered_map<string, deque<unsigned long long>>*, const string*> filters[] = {
+        {&byStudent, &query.studentID}, {&byCourse, &query.courseCode}, {&byAction, &query.action}
+    };
+    for (const auto& filter : filters) {
+        if (filter.second->empty()) {
+            continue;
+        }
+        auto iter = filter.first->find(*filter.second);
+        if (iter == filter.first->end()) {
+            return found;
+        }
+        lists.push_back(&iter->second);
+    }
+
+    auto matches = [&](const ActivityLogEntry& entry) {
+        return (query.studentID.empty() || entry.studentID == query.studentID) &&
+               (query.courseCode.empty() || entry.courseCode == query.courseCode) &&
+               (query.action.empty() || entry.action == query.action);
+    };
+
+    if (lists.empty()) {
+        for (unsigned long long sequence = range.first; sequence < range.second; sequence++) {
+            visit(entries[sequence - firstSequence]);
+            found++;
+        }
+        return found;
+    }
+
+    deque<unsigned long long>::const_iterator bestBegin, bestEnd;
+    size_t bestSize = numeric_limits<size_t>::max();
+    for (const auto* list : lists) {
+        auto low = lower_bound(list->begin(), list->end(), range.first);
+        auto high = lower_bound(low, list->end(), range.second);
+        if (static_cast<size_t>(high - low) < bestSize) {
+            bestBegin = low;
+            bestEnd = high;
+            bestSize = high - low;
+        }
+    }
+
+    for (auto iter = bestBegin; iter != bestEnd; ++iter) {
+        const ActivityLogEntry& entry = entries[*iter - firstSequence];
+        if (matches(entry)) {
+            visit(entry);
+            found++;
+        }
+    }
+    return found;
+}
+
+/**
+ @brief parses a date or date-time typed by a user
+
+ @details accepts "YYYY-MM-DD" or "YYYY-MM-DD HH:MM:SS" in local time. a date on its own means the start of that day, or its last second when endOfDay is set
+
+ @param text the text to parse
+ @param result receives the parsed time
+ @param endOfDay whether a date without a time means the end of the day
+
+ @return (bool) true if the text was a valid date, false otherwise
+ */
+bool ActivityLog::parseTimestamp(const string& text, time_t& result, bool endOfDay) {
+    tm tm{};
+    istringstream iss(text);
+    iss >> get_time(&tm, "%Y-%m-%d");
+    if (iss.fail()) {
+        return false;
+    }
+    iss >> ws;
+    if (iss.eof()) {
+        if (endOfDay) {
+            tm.tm_hour = 23;
+            tm.tm_min = 59;
+            tm.tm_sec = 59;
+        }
+    } else {
+        iss >> get_time(&tm, "%H:%M:%S");
+        if (iss.fail()) {
+            return false;
+        }
+        iss >> ws;
+        if (!iss.eof()) {
+            return false;
+        }
+    }
+    tm.tm_isdst = -1;
+    result = mktime(&tm);
+    return result != static_cast<time_t>(-1);
+}
@@ -0,0 +1,84 @@
+//
+//  ActivityLog.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/9/25.
+//
+
+#ifndef ACTIVITY_LOG_H
+#define ACTIVITY_LOG_H
+
+#include "ActivityArchive.h"
+#include "MemoryReport.h"
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <functional>
+#include <ctime>
+
+using namespace std;
+
+struct ActivityLogEntry {
+    unsigned long long sequence;
+    time_t time;
+    string timestamp;
+    string action;
+    string studentID;
+    string courseCode;
+    string details;
+
+    ActivityLogEntry(unsigned long long seq, time_t when, const string& time, const string& a, const string& ID, const string& cc, const string& d);
+};
+
+struct ActivityQuery {
+    string studentID;
+    string courseCode;
+    string action;
+    time_t from;
+    time_t to;
+
+    ActivityQuery();
+};
+
+class ActivityLog {
+private:
+    deque<ActivityLogEntry> entries;
+    unsigned long long firstSequence;
+    unsigned long long liveSequence;
+    unordered_map<string, deque<unsigned long long>> byStudent;
+    unordered_map<string, deque<unsigned long long>> byCourse;
+    unordered_map<string, deque<unsigned long long>> byAction;
+    deque<pair<time_t, unsigned long long>> secondStarts;
+    time_t lastTime;
+    string lastTimestamp;
+    ActivityArchive archive;
+    size_t blockEntries;
+    size_t liveEntries;
+
+    const string& formatTimestamp(time_t when);
+    bool sealStep(size_t budget);
+    pair<unsigned long long, unsigned long long> sequenceRange(time_t from, time_t to) const;
+
+public:
+    ActivityLog();
+
+    const ActivityLogEntry& append(const string& action, const string& studentID, const string& courseCode, const string& details);
+
+    void setArchiveThresholds(size_t entriesPerBlock, size_t entriesKeptLive);
+
+    size_t size() const;
+    bool empty() const;
+    size_t getLiveCount() const;
+    size_t getArchivedCount() const;
+    size_t getArchiveBlockCount() const;
+    size_t getArchiveMemoryBytes() const;
+    void accountMemory(MemoryReport& report) const;
+
+    size_t query(const ActivityQuery& query, const function<void(const ActivityLogEntry&)>& visit) const;
+    size_t forEachRecent(size_t count, const function<void(const ActivityLogEntry&)>& visit) const;
+
+    static bool parseTimestamp(const string& text, time_t& result, bool endOfDay = false);
+};
+
+#endif // ACTIVITY_LOG_H
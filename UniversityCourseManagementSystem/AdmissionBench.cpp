@@ -0,0 +1,240 @@
+//
+//  AdmissionBench.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "AdmissionQueue.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+struct Operation {
+    int student;
+    int course;
+    bool drop;
+};
+
+struct RunResult {
+    double seconds = 0;
+    vector<double> latenciesMicros;
+};
+
+/**
+ @brief gets a percentile of sorted samples
+
+ @param sorted the samples in ascending order
+ @param fraction the percentile, e.g. 0.99
+
+ @return (double) the sample at that rank, or 0 if there are none
+ */
+double percentile(const vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()));
+    return sorted[index];
+}
+
+/**
+ @brief builds a fresh term with every student and course of the workload
+
+ @param system the system to fill
+ @param studentCount the number of students
+ @param courseCount the number of courses
+ @param capacity the capacity of every course
+ */
+void buildTerm(UniversitySystem& system, int studentCount, int courseCount, int capacity) {
+    for (int c = 0; c < courseCount; c++) {
+        system.addCourse("C" + to_string(c), "Course " + to_string(c), "Dr. Rush", capacity);
+    }
+    for (int s = 0; s < studentCount; s++) {
+        system.addStudent("S" + to_string(s), "Student " + to_string(s));
+    }
+}
+
+/**
+ @brief runs the workload with every producer calling the system directly under one shared lock
+
+ @details the system is confined to one thread at a time, so without a queue this global lock is the only safe way for many threads to use it
+
+ @return (RunResult) elapsed time and per-request latency
+ */
+RunResult runDirect(const vector<vector<Operation>>& work, int studentCount, int courseCount, int capacity) {
+    UniversitySystem system;
+    ostream discard(nullptr);
+    system.setOutputStream(discard);
+    buildTerm(system, studentCount, courseCount, capacity);
+
+    mutex systemMutex;
+    vector<vector<double>> latencies(work.size());
+    vector<thread> producers;
+    Clock::time_point start = Clock::now();
+    for (size_t p = 0; p < work.size(); p++) {
+        producers.emplace_back([&, p]() {
+            for (const Operation& op : work[p]) {
+                string studentID = "S" + to_string(op.student);
+                string courseCode = "C" + to_string(op.course);
+                Clock::time_point issued = Clock::now();
+                {
+                    lock_guard<mutex> guard(systemMutex);
+                    if (op.drop) {
+                        system.dropStudentFromCourse(studentID, courseCode);
+                    } else {
+                        system.enrollStudentInCourse(studentID, courseCode);
+                    }
+                }
+                latencies[p].push_back(chrono::duration<double, micro>(Clock::now() - issued).count());
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    RunResult result;
+    result.seconds = chrono::duration<double>(Clock::now() - start).count();
+    for (const auto& samples : latencies) {
+        result.latenciesMicros.insert(result.latenciesMicros.end(), samples.begin(), samples.end());
+    }
+    return result;
+}
+
+/**
+ @brief runs the workload through an AdmissionQueue drained by one owner thread
+
+ @details producers back off when told to slow down and wait for space when rejected; latency runs from the first submit attempt to the completion callback
+
+ @return (RunResult) elapsed time and per-request latency
+ */
+RunResult runQueued(const vector<vector<Operation>>& work, int studentCount, int courseCount, int capacity, size_t batchSize, size_t queueCapacity, AdmissionStats& stats) {
+    UniversitySystem system;
+    ostream discard(nullptr);
+    system.setOutputStream(discard);
+    buildTerm(system, studentCount, courseCount, capacity);
+
+    AdmissionQueue queue(queueCapacity, 4);
+    size_t total = 0;
+    for (const auto& ops : work) {
+        total += ops.size();
+    }
+    vector<double> latencies;
+    latencies.reserve(total);
+
+    Clock::time_point start = Clock::now();
+    thread owner([&]() {
+        size_t applied = 0;
+        while (applied < total) {
+            if (queue.waitForWork(chrono::milliseconds(10))) {
+                applied += queue.drain(system, batchSize);
+            }
+        }
+    });
+
+    vector<thread> producers;
+    for (size_t p = 0; p < work.size(); p++) {
+        producers.emplace_back([&, p]() {
+            for (const Operation& op : work[p]) {
+                Clock::time_point issued = Clock::now();
+                // the callback runs on the owner thread, which is the only writer of latencies
+                AdmissionRequest request("S" + to_string(op.student), "C" + to_string(op.course), op.drop, [&latencies, issued](bool) {
+                    latencies.push_back(chrono::duration<double, micro>(Clock::now() - issued).count());
+                });
+                AdmissionStatus status;
+                while ((status = queue.submit(request)) == AdmissionStatus::Rejected) {
+                    queue.waitForSpace(chrono::milliseconds(1));
+                }
+                if (status == AdmissionStatus::SlowDown) {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    owner.join();
+    queue.close();
+
+    RunResult result;
+    result.seconds = chrono::duration<double>(Clock::now() - start).count();
+    result.latenciesMicros = std::move(latencies);
+    stats = queue.getStats();
+    return result;
+}
+
+/**
+ @brief prints throughput and latency percentiles for one run
+
+ @param label the name of the run
+ @param result the run to print
+ */
+void report(const string& label, RunResult& result) {
+    sort(result.latenciesMicros.begin(), result.latenciesMicros.end());
+    const vector<double>& l = result.latenciesMicros;
+    cout << left << setw(10) << label << right << setw(14) << static_cast<long long>(l.size() / result.seconds)
+         << setw(10) << percentile(l, 0.50) << setw(10) << percentile(l, 0.99) << setw(10) << percentile(l, 0.999)
+         << setw(12) << (l.empty() ? 0.0 : l.back()) << endl;
+}
+
+int main(int argc, const char * argv[]) {
+    int studentCount = argc > 1 ? stoi(argv[1]) : 50000;
+    int courseCount = argc > 2 ? stoi(argv[2]) : 1000;
+    size_t producerCount = argc > 3 ? stoul(argv[3]) : 16;
+    size_t requestCount = argc > 4 ? stoul(argv[4]) : 400000;
+    double skew = argc > 5 ? stod(argv[5]) : 1.1;
+    size_t batchSize = argc > 6 ? stoul(argv[6]) : 512;
+    size_t queueCapacity = argc > 7 ? stoul(argv[7]) : 1024;
+    const int capacity = 60;
+
+    // Zipf(skew) over courses: course 0 is the hottest
+    vector<double> cumulative(courseCount);
+    double sum = 0;
+    for (int c = 0; c < courseCount; c++) {
+        sum += 1.0 / pow(c + 1, skew);
+        cumulative[c] = sum;
+    }
+
+    vector<vector<Operation>> work(producerCount);
+    for (size_t p = 0; p < producerCount; p++) {
+        mt19937 rng(static_cast<unsigned>(p + 1));
+        uniform_real_distribution<double> pickCourse(0, sum);
+        uniform_int_distribution<int> pickStudent(0, studentCount - 1);
+        size_t share = requestCount / producerCount + (p < requestCount % producerCount ? 1 : 0);
+        for (size_t i = 0; i < share; i++) {
+            int course = static_cast<int>(lower_bound(cumulative.begin(), cumulative.end(), pickCourse(rng)) - cumulative.begin());
+            work[p].push_back({pickStudent(rng), min(course, courseCount - 1), rng() % 3 == 0});
+        }
+    }
+
+    cout << "Students: " << studentCount << " | Courses: " << courseCount << " (Zipf " << skew << ")"
+         << " | Producers: " << producerCount << " | Requests: " << requestCount << " | Drain batch: " << batchSize << endl;
+    cout << fixed << setprecision(1);
+    cout << left << setw(10) << "Path" << right << setw(14) << "Requests/sec" << setw(10) << "p50 us" << setw(10) << "p99 us"
+         << setw(10) << "p99.9 us" << setw(12) << "max us" << endl;
+
+    RunResult direct = runDirect(work, studentCount, courseCount, capacity);
+    report("direct", direct);
+
+    AdmissionStats stats;
+    RunResult queued = runQueued(work, studentCount, courseCount, capacity, batchSize, queueCapacity, stats);
+    report("queued", queued);
+
+    cout << "Queue: " << stats.accepted << " accepted, " << stats.slowedDown << " told to slow down, " << stats.rejected
+         << " rejected and retried | " << stats.drains << " drains, " << stats.courseBatches << " course batches (avg "
+         << (stats.courseBatches > 0 ? static_cast<double>(stats.applied) / stats.courseBatches : 0.0) << ", largest "
+         << stats.largestCourseBatch << ") | deepest queue " << stats.deepestQueue << endl;
+    return 0;
+}
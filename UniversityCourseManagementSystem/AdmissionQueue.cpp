@@ -0,0 +1,254 @@
+//
+//  AdmissionQueue.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "AdmissionQueue.h"
+#include <algorithm>
+
+/**
+ @brief constructs an empty request
+ */
+AdmissionRequest::AdmissionRequest() {
+    drop = false;
+}
+
+/**
+ @brief constructs an enroll or drop request
+
+ @param student the student ID
+ @param course the course code
+ @param isDrop true to drop the student from the course, false to enroll them
+ @param completion called on the draining thread with the outcome once the request is applied; may be empty
+ */
+AdmissionRequest::AdmissionRequest(const string& student, const string& course, bool isDrop, function<void(bool)> completion) {
+    studentID = student;
+    courseCode = course;
+    drop = isDrop;
+    onComplete = std::move(completion);
+}
+
+/**
+ @brief constructs an empty queue
+
+ @details submitters are told to slow down once the queue is three quarters full
+
+ @param maxPending the most requests that may wait at once
+ @param maxPerStudent the most requests one student may have waiting
+ */
+AdmissionQueue::AdmissionQueue(size_t maxPending, size_t maxPerStudent) {
+    pending = 0;
+    capacity = max<size_t>(1, maxPending);
+    slowDownAt = capacity - capacity / 4;
+    perStudentLimit = max<size_t>(1, maxPerStudent);
+    closed = false;
+}
+
+/**
+ @brief offers a request to the queue without blocking
+
+ @details safe to call from any thread
+
+ @param request the request to queue
+
+ @return (AdmissionStatus) Accepted; SlowDown if accepted but the queue is nearly full and the caller should back off; Rejected if the queue is full, closed, or the student already has perStudentLimit requests waiting. rejected requests are not queued and their callback is never run
+ */
+AdmissionStatus AdmissionQueue::submit(AdmissionRequest request) {
+    AdmissionStatus status;
+    {
+        lock_guard<mutex> guard(queueMutex);
+        auto iter = perStudent.find(request.studentID);
+        if (closed || pending >= capacity || (iter != perStudent.end() && iter->second.size() >= perStudentLimit)) {
+            stats.rejected++;
+            return AdmissionStatus::Rejected;
+        }
+
+        if (iter == perStudent.end()) {
+            iter = perStudent.emplace(request.studentID, deque<AdmissionRequest>()).first;
+            rotation.push_back(request.studentID);
+        }
+        iter->second.push_back(std::move(request));
+        pending++;
+        stats.deepestQueue = max(stats.deepestQueue, pending);
+
+        status = pending >= slowDownAt ? AdmissionStatus::SlowDown : AdmissionStatus::Accepted;
+        if (status == AdmissionStatus::SlowDown) {
+            stats.slowedDown++;
+        } else {
+            stats.accepted++;
+        }
+    }
+    workReady.notify_one();
+    return status;
+}
+
+/**
+ @brief blocks a submitter until the queue has room again
+
+ @param timeout the longest time to wait
+
+ @return (bool) true if there is room, false on timeout or if the queue was closed
+ */
+bool AdmissionQueue::waitForSpace(chrono::milliseconds timeout) {
+    unique_lock<mutex> guard(queueMutex);
+    return spaceReady.wait_for(guard, timeout, [this]() {
+        return closed || pending < slowDownAt;
+    }) && !closed;
+}
+
+/**
+ @brief blocks the draining thread until a request is waiting
+
+ @param timeout the longest time to wait
+
+ @return (bool) true if there is work, false on timeout or if the queue was closed and is empty
+ */
+bool AdmissionQueue::waitForWork(chrono::milliseconds timeout) {
+    unique_lock<mutex> guard(queueMutex);
+    return workReady.wait_for(guard, timeout, [this]() {
+        return closed || pending > 0;
+    }) && pending > 0;
+}
+
+/**
+ @brief applies up to maxRequests waiting requests to the system
+
+ @details must run on the thread that owns the system. the lock is held only while requests are taken, one per student per round, so submitters are never blocked behind the system. callbacks run on this thread after their course's batch is applied
+
+ @param system the system to apply the requests to
+ @param maxRequests the most requests to take in this drain
+
+ @return (size_t) the number of requests applied
+ */
+size_t AdmissionQueue::drain(UniversitySystem& system, size_t maxRequests) {
+    vector<AdmissionRequest> taken;
+    {
+        lock_guard<mutex> guard(queueMutex);
+        while (taken.size() < maxRequests && !rotation.empty()) {
+            string studentID = std::move(rotation.front());
+            rotation.pop_front();
+            auto iter = perStudent.find(studentID);
+            taken.push_back(std::move(iter->second.front()));
+            iter->second.pop_front();
+            if (iter->second.empty()) {
+                perStudent.erase(iter);
+            } else {
+                rotation.push_back(std::move(studentID));
+            }
+        }
+        pending -= taken.size();
+        if (!taken.empty()) {
+            stats.drains++;
+        }
+    }
+    if (taken.empty()) {
+        return 0;
+    }
+    spaceReady.notify_all();
+
+    // group by course, keeping each course's requests in the order they were taken
+    vector<AdmissionRequest*> order;
+    order.reserve(taken.size());
+    for (auto& request : taken) {
+        order.push_back(&request);
+    }
+    stable_sort(order.begin(), order.end(), [](const AdmissionRequest* a, const AdmissionRequest* b) {
+        return a->courseCode < b->courseCode;
+    });
+
+    vector<AdmissionRequest*> batch;
+    size_t courseBatches = 0;
+    size_t largestBatch = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        batch.push_back(order[i]);
+        if (i + 1 == order.size() || order[i + 1]->courseCode != order[i]->courseCode) {
+            largestBatch = max(largestBatch, batch.size());
+            courseBatches++;
+            applyCourseBatch(system, batch);
+            batch.clear();
+        }
+    }
+
+    lock_guard<mutex> guard(queueMutex);
+    stats.applied += taken.size();
+    stats.courseBatches += courseBatches;
+    stats.largestCourseBatch = max(stats.largestCourseBatch, largestBatch);
+    return taken.size();
+}
+
+/**
+ @brief applies one course's requests
+
+ @details consecutive enrolls go to the system as one enrollStudentsInCourse call and consecutive drops as one dropStudentsFromCourse call. alternating runs are kept apart so a freed seat is offered to the waitlist before a later enroll can take it
+
+ @param system the system to apply the requests to
+ @param batch the requests for one course, in arrival order
+ */
+void AdmissionQueue::applyCourseBatch(UniversitySystem& system, vector<AdmissionRequest*>& batch) {
+    const string& courseCode = batch.front()->courseCode;
+    size_t start = 0;
+    vector<string> studentIDs;
+    while (start < batch.size()) {
+        size_t end = start;
+        studentIDs.clear();
+        while (end < batch.size() && batch[end]->drop == batch[start]->drop) {
+            studentIDs.push_back(batch[end]->studentID);
+            end++;
+        }
+
+        vector<bool> results = batch[start]->drop ? system.dropStudentsFromCourse(courseCode, studentIDs)
+                                                  : system.enrollStudentsInCourse(courseCode, studentIDs);
+        for (size_t i = start; i < end; i++) {
+            if (batch[i]->onComplete) {
+                batch[i]->onComplete(results[i - start]);
+            }
+        }
+        start = end;
+    }
+}
+
+/**
+ @brief stops accepting requests and wakes every waiting thread
+
+ @details requests already queued can still be drained
+ */
+void AdmissionQueue::close() {
+    {
+        lock_guard<mutex> guard(queueMutex);
+        closed = true;
+    }
+    workReady.notify_all();
+    spaceReady.notify_all();
+}
+
+/**
+ @brief gets the number of requests waiting
+
+ @return (size_t) the queue length
+ */
+size_t AdmissionQueue::size() const {
+    lock_guard<mutex> guard(queueMutex);
+    return pending;
+}
+
+/**
+ @brief checks if the queue has been closed
+
+ @return (bool) true if close was called, false otherwise
+ */
+bool AdmissionQueue::isClosed() const {
+    lock_guard<mutex> guard(queueMutex);
+    return closed;
+}
+
+/**
+ @brief gets counters for admissions, rejections and batching
+
+ @return (AdmissionStats) a copy of the counters
+ */
+AdmissionStats AdmissionQueue::getStats() const {
+    lock_guard<mutex> guard(queueMutex);
+    return stats;
+}
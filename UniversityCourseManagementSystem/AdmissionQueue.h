@@ -0,0 +1,84 @@
+//
+//  AdmissionQueue.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef ADMISSION_QUEUE_H
+#define ADMISSION_QUEUE_H
+
+#include "UniversitySystem.h"
+#include <string>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+using namespace std;
+
+enum class AdmissionStatus { Accepted, SlowDown, Rejected };
+
+struct AdmissionRequest {
+    string studentID;
+    string courseCode;
+    bool drop;
+    function<void(bool)> onComplete;
+
+    AdmissionRequest();
+    AdmissionRequest(const string& student, const string& course, bool isDrop, function<void(bool)> completion = nullptr);
+};
+
+struct AdmissionStats {
+    unsigned long long accepted = 0;
+    unsigned long long slowedDown = 0;
+    unsigned long long rejected = 0;
+    unsigned long long applied = 0;
+    unsigned long long drains = 0;
+    unsigned long long courseBatches = 0;
+    size_t largestCourseBatch = 0;
+    size_t deepestQueue = 0;
+};
+
+/**
+ @brief bounded ingress queue that feeds enroll and drop requests to a UniversitySystem in fair, per-course micro-batches
+
+ @details any thread may submit; only the thread that owns the system drains. each student has a FIFO of at most perStudentLimit requests, and drains take one request per student in round-robin order, so one student (or script) flooding the queue can't starve the rest. a drain then groups what it took by course and applies each course's requests with a single course lookup and leaderboard refresh, keeping arrival order within the course
+ */
+class AdmissionQueue {
+private:
+    mutable mutex queueMutex;
+    condition_variable workReady;
+    condition_variable spaceReady;
+    unordered_map<string, deque<AdmissionRequest>> perStudent;
+    deque<string> rotation;
+    size_t pending;
+    size_t capacity;
+    size_t slowDownAt;
+    size_t perStudentLimit;
+    bool closed;
+    AdmissionStats stats;
+
+    void applyCourseBatch(UniversitySystem& system, vector<AdmissionRequest*>& batch);
+
+public:
+    explicit AdmissionQueue(size_t maxPending = 65536, size_t maxPerStudent = 8);
+
+    AdmissionQueue(const AdmissionQueue&) = delete;
+    AdmissionQueue& operator=(const AdmissionQueue&) = delete;
+
+    AdmissionStatus submit(AdmissionRequest request);
+    bool waitForSpace(chrono::milliseconds timeout);
+    bool waitForWork(chrono::milliseconds timeout);
+    size_t drain(UniversitySystem& system, size_t maxRequests = 1024);
+    void close();
+
+    size_t size() const;
+    bool isClosed() const;
+    AdmissionStats getStats() const;
+};
+
+#endif // ADMISSION_QUEUE_H
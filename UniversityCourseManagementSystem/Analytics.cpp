@@ -0,0 +1,607 @@
+//
+//  Analytics.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/11/25.
+//
+
+#include "Analytics.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+/**
+ @brief formats a number with a fixed number of decimals
+
+ @param value the number to format
+ @param decimals the number of digits after the point
+
+ @return (string) the formatted number
+ */
+static string formatDecimal(double value, int decimals) {
+    ostringstream oss;
+    oss << fixed << setprecision(decimals) << value;
+    return oss.str();
+}
+
+/**
+ @brief constructs an empty snapshot
+ */
+AnalyticsSnapshot::AnalyticsSnapshot() {
+    version = 0;
+    scheduleStarts.push_back(0);
+}
+
+/**
+ @brief copies the catalog and every student's schedule into a flat snapshot
+
+ @details must run on the thread that owns the system. costs one pass over the courses and one over the enrollments
+
+ @param system the system to copy
+
+ @return (AnalyticsSnapshot) the snapshot
+ */
+AnalyticsSnapshot AnalyticsSnapshot::capture(const UniversitySystem& system) {
+    AnalyticsSnapshot snapshot;
+    snapshot.version = system.getVersion();
+
+    unordered_map<string, uint32_t> courseIndex;
+    unordered_map<string, uint32_t> instructorIndex;
+    unordered_map<string, uint32_t> departmentIndex;
+    courseIndex.reserve(system.getCourses().size());
+
+    auto indexOf = [](unordered_map<string, uint32_t>& index, vector<string>& names, const string& name) {
+        auto result = index.emplace(name, static_cast<uint32_t>(names.size()));
+        if (result.second) {
+            names.push_back(name);
+        }
+        return result.first->second;
+    };
+
+    system.forEachCourse([&](const Course& course) {
+        courseIndex.emplace(course.getCourseCode(), static_cast<uint32_t>(snapshot.courseCodes.size()));
+        snapshot.courseCodes.push_back(course.getCourseCode());
+        snapshot.courseInstructor.push_back(indexOf(instructorIndex, snapshot.instructors, course.getInstructorName()));
+        snapshot.courseDepartment.push_back(indexOf(departmentIndex, snapshot.departments, course.getDepartment()));
+        // an offering's seats are counted in its sections
+        snapshot.courseCapacity.push_back(course.isSectioned() ? 0 : course.getCapacity());
+        snapshot.courseEnrolled.push_back(course.getCurrentEnrollment());
+        snapshot.courseWaitlisted.push_back(course.getWaitlistSize());
+    });
+
+    snapshot.studentIDs.reserve(system.getStudents().size());
+    snapshot.scheduleStarts.reserve(system.getStudents().size() + 1);
+    system.forEachStudent([&](const Student& student) {
+        snapshot.studentIDs.push_back(student.getStudentID());
+        student.forEachEnrolledCourse([&](const string& courseCode) {
+            auto iter = courseIndex.find(courseCode);
+            if (iter != courseIndex.end()) {
+                snapshot.scheduleCourses.push_back(iter->second);
+            }
+        });
+        snapshot.scheduleStarts.push_back(static_cast<uint32_t>(snapshot.scheduleCourses.size()));
+    });
+    return snapshot;
+}
+
+/**
+ @brief gets the number of enrollments in the snapshot
+
+ @return (size_t) the number of (student, course) enrollments
+ */
+size_t AnalyticsSnapshot::getEnrollmentCount() const {
+    return scheduleCourses.size();
+}
+
+/**
+ @brief prints the result as a table with columns sized to fit
+
+ @param os the stream to print to
+ */
+void AnalyticsResult::display(ostream& os) const {
+    vector<size_t> widths(columns.size());
+    for (size_t c = 0; c < columns.size(); c++) {
+        widths[c] = columns[c].size();
+        for (const auto& row : rows) {
+            widths[c] = max(widths[c], row[c].size());
+        }
+    }
+
+    os << "\n=== " << title << " ===" << endl;
+    for (size_t c = 0; c < columns.size(); c++) {
+        os << (c == 0 ? left : right) << setw(static_cast<int>(widths[c])) << columns[c] << (c + 1 < columns.size() ? " | " : "");
+    }
+    os << endl;
+    for (const auto& row : rows) {
+        for (size_t c = 0; c < columns.size(); c++) {
+            os << (c == 0 ? left : right) << setw(static_cast<int>(widths[c])) << row[c] << (c + 1 < columns.size() ? " | " : "");
+        }
+        os << endl;
+    }
+    os << left;
+}
+
+/**
+ @brief constructs a runner that uses a fixed number of threads
+
+ @param threads the number of threads. 0 means one
+ */
+ParallelRunner::ParallelRunner(unsigned threads) {
+    threadCount = max(1u, threads);
+}
+
+/**
+ @brief gets the number of threads work is split across
+
+ @return (unsigned) the thread count
+ */
+unsigned ParallelRunner::getThreadCount() const {
+    return threadCount;
+}
+
+/**
+ @brief destroys an aggregation
+ */
+Aggregation::~Aggregation() {
+}
+
+/**
+ @brief gets the name of the instructor load report
+
+ @return (string) "instructor-load"
+ */
+string InstructorLoadAggregation::getName() const {
+    return "instructor-load";
+}
+
+/**
+ @brief computes courses, filled seats, capacity, waitlists and distinct students per instructor
+
+ @details students are split across threads; each student's instructors are deduplicated locally so a student taking two courses from one instructor counts once
+
+ @param snapshot the data to aggregate
+ @param runner the threads to use
+
+ @return (AnalyticsResult) one row per instructor, most students first
+ */
+AnalyticsResult InstructorLoadAggregation::run(const AnalyticsSnapshot& snapshot, const ParallelRunner& runner) const {
+    struct Load {
+        long long courses = 0;
+        long long enrolled = 0;
+        long long capacity = 0;
+        long long waitlisted = 0;
+        long long students = 0;
+    };
+    size_t instructorCount = snapshot.instructors.size();
+
+    vector<vector<long long>> partials = runner.mapPartitions(snapshot.studentIDs.size(), vector<long long>(instructorCount, 0),
+        [&](vector<long long>& students, size_t begin, size_t end) {
+            vector<uint32_t> seen;
+            for (size_t s = begin; s < end; s++) {
+                seen.clear();
+                for (uint32_t i = snapshot.scheduleStarts[s]; i < snapshot.scheduleStarts[s + 1]; i++) {
+                    seen.push_back(snapshot.courseInstructor[snapshot.scheduleCourses[i]]);
+                }
+                sort(seen.begin(), seen.end());
+                seen.erase(unique(seen.begin(), seen.end()), seen.end());
+                for (uint32_t instructor : seen) {
+                    students[instructor]++;
+                }
+            }
+        });
+
+    vector<Load> loads(instructorCount);
+    for (const auto& partial : partials) {
+        for (size_t i = 0; i < instructorCount; i++) {
+            loads[i].students += partial[i];
+        }
+    }
+    for (size_t c = 0; c < snapshot.courseCodes.size(); c++) {
+        Load& load = loads[snapshot.courseInstructor[c]];
+        load.courses++;
+        load.enrolled += snapshot.courseEnrolled[c];
+        load.capacity += snapshot.courseCapacity[c];
+        load.waitlisted += snapshot.courseWaitlisted[c];
+    }
+
+    vector<size_t> order(instructorCount);
+    for (size_t i = 0; i < instructorCount; i++) {
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return loads[a].students != loads[b].students ? loads[a].students > loads[b].students : snapshot.instructors[a] < snapshot.instructors[b];
+    });
+
+    AnalyticsResult result;
+    result.title = "Instructor Load";
+    result.columns = {"Instructor", "Courses", "Seats Filled", "Capacity", "Waitlisted", "Students"};
+    for (size_t i : order) {
+        result.rows.push_back({snapshot.instructors[i], to_string(loads[i].courses), to_string(loads[i].enrolled),
+                               to_string(loads[i].capacity), to_string(loads[i].waitlisted), to_string(loads[i].students)});
+    }
+    return result;
+}
+
+/**
+ @brief gets the name of the department fill report
+
+ @return (string) "department-fill"
+ */
+string DepartmentFillAggregation::getName() const {
+    return "department-fill";
+}
+
+/**
+ @brief computes fill rate, waitlists and per-student course counts per department
+
+ @details seat counts come from the catalog; distinct students and the average number of courses each takes in the department come from the schedules, split across threads
+
+ @param snapshot the data to aggregate
+ @param runner the threads to use
+
+ @return (AnalyticsResult) one row per department, in code order
+ */
+AnalyticsResult DepartmentFillAggregation::run(const AnalyticsSnapshot& snapshot, const ParallelRunner& runner) const {
+    size_t departmentCount = snapshot.departments.size();
+
+    // per department: [0] distinct students, [1] enrollments
+    vector<vector<long long>> partials = runner.mapPartitions(snapshot.studentIDs.size(), vector<long long>(departmentCount * 2, 0),
+        [&](vector<long long>& counts, size_t begin, size_t end) {
+            vector<uint32_t> seen;
+            for (size_t s = begin; s < end; s++) {
+                seen.clear();
+                for (uint32_t i = snapshot.scheduleStarts[s]; i < snapshot.scheduleStarts[s + 1]; i++) {
+                    uint32_t department = snapshot.courseDepartment[snapshot.scheduleCourses[i]];
+                    seen.push_back(department);
+                    counts[department * 2 + 1]++;
+                }
+                sort(seen.begin(), seen.end());
+                seen.erase(unique(seen.begin(), seen.end()), seen.end());
+                for (uint32_t department : seen) {
+                    counts[department * 2]++;
+                }
+            }
+        });
+
+    vector<long long> students(departmentCount, 0);
+    vector<long long> enrollments(departmentCount, 0);
+    for (const auto& partial : partials) {
+        for (size_t d = 0; d < departmentCount; d++) {
+            students[d] += partial[d * 2];
+            enrollments[d] += partial[d * 2 + 1];
+        }
+    }
+    vector<long long> courses(departmentCount, 0);
+    vector<long long> capacity(departmentCount, 0);
+    vector<long long> waitlisted(departmentCount, 0);
+    for (size_t c = 0; c < snapshot.courseCodes.size(); c++) {
+        uint32_t department = snapshot.courseDepartment[c];
+        courses[department]++;
+        capacity[department] += snapshot.courseCapacity[c];
+        waitlisted[department] += snapshot.courseWaitlisted[c];
+    }
+
+    vector<size_t> order(departmentCount);
+    for (size_t d = 0; d < departmentCount; d++) {
+        order[d] = d;
+    }
+    sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return snapshot.departments[a] < snapshot.departments[b];
+    });
+
+    AnalyticsResult result;
+    result.title = "Department Fill Rates";
+    result.columns = {"Department", "Courses", "Seats Filled", "Capacity", "Fill %", "Waitlisted", "Students", "Courses/Student"};
+    for (size_t d : order) {
+        double fill = capacity[d] > 0 ? 100.0 * enrollments[d] / capacity[d] : 0.0;
+        double perStudent = students[d] > 0 ? static_cast<double>(enrollments[d]) / students[d] : 0.0;
+        result.rows.push_back({snapshot.departments[d].empty() ? "(none)" : snapshot.departments[d], to_string(courses[d]),
+                               to_string(enrollments[d]), to_string(capacity[d]), formatDecimal(fill, 1), to_string(waitlisted[d]),
+                               to_string(students[d]), formatDecimal(perStudent, 2)});
+    }
+    return result;
+}
+
+/**
+ @brief gets the name of the course load distribution report
+
+ @return (string) "course-load"
+ */
+string CourseLoadAggregation::getName() const {
+    return "course-load";
+}
+
+/**
+ @brief computes how many students take 0, 1, 2, ... courses
+
+ @param snapshot the data to aggregate
+ @param runner the threads to use
+
+ @return (AnalyticsResult) one row per course count, plus the mean
+ */
+AnalyticsResult CourseLoadAggregation::run(const AnalyticsSnapshot& snapshot, const ParallelRunner& runner) const {
+    vector<vector<long long>> partials = runner.mapPartitions(snapshot.studentIDs.size(), vector<long long>(),
+        [&](vector<long long>& histogram, size_t begin, size_t end) {
+            for (size_t s = begin; s < end; s++) {
+                size_t load = snapshot.scheduleStarts[s + 1] - snapshot.scheduleStarts[s];
+                if (load >= histogram.size()) {
+                    histogram.resize(load + 1, 0);
+                }
+                histogram[load]++;
+            }
+        });
+
+    vector<long long> histogram;
+    for (const auto& partial : partials) {
+        if (partial.size() > histogram.size()) {
+            histogram.resize(partial.size(), 0);
+        }
+        for (size_t load = 0; load < partial.size(); load++) {
+            histogram[load] += partial[load];
+        }
+    }
+
+    long long studentCount = static_cast<long long>(snapshot.studentIDs.size());
+    AnalyticsResult result;
+    result.title = "Course Load per Student";
+    result.columns = {"Courses", "Students", "Share %"};
+    for (size_t load = 0; load < histogram.size(); load++) {
+        result.rows.push_back({to_string(load), to_string(histogram[load]), formatDecimal(studentCount > 0 ? 100.0 * histogram[load] / studentCount : 0.0, 1)});
+    }
+    double mean = studentCount > 0 ? static_cast<double>(snapshot.getEnrollmentCount()) / studentCount : 0.0;
+    result.rows.push_back({"mean", formatDecimal(mean, 2), ""});
+    return result;
+}
+
+/**
+ @brief constructs the co-enrollment report
+
+ @param pairs the number of most co-enrolled course pairs to list
+ */
+CoEnrollmentAggregation::CoEnrollmentAggregation(size_t pairs) {
+    topPairs = pairs;
+}
+
+/**
+ @brief gets the name of the co-enrollment report
+
+ @return (string) "co-enrollment"
+ */
+string CoEnrollmentAggregation::getName() const {
+    return "co-enrollment";
+}
+
+/**
+ @brief orders co-enrolled pairs from most to fewest shared students, then by key
+
+ @return (bool) true if a ranks before b
+ */
+static bool ranksBefore(const pair<uint64_t, uint32_t>& a, const pair<uint64_t, uint32_t>& b) {
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+}
+
+/**
+ @brief offers a pair to a bounded list of the best pairs seen so far
+
+ @details the list is a heap with the worst kept pair on top, so each offer is O(log limit)
+
+ @param top the heap of kept pairs
+ @param limit the most pairs to keep
+ @param candidate the pair to offer
+ */
+static void keepTopPair(vector<pair<uint64_t, uint32_t>>& top, size_t limit, const pair<uint64_t, uint32_t>& candidate) {
+    if (top.size() < limit) {
+        top.push_back(candidate);
+        push_heap(top.begin(), top.end(), ranksBefore);
+    } else if (limit > 0 && ranksBefore(candidate, top.front())) {
+        pop_heap(top.begin(), top.end(), ranksBefore);
+        top.back() = candidate;
+        push_heap(top.begin(), top.end(), ranksBefore);
+    }
+}
+
+/**
+ @brief counts how many students share each pair of courses and lists the most shared pairs
+
+ @details schedules are sorted by course code, so each pair is always (lower, higher). when the upper triangle of the co-enrollment matrix fits in DENSE_MATRIX_BYTES, every thread counts into its own dense copy and the copies are summed and ranked in parallel, cell range by cell range. larger catalogs fall back to one sparse hash-map matrix per thread, summed on the calling thread
+
+ @param snapshot the data to aggregate
+ @param runner the threads to use
+
+ @return (AnalyticsResult) the most co-enrolled pairs, most students first
+ */
+AnalyticsResult CoEnrollmentAggregation::run(const AnalyticsSnapshot& snapshot, const ParallelRunner& runner) const {
+    using Ranked = vector<pair<uint64_t, uint32_t>>;
+    uint64_t courseCount = snapshot.courseCodes.size();
+    uint64_t cells = courseCount < 2 ? 0 : courseCount * (courseCount - 1) / 2;
+    size_t pairCount = 0;
+    Ranked ranked;
+
+    if (cells * sizeof(uint32_t) <= DENSE_MATRIX_BYTES) {
+        // cell of (a, b) with a < b: rows of the upper triangle laid end to end
+        auto rowStart = [courseCount](uint64_t a) {
+            return a * (2 * courseCount - a - 1) / 2;
+        };
+        vector<vector<uint32_t>> partials = runner.mapPartitions(snapshot.studentIDs.size(), vector<uint32_t>(cells, 0),
+            [&](vector<uint32_t>& counts, size_t begin, size_t end) {
+                for (size_t s = begin; s < end; s++) {
+                    uint32_t first = snapshot.scheduleStarts[s];
+                    uint32_t last = snapshot.scheduleStarts[s + 1];
+                    for (uint32_t i = first; i < last; i++) {
+                        for (uint32_t j = i + 1; j < last; j++) {
+                            uint64_t a = min(snapshot.scheduleCourses[i], snapshot.scheduleCourses[j]);
+                            uint64_t b = max(snapshot.scheduleCourses[i], snapshot.scheduleCourses[j]);
+                            counts[rowStart(a) + (b - a - 1)]++;
+                        }
+                    }
+                }
+            });
+
+        struct Scan {
+            size_t nonzero = 0;
+            Ranked top;
+        };
+        vector<uint32_t>& total = partials.front();
+        vector<Scan> scans = runner.mapPartitions(static_cast<size_t>(cells), Scan(), [&](Scan& scan, size_t begin, size_t end) {
+            for (size_t p = 1; p < partials.size(); p++) {
+                for (size_t cell = begin; cell < end; cell++) {
+                    total[cell] += partials[p][cell];
+                }
+            }
+            for (size_t cell = begin; cell < end; cell++) {
+                if (total[cell] > 0) {
+                    scan.nonzero++;
+                    keepTopPair(scan.top, topPairs, {cell, total[cell]});
+                }
+            }
+        });
+
+        for (const auto& scan : scans) {
+            pairCount += scan.nonzero;
+            ranked.insert(ranked.end(), scan.top.begin(), scan.top.end());
+        }
+        for (auto& entry : ranked) {
+            uint64_t a = 0;
+            while (rowStart(a + 1) <= entry.first) {
+                a++;
+            }
+            entry.first = (a << 32) | (a + 1 + entry.first - rowStart(a));
+        }
+    } else {
+        using PairCounts = unordered_map<uint64_t, uint32_t>;
+        vector<PairCounts> partials = runner.mapPartitions(snapshot.studentIDs.size(), PairCounts(),
+            [&](PairCounts& counts, size_t begin, size_t end) {
+                for (size_t s = begin; s < end; s++) {
+                    uint32_t first = snapshot.scheduleStarts[s];
+                    uint32_t last = snapshot.scheduleStarts[s + 1];
+                    for (uint32_t i = first; i < last; i++) {
+                        for (uint32_t j = i + 1; j < last; j++) {
+                            uint64_t a = min(snapshot.scheduleCourses[i], snapshot.scheduleCourses[j]);
+                            uint64_t b = max(snapshot.scheduleCourses[i], snapshot.scheduleCourses[j]);
+                            counts[(a << 32) | b]++;
+                        }
+                    }
+                }
+            });
+
+        PairCounts& total = partials.front();
+        for (size_t p = 1; p < partials.size(); p++) {
+            for (const auto& entry : partials[p]) {
+                total[entry.first] += entry.second;
+            }
+        }
+        pairCount = total.size();
+        for (const auto& entry : total) {
+            keepTopPair(ranked, topPairs, entry);
+        }
+    }
+
+    sort(ranked.begin(), ranked.end(), ranksBefore);
+    if (ranked.size() > topPairs) {
+        ranked.resize(topPairs);
+    }
+
+    AnalyticsResult result;
+    result.title = "Most Co-Enrolled Course Pairs (" + to_string(pairCount) + " pairs share at least one student)";
+    result.columns = {"Course", "Course", "Shared Students"};
+    for (const auto& entry : ranked) {
+        result.rows.push_back({snapshot.courseCodes[entry.first >> 32], snapshot.courseCodes[entry.first & 0xFFFFFFFFu], to_string(entry.second)});
+    }
+    return result;
+}
+
+/**
+ @brief constructs an engine with the built-in aggregations
+
+ @param threads the number of threads each aggregation is split across
+ */
+AnalyticsEngine::AnalyticsEngine(unsigned threads) : runner(threads) {
+    registerAggregation(unique_ptr<Aggregation>(new InstructorLoadAggregation()));
+    registerAggregation(unique_ptr<Aggregation>(new DepartmentFillAggregation()));
+    registerAggregation(unique_ptr<Aggregation>(new CourseLoadAggregation()));
+    registerAggregation(unique_ptr<Aggregation>(new CoEnrollmentAggregation()));
+}
+
+/**
+ @brief changes the number of threads used by later runs
+
+ @param threads the thread count. 0 means one
+ */
+void AnalyticsEngine::setThreadCount(unsigned threads) {
+    runner = ParallelRunner(threads);
+}
+
+/**
+ @brief gets the number of threads aggregations are split across
+
+ @return (unsigned) the thread count
+ */
+unsigned AnalyticsEngine::getThreadCount() const {
+    return runner.getThreadCount();
+}
+
+/**
+ @brief adds an aggregation to the engine
+
+ @param aggregation the aggregation. its name must be unique
+
+ @return (bool) true if added, false if the name is taken or the aggregation is null
+ */
+bool AnalyticsEngine::registerAggregation(unique_ptr<Aggregation> aggregation) {
+    if (!aggregation) {
+        return false;
+    }
+    for (const auto& existing : aggregations) {
+        if (existing->getName() == aggregation->getName()) {
+            return false;
+        }
+    }
+    aggregations.push_back(std::move(aggregation));
+    return true;
+}
+
+/**
+ @brief lists the registered aggregations
+
+ @return (vector<string>) the names, in registration order
+ */
+vector<string> AnalyticsEngine::getAggregationNames() const {
+    vector<string> names;
+    for (const auto& aggregation : aggregations) {
+        names.push_back(aggregation->getName());
+    }
+    return names;
+}
+
+/**
+ @brief runs one aggregation over a snapshot
+
+ @param name the name of the aggregation
+ @param snapshot the data to aggregate
+
+ @return (pair<bool, AnalyticsResult>) true and the result if the aggregation exists, false otherwise
+ */
+pair<bool, AnalyticsResult> AnalyticsEngine::run(const string& name, const AnalyticsSnapshot& snapshot) const {
+    for (const auto& aggregation : aggregations) {
+        if (aggregation->getName() == name) {
+            return {true, aggregation->run(snapshot, runner)};
+        }
+    }
+    return {false, AnalyticsResult()};
+}
+
+/**
+ @brief runs every registered aggregation over the same snapshot
+
+ @param snapshot the data to aggregate
+
+ @return (vector<AnalyticsResult>) one result per aggregation, in registration order
+ */
+vector<AnalyticsResult> AnalyticsEngine::runAll(const AnalyticsSnapshot& snapshot) const {
+    vector<AnalyticsResult> results;
+    for (const auto& aggregation : aggregations) {
+        results.push_back(aggregation->run(snapshot, runner));
+    }
+    return results;
+}
@@ -0,0 +1,152 @@
+//
+//  Analytics.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/11/25.
+//
+
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include "UniversitySystem.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <iostream>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ @brief immutable, flattened copy of the catalog and rosters for analytics
+
+ @details courses, instructors, departments and students get dense indexes, and every student's schedule is stored in one array (scheduleCourses[scheduleStarts[s] .. scheduleStarts[s + 1]]). capture it on the thread that owns the UniversitySystem; afterwards any number of threads can read it while the system keeps changing
+ */
+struct AnalyticsSnapshot {
+    vector<string> courseCodes;
+    vector<uint32_t> courseInstructor;
+    vector<uint32_t> courseDepartment;
+    vector<int> courseCapacity;
+    vector<int> courseEnrolled;
+    vector<int> courseWaitlisted;
+    vector<string> instructors;
+    vector<string> departments;
+    vector<string> studentIDs;
+    vector<uint32_t> scheduleStarts;
+    vector<uint32_t> scheduleCourses;
+    unsigned long long version;
+
+    AnalyticsSnapshot();
+
+    static AnalyticsSnapshot capture(const UniversitySystem& system);
+
+    size_t getEnrollmentCount() const;
+};
+
+struct AnalyticsResult {
+    string title;
+    vector<string> columns;
+    vector<vector<string>> rows;
+
+    void display(ostream& os = cout) const;
+};
+
+class ParallelRunner {
+private:
+    unsigned threadCount;
+
+public:
+    explicit ParallelRunner(unsigned threads);
+
+    unsigned getThreadCount() const;
+
+    /**
+     @brief splits [0, count) into one contiguous range per thread and runs body on each range in parallel
+
+     @details every thread works on its own copy of initial, so bodies never share mutable state. the caller merges the returned partials
+
+     @param count the number of items to process
+     @param initial the starting value of each thread's partial result
+     @param body callable taking (Partial&, size_t begin, size_t end)
+
+     @return (vector<Partial>) one partial result per range, in range order
+     */
+    template <typename Partial, typename Body>
+    vector<Partial> mapPartitions(size_t count, const Partial& initial, Body body) const {
+        size_t parts = max<size_t>(1, min<size_t>(threadCount, count));
+        vector<Partial> partials(parts, initial);
+        vector<thread> workers;
+        for (size_t part = 0; part < parts; part++) {
+            size_t begin = count * part / parts;
+            size_t end = count * (part + 1) / parts;
+            if (part + 1 == parts) {
+                body(partials[part], begin, end);
+            } else {
+                workers.emplace_back([&, part, begin, end]() {
+                    body(partials[part], begin, end);
+                });
+            }
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return partials;
+    }
+};
+
+class Aggregation {
+public:
+    virtual ~Aggregation();
+    virtual string getName() const = 0;
+    virtual AnalyticsResult run(const AnalyticsSnapshot& snapshot, const ParallelRunner& runner) const = 0;
+};
+
+class InstructorLoadAggregation : public Aggregation {
+public:
+    string getName() const override;
+    AnalyticsResult run(const AnalyticsSnapshot& snapshot, const ParallelRunner& runner) const override;
+};
+
+class DepartmentFillAggregation : public Aggregation {
+public:
+    string getName() const override;
+    AnalyticsResult run(const AnalyticsSnapshot& snapshot, const ParallelRunner& runner) const override;
+};
+
+class CourseLoadAggregation : public Aggregation {
+public:
+    string getName() const override;
+    AnalyticsResult run(const AnalyticsSnapshot& snapshot, const ParallelRunner& runner) const override;
+};
+
+class CoEnrollmentAggregation : public Aggregation {
+private:
+    static const size_t DENSE_MATRIX_BYTES = 64 * 1024 * 1024;
+    size_t topPairs;
+
+public:
+    explicit CoEnrollmentAggregation(size_t pairs = 20);
+    string getName() const override;
+    AnalyticsResult run(const AnalyticsSnapshot& snapshot, const ParallelRunner& runner) const override;
+};
+
+class AnalyticsEngine {
+private:
+    ParallelRunner runner;
+    vector<unique_ptr<Aggregation>> aggregations;
+
+public:
+    explicit AnalyticsEngine(unsigned threads = thread::hardware_concurrency());
+
+    void setThreadCount(unsigned threads);
+    unsigned getThreadCount() const;
+
+    bool registerAggregation(unique_ptr<Aggregation> aggregation);
+    vector<string> getAggregationNames() const;
+
+    pair<bool, AnalyticsResult> run(const string& name, const AnalyticsSnapshot& snapshot) const;
+    vector<AnalyticsResult> runAll(const AnalyticsSnapshot& snapshot) const;
+};
+
+#endif // ANALYTICS_H
@@ -0,0 +1,109 @@
+//
+//  AnalyticsBench.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/11/25.
+//
+
+#include "Analytics.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+/**
+ @brief times one aggregation, keeping the best of a few runs
+
+ @param engine the engine to run with
+ @param name the aggregation to run
+ @param snapshot the data to aggregate
+ @param repeats the number of runs
+
+ @return (double) the fastest run in milliseconds
+ */
+double timeAggregation(const AnalyticsEngine& engine, const string& name, const AnalyticsSnapshot& snapshot, int repeats) {
+    double best = 0;
+    for (int r = 0; r < repeats; r++) {
+        Clock::time_point start = Clock::now();
+        engine.run(name, snapshot);
+        double millis = chrono::duration<double, milli>(Clock::now() - start).count();
+        if (r == 0 || millis < best) {
+            best = millis;
+        }
+    }
+    return best;
+}
+
+int main(int argc, const char * argv[]) {
+    int studentCount = argc > 1 ? stoi(argv[1]) : 200000;
+    int courseCount = argc > 2 ? stoi(argv[2]) : 2000;
+    int perStudent = argc > 3 ? stoi(argv[3]) : 5;
+    unsigned maxThreads = argc > 4 ? static_cast<unsigned>(stoul(argv[4])) : max(1u, thread::hardware_concurrency());
+    const int repeats = 3;
+    const char* departments[] = {"CS", "MATH", "PHYS", "CHEM", "BIO", "HIST", "ENG", "ECON"};
+
+    UniversitySystem system;
+    ostringstream quiet;
+    system.setOutputStream(quiet);
+
+    Clock::time_point buildStart = Clock::now();
+    for (int c = 0; c < courseCount; c++) {
+        string code = string(departments[c % 8]) + to_string(100 + c);
+        system.addCourse(code, "Course " + to_string(c), "Dr. Instructor" + to_string(c % (courseCount / 4 + 1)), perStudent * studentCount / courseCount * 8);
+        quiet.str("");
+    }
+    mt19937 rng(42);
+    uniform_int_distribution<int> pickCourse(0, courseCount - 1);
+    for (int s = 0; s < studentCount; s++) {
+        string id = "S" + to_string(s);
+        system.addStudent(id, "Student " + to_string(s));
+        int enrolled = 0;
+        for (int attempt = 0; enrolled < perStudent && attempt < perStudent * 4; attempt++) {
+            // squaring skews demand toward low-numbered courses so some pairs are popular
+            int c = pickCourse(rng);
+            c = static_cast<int>(static_cast<long long>(c) * c / courseCount);
+            if (system.enrollStudentInCourse(id, string(departments[c % 8]) + to_string(100 + c))) {
+                enrolled++;
+            }
+        }
+        quiet.str("");
+    }
+    double buildSeconds = chrono::duration<double>(Clock::now() - buildStart).count();
+
+    Clock::time_point captureStart = Clock::now();
+    AnalyticsSnapshot snapshot = AnalyticsSnapshot::capture(system);
+    double captureMillis = chrono::duration<double, milli>(Clock::now() - captureStart).count();
+
+    cout << fixed << setprecision(1);
+    cout << "Students: " << snapshot.studentIDs.size() << " | Courses: " << snapshot.courseCodes.size()
+         << " | Enrollments: " << snapshot.getEnrollmentCount() << endl;
+    cout << "Built in " << buildSeconds << " s | Snapshot captured in " << captureMillis << " ms" << endl;
+
+    vector<unsigned> threadCounts;
+    for (unsigned t = 1; t < maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+
+    AnalyticsEngine engine(1);
+    for (const string& name : engine.getAggregationNames()) {
+        cout << "\n" << name << endl;
+        cout << left << setw(10) << "Threads" << right << setw(12) << "ms" << setw(12) << "Speedup" << endl;
+        double baseline = 0;
+        for (unsigned threads : threadCounts) {
+            engine.setThreadCount(threads);
+            double millis = timeAggregation(engine, name, snapshot, repeats);
+            if (threads == 1) {
+                baseline = millis;
+            }
+            cout << left << setw(10) << threads << right << setw(12) << millis << setw(11) << (baseline / millis) << "x" << endl;
+        }
+    }
+    return 0;
+}
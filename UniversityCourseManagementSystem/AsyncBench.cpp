@@ -0,0 +1,132 @@
+//
+//  AsyncBench.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "AsyncUniversitySystem.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+struct Registration {
+    string studentID;
+    string courseCode;
+    int thinkMillis;
+    bool dropAfter;
+};
+
+struct Progress {
+    size_t enrollsAnswered = 0;
+    size_t enrolled = 0;
+    size_t finished = 0;
+    Clock::time_point lastEnrollAnswered;
+};
+
+/**
+ @brief builds a term with one student per registration
+
+ @param system the system to fill
+ @param registrations the registrations whose students and courses to add
+ @param courseCount the number of courses
+ */
+void buildTerm(UniversitySystem& system, const vector<Registration>& registrations, int courseCount) {
+    for (int c = 0; c < courseCount; c++) {
+        system.addCourse("C" + to_string(c), "Course " + to_string(c), "Dr. Async", 40);
+    }
+    for (const auto& registration : registrations) {
+        system.addStudent(registration.studentID, "Student " + registration.studentID);
+    }
+}
+
+/**
+ @brief one student's registration session: enroll, think, maybe drop
+
+ @param facade the async system
+ @param registration what the student does
+ @param progress shared counters
+ */
+Task<void> session(AsyncUniversitySystem& facade, const Registration& registration, Progress& progress) {
+    bool enrolled = co_await facade.enrollAsync(registration.studentID, registration.courseCode);
+    progress.enrollsAnswered++;
+    progress.lastEnrollAnswered = Clock::now();
+    if (enrolled) {
+        progress.enrolled++;
+    }
+
+    co_await facade.getExecutor().sleepFor(chrono::milliseconds(registration.thinkMillis));
+    if (registration.dropAfter) {
+        co_await facade.dropAsync(registration.studentID, registration.courseCode);
+    }
+    progress.finished++;
+}
+
+int main(int argc, const char * argv[]) {
+    size_t registrationCount = argc > 1 ? stoul(argv[1]) : 50000;
+    int courseCount = argc > 2 ? stoi(argv[2]) : 500;
+    int maxThinkMillis = argc > 3 ? stoi(argv[3]) : 50;
+
+    mt19937 rng(42);
+    vector<Registration> registrations;
+    registrations.reserve(registrationCount);
+    for (size_t i = 0; i < registrationCount; i++) {
+        registrations.push_back({"S" + to_string(i), "C" + to_string(rng() % courseCount),
+                                 static_cast<int>(rng() % (maxThinkMillis + 1)), rng() % 3 == 0});
+    }
+    ostream discard(nullptr);
+
+    cout << "Registrations: " << registrationCount << " | Courses: " << courseCount << " | Think time: 0-" << maxThinkMillis << " ms" << endl;
+    cout << fixed << setprecision(1);
+
+    // the same enrolls and drops, one call at a time and with no think time, for the per-operation cost
+    {
+        UniversitySystem system;
+        system.setOutputStream(discard);
+        buildTerm(system, registrations, courseCount);
+        Clock::time_point start = Clock::now();
+        size_t operations = 0;
+        for (const auto& registration : registrations) {
+            system.enrollStudentInCourse(registration.studentID, registration.courseCode);
+            operations++;
+        }
+        for (const auto& registration : registrations) {
+            if (registration.dropAfter) {
+                system.dropStudentFromCourse(registration.studentID, registration.courseCode);
+                operations++;
+            }
+        }
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << "Synchronous calls: " << operations << " operations in " << seconds * 1000 << " ms ("
+             << static_cast<long long>(operations / seconds) << " ops/sec)" << endl;
+    }
+
+    // every session in flight at once on one thread
+    UniversitySystem system;
+    system.setOutputStream(discard);
+    buildTerm(system, registrations, courseCount);
+    Executor executor;
+    AsyncUniversitySystem facade(system, executor);
+    Progress progress;
+
+    Clock::time_point start = Clock::now();
+    for (const auto& registration : registrations) {
+        executor.spawn(session(facade, registration, progress));
+    }
+    executor.run();
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    double admitMillis = chrono::duration<double, milli>(progress.lastEnrollAnswered - start).count();
+
+    AdmissionStats stats = facade.getAdmissionStats();
+    cout << "Coroutines: " << executor.getPeakLiveTaskCount() << " sessions in flight on one thread, all "
+         << progress.enrollsAnswered << " enrolls answered in " << admitMillis << " ms (" << progress.enrolled << " enrolled)" << endl;
+    cout << "            " << progress.finished << " sessions finished in " << seconds * 1000 << " ms including think time | "
+         << executor.getResumptionCount() << " resumptions, " << stats.drains << " drains, " << stats.courseBatches << " course batches" << endl;
+    return 0;
+}
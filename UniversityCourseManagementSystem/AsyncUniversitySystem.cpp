@@ -0,0 +1,219 @@
+//
+//  AsyncUniversitySystem.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "AsyncUniversitySystem.h"
+#include <limits>
+
+/**
+ @brief constructs a facade over a system
+
+ @param target the system; it and runner must outlive the facade, and runner must run on the system's owning thread
+ @param runner the executor that resumes callers
+ @param maxPending the most enrolls and drops that may wait for a drain at once; callers past that wait for the next drain
+ @param maxPerStudent the most enrolls and drops one student may have waiting
+ */
+AsyncUniversitySystem::AsyncUniversitySystem(UniversitySystem& target, Executor& runner, size_t maxPending, size_t maxPerStudent)
+    : system(target), executor(runner), admissions(maxPending, maxPerStudent) {
+    drainScheduled = false;
+}
+
+/**
+ @brief offers the request to the queue and suspends the caller unless it was rejected
+
+ @param waiter the calling coroutine
+
+ @return (bool) true to stay suspended until the drain resumes the caller, false to resume at once
+ */
+bool AsyncUniversitySystem::AdmissionAwaiter::await_suspend(coroutine_handle<> waiter) {
+    Executor& executor = owner.executor;
+    AdmissionStatus status = owner.admissions.submit(AdmissionRequest(studentID, courseCode, drop, [this, waiter, &executor](bool ok) {
+        result = ok;
+        executor.schedule(waiter);
+    }));
+    if (status == AdmissionStatus::Rejected) {
+        rejected = true;
+        return false;
+    }
+    owner.scheduleDrain();
+    return true;
+}
+
+/**
+ @brief suspends the caller until the next drain
+
+ @param waiter the calling coroutine
+ */
+void AsyncUniversitySystem::SpaceAwaiter::await_suspend(coroutine_handle<> waiter) {
+    owner.spaceWaiters.push_back(waiter);
+    owner.scheduleDrain();
+}
+
+/**
+ @brief arranges for one drain once every ready coroutine has run
+ */
+void AsyncUniversitySystem::scheduleDrain() {
+    if (drainScheduled) {
+        return;
+    }
+    drainScheduled = true;
+    executor.whenIdle([this]() {
+        drainAdmissions();
+    });
+}
+
+/**
+ @brief applies every queued enroll and drop and resumes their callers
+
+ @details callers that were turned away for lack of room are resumed too, to try again
+ */
+void AsyncUniversitySystem::drainAdmissions() {
+    drainScheduled = false;
+    system.expireHolds();
+    admissions.drain(system, numeric_limits<size_t>::max());
+
+    vector<coroutine_handle<>> waiters;
+    waiters.swap(spaceWaiters);
+    for (coroutine_handle<> waiter : waiters) {
+        executor.schedule(waiter);
+    }
+}
+
+/**
+ @brief queues one enroll or drop and waits for the drain that applies it
+
+ @param studentID the student
+ @param courseCode the course
+ @param drop true to drop, false to enroll
+
+ @return (Task<bool>) resolves to the operation's result
+ */
+Task<bool> AsyncUniversitySystem::admitAsync(string studentID, string courseCode, bool drop) {
+    while (true) {
+        AdmissionAwaiter admission{*this, studentID, courseCode, drop};
+        bool result = co_await admission;
+        if (!admission.rejected) {
+            co_return result;
+        }
+        co_await SpaceAwaiter{*this};
+    }
+}
+
+/**
+ @brief enrolls a student in a course, or waitlists them if it is full
+
+ @details applied together with every other enroll and drop issued in the same round of the executor
+
+ @param studentID the student to enroll
+ @param courseCode the course to enroll in
+
+ @return (Task<bool>) resolves to true if enrolled, false if waitlisted or refused
+ */
+Task<bool> AsyncUniversitySystem::enrollAsync(string studentID, string courseCode) {
+    return admitAsync(std::move(studentID), std::move(courseCode), false);
+}
+
+/**
+ @brief drops a student from a course, refilling the seat from the waitlist
+
+ @param studentID the student to drop
+ @param courseCode the course to drop from
+
+ @return (Task<bool>) resolves to true if dropped, false otherwise
+ */
+Task<bool> AsyncUniversitySystem::dropAsync(string studentID, string courseCode) {
+    return admitAsync(std::move(studentID), std::move(courseCode), true);
+}
+
+/**
+ @brief enrolls a student in every course of a schedule or in none of them
+
+ @param studentID the student to enroll
+ @param courseCodes the courses to enroll in
+
+ @return (Task<bool>) resolves to true if every course was enrolled, false if nothing changed
+ */
+Task<bool> AsyncUniversitySystem::scheduleAsync(string studentID, vector<string> courseCodes) {
+    system.expireHolds();
+    co_return system.enrollSchedule(studentID, courseCodes);
+}
+
+/**
+ @brief holds a seat for a student for a limited time
+
+ @param studentID the student to hold a seat for
+ @param courseCode the course
+ @param seconds how long the hold lasts
+
+ @return (Task<bool>) resolves to true if the seat was held
+ */
+Task<bool> AsyncUniversitySystem::holdAsync(string studentID, string courseCode, int seconds) {
+    system.expireHolds();
+    co_return system.placeHold(studentID, courseCode, seconds);
+}
+
+/**
+ @brief turns a held seat into an enrollment
+
+ @param studentID the student holding the seat
+ @param courseCode the course
+
+ @return (Task<bool>) resolves to true if enrolled
+ */
+Task<bool> AsyncUniversitySystem::confirmAsync(string studentID, string courseCode) {
+    system.expireHolds();
+    co_return system.confirmHold(studentID, courseCode);
+}
+
+/**
+ @brief gives a held seat back
+
+ @param studentID the student holding the seat
+ @param courseCode the course
+
+ @return (Task<bool>) resolves to true if a hold was released
+ */
+Task<bool> AsyncUniversitySystem::releaseAsync(string studentID, string courseCode) {
+    system.expireHolds();
+    co_return system.releaseHold(studentID, courseCode);
+}
+
+/**
+ @brief loads a data file without blocking the executor
+
+ @details the file is read into a staged copy on a background thread (see loadFromFileAsync) while other tasks keep running; the caller resumes on the loop's thread to swap it in, re-applying the file if those tasks changed the system meanwhile
+
+ @param fileName path to the file to load
+
+ @return (Task<bool>) resolves to true if the loaded data was applied
+ */
+Task<bool> AsyncUniversitySystem::loadAsync(string fileName) {
+    shared_ptr<LoadHandle> handle = system.loadFromFileAsync(fileName);
+    // the frame keeps the handle alive; GCC 12 destroys a lambda temporary in a co_await twice, so it must not own a copy
+    LoadHandle* loading = handle.get();
+    co_await executor.until([loading]() {
+        return loading->isDone();
+    });
+    co_return system.finishLoad(*handle);
+}
+
+/**
+ @brief gets the executor that resumes this facade's callers
+
+ @return (Executor&) the executor
+ */
+Executor& AsyncUniversitySystem::getExecutor() {
+    return executor;
+}
+
+/**
+ @brief gets the admission queue's counters
+
+ @return (AdmissionStats) a copy of the counters
+ */
+AdmissionStats AsyncUniversitySystem::getAdmissionStats() const {
+    return admissions.getStats();
+}
@@ -0,0 +1,88 @@
+//
+//  AsyncUniversitySystem.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef ASYNC_UNIVERSITY_SYSTEM_H
+#define ASYNC_UNIVERSITY_SYSTEM_H
+
+#include "UniversitySystem.h"
+#include "AdmissionQueue.h"
+#include "Executor.h"
+#include "Task.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ @brief awaitable facade over a UniversitySystem, driven by an Executor on the system's owning thread
+
+ @details enrollAsync and dropAsync park the caller in an AdmissionQueue; once every ready coroutine has run, one drain applies them all in per-course micro-batches and resumes each caller with its result. so thousands of registrations in flight on one thread cost one suspended frame each, not a thread each. loadAsync reads the file on a background thread while the loop keeps serving. the remaining operations finish immediately but are awaitable so callers can treat every operation alike. string parameters are taken by value because coroutines outlive the caller's arguments
+ */
+class AsyncUniversitySystem {
+private:
+    UniversitySystem& system;
+    Executor& executor;
+    AdmissionQueue admissions;
+    vector<coroutine_handle<>> spaceWaiters;
+    bool drainScheduled;
+
+    // parks the caller in the admission queue, or returns at once with rejected set if the queue is full
+    struct AdmissionAwaiter {
+        AsyncUniversitySystem& owner;
+        const string& studentID;
+        const string& courseCode;
+        bool drop;
+        bool result = false;
+        bool rejected = false;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(coroutine_handle<> waiter);
+
+        bool await_resume() const noexcept {
+            return result;
+        }
+    };
+
+    // parks the caller until the next drain has made room in the admission queue
+    struct SpaceAwaiter {
+        AsyncUniversitySystem& owner;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(coroutine_handle<> waiter);
+
+        void await_resume() const noexcept {}
+    };
+
+    void scheduleDrain();
+    void drainAdmissions();
+    Task<bool> admitAsync(string studentID, string courseCode, bool drop);
+
+public:
+    AsyncUniversitySystem(UniversitySystem& target, Executor& runner, size_t maxPending = 65536, size_t maxPerStudent = 8);
+
+    AsyncUniversitySystem(const AsyncUniversitySystem&) = delete;
+    AsyncUniversitySystem& operator=(const AsyncUniversitySystem&) = delete;
+
+    Task<bool> enrollAsync(string studentID, string courseCode);
+    Task<bool> dropAsync(string studentID, string courseCode);
+    Task<bool> scheduleAsync(string studentID, vector<string> courseCodes);
+    Task<bool> holdAsync(string studentID, string courseCode, int seconds = 300);
+    Task<bool> confirmAsync(string studentID, string courseCode);
+    Task<bool> releaseAsync(string studentID, string courseCode);
+    Task<bool> loadAsync(string fileName);
+
+    Executor& getExecutor();
+    AdmissionStats getAdmissionStats() const;
+};
+
+#endif // ASYNC_UNIVERSITY_SYSTEM_H
@@ -0,0 +1,683 @@
+//
+//  BPlusTree.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "BPlusTree.h"
+#include <algorithm>
+#include <cstring>
+
+// page 0: magic, root page, free list head, entry count, height
+static const char TREE_MAGIC[8] = {'U', 'C', 'M', 'S', 'B', 'P', 'T', '1'};
+
+// node pages: type byte, entry count, then the leaf's right sibling or the internal node's leftmost child
+static const unsigned char LEAF_PAGE = 1;
+static const unsigned char INTERNAL_PAGE = 2;
+static const size_t NODE_HEADER_BYTES = 8;
+static const size_t NODE_CAPACITY = BufferPool::PAGE_SIZE - NODE_HEADER_BYTES;
+
+// overflow pages: next page in the chain, bytes used on this page
+static const size_t OVERFLOW_HEADER_BYTES = 6;
+static const size_t OVERFLOW_CAPACITY = BufferPool::PAGE_SIZE - OVERFLOW_HEADER_BYTES;
+
+static void put16(unsigned char* at, uint16_t value) {
+    memcpy(at, &value, sizeof(value));
+}
+
+static void put32(unsigned char* at, uint32_t value) {
+    memcpy(at, &value, sizeof(value));
+}
+
+static uint16_t get16(const unsigned char* at) {
+    uint16_t value;
+    memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+static uint32_t get32(const unsigned char* at) {
+    uint32_t value;
+    memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+/**
+ @brief constructs a closed tree
+ */
+BPlusTree::BPlusTree() {
+    root = 0;
+    freeHead = 0;
+    entryCount = 0;
+    height = 0;
+    healthy = false;
+}
+
+/**
+ @brief writes back the header and every dirty page
+ */
+BPlusTree::~BPlusTree() {
+    close();
+}
+
+/**
+ @brief opens a tree file, creating an empty tree if the file is new
+
+ @param fileName path of the file
+ @param cachePages the most pages the buffer pool keeps in memory
+
+ @return (bool) true if the tree is ready, false if the file could not be opened or isn't a tree file
+ */
+bool BPlusTree::open(const string& fileName, size_t cachePages) {
+    close();
+    if (!pool.open(fileName, cachePages)) {
+        return false;
+    }
+
+    if (pool.getPageCount() == 0) {
+        PageRef header = pool.allocate();
+        PageRef leaf = pool.allocate();
+        if (!header.valid() || !leaf.valid()) {
+            pool.close();
+            return false;
+        }
+        leaf.data()[0] = LEAF_PAGE;
+        root = leaf.id();
+        freeHead = 0;
+        entryCount = 0;
+        height = 1;
+        header.release();
+        healthy = writeHeader();
+        return healthy;
+    }
+
+    healthy = readHeader();
+    if (!healthy) {
+        pool.close();
+    }
+    return healthy;
+}
+
+/**
+ @brief writes the header and every dirty page to the file
+
+ @return (bool) true if everything was written
+ */
+bool BPlusTree::flush() {
+    return healthy && writeHeader() && pool.flush();
+}
+
+/**
+ @brief flushes and closes the file
+ */
+void BPlusTree::close() {
+    if (pool.isOpen()) {
+        flush();
+        pool.close();
+    }
+    healthy = false;
+}
+
+/**
+ @brief checks if a tree file is open
+
+ @return (bool) true if open
+ */
+bool BPlusTree::isOpen() const {
+    return healthy;
+}
+
+bool BPlusTree::readHeader() {
+    PageRef header = pool.fetch(0);
+    if (!header.valid() || memcmp(header.data(), TREE_MAGIC, sizeof(TREE_MAGIC)) != 0) {
+        return false;
+    }
+    const unsigned char* at = header.data() + sizeof(TREE_MAGIC);
+    root = get32(at);
+    freeHead = get32(at + 4);
+    memcpy(&entryCount, at + 8, sizeof(entryCount));
+    height = get32(at + 16);
+    return root != 0;
+}
+
+bool BPlusTree::writeHeader() {
+    PageRef header = pool.fetch(0);
+    if (!header.valid()) {
+        return false;
+    }
+    unsigned char* at = header.data();
+    memcpy(at, TREE_MAGIC, sizeof(TREE_MAGIC));
+    at += sizeof(TREE_MAGIC);
+    put32(at, root);
+    put32(at + 4, freeHead);
+    memcpy(at + 8, &entryCount, sizeof(entryCount));
+    put32(at + 16, height);
+    header.markDirty();
+    return true;
+}
+
+/**
+ @brief takes a page from the free list, or a new page at the end of the file
+
+ @return (PageID) the page, or 0 if none could be pinned
+ */
+PageID BPlusTree::allocatePage() {
+    if (freeHead != 0) {
+        PageRef page = pool.fetch(freeHead);
+        if (!page.valid()) {
+            return 0;
+        }
+        PageID reused = freeHead;
+        freeHead = get32(page.data());
+        memset(page.data(), 0, BufferPool::PAGE_SIZE);
+        page.markDirty();
+        return reused;
+    }
+    PageRef page = pool.allocate();
+    return page.valid() ? page.id() : 0;
+}
+
+/**
+ @brief puts a page on the free list
+
+ @param page the page to free
+ */
+void BPlusTree::freePage(PageID page) {
+    PageRef ref = pool.fetch(page);
+    if (!ref.valid()) {
+        return;
+    }
+    memset(ref.data(), 0, BufferPool::PAGE_SIZE);
+    put32(ref.data(), freeHead);
+    ref.markDirty();
+    freeHead = page;
+}
+
+/**
+ @brief decodes a node page
+
+ @param page the page
+ @param node receives the node
+
+ @return (bool) true if the page was read and holds a node
+ */
+bool BPlusTree::readNode(PageID page, Node& node) {
+    PageRef ref = pool.fetch(page);
+    if (!ref.valid()) {
+        return false;
+    }
+    const unsigned char* at = ref.data();
+    if (at[0] != LEAF_PAGE && at[0] != INTERNAL_PAGE) {
+        return false;
+    }
+    node.leaf = at[0] == LEAF_PAGE;
+    uint16_t count = get16(at + 1);
+    node.link = get32(at + 4);
+    node.keys.clear();
+    node.values.clear();
+    node.children.clear();
+    node.keys.reserve(count);
+
+    const unsigned char* cursor = at + NODE_HEADER_BYTES;
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t keyLength = get16(cursor);
+        node.keys.emplace_back(reinterpret_cast<const char*>(cursor + 2), keyLength);
+        cursor += 2 + keyLength;
+        if (!node.leaf) {
+            node.children.push_back(get32(cursor));
+            cursor += 4;
+            continue;
+        }
+        LeafValue value;
+        value.overflow = *cursor++ != 0;
+        if (value.overflow) {
+            value.firstPage = get32(cursor);
+            value.length = get32(cursor + 4);
+            cursor += 8;
+        } else {
+            uint16_t valueLength = get16(cursor);
+            value.bytes.assign(reinterpret_cast<const char*>(cursor + 2), valueLength);
+            value.length = valueLength;
+            cursor += 2 + valueLength;
+        }
+        node.values.push_back(std::move(value));
+    }
+    return true;
+}
+
+/**
+ @brief encodes a node into its page
+
+ @param page the page
+ @param node the node; must fit in NODE_CAPACITY bytes
+
+ @return (bool) true if written
+ */
+bool BPlusTree::writeNode(PageID page, const Node& node) {
+    PageRef ref = pool.fetch(page);
+    if (!ref.valid()) {
+        return false;
+    }
+    unsigned char* at = ref.data();
+    memset(at, 0, BufferPool::PAGE_SIZE);
+    at[0] = node.leaf ? LEAF_PAGE : INTERNAL_PAGE;
+    put16(at + 1, static_cast<uint16_t>(node.keys.size()));
+    put32(at + 4, node.link);
+
+    unsigned char* cursor = at + NODE_HEADER_BYTES;
+    for (size_t i = 0; i < node.keys.size(); i++) {
+        put16(cursor, static_cast<uint16_t>(node.keys[i].size()));
+        memcpy(cursor + 2, node.keys[i].data(), node.keys[i].size());
+        cursor += 2 + node.keys[i].size();
+        if (!node.leaf) {
+            put32(cursor, node.children[i]);
+            cursor += 4;
+            continue;
+        }
+        const LeafValue& value = node.values[i];
+        *cursor++ = value.overflow ? 1 : 0;
+        if (value.overflow) {
+            put32(cursor, value.firstPage);
+            put32(cursor + 4, value.length);
+            cursor += 8;
+        } else {
+            put16(cursor, static_cast<uint16_t>(value.bytes.size()));
+            memcpy(cursor + 2, value.bytes.data(), value.bytes.size());
+            cursor += 2 + value.bytes.size();
+        }
+    }
+    ref.markDirty();
+    return true;
+}
+
+/**
+ @brief gets the encoded size of a range of a node's entries
+
+ @param node the node
+ @param from the first entry
+ @param to one past the last entry
+
+ @return (size_t) the bytes those entries take on a page
+ */
+size_t BPlusTree::encodedSize(const Node& node, size_t from, size_t to) {
+    size_t bytes = 0;
+    for (size_t i = from; i < to; i++) {
+        bytes += 2 + node.keys[i].size();
+        if (!node.leaf) {
+            bytes += 4;
+        } else if (node.values[i].overflow) {
+            bytes += 9;
+        } else {
+            bytes += 3 + node.values[i].bytes.size();
+        }
+    }
+    return bytes;
+}
+
+/**
+ @brief picks where to split an overfull node so both halves are as small as possible
+
+ @details splitting by bytes rather than by count keeps a run of long keys from overfilling one half
+
+ @param node the overfull node, with at least two entries
+
+ @return (size_t) the index of the first entry of the right half
+ */
+size_t BPlusTree::bestSplit(const Node& node) {
+    size_t total = encodedSize(node, 0, node.keys.size());
+    size_t left = 0;
+    size_t best = 1;
+    size_t bestLargest = total;
+    for (size_t i = 1; i < node.keys.size(); i++) {
+        left += encodedSize(node, i - 1, i);
+        size_t largest = max(left, total - left);
+        if (largest < bestLargest) {
+            bestLargest = largest;
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ @brief stores a value inline, or in a new overflow chain if it is long
+
+ @param value the value
+ @param stored receives where it was stored
+
+ @return (bool) true if stored
+ */
+bool BPlusTree::writeValue(const string& value, LeafValue& stored) {
+    stored = LeafValue();
+    stored.length = static_cast<uint32_t>(value.size());
+    if (value.size() <= INLINE_VALUE_BYTES) {
+        stored.bytes = value;
+        return true;
+    }
+
+    stored.overflow = true;
+    // written back to front so each page can point at the one after it
+    size_t pages = (value.size() + OVERFLOW_CAPACITY - 1) / OVERFLOW_CAPACITY;
+    PageID next = 0;
+    for (size_t p = pages; p-- > 0;) {
+        PageID page = allocatePage();
+        PageRef ref = page != 0 ? pool.fetch(page) : PageRef();
+        if (!ref.valid()) {
+            return false;
+        }
+        size_t offset = p * OVERFLOW_CAPACITY;
+        size_t length = min(OVERFLOW_CAPACITY, value.size() - offset);
+        put32(ref.data(), next);
+        put16(ref.data() + 4, static_cast<uint16_t>(length));
+        memcpy(ref.data() + OVERFLOW_HEADER_BYTES, value.data() + offset, length);
+        ref.markDirty();
+        next = page;
+    }
+    stored.firstPage = next;
+    return true;
+}
+
+/**
+ @brief reads a value back, following its overflow chain if it has one
+
+ @param stored where the value is stored
+ @param value receives the value
+
+ @return (bool) true if read
+ */
+bool BPlusTree::readValue(const LeafValue& stored, string& value) {
+    if (!stored.overflow) {
+        value = stored.bytes;
+        return true;
+    }
+    value.clear();
+    value.reserve(stored.length);
+    PageID page = stored.firstPage;
+    while (page != 0 && value.size() < stored.length) {
+        PageRef ref = pool.fetch(page);
+        if (!ref.valid()) {
+            return false;
+        }
+        uint16_t length = get16(ref.data() + 4);
+        value.append(reinterpret_cast<const char*>(ref.data() + OVERFLOW_HEADER_BYTES), length);
+        page = get32(ref.data());
+    }
+    return value.size() == stored.length;
+}
+
+/**
+ @brief frees a value's overflow chain
+
+ @param stored where the value is stored
+ */
+void BPlusTree::freeValue(const LeafValue& stored) {
+    PageID page = stored.overflow ? stored.firstPage : 0;
+    while (page != 0) {
+        PageID next;
+        {
+            PageRef ref = pool.fetch(page);
+            if (!ref.valid()) {
+                return;
+            }
+            next = get32(ref.data());
+        }
+        freePage(page);
+        page = next;
+    }
+}
+
+/**
+ @brief inserts or replaces a key below a node, splitting nodes on the way back up
+
+ @param page the node's page
+ @param key the key
+ @param value the value
+ @param split set if this node split; the caller links the new right node in
+
+ @return (bool) true if stored
+ */
+bool BPlusTree::insert(PageID page, const string& key, const string& value, Split& split) {
+    Node node;
+    if (!readNode(page, node)) {
+        return false;
+    }
+
+    if (node.leaf) {
+        size_t index = lower_bound(node.keys.begin(), node.keys.end(), key) - node.keys.begin();
+        LeafValue stored;
+        if (!writeValue(value, stored)) {
+            return false;
+        }
+        if (index < node.keys.size() && node.keys[index] == key) {
+            freeValue(node.values[index]);
+            node.values[index] = std::move(stored);
+        } else {
+            node.keys.insert(node.keys.begin() + index, key);
+            node.values.insert(node.values.begin() + index, std::move(stored));
+            entryCount++;
+        }
+    } else {
+        size_t index = upper_bound(node.keys.begin(), node.keys.end(), key) - node.keys.begin();
+        PageID child = index == 0 ? node.link : node.children[index - 1];
+        Split childSplit;
+        if (!insert(child, key, value, childSplit)) {
+            return false;
+        }
+        if (!childSplit.happened) {
+            return true;
+        }
+        node.keys.insert(node.keys.begin() + index, childSplit.key);
+        node.children.insert(node.children.begin() + index, childSplit.right);
+    }
+
+    if (encodedSize(node, 0, node.keys.size()) <= NODE_CAPACITY) {
+        return writeNode(page, node);
+    }
+
+    PageID rightPage = allocatePage();
+    if (rightPage == 0) {
+        return false;
+    }
+    size_t at = bestSplit(node);
+    Node right;
+    right.leaf = node.leaf;
+    if (node.leaf) {
+        right.keys.assign(node.keys.begin() + at, node.keys.end());
+        right.values.assign(node.values.begin() + at, node.values.end());
+        right.link = node.link;
+        node.keys.resize(at);
+        node.values.resize(at);
+        node.link = rightPage;
+        split.key = right.keys.front();
+    } else {
+        // the key at the split point moves up; its child becomes the right node's leftmost child
+        split.key = node.keys[at];
+        right.link = node.children[at];
+        right.keys.assign(node.keys.begin() + at + 1, node.keys.end());
+        right.children.assign(node.children.begin() + at + 1, node.children.end());
+        node.keys.resize(at);
+        node.children.resize(at);
+    }
+    split.happened = true;
+    split.right = rightPage;
+    return writeNode(page, node) && writeNode(rightPage, right);
+}
+
+/**
+ @brief stores a value under a key, replacing any value it had
+
+ @param key the key; at most MAX_KEY_BYTES bytes
+ @param value the value
+
+ @return (bool) true if stored, false if the key is too long or the file could not be written
+ */
+bool BPlusTree::put(const string& key, const string& value) {
+    if (!healthy || key.size() > MAX_KEY_BYTES || value.size() > UINT32_MAX) {
+        return false;
+    }
+    Split split;
+    if (!insert(root, key, value, split)) {
+        return false;
+    }
+    if (split.happened) {
+        PageID newRoot = allocatePage();
+        if (newRoot == 0) {
+            return false;
+        }
+        Node top;
+        top.leaf = false;
+        top.link = root;
+        top.keys.push_back(split.key);
+        top.children.push_back(split.right);
+        if (!writeNode(newRoot, top)) {
+            return false;
+        }
+        root = newRoot;
+        height++;
+    }
+    return true;
+}
+
+/**
+ @brief finds the leaf that would hold a key
+
+ @param key the key
+
+ @return (PageID) the leaf's page, or 0 if a page could not be read
+ */
+PageID BPlusTree::findLeaf(const string& key) {
+    PageID page = root;
+    Node node;
+    while (true) {
+        if (!readNode(page, node)) {
+            return 0;
+        }
+        if (node.leaf) {
+            return page;
+        }
+        size_t index = upper_bound(node.keys.begin(), node.keys.end(), key) - node.keys.begin();
+        page = index == 0 ? node.link : node.children[index - 1];
+    }
+}
+
+/**
+ @brief looks up a key
+
+ @param key the key
+
+ @return (pair<bool, string>) (true, value) if found, (false, "") otherwise
+ */
+pair<bool, string> BPlusTree::get(const string& key) {
+    PageID page = healthy ? findLeaf(key) : 0;
+    Node leaf;
+    if (page == 0 || !readNode(page, leaf)) {
+        return make_pair(false, "");
+    }
+    auto iter = lower_bound(leaf.keys.begin(), leaf.keys.end(), key);
+    string value;
+    if (iter == leaf.keys.end() || *iter != key || !readValue(leaf.values[iter - leaf.keys.begin()], value)) {
+        return make_pair(false, "");
+    }
+    return make_pair(true, value);
+}
+
+/**
+ @brief removes a key and frees its overflow pages
+
+ @param key the key
+
+ @return (bool) true if the key was there
+ */
+bool BPlusTree::erase(const string& key) {
+    PageID page = healthy ? findLeaf(key) : 0;
+    Node leaf;
+    if (page == 0 || !readNode(page, leaf)) {
+        return false;
+    }
+    auto iter = lower_bound(leaf.keys.begin(), leaf.keys.end(), key);
+    if (iter == leaf.keys.end() || *iter != key) {
+        return false;
+    }
+    size_t index = iter - leaf.keys.begin();
+    freeValue(leaf.values[index]);
+    leaf.keys.erase(leaf.keys.begin() + index);
+    leaf.values.erase(leaf.values.begin() + index);
+    entryCount--;
+    return writeNode(page, leaf);
+}
+
+/**
+ @brief visits entries in key order starting at a key
+
+ @param from the first key to visit (or the next one after it)
+ @param visit callable taking (key, value) and returning false to stop; it must not change the tree
+
+ @return (size_t) the number of entries visited
+ */
+size_t BPlusTree::scan(const string& from, const function<bool(const string&, const string&)>& visit) {
+    PageID page = healthy ? findLeaf(from) : 0;
+    size_t visited = 0;
+    Node leaf;
+    string value;
+    while (page != 0 && readNode(page, leaf)) {
+        size_t start = lower_bound(leaf.keys.begin(), leaf.keys.end(), from) - leaf.keys.begin();
+        for (size_t i = start; i < leaf.keys.size(); i++) {
+            if (!readValue(leaf.values[i], value)) {
+                return visited;
+            }
+            visited++;
+            if (!visit(leaf.keys[i], value)) {
+                return visited;
+            }
+        }
+        page = leaf.link;
+    }
+    return visited;
+}
+
+/**
+ @brief visits every entry whose key starts with a prefix, in key order
+
+ @param prefix the key prefix
+ @param visit callable taking (key, value) and returning false to stop; it must not change the tree
+
+ @return (size_t) the number of entries visited
+ */
+size_t BPlusTree::scanPrefix(const string& prefix, const function<bool(const string&, const string&)>& visit) {
+    size_t matched = 0;
+    scan(prefix, [&](const string& key, const string& value) {
+        if (key.compare(0, prefix.size(), prefix) != 0) {
+            return false;
+        }
+        matched++;
+        return visit(key, value);
+    });
+    return matched;
+}
+
+/**
+ @brief gets the number of entries
+
+ @return (uint64_t) the entry count
+ */
+uint64_t BPlusTree::size() const {
+    return entryCount;
+}
+
+/**
+ @brief gets the number of levels, counting the leaves
+
+ @return (unsigned) the height
+ */
+unsigned BPlusTree::getHeight() const {
+    return height;
+}
+
+/**
+ @brief gets the page cache, for its counters
+
+ @return (const BufferPool&) the buffer pool
+ */
+const BufferPool& BPlusTree::getBufferPool() const {
+    return pool;
+}
@@ -0,0 +1,99 @@
+//
+//  BPlusTree.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include "BufferPool.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ @brief on-disk B+-tree from string keys to string values, paged through a BufferPool
+
+ @details page 0 holds the header (root page, free page list, entry count); every other page is a leaf, an internal node, or part of an overflow chain. leaves are linked left to right so range scans never revisit internal nodes. values longer than INLINE_VALUE_BYTES are kept in a chain of overflow pages so a node always holds several entries. erase frees overflow pages for reuse but never merges nodes, so a tree that shrinks keeps its shape until it is rebuilt. not thread-safe
+ */
+class BPlusTree {
+public:
+    static constexpr size_t MAX_KEY_BYTES = 512;
+    static constexpr size_t INLINE_VALUE_BYTES = 1024;
+
+private:
+    struct LeafValue {
+        bool overflow = false;
+        string bytes;
+        PageID firstPage = 0;
+        uint32_t length = 0;
+    };
+
+    struct Node {
+        bool leaf = true;
+        PageID link = 0;
+        vector<string> keys;
+        vector<LeafValue> values;
+        vector<PageID> children;
+    };
+
+    struct Split {
+        bool happened = false;
+        string key;
+        PageID right = 0;
+    };
+
+    BufferPool pool;
+    PageID root;
+    PageID freeHead;
+    uint64_t entryCount;
+    unsigned height;
+    bool healthy;
+
+    bool readHeader();
+    bool writeHeader();
+    PageID allocatePage();
+    void freePage(PageID page);
+
+    bool readNode(PageID page, Node& node);
+    bool writeNode(PageID page, const Node& node);
+    static size_t encodedSize(const Node& node, size_t from, size_t to);
+    static size_t bestSplit(const Node& node);
+
+    bool writeValue(const string& value, LeafValue& stored);
+    bool readValue(const LeafValue& stored, string& value);
+    void freeValue(const LeafValue& stored);
+
+    bool insert(PageID page, const string& key, const string& value, Split& split);
+    PageID findLeaf(const string& key);
+
+public:
+    BPlusTree();
+    ~BPlusTree();
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    bool open(const string& fileName, size_t cachePages);
+    bool flush();
+    void close();
+    bool isOpen() const;
+
+    bool put(const string& key, const string& value);
+    pair<bool, string> get(const string& key);
+    bool erase(const string& key);
+    size_t scan(const string& from, const function<bool(const string&, const string&)>& visit);
+    size_t scanPrefix(const string& prefix, const function<bool(const string&, const string&)>& visit);
+
+    uint64_t size() const;
+    unsigned getHeight() const;
+    const BufferPool& getBufferPool() const;
+};
+
+#endif // BPLUS_TREE_H
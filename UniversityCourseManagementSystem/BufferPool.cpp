@@ -0,0 +1,373 @@
+//
+//  BufferPool.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "BufferPool.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/**
+ @brief constructs an empty, unpinned reference
+ */
+PageRef::PageRef() {
+    pool = nullptr;
+    page = 0;
+    bytes = nullptr;
+    dirty = false;
+}
+
+/**
+ @brief constructs a reference to a page its pool has just pinned
+
+ @param owner the pool that pinned the page
+ @param pageID the page
+ @param frameBytes the page's bytes in its frame
+ */
+PageRef::PageRef(BufferPool* owner, PageID pageID, unsigned char* frameBytes) {
+    pool = owner;
+    page = pageID;
+    bytes = frameBytes;
+    dirty = false;
+}
+
+PageRef::PageRef(PageRef&& other) noexcept {
+    pool = other.pool;
+    page = other.page;
+    bytes = other.bytes;
+    dirty = other.dirty;
+    other.pool = nullptr;
+    other.bytes = nullptr;
+}
+
+PageRef& PageRef::operator=(PageRef&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool = other.pool;
+        page = other.page;
+        bytes = other.bytes;
+        dirty = other.dirty;
+        other.pool = nullptr;
+        other.bytes = nullptr;
+    }
+    return *this;
+}
+
+/**
+ @brief unpins the page
+ */
+PageRef::~PageRef() {
+    release();
+}
+
+/**
+ @brief gets the page number
+
+ @return (PageID) the page
+ */
+PageID PageRef::id() const {
+    return page;
+}
+
+/**
+ @brief gets the page's bytes, valid while the reference is held
+
+ @return (unsigned char*) PAGE_SIZE bytes
+ */
+unsigned char* PageRef::data() const {
+    return bytes;
+}
+
+/**
+ @brief records that the page was changed and must be written back
+ */
+void PageRef::markDirty() {
+    dirty = true;
+}
+
+/**
+ @brief checks if the reference holds a page
+
+ @return (bool) false if the pool could not pin the page
+ */
+bool PageRef::valid() const {
+    return pool != nullptr;
+}
+
+/**
+ @brief unpins the page early
+ */
+void PageRef::release() {
+    if (pool != nullptr) {
+        pool->unpin(page, dirty);
+        pool = nullptr;
+        bytes = nullptr;
+    }
+}
+
+/**
+ @brief constructs a closed pool
+ */
+BufferPool::BufferPool() {
+    fd = -1;
+    clockHand = 0;
+    pageCount = 0;
+}
+
+/**
+ @brief writes back dirty pages and closes the file
+ */
+BufferPool::~BufferPool() {
+    close();
+}
+
+/**
+ @brief opens (or creates) a page file
+
+ @param fileName path of the file
+ @param frameCount the most pages to keep in memory; at least 8
+
+ @return (bool) true if the file was opened, false otherwise
+ */
+bool BufferPool::open(const string& fileName, size_t frameCount) {
+    close();
+    fd = ::open(fileName.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+
+    path = fileName;
+    pageCount = static_cast<PageID>(info.st_size / PAGE_SIZE);
+    frameCount = frameCount < 8 ? 8 : frameCount;
+    frames.assign(frameCount, Frame());
+    memory.assign(frameCount * PAGE_SIZE, 0);
+    resident.clear();
+    clockHand = 0;
+    stats = BufferPoolStats();
+    return true;
+}
+
+/**
+ @brief writes every dirty page back to the file
+
+ @return (bool) true if every write succeeded
+ */
+bool BufferPool::flush() {
+    bool ok = true;
+    for (size_t i = 0; i < frames.size(); i++) {
+        if (frames[i].inUse && frames[i].dirty) {
+            ok = writeFrame(i) && ok;
+        }
+    }
+    if (fd >= 0 && fdatasync(fd) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+/**
+ @brief writes back dirty pages and closes the file
+
+ @details every PageRef must have been released
+ */
+void BufferPool::close() {
+    if (fd < 0) {
+        return;
+    }
+    flush();
+    ::close(fd);
+    fd = -1;
+    frames.clear();
+    memory.clear();
+    resident.clear();
+}
+
+/**
+ @brief checks if a file is open
+
+ @return (bool) true if open
+ */
+bool BufferPool::isOpen() const {
+    return fd >= 0;
+}
+
+/**
+ @brief writes one frame's page to the file
+
+ @param frame the frame index
+
+ @return (bool) true if written
+ */
+bool BufferPool::writeFrame(size_t frame) {
+    off_t offset = static_cast<off_t>(frames[frame].page) * PAGE_SIZE;
+    if (pwrite(fd, &memory[frame * PAGE_SIZE], PAGE_SIZE, offset) != static_cast<ssize_t>(PAGE_SIZE)) {
+        return false;
+    }
+    frames[frame].dirty = false;
+    stats.pagesWritten++;
+    return true;
+}
+
+/**
+ @brief picks a frame to load a page into
+
+ @details an empty frame if there is one, otherwise the clock hand sweeps past recently used frames, clearing their reference bit, until it finds an unpinned frame that wasn't used since the last sweep. a dirty victim is written back first
+
+ @return (size_t) the frame index, or frames.size() if every frame is pinned
+ */
+size_t BufferPool::findVictim() {
+    for (size_t step = 0; step < 2 * frames.size(); step++) {
+        size_t frame = clockHand;
+        clockHand = (clockHand + 1) % frames.size();
+        Frame& candidate = frames[frame];
+        if (!candidate.inUse) {
+            return frame;
+        }
+        if (candidate.pins > 0) {
+            continue;
+        }
+        if (candidate.referenced) {
+            candidate.referenced = false;
+            continue;
+        }
+        if (candidate.dirty && !writeFrame(frame)) {
+            continue;
+        }
+        resident.erase(candidate.page);
+        candidate.inUse = false;
+        stats.evictions++;
+        return frame;
+    }
+    return frames.size();
+}
+
+/**
+ @brief pins a page, reading it from the file if it isn't cached
+
+ @param page the page to pin
+
+ @return (PageRef) the pinned page, or an invalid reference if every frame is pinned or the read failed
+ */
+PageRef BufferPool::fetch(PageID page) {
+    auto iter = resident.find(page);
+    if (iter != resident.end()) {
+        Frame& frame = frames[iter->second];
+        frame.pins++;
+        frame.referenced = true;
+        stats.hits++;
+        return PageRef(this, page, &memory[iter->second * PAGE_SIZE]);
+    }
+
+    size_t victim = findVictim();
+    if (victim == frames.size()) {
+        return PageRef();
+    }
+    unsigned char* bytes = &memory[victim * PAGE_SIZE];
+    if (page < pageCount) {
+        ssize_t got = pread(fd, bytes, PAGE_SIZE, static_cast<off_t>(page) * PAGE_SIZE);
+        if (got < 0) {
+            return PageRef();
+        }
+        memset(bytes + got, 0, PAGE_SIZE - got);
+    } else {
+        memset(bytes, 0, PAGE_SIZE);
+    }
+    stats.misses++;
+
+    Frame& frame = frames[victim];
+    frame.page = page;
+    frame.pins = 1;
+    frame.dirty = false;
+    frame.referenced = true;
+    frame.inUse = true;
+    resident[page] = victim;
+    return PageRef(this, page, bytes);
+}
+
+/**
+ @brief pins a new zeroed page at the end of the file
+
+ @details the page is marked dirty so it reaches the file even if the caller never writes to it
+
+ @return (PageRef) the new page, or an invalid reference if every frame is pinned
+ */
+PageRef BufferPool::allocate() {
+    PageRef ref = fetch(pageCount);
+    if (ref.valid()) {
+        memset(ref.data(), 0, PAGE_SIZE);
+        ref.markDirty();
+        pageCount++;
+    }
+    return ref;
+}
+
+/**
+ @brief drops one pin on a page
+
+ @param page the page
+ @param dirty whether the holder changed the page
+ */
+void BufferPool::unpin(PageID page, bool dirty) {
+    auto iter = resident.find(page);
+    if (iter == resident.end()) {
+        return;
+    }
+    Frame& frame = frames[iter->second];
+    frame.pins--;
+    frame.dirty = frame.dirty || dirty;
+}
+
+/**
+ @brief gets the number of pages in the file, including ones not yet written back
+
+ @return (PageID) the page count
+ */
+PageID BufferPool::getPageCount() const {
+    return pageCount;
+}
+
+/**
+ @brief gets the number of frames
+
+ @return (size_t) the most pages held in memory
+ */
+size_t BufferPool::getFrameCount() const {
+    return frames.size();
+}
+
+/**
+ @brief gets the number of frames holding a page
+
+ @return (size_t) the cached page count
+ */
+size_t BufferPool::getResidentCount() const {
+    return resident.size();
+}
+
+/**
+ @brief gets hit, miss, eviction and write counters
+
+ @return (BufferPoolStats) a copy of the counters
+ */
+BufferPoolStats BufferPool::getStats() const {
+    return stats;
+}
+
+/**
+ @brief gets the bytes held by the frames and the page table
+
+ @return (size_t) the allocated bytes
+ */
+size_t BufferPool::getMemoryBytes() const {
+    return memory.capacity() + frames.capacity() * sizeof(Frame) + resident.size() * (sizeof(PageID) + sizeof(size_t) + 2 * sizeof(void*));
+}
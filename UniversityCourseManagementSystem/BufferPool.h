@@ -0,0 +1,113 @@
+//
+//  BufferPool.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+typedef uint32_t PageID;
+
+struct BufferPoolStats {
+    unsigned long long hits = 0;
+    unsigned long long misses = 0;
+    unsigned long long evictions = 0;
+    unsigned long long pagesWritten = 0;
+};
+
+class BufferPool;
+
+/**
+ @brief a pinned page; the page stays in its frame until the PageRef is destroyed
+
+ @details call markDirty after changing data() so the page is written back before its frame is reused
+ */
+class PageRef {
+private:
+    BufferPool* pool;
+    PageID page;
+    unsigned char* bytes;
+    bool dirty;
+
+public:
+    PageRef();
+    PageRef(BufferPool* owner, PageID pageID, unsigned char* frameBytes);
+    PageRef(PageRef&& other) noexcept;
+    PageRef& operator=(PageRef&& other) noexcept;
+    ~PageRef();
+
+    PageRef(const PageRef&) = delete;
+    PageRef& operator=(const PageRef&) = delete;
+
+    PageID id() const;
+    unsigned char* data() const;
+    void markDirty();
+    bool valid() const;
+    void release();
+};
+
+/**
+ @brief fixed-size page cache over one file
+
+ @details holds at most frameCount pages of PAGE_SIZE bytes. pages are read with pread on a miss and written back with pwrite when a dirty frame is reused or on flush. frames are reused in clock (second-chance) order, skipping pinned ones. not thread-safe
+ */
+class BufferPool {
+    friend class PageRef;
+public:
+    static constexpr size_t PAGE_SIZE = 4096;
+
+private:
+    struct Frame {
+        PageID page = 0;
+        int pins = 0;
+        bool dirty = false;
+        bool referenced = false;
+        bool inUse = false;
+    };
+
+    int fd;
+    string path;
+    vector<Frame> frames;
+    vector<unsigned char> memory;
+    unordered_map<PageID, size_t> resident;
+    size_t clockHand;
+    PageID pageCount;
+    BufferPoolStats stats;
+
+    size_t findVictim();
+    bool writeFrame(size_t frame);
+    void unpin(PageID page, bool dirty);
+
+public:
+    BufferPool();
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    bool open(const string& fileName, size_t frameCount);
+    bool flush();
+    void close();
+    bool isOpen() const;
+
+    PageRef fetch(PageID page);
+    PageRef allocate();
+
+    PageID getPageCount() const;
+    size_t getFrameCount() const;
+    size_t getResidentCount() const;
+    BufferPoolStats getStats() const;
+    size_t getMemoryBytes() const;
+};
+
+#endif // BUFFER_POOL_H
@@ -0,0 +1,258 @@
+//
+//  CatalogImage.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "CatalogImage.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char CATALOG_MAGIC[8] = {'U', 'C', 'M', 'S', 'C', 'A', 'T', '1'};
+static const uint32_t CATALOG_FORMAT_VERSION = 1;
+
+/**
+ @brief constructs a closed image
+ */
+CatalogImage::CatalogImage() {
+    mapping = nullptr;
+    mappedBytes = 0;
+    header = nullptr;
+    records = nullptr;
+    strings = nullptr;
+}
+
+/**
+ @brief unmaps the image
+ */
+CatalogImage::~CatalogImage() {
+    close();
+}
+
+/**
+ @brief writes a catalog image file
+
+ @details the image is written to a temporary file and renamed into place, so a process opening fileName sees either the old image or the whole new one, and processes already mapping the old one keep it
+
+ @param fileName path of the image to write
+ @param courses the courses, in any order; codes must be unique
+
+ @return (bool) true if the image was written, false if a code repeats, the strings don't fit in 4 GB, or the file couldn't be written
+ */
+bool CatalogImage::write(const string& fileName, const vector<CatalogEntry>& courses) {
+    vector<const CatalogEntry*> sorted;
+    sorted.reserve(courses.size());
+    for (const auto& entry : courses) {
+        sorted.push_back(&entry);
+    }
+    sort(sorted.begin(), sorted.end(), [](const CatalogEntry* a, const CatalogEntry* b) {
+        return a->courseCode < b->courseCode;
+    });
+    for (size_t i = 1; i < sorted.size(); i++) {
+        if (sorted[i - 1]->courseCode == sorted[i]->courseCode) {
+            return false;
+        }
+    }
+
+    string pool;
+    vector<Record> table(sorted.size());
+    auto append = [&](string_view value, uint32_t& offset, uint32_t& length) {
+        offset = static_cast<uint32_t>(pool.size());
+        length = static_cast<uint32_t>(value.size());
+        pool.append(value.data(), value.size());
+    };
+    for (size_t i = 0; i < sorted.size(); i++) {
+        Record& record = table[i];
+        append(sorted[i]->courseCode, record.codeOffset, record.codeLength);
+        append(sorted[i]->title, record.titleOffset, record.titleLength);
+        append(sorted[i]->instructorName, record.instructorOffset, record.instructorLength);
+        record.capacity = sorted[i]->capacity;
+        record.reserved = 0;
+        if (pool.size() > numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+    }
+
+    Header head;
+    memcpy(head.magic, CATALOG_MAGIC, sizeof(head.magic));
+    head.formatVersion = CATALOG_FORMAT_VERSION;
+    head.courseCount = static_cast<uint32_t>(table.size());
+    head.recordsOffset = sizeof(Header);
+    head.stringsOffset = head.recordsOffset + table.size() * sizeof(Record);
+    head.stringsLength = pool.size();
+
+    string tempName = fileName + ".tmp";
+    {
+        ofstream file(tempName, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+        file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(Record));
+        file.write(pool.data(), pool.size());
+        if (!file.good()) {
+            file.close();
+            remove(tempName.c_str());
+            return false;
+        }
+    }
+    if (rename(tempName.c_str(), fileName.c_str()) != 0) {
+        remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ @brief maps an image file read-only
+
+ @details only the header is checked here, so opening costs the same for any catalog size; string offsets are checked as they are read
+
+ @param fileName path of the image
+
+ @return (bool) true if the file is a catalog image and was mapped, false otherwise
+ */
+bool CatalogImage::open(const string& fileName) {
+    close();
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+    size_t length = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(mapped);
+    const Header* head = reinterpret_cast<const Header*>(bytes);
+    bool valid = memcmp(head->magic, CATALOG_MAGIC, sizeof(head->magic)) == 0 && head->formatVersion == CATALOG_FORMAT_VERSION &&
+                 head->recordsOffset % alignof(Record) == 0 && head->recordsOffset <= length &&
+                 head->courseCount <= (length - head->recordsOffset) / sizeof(Record) &&
+                 head->stringsOffset <= length && head->stringsLength <= length - head->stringsOffset;
+    if (!valid) {
+        munmap(mapped, length);
+        return false;
+    }
+
+    mapping = bytes;
+    mappedBytes = length;
+    header = head;
+    records = reinterpret_cast<const Record*>(bytes + head->recordsOffset);
+    strings = reinterpret_cast<const char*>(bytes + head->stringsOffset);
+    return true;
+}
+
+/**
+ @brief unmaps the image
+
+ @details every CatalogEntry read from it becomes invalid
+ */
+void CatalogImage::close() {
+    if (mapping != nullptr) {
+        munmap(const_cast<unsigned char*>(mapping), mappedBytes);
+    }
+    mapping = nullptr;
+    mappedBytes = 0;
+    header = nullptr;
+    records = nullptr;
+    strings = nullptr;
+}
+
+/**
+ @brief checks if an image is mapped
+
+ @return (bool) true if mapped
+ */
+bool CatalogImage::isOpen() const {
+    return mapping != nullptr;
+}
+
+/**
+ @brief gets a view of one string in the pool
+
+ @param offset the string's offset in the pool
+ @param length the string's length
+
+ @return (string_view) the string, or an empty view if it lies outside the pool
+ */
+string_view CatalogImage::text(uint32_t offset, uint32_t length) const {
+    if (offset > header->stringsLength || length > header->stringsLength - offset) {
+        return string_view();
+    }
+    return string_view(strings + offset, length);
+}
+
+/**
+ @brief gets the number of courses in the image
+
+ @return (size_t) the course count, 0 if no image is mapped
+ */
+size_t CatalogImage::getCourseCount() const {
+    return header ? header->courseCount : 0;
+}
+
+/**
+ @brief reads one course
+
+ @param index the course's position in code order, below getCourseCount()
+
+ @return (CatalogEntry) views into the mapping
+ */
+CatalogEntry CatalogImage::getCourse(size_t index) const {
+    const Record& record = records[index];
+    CatalogEntry entry;
+    entry.courseCode = text(record.codeOffset, record.codeLength);
+    entry.title = text(record.titleOffset, record.titleLength);
+    entry.instructorName = text(record.instructorOffset, record.instructorLength);
+    entry.capacity = record.capacity;
+    return entry;
+}
+
+/**
+ @brief finds a course by code with a binary search of the record table
+
+ @param courseCode the course code
+
+ @return (pair<bool, size_t>) (true, index) if found, (false, 0) otherwise
+ */
+pair<bool, size_t> CatalogImage::findCourse(string_view courseCode) const {
+    size_t low = 0;
+    size_t high = getCourseCount();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        const Record& record = records[middle];
+        string_view code = text(record.codeOffset, record.codeLength);
+        if (code < courseCode) {
+            low = middle + 1;
+        } else if (courseCode < code) {
+            high = middle;
+        } else {
+            return make_pair(true, middle);
+        }
+    }
+    return make_pair(false, static_cast<size_t>(0));
+}
+
+/**
+ @brief gets the size of the mapping
+
+ @return (size_t) the image's size in bytes; shared with every other process mapping it
+ */
+size_t CatalogImage::getMappedBytes() const {
+    return mappedBytes;
+}
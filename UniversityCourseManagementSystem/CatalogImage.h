@@ -0,0 +1,86 @@
+//
+//  CatalogImage.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef CATALOG_IMAGE_H
+#define CATALOG_IMAGE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ @brief one course as stored in a catalog image
+
+ @details when read from an open image the views point into the mapping and stay valid until the image is closed
+ */
+struct CatalogEntry {
+    string_view courseCode;
+    string_view title;
+    string_view instructorName;
+    int capacity = 0;
+};
+
+/**
+ @brief read-only course catalog file that many processes map at once
+
+ @details the file is a header, a table of fixed-size course records sorted by code, and a pool of the records' strings. records refer to strings by offset, never by pointer, so the file is used exactly as it sits on disk: opening it is one mmap, nothing is parsed or copied, and every process that maps it shares the same physical pages through the page cache. lookups binary search the record table. the image never changes once written; a new catalog is written next to it and renamed over it, so processes already mapping the old one are unaffected
+ */
+class CatalogImage {
+private:
+    struct Header {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t courseCount;
+        uint64_t recordsOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsLength;
+    };
+
+    struct Record {
+        uint32_t codeOffset;
+        uint32_t codeLength;
+        uint32_t titleOffset;
+        uint32_t titleLength;
+        uint32_t instructorOffset;
+        uint32_t instructorLength;
+        int32_t capacity;
+        uint32_t reserved;
+    };
+
+    const unsigned char* mapping;
+    size_t mappedBytes;
+    const Header* header;
+    const Record* records;
+    const char* strings;
+
+    string_view text(uint32_t offset, uint32_t length) const;
+
+public:
+    CatalogImage();
+    ~CatalogImage();
+
+    CatalogImage(const CatalogImage&) = delete;
+    CatalogImage& operator=(const CatalogImage&) = delete;
+
+    static bool write(const string& fileName, const vector<CatalogEntry>& courses);
+
+    bool open(const string& fileName);
+    void close();
+    bool isOpen() const;
+
+    size_t getCourseCount() const;
+    CatalogEntry getCourse(size_t index) const;
+    pair<bool, size_t> findCourse(string_view courseCode) const;
+    size_t getMappedBytes() const;
+};
+
+#endif // CATALOG_IMAGE_H
@@ -0,0 +1,112 @@
+//
+//  CheckpointBench.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "UniversitySystem.h"
+#include "CheckpointHandle.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+/**
+ @brief builds a term with every student enrolled in a few courses
+
+ @param system the term to fill
+ @param studentCount the number of students
+ @param courseCount the number of courses
+ @param perStudent enrollments per student
+ */
+void buildTerm(UniversitySystem& system, int studentCount, int courseCount, int perStudent) {
+    int capacity = perStudent * studentCount / courseCount + 10;
+    for (int c = 0; c < courseCount; c++) {
+        system.addCourse("C" + to_string(c), "Course " + to_string(c), "Dr. Instructor " + to_string(c % 97), capacity);
+    }
+    for (int s = 0; s < studentCount; s++) {
+        string studentID = "S" + to_string(s);
+        system.addStudent(studentID, "Student Number " + to_string(s));
+        for (int k = 0; k < perStudent; k++) {
+            system.enrollStudentInCourse(studentID, "C" + to_string((s * 7 + k * 131) % courseCount));
+        }
+    }
+}
+
+/**
+ @brief reads a whole file
+
+ @param fileName the file
+
+ @return (string) its contents, empty if it can't be read
+ */
+string readFile(const string& fileName) {
+    ifstream file(fileName, ios::binary);
+    stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+int main(int argc, const char * argv[]) {
+    int studentCount = argc > 1 ? stoi(argv[1]) : 200000;
+    int courseCount = argc > 2 ? stoi(argv[2]) : 4000;
+    int perStudent = argc > 3 ? stoi(argv[3]) : 5;
+    size_t sliceRecords = argc > 4 ? stoul(argv[4]) : 256;
+    string outputFile = argc > 5 ? argv[5] : "university_checkpoint_bench.out";
+
+    UniversitySystem system;
+    ostream discard(nullptr);
+    system.setOutputStream(discard);
+    buildTerm(system, studentCount, courseCount, perStudent);
+    cout << "Students: " << studentCount << " | Courses: " << courseCount << " | Enrollments: " << studentCount * perStudent << endl;
+    cout << fixed << setprecision(1);
+
+    // stop-the-world: nothing else runs until the whole file is written
+    Clock::time_point start = Clock::now();
+    system.saveToFile(outputFile);
+    double saveMillis = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "saveToFile pause:      " << setw(10) << saveMillis << " ms" << endl;
+
+    ostringstream expected;
+    system.writeSnapshot(expected);
+
+    // checkpoint: one slice, then a drop and an enroll, until the capture is done
+    mt19937 generator(2025);
+    uniform_int_distribution<int> pickStudent(0, studentCount - 1);
+    uniform_int_distribution<int> pickCourse(0, courseCount - 1);
+    unsigned long long requests = 0;
+    double longestRequestMicros = 0;
+    start = Clock::now();
+    shared_ptr<CheckpointHandle> handle = system.beginCheckpoint(outputFile);
+    while (system.isCheckpointActive()) {
+        system.advanceCheckpoint(sliceRecords);
+        string studentID = "S" + to_string(pickStudent(generator));
+        Clock::time_point requestStart = Clock::now();
+        system.dropStudentFromCourse(studentID, "C" + to_string(pickCourse(generator)));
+        system.enrollStudentInCourse(studentID, "C" + to_string(pickCourse(generator)));
+        longestRequestMicros = max(longestRequestMicros, chrono::duration<double, micro>(Clock::now() - requestStart).count());
+        requests += 2;
+    }
+    double captureMillis = chrono::duration<double, milli>(Clock::now() - start).count();
+    bool written = handle->wait();
+    double totalMillis = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    cout << "checkpoint slices:     " << setw(10) << handle->getSliceCount() << " of " << sliceRecords << " records" << endl;
+    cout << "longest slice pause:   " << setw(10) << handle->getLongestSliceMicros() / 1000.0 << " ms" << endl;
+    cout << "longest request:       " << setw(10) << longestRequestMicros / 1000.0 << " ms" << endl;
+    cout << "requests served:       " << setw(10) << requests << " during " << captureMillis << " ms of capture" << endl;
+    cout << "records copied:        " << setw(10) << handle->getRecordsPreserved() << endl;
+    cout << "file written after:    " << setw(10) << totalMillis << " ms" << endl;
+    cout << "image matches start:   " << setw(10) << (written && readFile(outputFile) == expected.str() ? "yes" : "NO") << endl;
+
+    remove(outputFile.c_str());
+    return 0;
+}
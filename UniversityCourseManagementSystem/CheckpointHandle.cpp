@@ -0,0 +1,244 @@
+//
+//  CheckpointHandle.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "CheckpointHandle.h"
+#include "ReportWriter.h"
+#include "Tracer.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ @brief constructs a handle for a checkpoint to the given file and starts its writer thread
+
+ @param file the path the image is written to
+ */
+CheckpointHandle::CheckpointHandle(const string& file) : fileName(file), phase(Phase::Students), phaseStarted(false), captureDone(false), abandoned(false),
+                                                        bytesWritten(0), recordsCaptured(0), recordsPreserved(0), slices(0), longestSliceMicros(0), done(false), written(false) {
+    writer = thread([this]() {
+        runWriter();
+    });
+}
+
+/**
+ @brief destroys the handle
+
+ @details an image whose capture never finished is abandoned: the writer stops and removes its temporary file
+ */
+CheckpointHandle::~CheckpointHandle() {
+    {
+        lock_guard<mutex> guard(queueMutex);
+        abandoned = !captureDone;
+    }
+    queueReady.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+/**
+ @brief checks if a student's record has yet to be captured
+
+ @param studentID the student
+ 
+ @return (bool) true if the walk hasn't reached the student
+ */
+bool CheckpointHandle::isStudentPending(const string& studentID) const {
+    return phase == Phase::Students && (!phaseStarted || studentID > cursor);
+}
+
+/**
+ @brief checks if a course is still needed by a phase that hasn't passed it
+
+ @details a course is read by the course, enrollment and waitlist phases, so it stays pending until the waitlist walk passes it
+
+ @param courseCode the course
+
+ @return (bool) true if some phase has yet to read the course
+ */
+bool CheckpointHandle::isCoursePending(const string& courseCode) const {
+    return phase < Phase::Waitlists || (phase == Phase::Waitlists && (!phaseStarted || courseCode > cursor));
+}
+
+/**
+ @brief checks if the section links have yet to be captured
+
+ @return (bool) true before the section phase has run
+ */
+bool CheckpointHandle::areSectionsPending() const {
+    return phase <= Phase::Sections;
+}
+
+/**
+ @brief hands captured text to the writer thread
+
+ @param text the text of one slice
+ @param last true if the capture is complete
+ */
+void CheckpointHandle::submit(string text, bool last) {
+    {
+        lock_guard<mutex> guard(queueMutex);
+        if (!text.empty()) {
+            chunks.push_back(std::move(text));
+        }
+        captureDone = captureDone || last;
+    }
+    queueReady.notify_one();
+}
+
+/**
+ @brief writer thread body: writes captured slices in order, then renames the finished image into place
+
+ @details the file is written as fileName.tmp and synced before the rename, so fileName always holds either the previous image or the complete new one
+ */
+void CheckpointHandle::runWriter() {
+    Tracer::setThreadName("checkpoint writer");
+    string tempName = fileName + ".tmp";
+    int fd = ::open(tempName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool ok = fd >= 0;
+    {
+        ReportWriter report(ok ? fd : -1);
+        while (true) {
+            unique_lock<mutex> lock(queueMutex);
+            queueReady.wait(lock, [this]() {
+                return !chunks.empty() || captureDone || abandoned;
+            });
+            if (abandoned || chunks.empty()) {
+                break;
+            }
+            string text = std::move(chunks.front());
+            chunks.pop_front();
+            lock.unlock();
+
+            TraceSpan span("checkpoint.write");
+            span.setArg("bytes", text.size());
+            if (ok) {
+                report << text;
+            }
+            bytesWritten.fetch_add(text.size(), memory_order_relaxed);
+        }
+        ok = ok && report.flush();
+    }
+
+    bool keep;
+    {
+        lock_guard<mutex> guard(queueMutex);
+        keep = ok && !abandoned;
+    }
+    if (fd >= 0) {
+        TraceSpan span("checkpoint.sync");
+        keep = fsync(fd) == 0 && keep;
+        ::close(fd);
+    }
+    keep = keep && rename(tempName.c_str(), fileName.c_str()) == 0;
+    if (!keep) {
+        remove(tempName.c_str());
+    }
+    written.store(keep, memory_order_release);
+    done.store(true, memory_order_release);
+}
+
+/**
+ @brief returns the file the image is written to
+
+ @return (string) the file path
+ */
+string CheckpointHandle::getFileName() const {
+    return fileName;
+}
+
+/**
+ @brief returns the number of bytes handed to the file so far
+
+ @return (uint64_t) bytes written
+ */
+uint64_t CheckpointHandle::getBytesWritten() const {
+    return bytesWritten.load(memory_order_relaxed);
+}
+
+/**
+ @brief returns the number of records captured so far
+
+ @return (uint64_t) students, courses (once per phase) and section links captured
+ */
+uint64_t CheckpointHandle::getRecordsCaptured() const {
+    return recordsCaptured.load(memory_order_relaxed);
+}
+
+/**
+ @brief returns the number of records copied because they changed before the walk reached them
+
+ @return (uint64_t) the copy-on-write count
+ */
+uint64_t CheckpointHandle::getRecordsPreserved() const {
+    return recordsPreserved.load(memory_order_relaxed);
+}
+
+/**
+ @brief returns the number of capture slices run so far
+
+ @return (uint64_t) the slice count
+ */
+uint64_t CheckpointHandle::getSliceCount() const {
+    return slices.load(memory_order_relaxed);
+}
+
+/**
+ @brief returns the longest time the owning thread spent in one capture slice
+
+ @return (uint64_t) microseconds; the longest pause the checkpoint caused
+ */
+uint64_t CheckpointHandle::getLongestSliceMicros() const {
+    return longestSliceMicros.load(memory_order_relaxed);
+}
+
+/**
+ @brief checks if the whole image has been captured
+
+ @return (bool) true once the last slice was handed to the writer
+ */
+bool CheckpointHandle::isCaptured() const {
+    lock_guard<mutex> guard(queueMutex);
+    return captureDone;
+}
+
+/**
+ @brief checks if the writer thread has finished
+
+ @return (bool) true once the file was renamed into place or the checkpoint failed
+ */
+bool CheckpointHandle::isDone() const {
+    return done.load(memory_order_acquire);
+}
+
+/**
+ @brief checks if the image reached its file
+
+ @details only meaningful once isDone() returns true
+
+ @return (bool) true if the complete image was written and renamed into place
+ */
+bool CheckpointHandle::wasWritten() const {
+    return written.load(memory_order_acquire);
+}
+
+/**
+ @brief blocks until the writer thread finishes
+
+ @details the capture runs on the owning thread, so this returns at once if it hasn't finished; call UniversitySystem::finishCheckpoint first
+
+ @return (bool) true if the image was written
+ */
+bool CheckpointHandle::wait() {
+    if (!isCaptured()) {
+        return false;
+    }
+    if (writer.joinable()) {
+        writer.join();
+    }
+    return wasWritten();
+}
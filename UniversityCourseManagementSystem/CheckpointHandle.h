@@ -0,0 +1,98 @@
+//
+//  CheckpointHandle.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef CHECKPOINT_HANDLE_H
+#define CHECKPOINT_HANDLE_H
+
+#include "Course.h"
+#include <string>
+#include <map>
+#include <set>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+using namespace std;
+
+class UniversitySystem;
+
+/**
+ @brief a point-in-time image of a system being captured in slices and written by a background thread
+
+ @details the owning thread captures the image a slice at a time (UniversitySystem::advanceCheckpoint) in the data file format, walking students, course definitions, section links, enrollments and waitlists in key order. a record that is about to change before the walk reaches it is copied first, so the image shows every record as it was when the checkpoint began while traffic carries on. captured text is handed to the writer thread, which writes it to a temporary file and renames it into place once the last slice is written
+ */
+class CheckpointHandle {
+    friend class UniversitySystem;
+private:
+    enum class Phase {
+        Students,
+        Courses,
+        Sections,
+        Enrollments,
+        Waitlists,
+        Done
+    };
+
+    string fileName;
+
+    // capture state, used only by the owning thread. cursor is the last key captured in the current phase
+    Phase phase;
+    bool phaseStarted;
+    string cursor;
+    map<string, string> preservedStudents;
+    set<string> newStudents;
+    map<string, Course> preservedCourses;
+    set<string> newCourses;
+    unique_ptr<map<string, string>> preservedSections;
+
+    // captured text waiting for the writer thread
+    mutable mutex queueMutex;
+    condition_variable queueReady;
+    deque<string> chunks;
+    bool captureDone;
+    bool abandoned;
+
+    atomic<uint64_t> bytesWritten;
+    atomic<uint64_t> recordsCaptured;
+    atomic<uint64_t> recordsPreserved;
+    atomic<uint64_t> slices;
+    atomic<uint64_t> longestSliceMicros;
+    atomic<bool> done;
+    atomic<bool> written;
+    thread writer;
+
+    bool isStudentPending(const string& studentID) const;
+    bool isCoursePending(const string& courseCode) const;
+    bool areSectionsPending() const;
+    void submit(string text, bool last);
+    void runWriter();
+
+public:
+    explicit CheckpointHandle(const string& file);
+    ~CheckpointHandle();
+
+    CheckpointHandle(const CheckpointHandle&) = delete;
+    CheckpointHandle& operator=(const CheckpointHandle&) = delete;
+
+    string getFileName() const;
+    uint64_t getBytesWritten() const;
+    uint64_t getRecordsCaptured() const;
+    uint64_t getRecordsPreserved() const;
+    uint64_t getSliceCount() const;
+    uint64_t getLongestSliceMicros() const;
+
+    bool isCaptured() const;
+    bool isDone() const;
+    bool wasWritten() const;
+    bool wait();
+};
+
+#endif // CHECKPOINT_HANDLE_H
@@ -0,0 +1,596 @@
+//
+//  CommandProcessor.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/8/25.
+//
+
+#include "CommandProcessor.h"
+#include "Tracer.h"
+#include <algorithm>
+
+/**
+ @brief default constructor for a CommandResult
+
+ @details a failed result with no message
+ */
+CommandResult::CommandResult() {
+    success = false;
+    message = "";
+}
+
+/**
+ @brief constructs a CommandResult
+
+ @param ok whether the command succeeded
+ @param text the output or error message of the command
+ */
+CommandResult::CommandResult(bool ok, const string& text) {
+    success = ok;
+    message = text;
+}
+
+/**
+ @brief constructs a processor that runs commands against a system
+
+ @details the system's messages (and the term registry's, if there is one) are captured while the processor exists so they can be returned with each result
+
+ @param target the system to run commands against. it must outlive the processor
+ @param termRegistry the terms the TERM commands work on, or nullptr to reject them. it must outlive the processor
+ */
+CommandProcessor::CommandProcessor(UniversitySystem& target, TermRegistry* termRegistry) : system(target), previousOut(target.getOutputStream()), terms(termRegistry) {
+    system.setOutputStream(captured);
+    if (terms != nullptr) {
+        terms->setOutputStream(captured);
+    }
+}
+
+/**
+ @brief restores the system's previous output stream
+
+ @details a checkpoint still being captured is finished first so its file isn't abandoned
+ */
+CommandProcessor::~CommandProcessor() {
+    system.finishCheckpoint();
+    system.setOutputStream(previousOut);
+    if (terms != nullptr) {
+        terms->setOutputStream(cout);
+    }
+}
+
+/**
+ @brief splits a command line on commas
+
+ @details the last field keeps any remaining commas, like the data file format. missing fields are returned empty
+
+ @param line the full command line
+ @param expectedFields the number of fields after the command name
+
+ @return (vector<string>) the command name followed by expectedFields fields
+ */
+vector<string> CommandProcessor::splitFields(const string& line, size_t expectedFields) {
+    vector<string> fields;
+    size_t start = 0;
+    for (size_t i = 0; i < expectedFields; i++) {
+        size_t comma = line.find(',', start);
+        if (comma == string::npos) {
+            break;
+        }
+        fields.push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+    fields.push_back(start <= line.size() ? line.substr(start) : "");
+    fields.resize(expectedFields + 1);
+    return fields;
+}
+
+/**
+ @brief parses a whole string as an integer
+
+ @param text the text to parse
+ @param value receives the parsed value
+
+ @return (bool) true if the text was a valid integer, false otherwise
+ */
+bool CommandProcessor::parseInt(const string& text, int& value) {
+    try {
+        size_t used = 0;
+        value = stoi(text, &used);
+        return used == text.size();
+    } catch (const exception& e) {
+        return false;
+    }
+}
+
+/**
+ @brief returns and clears everything the system printed during the current command
+
+ @return (string) the captured text without its trailing newline
+ */
+string CommandProcessor::takeCaptured() {
+    string text = captured.str();
+    captured.str("");
+    captured.clear();
+    while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) {
+        text.pop_back();
+    }
+    return text;
+}
+
+/**
+ @brief builds the result of a command that either worked or printed a reason for failing
+
+ @param ok whether the operation returned success
+ @param successMessage the message to use when it worked and printed nothing
+
+ @return (CommandResult) the result
+ */
+CommandResult CommandProcessor::finish(bool ok, const string& successMessage) {
+    string text = takeCaptured();
+    if (text.empty()) {
+        text = ok ? successMessage : "failed";
+    }
+    return CommandResult(ok, text);
+}
+
+/**
+ @brief runs one command line
+
+ @details commands use the same comma-separated layout as data files, e.g. "ENROLL,S001,CS101". see getCommandNames for the full list. while the system is recording, the line, its outcome and its timing are added to the traffic file
+
+ @param line the command line
+
+ @return (CommandResult) success flag plus the command's output or error message
+ */
+CommandResult CommandProcessor::execute(const string& line) {
+    if (!system.isRecording()) {
+        return dispatch(line);
+    }
+    chrono::steady_clock::time_point arrived = chrono::steady_clock::now();
+    CommandResult result = dispatch(line);
+    system.recordRequest(line, result.success, arrived, chrono::steady_clock::now());
+    return result;
+}
+
+/**
+ @brief parses and runs one command line
+
+ @param line the command line
+
+ @return (CommandResult) success flag plus the command's output or error message
+ */
+CommandResult CommandProcessor::dispatch(const string& line) {
+    TraceSpan span("execute");
+    system.expireHolds();
+    system.advanceCheckpoint();
+    takeCaptured();
+
+    size_t comma = line.find(',');
+    string command = line.substr(0, comma);
+    while (!command.empty() && (command.back() == '\r' || command.back() == ' ')) {
+        command.pop_back();
+    }
+    if (Tracer::isEnabled()) {
+        span.setDetail(Tracer::intern(command));
+    }
+
+    if (command == "ADD_STUDENT" || command == "STUDENT") {
+        vector<string> f = splitFields(line, 2);
+        return finish(system.addStudent(f[1], f[2]), "student added");
+    }
+    if (command == "REMOVE_STUDENT") {
+        vector<string> f = splitFields(line, 1);
+        return finish(system.removeStudent(f[1]), "student removed");
+    }
+    if (command == "UPDATE_STUDENT") {
+        vector<string> f = splitFields(line, 2);
+        return finish(system.updateStudent(f[1], f[2]), "student updated");
+    }
+    if (command == "PROFILE") {
+        vector<string> f = splitFields(line, 3);
+        int standing = 0;
+        if (!parseInt(f[2], standing)) {
+            return CommandResult(false, "invalid class standing");
+        }
+        return finish(system.setStudentProfile(f[1], standing, f[3]), "profile updated");
+    }
+    if (command == "ADD_COURSE" || command == "COURSE") {
+        vector<string> f = splitFields(line, 4);
+        int capacity = 30;
+        if (!f[4].empty() && !parseInt(f[4], capacity)) {
+            return CommandResult(false, "invalid capacity");
+        }
+        return finish(system.addCourse(f[1], f[2], f[3], capacity), "course added");
+    }
+    if (command == "REMOVE_COURSE") {
+        vector<string> f = splitFields(line, 1);
+        return finish(system.removeCourse(f[1]), "course removed");
+    }
+    if (command == "UPDATE_COURSE") {
+        vector<string> f = splitFields(line, 4);
+        int capacity = -1;
+        if (!f[4].empty() && !parseInt(f[4], capacity)) {
+            return CommandResult(false, "invalid capacity");
+        }
+        return finish(system.updateCourse(f[1], f[2], f[3], capacity), "course updated");
+    }
+    if (command == "POLICY") {
+        vector<string> f = splitFields(line, 2);
+        return finish(system.setWaitlistPolicy(f[1], f[2]), "policy updated");
+    }
+    if (command == "SECTION") {
+        vector<string> f = splitFields(line, 2);
+        return finish(system.addSection(f[1], f[2]), "section added");
+    }
+    if (command == "ENROLL") {
+        vector<string> f = splitFields(line, 2);
+        return finish(system.enrollStudentInCourse(f[1], f[2]), "enrolled");
+    }
+    if (command == "DROP") {
+        vector<string> f = splitFields(line, 2);
+        return finish(system.dropStudentFromCourse(f[1], f[2]), "dropped");
+    }
+    if (command == "SCHEDULE") {
+        vector<string> f = splitFields(line, max<size_t>(2, count(line.begin(), line.end(), ',')));
+        vector<string> courseCodes;
+        for (size_t i = 2; i < f.size(); i++) {
+            if (!f[i].empty()) {
+                courseCodes.push_back(f[i]);
+            }
+        }
+        return finish(system.enrollSchedule(f[1], courseCodes), "enrolled in " + to_string(courseCodes.size()) + " courses");
+    }
+    if (command == "HOLD") {
+        vector<string> f = splitFields(line, 3);
+        int seconds = 300;
+        if (!f[3].empty() && !parseInt(f[3], seconds)) {
+            return CommandResult(false, "invalid hold length");
+        }
+        return finish(system.placeHold(f[1], f[2], seconds), "seat held for " + to_string(seconds) + "s");
+    }
+    if (command == "CONFIRM") {
+        vector<string> f = splitFields(line, 2);
+        return finish(system.confirmHold(f[1], f[2]), "enrolled");
+    }
+    if (command == "RELEASE") {
+        vector<string> f = splitFields(line, 2);
+        return finish(system.releaseHold(f[1], f[2]), "hold released");
+    }
+    if (command == "PREFER") {
+        vector<string> f = splitFields(line, max<size_t>(3, count(line.begin(), line.end(), ',')));
+        int maxCourses = 0;
+        if (!f[2].empty() && !parseInt(f[2], maxCourses)) {
+            return CommandResult(false, "invalid course limit");
+        }
+        vector<string> courseCodes;
+        for (size_t i = 3; i < f.size(); i++) {
+            if (!f[i].empty()) {
+                courseCodes.push_back(f[i]);
+            }
+        }
+        return finish(system.submitPreferences(f[1], courseCodes, maxCourses), "ranked " + to_string(courseCodes.size()) + " courses");
+    }
+    if (command == "CLOSE_WINDOW") {
+        vector<string> f = splitFields(line, 1);
+        int seed = 0;
+        if (!f[1].empty() && !parseInt(f[1], seed)) {
+            return CommandResult(false, "invalid seed");
+        }
+        system.closeRegistrationWindow(static_cast<unsigned long long>(seed));
+        return finish(true, "registration window closed");
+    }
+    if (command == "SEARCH_STUDENT") {
+        vector<string> f = splitFields(line, 1);
+        auto result = system.searchStudentByName(f[1]);
+        return CommandResult(result.first, result.first ? result.second : "student not found");
+    }
+    if (command == "SEARCH_COURSE") {
+        vector<string> f = splitFields(line, 1);
+        auto result = system.searchCourseByTitle(f[1]);
+        return CommandResult(result.first, result.first ? result.second : "course not found");
+    }
+    if (command == "INSTRUCTOR") {
+        vector<string> f = splitFields(line, 1);
+        string text;
+        system.forEachStudentOfInstructor(f[1], [&](const Student& student) {
+            text += (text.empty() ? "" : "\n") + student.getStudentID() + " - " + student.getFullName();
+        });
+        return CommandResult(true, text);
+    }
+    if (command == "LIST_STUDENT") {
+        vector<string> f = splitFields(line, 1);
+        system.listStudentCourses(f[1]);
+        return finish(system.findStudent(f[1]) != nullptr, "");
+    }
+    if (command == "LIST_COURSE") {
+        vector<string> f = splitFields(line, 1);
+        system.listCourseStudents(f[1]);
+        return finish(system.findCourse(f[1]) != nullptr, "");
+    }
+    if (command == "STUDENTS") {
+        system.displayAllStudents();
+        return finish(true, "");
+    }
+    if (command == "COURSES") {
+        system.displayAllCourses();
+        return finish(true, "");
+    }
+    if (command == "STATS") {
+        system.displaySystemStatistics();
+        return finish(true, "");
+    }
+    if (command == "LOG") {
+        vector<string> f = splitFields(line, 1);
+        int count = 10;
+        if (!f[1].empty() && !parseInt(f[1], count)) {
+            return CommandResult(false, "invalid count");
+        }
+        system.displayRecentActivities(count);
+        return finish(true, "");
+    }
+    if (command == "QUERY_LOG") {
+        vector<string> f = splitFields(line, 5);
+        ActivityQuery query;
+        query.studentID = f[1];
+        query.courseCode = f[2];
+        query.action = f[3];
+        if ((!f[4].empty() && !ActivityLog::parseTimestamp(f[4], query.from)) ||
+            (!f[5].empty() && !ActivityLog::parseTimestamp(f[5], query.to, true))) {
+            return CommandResult(false, "invalid date");
+        }
+        system.displayActivities(query);
+        return finish(true, "");
+    }
+    if (command == "TOP_COURSES") {
+        vector<string> f = splitFields(line, 1);
+        int count = 10;
+        if (!f[1].empty() && !parseInt(f[1], count)) {
+            return CommandResult(false, "invalid count");
+        }
+        system.displayLeaderboards(count);
+        return finish(true, "");
+    }
+    if (command == "BELOW_FILL") {
+        vector<string> f = splitFields(line, 1);
+        int percent = 0;
+        if (!parseInt(f[1], percent)) {
+            return CommandResult(false, "invalid percentage");
+        }
+        system.displayCoursesBelowFill(percent / 100.0);
+        return finish(true, "");
+    }
+    if (command == "ANALYTICS") {
+        vector<string> f = splitFields(line, 1);
+        AnalyticsSnapshot snapshot = AnalyticsSnapshot::capture(system);
+        if (f[1].empty()) {
+            for (const auto& result : analytics.runAll(snapshot)) {
+                result.display(captured);
+            }
+            return finish(true, "");
+        }
+        pair<bool, AnalyticsResult> result = analytics.run(f[1], snapshot);
+        if (!result.first) {
+            return CommandResult(false, "unknown report " + f[1]);
+        }
+        result.second.display(captured);
+        return finish(true, "");
+    }
+    if (command == "REPORT") {
+        vector<string> f = splitFields(line, 3);
+        ReportFormat format = ReportFormat::Table;
+        if (!f[2].empty() && !ReportWriter::parseFormat(f[2], format)) {
+            return CommandResult(false, "unknown format " + f[2] + " -- expected table, csv or json");
+        }
+        if (!f[3].empty()) {
+            return finish(system.saveReport(f[1], format, f[3]), "report written");
+        }
+        bool ok;
+        {
+            ReportWriter report(captured, format);
+            ok = system.writeReport(f[1], report);
+        }
+        return finish(ok, "");
+    }
+    if (command == "LOAD") {
+        vector<string> f = splitFields(line, 1);
+        return finish(system.loadFromFile(f[1]), "loaded");
+    }
+    if (command == "SAVE") {
+        vector<string> f = splitFields(line, 1);
+        return finish(system.saveToFile(f[1]), "saved");
+    }
+    if (command == "CHECKPOINT") {
+        vector<string> f = splitFields(line, 1);
+        shared_ptr<CheckpointHandle> handle = system.getCheckpoint();
+        if (f[1].empty() || system.isCheckpointActive()) {
+            takeCaptured();
+            if (!handle) {
+                return CommandResult(false, "no checkpoint has been started");
+            }
+            string state = system.isCheckpointActive() ? "capturing" : (!handle->isDone() ? "writing" : (handle->wasWritten() ? "written" : "failed"));
+            return CommandResult(true, "checkpoint to " + handle->getFileName() + ": " + state + ", " + to_string(handle->getRecordsCaptured()) +
+                                 " records in " + to_string(handle->getSliceCount()) + " slices, " + to_string(handle->getRecordsPreserved()) +
+                                 " copied before a change, " + to_string(handle->getBytesWritten()) + " bytes written, longest slice " +
+                                 to_string(handle->getLongestSliceMicros()) + " us");
+        }
+        return finish(system.beginCheckpoint(f[1]) != nullptr, "checkpoint to " + f[1] + " started");
+    }
+    if (command == "TRACE") {
+        vector<string> f = splitFields(line, 1);
+        if (f[1] == "start") {
+            Tracer::start();
+            return CommandResult(true, "tracing started");
+        }
+        if (f[1] == "stop") {
+            Tracer::stop();
+            return CommandResult(true, "tracing stopped");
+        }
+        if (f[1].empty()) {
+            return CommandResult(false, "expected start, stop or a file name");
+        }
+        if (!Tracer::writeChromeTrace(f[1])) {
+            return CommandResult(false, "could not write " + f[1]);
+        }
+        return CommandResult(true, to_string(Tracer::getEventCount()) + " spans written to " + f[1]);
+    }
+    if (command == "RECORD") {
+        vector<string> f = splitFields(line, 1);
+        if (f[1] == "stop") {
+            return finish(system.stopRecording(), "recording stopped");
+        }
+        if (f[1].empty()) {
+            return CommandResult(false, "expected stop or a file name");
+        }
+        return finish(system.startRecording(f[1]), "recording to " + f[1]);
+    }
+    if (command == "DIGEST") {
+        return CommandResult(true, TrafficRecorder::formatDigest(system.stateDigest()));
+    }
+    if (command == "TERMS" || command.compare(0, 4, "TERM") == 0) {
+        return runTermCommand(command, line);
+    }
+
+    return CommandResult(false, "unknown command '" + command + "'");
+}
+
+/**
+ @brief runs a command that works on the term registry rather than the processor's own system
+
+ @details TERM,Term,Command runs any other command against one term. student record commands in a term change the shared master record and so every term, and LOAD adds a file's new students to every term, the way the registry always treats students. everything else runs through a processor of the term's own, under only that term's lock
+
+ @param command the command name
+ @param line the whole command line
+
+ @return (CommandResult) success flag plus the command's output or error message
+ */
+CommandResult CommandProcessor::runTermCommand(const string& command, const string& line) {
+    if (terms == nullptr) {
+        return CommandResult(false, "terms are not available here");
+    }
+    if (command == "TERMS") {
+        vector<string> names = terms->getTermNames();
+        string text = to_string(names.size()) + " terms";
+        for (const auto& term : names) {
+            text += "\n" + term;
+        }
+        return CommandResult(true, text);
+    }
+    if (command == "TERM_OPEN") {
+        vector<string> f = splitFields(line, 1);
+        return finish(terms->openTerm(f[1]), "term " + f[1] + " opened");
+    }
+    if (command == "TERM_DROP") {
+        vector<string> f = splitFields(line, 1);
+        return finish(terms->dropTerm(f[1]), "term " + f[1] + " dropped");
+    }
+    if (command == "TERM_LOAD") {
+        vector<string> f = splitFields(line, 2);
+        return finish(terms->loadTerm(f[1], f[2]), "loaded into " + f[1]);
+    }
+    if (command == "TERM_SAVE") {
+        vector<string> f = splitFields(line, 2);
+        return finish(terms->saveTerm(f[1], f[2]), "term " + f[1] + " saved");
+    }
+    if (command == "TERM_RESTORE") {
+        vector<string> f = splitFields(line, 2);
+        return finish(terms->restoreTerm(f[1], f[2]), "term " + f[1] + " restored");
+    }
+    if (command == "TERM_STORE") {
+        vector<string> f = splitFields(line, 3);
+        int residentTerms = 4;
+        int cachePages = 256;
+        if ((!f[2].empty() && !parseInt(f[2], residentTerms)) || (!f[3].empty() && !parseInt(f[3], cachePages)) || residentTerms < 1 || cachePages < 1) {
+            return CommandResult(false, "resident terms and cache pages must be positive numbers");
+        }
+        if (f[1].empty()) {
+            return finish(terms->detachStore(), "term store closed");
+        }
+        return finish(terms->attachStore(f[1], residentTerms, cachePages), "terms stored in " + f[1] + ", " + to_string(residentTerms) + " kept in memory");
+    }
+    if (command == "TERM_ARCHIVE") {
+        vector<string> f = splitFields(line, 1);
+        return finish(terms->archiveTerm(f[1]), "term " + f[1] + " archived");
+    }
+    if (command == "TERM_ROSTER") {
+        vector<string> f = splitFields(line, 2);
+        pair<bool, vector<string>> roster = terms->getRoster(f[1], f[2]);
+        if (!roster.first) {
+            return CommandResult(false, "course " + f[2] + " doesn't exist in term " + f[1]);
+        }
+        string text = to_string(roster.second.size()) + " enrolled";
+        for (const auto& studentID : roster.second) {
+            text += "\n" + studentID;
+        }
+        return CommandResult(true, text);
+    }
+    if (command == "TERM_STATS") {
+        TermStorageStats stats = terms->getStorageStats();
+        return CommandResult(true, to_string(stats.residentTerms) + " terms in memory, " + to_string(stats.storedTerms) + " stored in " +
+                             to_string(stats.storePages) + " pages, " + to_string(stats.pageIns) + " page-ins, " + to_string(stats.writeBacks) +
+                             " write-backs, cache " + to_string(stats.cache.hits) + " hits / " + to_string(stats.cache.misses) + " misses / " +
+                             to_string(stats.cache.evictions) + " evictions");
+    }
+    if (command != "TERM") {
+        return CommandResult(false, "unknown command '" + command + "'");
+    }
+
+    vector<string> f = splitFields(line, 2);
+    string inner = f[2];
+    string innerCommand = inner.substr(0, inner.find(','));
+    if (innerCommand == "ADD_STUDENT" || innerCommand == "STUDENT") {
+        vector<string> g = splitFields(inner, 2);
+        return finish(terms->addStudent(g[1], g[2]), "student added to every term");
+    }
+    if (innerCommand == "UPDATE_STUDENT") {
+        vector<string> g = splitFields(inner, 2);
+        return finish(terms->updateStudent(g[1], g[2]), "student updated in every term");
+    }
+    if (innerCommand == "PROFILE") {
+        vector<string> g = splitFields(inner, 3);
+        int standing = 0;
+        if (!parseInt(g[2], standing)) {
+            return CommandResult(false, "invalid class standing");
+        }
+        return finish(terms->setStudentProfile(g[1], standing, g[3]), "profile updated in every term");
+    }
+    if (innerCommand == "REMOVE_STUDENT") {
+        vector<string> g = splitFields(inner, 1);
+        return finish(terms->removeStudent(g[1]), "student removed from every term");
+    }
+    if (innerCommand == "LOAD") {
+        vector<string> g = splitFields(inner, 1);
+        return finish(terms->loadTerm(f[1], g[1]), "loaded into " + f[1]);
+    }
+
+    shared_ptr<TermPartition> partition = terms->getTerm(f[1]);
+    if (!partition) {
+        return CommandResult(false, "term " + f[1] + " doesn't exist");
+    }
+    return partition->with([&](UniversitySystem& termSystem) {
+        CommandProcessor termProcessor(termSystem);
+        return termProcessor.execute(inner);
+    });
+}
+
+/**
+ @brief lists every command execute understands, with its fields
+
+ @return (vector<string>) one usage line per command
+ */
+vector<string> CommandProcessor::getCommandNames() {
+    return {
+        "ADD_STUDENT,ID,Full Name", "REMOVE_STUDENT,ID", "UPDATE_STUDENT,ID,New Name", "PROFILE,ID,Standing,Major",
+        "ADD_COURSE,Code,Title,Instructor,Capacity", "REMOVE_COURSE,Code", "UPDATE_COURSE,Code,Title,Instructor,Capacity", "POLICY,Code,Policy",
+        "SECTION,Code,Section Code",
+        "ENROLL,ID,Code", "DROP,ID,Code", "SCHEDULE,ID,Code,Code,...",
+        "HOLD,ID,Code,Seconds", "CONFIRM,ID,Code", "RELEASE,ID,Code",
+        "PREFER,ID,Max Courses,Code,Code,...", "CLOSE_WINDOW,Seed",
+        "SEARCH_STUDENT,Full Name", "SEARCH_COURSE,Title", "INSTRUCTOR,Name", "LIST_STUDENT,ID", "LIST_COURSE,Code",
+        "STUDENTS", "COURSES", "STATS", "LOG,Count",
+        "QUERY_LOG,ID,Code,Action,From,To", "TOP_COURSES,Count", "BELOW_FILL,Percent", "ANALYTICS,Report",
+        "REPORT,students|courses|rosters,table|csv|json,File", "LOAD,File", "SAVE,File", "CHECKPOINT,File", "TRACE,start|stop|File",
+        "RECORD,stop|File", "DIGEST",
+        "TERMS", "TERM_OPEN,Term", "TERM_DROP,Term", "TERM_LOAD,Term,File", "TERM_SAVE,Term,File", "TERM_RESTORE,Term,File", "TERM,Term,Command",
+        "TERM_STORE,File,Resident Terms,Cache Pages", "TERM_ARCHIVE,Term", "TERM_ROSTER,Term,Code", "TERM_STATS"
+    };
+}
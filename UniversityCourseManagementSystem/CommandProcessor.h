@@ -0,0 +1,55 @@
+//
+//  CommandProcessor.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/8/25.
+//
+
+#ifndef COMMAND_PROCESSOR_H
+#define COMMAND_PROCESSOR_H
+
+#include "UniversitySystem.h"
+#include "Analytics.h"
+#include "TermRegistry.h"
+#include <string>
+#include <vector>
+#include <sstream>
+
+using namespace std;
+
+struct CommandResult {
+    bool success;
+    string message;
+
+    CommandResult();
+    CommandResult(bool ok, const string& text);
+};
+
+class CommandProcessor {
+private:
+    UniversitySystem& system;
+    ostream& previousOut;
+    TermRegistry* terms;
+    ostringstream captured;
+    AnalyticsEngine analytics;
+
+    static vector<string> splitFields(const string& line, size_t expectedFields);
+    static bool parseInt(const string& text, int& value);
+    string takeCaptured();
+    CommandResult finish(bool ok, const string& successMessage);
+    CommandResult dispatch(const string& line);
+    CommandResult runTermCommand(const string& command, const string& line);
+
+public:
+    explicit CommandProcessor(UniversitySystem& target, TermRegistry* termRegistry = nullptr);
+    ~CommandProcessor();
+
+    CommandProcessor(const CommandProcessor&) = delete;
+    CommandProcessor& operator=(const CommandProcessor&) = delete;
+
+    CommandResult execute(const string& line);
+
+    static vector<string> getCommandNames();
+};
+
+#endif // COMMAND_PROCESSOR_H
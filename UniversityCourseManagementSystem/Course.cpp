@@ -6,12 +6,22 @@
 //
 
 #include "Course.h"
-#include <iostream>
+#include "MemoryReport.h"
+#include "ReportWriter.h"
+#include <cctype>
+#include <algorithm>
+#include <atomic>
+
+/*
+ version stamps come from one process-wide clock, so a course that is removed and added again never reuses a stamp a
+ pending schedule transaction may still hold
+ */
+static atomic<unsigned long long> versionClock(0);
 
 /**
  @brief default constructor for the Course class
  
- @details initializes courseCode, title, and instructorName to empty strings, capacity to 30, and currentEnrollment to 0
+ @details initializes courseCode, title, and instructorName to empty strings, capacity to 30, currentEnrollment to 0, and the waitlist to first-come order
  */
 Course::Course() {
     courseCode = "";
@@ -19,12 +29,16 @@ Course::Course() {
     instructorName = "";
     capacity = 30;
     currentEnrollment = 0;
+    sectioned = false;
+    waitlistSequence = 0;
+    waitlistPolicy = defaultWaitlistPolicy();
+    touch();
 }
 
 /**
  @brief parameterized constructor for the Course class
  
- @details initializes the course with the given code, title, instructor name, and capacity. currentEnrollment is initialized to 0
+ @details initializes the course with the given code, title, instructor name, and capacity. currentEnrollment is initialized to 0 and the waitlist uses first-come order
  
  @param code the course code
  @param courseTitle the course title
@@ -37,41 +51,62 @@ Course::Course(const string& code, const string& courseTitle, const string& inst
     instructorName = instructor;
     capacity = maxCapacity;
     currentEnrollment = 0;
+    sectioned = false;
+    waitlistSequence = 0;
+    waitlistPolicy = defaultWaitlistPolicy();
+    touch();
 }
 
 /**
  @brief returns the course code
  
- @return (string) the course code
+ @return (const string&) the course code
  */
-string Course::getCourseCode() const {
+const string& Course::getCourseCode() const {
     return courseCode;
 }
 
 /**
  @brief returns the course title
  
- @return (string) the course title
+ @return (const string&) the course title
  */
-string Course::getTitle() const {
+const string& Course::getTitle() const {
     return title;
 }
 
 /**
  @brief returns the instructor's name
  
- @return (string) the instructor's name
+ @return (const string&) the instructor's name
  */
-string Course::getInstructorName() const {
+const string& Course::getInstructorName() const {
     return instructorName;
 }
 
+/**
+ @brief returns the department the course belongs to
+ 
+ @details the department is the leading letters of the course code, e.g. "CS" for "CS101"
+ 
+ @return (string) the department code
+ */
+string Course::getDepartment() const {
+    size_t length = 0;
+    while (length < courseCode.size() && isalpha(static_cast<unsigned char>(courseCode[length]))) {
+        length++;
+    }
+    return courseCode.substr(0, length);
+}
+
 /**
  @brief returns the list of enrolled students
  
- @return (set<string>) a set of student IDs currently enrolled in the course
+ @details returns a reference, so iterating the roster copies nothing. it stays valid until the course is changed or removed
+ 
+ @return (const set<string>&) a set of student IDs currently enrolled in the course
  */
-set<string> Course::getEnrolledStudents() const {
+const set<string>& Course::getEnrolledStudents() const {
     return enrolledStudents;
 }
 
@@ -102,6 +137,59 @@ int Course::getWaitlistSize() const {
     return waitlist.size();
 }
 
+/**
+ @brief returns the waitlist in promotion order
+ 
+ @return (vector<string>) the waitlisted student IDs, next to be promoted first
+ */
+vector<string> Course::getWaitlist() const {
+    vector<string> ordered;
+    ordered.reserve(waitlist.size());
+    forEachWaitlisted([&](const string& studentID) {
+        ordered.push_back(studentID);
+    });
+    return ordered;
+}
+
+/**
+ @brief returns the number of seats on hold
+ 
+ @return (int) the number of students holding a seat they have not confirmed yet
+ */
+int Course::getHeldSeats() const {
+    return static_cast<int>(heldSeats.size());
+}
+
+/**
+ @brief returns the number of open seats
+ 
+ @return (int) capacity minus enrolled and held seats, or 0 if the course is full
+ */
+int Course::getAvailableSeats() const {
+    if (sectioned) {
+        return 0;
+    }
+    return max(0, capacity - currentEnrollment - getHeldSeats());
+}
+
+/**
+ @brief returns the course's version stamp
+ 
+ @details the stamp changes whenever the roster, waitlist or capacity changes, so a caller that read the course earlier can check that nothing it relied on has moved since
+ 
+ @return (unsigned long long) the current stamp
+ */
+unsigned long long Course::getVersion() const {
+    return version;
+}
+
+/**
+ @brief gives the course a new version stamp after a change to its roster, waitlist or capacity
+ */
+void Course::touch() {
+    version = ++versionClock;
+}
+
 /**
  @brief sets the course title
  
@@ -120,6 +208,27 @@ void Course::setInstructorName(const string& instructor){
     instructorName = instructor;
 }
 
+/**
+ @brief checks if the course is an offering split into sections
+
+ @return (bool) true if its seats live in its sections
+ */
+bool Course::isSectioned() const {
+    return sectioned;
+}
+
+/**
+ @brief marks the course as an offering whose seats live in separate section courses
+
+ @details a sectioned course has no seats of its own, so every enrollment lands on its waitlist, which the sections share
+
+ @param hasSections true once the first section is added, false when the last one goes
+ */
+void Course::setSectioned(bool hasSections) {
+    sectioned = hasSections;
+    touch();
+}
+
 /**
  @brief sets the course capacity
  
@@ -127,45 +236,81 @@ void Course::setInstructorName(const string& instructor){
  */
 void Course::setCapacity(int maxCapacity) {
     capacity = maxCapacity;
+    touch();
 }
 
 /**
- @brief enrolls a student in the course
+ @brief returns the policy that orders the waitlist
  
- @details adds the student to the enrolled list if space is available. If the course is full, the student is added to the waitlist. handles duplicates and exmpty IDs.
+ @return (const WaitlistPolicy&) the current policy
+ */
+const WaitlistPolicy& Course::getWaitlistPolicy() const {
+    return *waitlistPolicy;
+}
+
+/**
+ @brief replaces the policy that orders the waitlist
  
- @param studentID the student ID to enroll
+ @details students already waiting keep their rank until updateWaitlistRank or rerankWaitlist is called for them. a null policy is ignored
  
- @return (bool) true if the student is enrolled, false otherwise
+ @param policy the new policy
+ */
+void Course::setWaitlistPolicy(shared_ptr<const WaitlistPolicy> policy) {
+    if (policy) {
+        waitlistPolicy = policy;
+    }
+}
+
+/**
+ @brief changes the rank of a student already on the waitlist
+ 
+ @details the student keeps their original arrival order for tie-breaking. O(log n)
+ 
+ @param studentID the waitlisted student
+ @param priorityRank the new rank (lower is served first)
+ 
+ @return (bool) true if the student was on the waitlist, false otherwise
  */
-bool Course::enrollStudent(const string& studentID) {
-    if (studentID.empty()){
-        cout << "No student ID provided" << endl;
+bool Course::updateWaitlistRank(const string& studentID, int priorityRank) {
+    if (!waitlist.contains(studentID)) {
         return false;
     }
     
-    if (isStudentEnrolled(studentID)) {
-        cout << "Student already enrolled in course" << endl;
+    unsigned long long sequence = waitlist.priorityOf(studentID).sequence;
+    touch();
+    return waitlist.update(studentID, WaitlistPriority(priorityRank, sequence));
+}
+
+/**
+ @brief enrolls a student in the course
+ 
+ @details adds the student to the enrolled list if space is available. If the course is full, the student is added to the waitlist. handles duplicates and exmpty IDs. callers can use isStudentEnrolled and isStudentWaitlisted to tell the outcomes apart
+ 
+ @param studentID the student ID to enroll
+ @param priorityRank the student's rank under the waitlist policy, used only if the course is full (lower is served first)
+ 
+ @return (bool) true if the student is enrolled, false otherwise
+ */
+bool Course::enrollStudent(const string& studentID, int priorityRank) {
+    if (studentID.empty() || isStudentEnrolled(studentID)) {
         return false;
     }
     
     if (hasAvailableSeats()) {
         enrolledStudents.insert(studentID);
         currentEnrollment++;
+        touch();
         return true;
-    } else {
-        bool addedToWaitlist = addToWaitlist(studentID);
-        if (addedToWaitlist) {
-            cout << "Added student to waitlist" << endl;
-        }
-        return false;
     }
+    
+    addToWaitlist(studentID, priorityRank);
+    return false;
 }
 
 /**
  @brief drops a student from the course
  
- @details if the student is enrolled, removes them and fills the spot from the waitlist
+ @details if the student is enrolled, removes them. the freed seat is not refilled here -- call promoteFromWaitlist so the caller can update the promoted students' records too
  
  @param studentID the student ID to drop
  
@@ -179,20 +324,119 @@ bool Course::dropStudent(const string& studentID) {
     size_t removed = enrolledStudents.erase(studentID);
     if (removed > 0) {
         currentEnrollment--;
-        
-        if (!waitlist.empty()) {
-            string waitlistedStudent = removeFromWaitlist();
-            if (!waitlistedStudent.empty()) {
-                enrolledStudents.insert(waitlistedStudent);
-                currentEnrollment++;
-            }
-        }
+        touch();
         return true;
     }
     
     return false;
 }
 
+/**
+ @brief fills every open seat from the head of the waitlist
+ 
+ @details promotes as many students as there are free seats in a single pass, so a capacity increase of k seats promotes k students
+ 
+ @return (vector<string>) the promoted student IDs in promotion order
+ */
+vector<string> Course::promoteFromWaitlist() {
+    vector<string> promoted;
+    while (hasAvailableSeats() && !waitlist.empty()) {
+        string studentID = removeFromWaitlist();
+        enrolledStudents.insert(studentID);
+        currentEnrollment++;
+        promoted.push_back(studentID);
+    }
+    if (!promoted.empty()) {
+        touch();
+    }
+    return promoted;
+}
+
+/**
+ @brief takes a student off the waitlist without enrolling them
+ 
+ @details used when the student leaves the system while still waiting for a seat
+ 
+ @param studentID the student ID to remove
+ 
+ @return (bool) true if the student was on the waitlist, false otherwise
+ */
+bool Course::withdrawFromWaitlist(const string& studentID) {
+    if (!waitlist.erase(studentID)) {
+        return false;
+    }
+    touch();
+    return true;
+}
+
+/**
+ @brief takes the student at the head of the waitlist off it without enrolling them
+
+ @details used to move waitlisted students of a sectioned course into one of its sections
+
+ @return (string) the student ID, or an empty string if the waitlist is empty
+ */
+string Course::takeFromWaitlist() {
+    string studentID = removeFromWaitlist();
+    if (!studentID.empty()) {
+        touch();
+    }
+    return studentID;
+}
+
+/**
+ @brief reserves an open seat for a student without enrolling them
+ 
+ @details the seat counts against capacity until it is confirmed or released, so neither enrollment nor waitlist promotion can take it
+ 
+ @param studentID the student to hold a seat for
+ 
+ @return (bool) true if a seat was held, false if the course is full or the student is already enrolled, waiting, or holding
+ */
+bool Course::holdSeat(const string& studentID) {
+    if (studentID.empty() || !hasAvailableSeats() || isStudentEnrolled(studentID) || isStudentWaitlisted(studentID) || isSeatHeldBy(studentID)) {
+        return false;
+    }
+    
+    heldSeats.insert(studentID);
+    touch();
+    return true;
+}
+
+/**
+ @brief gives a held seat back
+ 
+ @details the freed seat is not refilled here -- call promoteFromWaitlist, as after a drop
+ 
+ @param studentID the student holding the seat
+ 
+ @return (bool) true if the student held a seat, false otherwise
+ */
+bool Course::releaseSeat(const string& studentID) {
+    if (heldSeats.erase(studentID) == 0) {
+        return false;
+    }
+    touch();
+    return true;
+}
+
+/**
+ @brief turns a held seat into an enrollment
+ 
+ @param studentID the student holding the seat
+ 
+ @return (bool) true if the student held a seat and is now enrolled, false otherwise
+ */
+bool Course::confirmSeat(const string& studentID) {
+    if (heldSeats.erase(studentID) == 0) {
+        return false;
+    }
+    enrolledStudents.insert(studentID);
+    currentEnrollment++;
+    touch();
+    return true;
+}
+
 /**
  @brief checks if a student is enrolled in the course
  
@@ -204,36 +448,71 @@ bool Course::isStudentEnrolled(const string& studentID) const {
     return enrolledStudents.find(studentID) != enrolledStudents.end();
 }
 
+/**
+ @brief checks if a student is on the waitlist
+ 
+ @param studentID the student ID to check
+ 
+ @return (bool) true if the student is waiting for a seat, false otherwise
+ */
+bool Course::isStudentWaitlisted(const string& studentID) const {
+    return waitlist.contains(studentID);
+}
+
+/**
+ @brief checks if a student holds a seat in the course
+ 
+ @param studentID the student ID to check
+ 
+ @return (bool) true if the student holds an unconfirmed seat, false otherwise
+ */
+bool Course::isSeatHeldBy(const string& studentID) const {
+    return heldSeats.find(studentID) != heldSeats.end();
+}
+
+/**
+ @brief adds the memory used by the waitlist to a report row
+ 
+ @details every waiting student ID is stored twice: once in the heap array and once as a key of the slot index
+ 
+ @param usage the row to add to
+ */
+void Course::accountWaitlistMemory(MemoryUsage& usage) const {
+    usage.elements += waitlist.size();
+    usage.capacityBytes += waitlist.capacity() * sizeof(pair<string, WaitlistPriority>) + waitlist.bucketCount() * sizeof(void*);
+    usage.nodeBytes += waitlist.size() * (HASH_NODE_OVERHEAD + sizeof(pair<const string, size_t>));
+    waitlist.forEachKey([&](const string& studentID) {
+        usage.stringBytes += 2 * stringHeapBytes(studentID);
+    });
+}
+
 /**
  @brief adds a student to the waitlist
  
- @details prevents duplicates by scanning the waitlist before adding
+ @details the student is placed by rank, then by arrival. duplicates are rejected in O(1)
  
  @param studentID the student ID to add to the waitlist
+ @param priorityRank the student's rank under the waitlist policy
  
  @return (bool) true if successfully added, false if already on the waitlist
  */
-bool Course::addToWaitlist(const string& studentID) {
+bool Course::addToWaitlist(const string& studentID, int priorityRank) {
     if (studentID.empty()) {
         return false;
     }
     
-    queue<string> tempQueue = waitlist;
-    while (!tempQueue.empty()) {
-        if (tempQueue.front() == studentID) {
-            cout << "already on waitlist" << endl;
-            return false;
-        }
-        tempQueue.pop();
+    if (!waitlist.push(studentID, WaitlistPriority(priorityRank, waitlistSequence))) {
+        return false;
     }
-    waitlist.push(studentID);
+    waitlistSequence++;
+    touch();
     return true;
 }
 
 /**
  @brief removes and returns the next student from the waitlist
  
- @details follows first in, first out behavior
+ @details takes the student with the best rank, first in, first out among equal ranks
  
  @return (string) the student ID removed from the waitlist, or an empty string if none
  */
@@ -242,54 +521,78 @@ string Course::removeFromWaitlist() {
         return "";
     }
     
-    string studentID = waitlist.front();
-    waitlist.pop();
-    return studentID;
+    return waitlist.pop();
 }
 
 /**
  @brief checks if the course has available seats
  
+ @details held seats count as taken
+ 
  @return (bool) true if there is space in the course, false otherwise
  */
 bool Course::hasAvailableSeats() const {
-    return currentEnrollment < capacity;
+    return !sectioned && currentEnrollment + getHeldSeats() < capacity;
 }
 
 /**
  @brief displays the list of enrolled students
  
- @details outputs all enrolled student IDs to the console
+ @details outputs all enrolled student IDs to the given stream, followed by the number of seats on hold if there are any
+ 
+ @param os the stream to write to (defaults to the console)
+ */
+void Course::displayEnrolledStudents(ostream& os) const {
+    ReportWriter report(os);
+    displayEnrolledStudents(report);
+}
+
+/**
+ @brief displays the list of enrolled students into a report
+ 
+ @param report the report to write to
  */
-void Course::displayEnrolledStudents() const {
+void Course::displayEnrolledStudents(ReportWriter& report) const {
     if (enrolledStudents.empty()) {
-        cout << "No students enrolled" << endl;
-        return;
+        report << "No students enrolled\n";
+    } else {
+        report << "Enrolled Students (" << currentEnrollment << "):\n";
+        for (const auto& student : enrolledStudents) {
+            report << " - " << student << '\n';
+        }
     }
-    
-    cout << "Enrolled Students (" << currentEnrollment << "):" << endl;
-    for (const auto& student : enrolledStudents) {
-        cout << " - " << student << endl;
+    if (!heldSeats.empty()) {
+        report << "Seats on hold: " << heldSeats.size() << '\n';
     }
 }
 
 /**
  @brief displays the waitlist for the course
  
- @details outputs the current waitlisted students in order
+ @details outputs the current waitlisted students in order to the given stream
+ 
+ @param os the stream to write to (defaults to the console)
  */
-void Course::displayWaitlist() const {
+void Course::displayWaitlist(ostream& os) const {
+    ReportWriter report(os);
+    displayWaitlist(report);
+}
+
+/**
+ @brief displays the waitlist for the course into a report
+ 
+ @param report the report to write to
+ */
+void Course::displayWaitlist(ReportWriter& report) const {
     if (waitlist.empty()) {
-        cout << "No students on waitlist" << endl;
+        report << "No students on waitlist\n";
         return;
     }
     
-    cout << "Waitlist (" << getWaitlistSize() << "):" << endl;
-    queue<string> tempQueue = waitlist;
+    report << "Waitlist (" << getWaitlistSize() << "):\n";
     int position = 1;
-    while (!tempQueue.empty()) {
-        cout << " " << position << ". " << tempQueue.front() << endl;
-        tempQueue.pop();
+    forEachWaitlisted([&](const string& studentID) {
+        report << ' ' << position << ". " << studentID << '\n';
         position++;
-    }
+    });
 }
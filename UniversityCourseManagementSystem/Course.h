@@ -8,24 +8,36 @@
 #ifndef COURSE_H
 #define COURSE_H
 
+#include "IndexedHeap.h"
+#include "WaitlistPolicy.h"
 #include <string>
 #include <set>
-#include <queue>
+#include <vector>
+#include <memory>
+#include <iostream>
 
 using namespace std;
 
+struct MemoryUsage;
+class ReportWriter;
+
 class Course {
 private:
     string courseCode;
     string title;
     string instructorName;
     set<string> enrolledStudents;
-    queue<string> waitlist;
+    set<string> heldSeats;
+    IndexedHeap<string, WaitlistPriority> waitlist;
+    unsigned long long waitlistSequence;
+    shared_ptr<const WaitlistPolicy> waitlistPolicy;
     int capacity;
     int currentEnrollment;
+    bool sectioned;
+    unsigned long long version;
     
-    bool isStudentEnrolled(const string& studentID) const;
-    bool addToWaitlist(const string& studentID);
+    void touch();
+    bool addToWaitlist(const string& studentID, int priorityRank);
     string removeFromWaitlist();
     
     bool hasAvailableSeats() const;
@@ -33,23 +45,83 @@ public:
     Course();
     Course(const string& code, const string& courseTitle, const string& instructor, int maxCapacity = 30);
     
-    string getCourseCode() const;
-    string getTitle() const;
-    string getInstructorName() const;
-    set<string> getEnrolledStudents() const;
+    const string& getCourseCode() const;
+    const string& getTitle() const;
+    const string& getInstructorName() const;
+    string getDepartment() const;
+    const set<string>& getEnrolledStudents() const;
     int getCapacity() const;
     int getCurrentEnrollment() const;
     int getWaitlistSize() const;
+    int getHeldSeats() const;
+    int getAvailableSeats() const;
+    unsigned long long getVersion() const;
+    vector<string> getWaitlist() const;
+    bool isSectioned() const;
+    
+    template <typename Visitor>
+    void forEachEnrolledStudent(Visitor&& visit) const {
+        for (const auto& studentID : enrolledStudents) {
+            visit(studentID);
+        }
+    }
+    
+    template <typename Visitor>
+    void forEachWaitlistedStudent(Visitor&& visit) const {
+        waitlist.forEachKey(visit);
+    }
+    
+    template <typename Visitor>
+    void forEachWaitlisted(Visitor&& visit) const {
+        waitlist.forEachInOrder(visit);
+    }
+    
+    template <typename RankOf>
+    void rerankWaitlist(RankOf&& rankOf) {
+        if (waitlist.empty()) {
+            return;
+        }
+        touch();
+        waitlist.reprioritize([&](const string& studentID, const WaitlistPriority& priority) {
+            return WaitlistPriority(rankOf(studentID, priority.rank), priority.sequence);
+        });
+    }
+    
+    template <typename Visitor>
+    void forEachSeatHolder(Visitor&& visit) const {
+        for (const auto& studentID : heldSeats) {
+            visit(studentID);
+        }
+    }
+    
+    bool isStudentEnrolled(const string& studentID) const;
+    bool isStudentWaitlisted(const string& studentID) const;
+    bool isSeatHeldBy(const string& studentID) const;
+    void accountWaitlistMemory(MemoryUsage& usage) const;
     
     void setTitle(const string& courseTitle);
     void setInstructorName(const string& instructor);
     void setCapacity(int maxCapacity);
+    void setSectioned(bool hasSections);
     
-    bool enrollStudent(const string& studentID);
+    const WaitlistPolicy& getWaitlistPolicy() const;
+    void setWaitlistPolicy(shared_ptr<const WaitlistPolicy> policy);
+    bool updateWaitlistRank(const string& studentID, int priorityRank);
+    
+    bool enrollStudent(const string& studentID, int priorityRank = 0);
     bool dropStudent(const string& studentID);
+    vector<string> promoteFromWaitlist();
+    bool withdrawFromWaitlist(const string& studentID);
+    string takeFromWaitlist();
+    
+    bool holdSeat(const string& studentID);
+    bool releaseSeat(const string& studentID);
+    bool confirmSeat(const string& studentID);
     
-    void displayEnrolledStudents() const;
-    void displayWaitlist() const;
+    void displayEnrolledStudents(ostream& os = cout) const;
+    void displayEnrolledStudents(ReportWriter& report) const;
+    void displayWaitlist(ostream& os = cout) const;
+    void displayWaitlist(ReportWriter& report) const;
 };
 
 #endif // COURSE_H
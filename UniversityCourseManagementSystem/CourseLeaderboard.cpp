@@ -0,0 +1,287 @@
+//
+//  CourseLeaderboard.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/10/25.
+//
+
+#include "CourseLeaderboard.h"
+#include <algorithm>
+
+/**
+ @brief constructs an empty CourseStanding
+ */
+CourseStanding::CourseStanding() {
+    enrolled = 0;
+    capacity = 1;
+    waitlisted = 0;
+    seatsRanked = true;
+}
+
+/**
+ @brief captures the current counts of a course
+
+ @param course the course to read
+ */
+CourseStanding::CourseStanding(const Course& course) {
+    courseCode = course.getCourseCode();
+    enrolled = course.getCurrentEnrollment();
+    capacity = max(1, course.getCapacity());
+    waitlisted = course.getWaitlistSize();
+    seatsRanked = !course.isSectioned();
+}
+
+/**
+ @brief gets the share of seats that are taken
+
+ @return (double) enrolled divided by capacity
+ */
+double CourseStanding::getFillRatio() const {
+    return static_cast<double>(enrolled) / capacity;
+}
+
+/**
+ @brief orders standings from emptiest to fullest
+
+ @details compares enrolled/capacity exactly by cross-multiplying, then by course code so every course has a distinct key
+
+ @return (bool) true if a is less full than b
+ */
+bool CourseLeaderboard::FillOrder::operator()(const CourseStanding* a, const CourseStanding* b) const {
+    long long left = static_cast<long long>(a->enrolled) * b->capacity;
+    long long right = static_cast<long long>(b->enrolled) * a->capacity;
+    if (left != right) {
+        return left < right;
+    }
+    return a->courseCode < b->courseCode;
+}
+
+/**
+ @brief constructs an empty leaderboard
+ */
+CourseLeaderboard::CourseLeaderboard() {
+}
+
+/**
+ @brief copies a leaderboard
+
+ @details the fill index points into the standings table, so it is rebuilt against the copy's own table. moves keep the table's nodes, so they are defaulted
+
+ @param other the leaderboard to copy
+ */
+CourseLeaderboard::CourseLeaderboard(const CourseLeaderboard& other) : standings(other.standings), byWaitlist(other.byWaitlist), byEnrollment(other.byEnrollment) {
+    for (const auto& entry : standings) {
+        byFill.insert(&entry.second);
+    }
+}
+
+/**
+ @brief replaces this leaderboard with a copy of another
+
+ @param other the leaderboard to copy
+
+ @return (CourseLeaderboard&) this leaderboard
+ */
+CourseLeaderboard& CourseLeaderboard::operator=(const CourseLeaderboard& other) {
+    if (this != &other) {
+        standings = other.standings;
+        byWaitlist = other.byWaitlist;
+        byEnrollment = other.byEnrollment;
+        byFill.clear();
+        for (const auto& entry : standings) {
+            byFill.insert(&entry.second);
+        }
+    }
+    return *this;
+}
+
+/**
+ @brief removes a standing from every ordered index
+
+ @param standing the standing as it is currently indexed
+ */
+void CourseLeaderboard::unlink(const CourseStanding& standing) {
+    byWaitlist.erase({-standing.waitlisted, standing.courseCode});
+    if (standing.seatsRanked) {
+        byEnrollment.erase({-standing.enrolled, standing.courseCode});
+        byFill.erase(&standing);
+    }
+}
+
+/**
+ @brief adds a standing to every ordered index
+
+ @details counts are stored negated so the largest values come first, with ties in course code order. an offering split into sections is only ranked by its shared waitlist
+
+ @param standing the standing to index. it must live in the standings table
+ */
+void CourseLeaderboard::link(const CourseStanding& standing) {
+    byWaitlist.emplace(-standing.waitlisted, standing.courseCode);
+    if (standing.seatsRanked) {
+        byEnrollment.emplace(-standing.enrolled, standing.courseCode);
+        byFill.insert(&standing);
+    }
+}
+
+/**
+ @brief records the current counts of a course
+
+ @details call after anything that changes the course's enrollment, waitlist or capacity. O(log n), and free when nothing changed. an offering split into sections keeps its place in the waitlist ranking, since the shared waitlist lives on it, but its seats are ranked through its sections
+
+ @param course the course to record
+ */
+void CourseLeaderboard::refresh(const Course& course) {
+    CourseStanding current(course);
+    auto iter = standings.find(current.courseCode);
+    if (iter == standings.end()) {
+        iter = standings.emplace(current.courseCode, current).first;
+        link(iter->second);
+        return;
+    }
+
+    CourseStanding& standing = iter->second;
+    if (standing.enrolled == current.enrolled && standing.capacity == current.capacity && standing.waitlisted == current.waitlisted && standing.seatsRanked == current.seatsRanked) {
+        return;
+    }
+    unlink(standing);
+    standing = current;
+    link(standing);
+}
+
+/**
+ @brief forgets a course
+
+ @param courseCode the code of the removed course
+ */
+void CourseLeaderboard::remove(const string& courseCode) {
+    auto iter = standings.find(courseCode);
+    if (iter == standings.end()) {
+        return;
+    }
+    unlink(iter->second);
+    standings.erase(iter);
+}
+
+/**
+ @brief forgets every course
+ */
+void CourseLeaderboard::clear() {
+    byWaitlist.clear();
+    byEnrollment.clear();
+    byFill.clear();
+    standings.clear();
+}
+
+/**
+ @brief gets the number of courses tracked
+
+ @return (size_t) the number of courses
+ */
+size_t CourseLeaderboard::size() const {
+    return standings.size();
+}
+
+/**
+ @brief adds a row for the standings table and its ordered indexes to a memory report
+
+ @param report the report to add to
+ */
+void CourseLeaderboard::accountMemory(MemoryReport& report) const {
+    MemoryUsage& usage = report.add("course leaderboard");
+    usage.elements = standings.size();
+    usage.nodeBytes = hashNodeBytes(standings) + treeNodeBytes(byWaitlist) + treeNodeBytes(byEnrollment) + treeNodeBytes(byFill);
+    usage.capacityBytes = hashBucketBytes(standings);
+    for (const auto& entry : standings) {
+        usage.stringBytes += 4 * stringHeapBytes(entry.first);
+    }
+}
+
+/**
+ @brief gets the courses with the longest waitlists
+
+ @param k the number of courses to return
+
+ @return (vector<CourseStanding>) up to k courses, longest waitlist first. O(k)
+ */
+vector<CourseStanding> CourseLeaderboard::longestWaitlists(size_t k) const {
+    vector<CourseStanding> result;
+    for (auto iter = byWaitlist.begin(); iter != byWaitlist.end() && result.size() < k; ++iter) {
+        result.push_back(standings.at(iter->second));
+    }
+    return result;
+}
+
+/**
+ @brief gets the courses with the most enrolled students
+
+ @param k the number of courses to return
+
+ @return (vector<CourseStanding>) up to k courses, largest enrollment first. O(k)
+ */
+vector<CourseStanding> CourseLeaderboard::mostEnrolled(size_t k) const {
+    vector<CourseStanding> result;
+    for (auto iter = byEnrollment.begin(); iter != byEnrollment.end() && result.size() < k; ++iter) {
+        result.push_back(standings.at(iter->second));
+    }
+    return result;
+}
+
+/**
+ @brief gets the courses with the lowest share of seats taken
+
+ @param k the number of courses to return
+
+ @return (vector<CourseStanding>) up to k courses, emptiest first. O(k)
+ */
+vector<CourseStanding> CourseLeaderboard::emptiest(size_t k) const {
+    vector<CourseStanding> result;
+    for (auto iter = byFill.begin(); iter != byFill.end() && result.size() < k; ++iter) {
+        result.push_back(**iter);
+    }
+    return result;
+}
+
+/**
+ @brief gets the courses with the highest share of seats taken
+
+ @param k the number of courses to return
+
+ @return (vector<CourseStanding>) up to k courses, fullest first. O(k)
+ */
+vector<CourseStanding> CourseLeaderboard::fullest(size_t k) const {
+    vector<CourseStanding> result;
+    for (auto iter = byFill.rbegin(); iter != byFill.rend() && result.size() < k; ++iter) {
+        result.push_back(**iter);
+    }
+    return result;
+}
+
+/**
+ @brief gets every course whose fill ratio is below a threshold
+
+ @param ratio the threshold, e.g. 0.25 for courses under 25% full
+
+ @return (vector<CourseStanding>) the matching courses, emptiest first. O(k) for k matches
+ */
+vector<CourseStanding> CourseLeaderboard::belowFill(double ratio) const {
+    vector<CourseStanding> result;
+    for (auto iter = byFill.begin(); iter != byFill.end() && (*iter)->enrolled < ratio * (*iter)->capacity; ++iter) {
+        result.push_back(**iter);
+    }
+    return result;
+}
+
+/**
+ @brief gets every course whose waitlist has at least a given length
+
+ @param length the minimum waitlist length
+
+ @return (vector<CourseStanding>) the matching courses, longest waitlist first. O(k) for k matches
+ */
+vector<CourseStanding> CourseLeaderboard::waitlistAtLeast(int length) const {
+    vector<CourseStanding> result;
+    for (auto iter = byWaitlist.begin(); iter != byWaitlist.end() && -iter->first >= length; ++iter) {
+        result.push_back(standings.at(iter->second));
+    }
+    return result;
+}
@@ -0,0 +1,70 @@
+//
+//  CourseLeaderboard.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/10/25.
+//
+
+#ifndef COURSE_LEADERBOARD_H
+#define COURSE_LEADERBOARD_H
+
+#include "Course.h"
+#include "MemoryReport.h"
+#include <string>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+struct CourseStanding {
+    string courseCode;
+    int enrolled;
+    int capacity;
+    int waitlisted;
+    // false for an offering split into sections: its seats are ranked through the sections, but its shared waitlist is ranked here
+    bool seatsRanked;
+
+    CourseStanding();
+    explicit CourseStanding(const Course& course);
+
+    double getFillRatio() const;
+};
+
+class CourseLeaderboard {
+private:
+    struct FillOrder {
+        bool operator()(const CourseStanding* a, const CourseStanding* b) const;
+    };
+
+    unordered_map<string, CourseStanding> standings;
+    set<pair<int, string>> byWaitlist;
+    set<pair<int, string>> byEnrollment;
+    set<const CourseStanding*, FillOrder> byFill;
+
+    void unlink(const CourseStanding& standing);
+    void link(const CourseStanding& standing);
+
+public:
+    CourseLeaderboard();
+    CourseLeaderboard(const CourseLeaderboard& other);
+    CourseLeaderboard& operator=(const CourseLeaderboard& other);
+    CourseLeaderboard(CourseLeaderboard&& other) = default;
+    CourseLeaderboard& operator=(CourseLeaderboard&& other) = default;
+
+    void refresh(const Course& course);
+    void remove(const string& courseCode);
+    void clear();
+    size_t size() const;
+    void accountMemory(MemoryReport& report) const;
+
+    vector<CourseStanding> longestWaitlists(size_t k) const;
+    vector<CourseStanding> mostEnrolled(size_t k) const;
+    vector<CourseStanding> emptiest(size_t k) const;
+    vector<CourseStanding> fullest(size_t k) const;
+    vector<CourseStanding> belowFill(double ratio) const;
+    vector<CourseStanding> waitlistAtLeast(int length) const;
+};
+
+#endif // COURSE_LEADERBOARD_H
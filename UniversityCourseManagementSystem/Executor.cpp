@@ -0,0 +1,200 @@
+//
+//  Executor.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "Executor.h"
+#include <thread>
+
+/**
+ @brief constructs an idle executor
+
+ @param pollEvery how often until() conditions are re-checked while nothing else is ready
+ */
+Executor::Executor(chrono::milliseconds pollEvery) {
+    timerSequence = 0;
+    pollInterval = pollEvery;
+    liveTasks = 0;
+    peakLiveTasks = 0;
+    resumptions = 0;
+}
+
+/**
+ @brief queues a suspended coroutine to be resumed by the loop
+
+ @param waiter the coroutine to resume
+ */
+void Executor::schedule(coroutine_handle<> waiter) {
+    ready.push_back(waiter);
+}
+
+/**
+ @brief defers work until every ready coroutine has run
+
+ @details used to batch: the first caller schedules one flush, later callers in the same round just add to what it will flush
+
+ @param work the work to run
+ */
+void Executor::whenIdle(function<void()> work) {
+    idleWork.push_back(std::move(work));
+}
+
+/**
+ @brief lets every other ready coroutine run before this one continues
+
+ @return (YieldAwaiter) the awaitable
+ */
+Executor::YieldAwaiter Executor::yield() {
+    return YieldAwaiter{*this};
+}
+
+/**
+ @brief suspends the caller for at least a delay
+
+ @param delay how long to sleep
+
+ @return (SleepAwaiter) the awaitable
+ */
+Executor::SleepAwaiter Executor::sleepFor(chrono::steady_clock::duration delay) {
+    return SleepAwaiter{*this, chrono::steady_clock::now() + delay};
+}
+
+/**
+ @brief suspends the caller until a point in time
+
+ @param when the time to wake at
+
+ @return (SleepAwaiter) the awaitable
+ */
+Executor::SleepAwaiter Executor::sleepUntil(chrono::steady_clock::time_point when) {
+    return SleepAwaiter{*this, when};
+}
+
+/**
+ @brief suspends the caller until a condition holds
+
+ @details the condition is checked on the loop's thread once per round, e.g. whether a background thread has finished
+
+ @param isReady the condition; must be cheap and safe to call from the loop's thread
+
+ @return (PollAwaiter) the awaitable
+ */
+Executor::PollAwaiter Executor::until(function<bool()> isReady) {
+    return PollAwaiter{*this, std::move(isReady)};
+}
+
+/**
+ @brief resumes ready coroutines and deferred work until there is none left
+
+ @return (size_t) the number of coroutines resumed
+ */
+size_t Executor::runReady() {
+    size_t resumed = 0;
+    while (true) {
+        while (!ready.empty()) {
+            coroutine_handle<> waiter = ready.front();
+            ready.pop_front();
+            waiter.resume();
+            resumed++;
+        }
+        if (idleWork.empty()) {
+            break;
+        }
+        deque<function<void()>> work;
+        work.swap(idleWork);
+        for (auto& step : work) {
+            step();
+        }
+    }
+    resumptions += resumed;
+    return resumed;
+}
+
+/**
+ @brief runs one round of the loop
+
+ @details runs everything ready, wakes due sleepers and satisfied pollers, and if that made nothing ready sleeps until the next timer or poll
+
+ @return (bool) true if anything is still pending, false once the loop has nothing left to do
+ */
+bool Executor::runOnce() {
+    runReady();
+
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    while (!timers.empty() && timers.top().when <= now) {
+        ready.push_back(timers.top().waiter);
+        timers.pop();
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < pollers.size(); i++) {
+        if (pollers[i].isReady()) {
+            ready.push_back(pollers[i].waiter);
+        } else {
+            pollers[kept++] = std::move(pollers[i]);
+        }
+    }
+    pollers.resize(kept);
+
+    if (!ready.empty()) {
+        return true;
+    }
+    if (timers.empty() && pollers.empty()) {
+        return false;
+    }
+
+    chrono::steady_clock::time_point wake = timers.empty() ? now + pollInterval : timers.top().when;
+    if (!pollers.empty() && now + pollInterval < wake) {
+        wake = now + pollInterval;
+    }
+    this_thread::sleep_until(wake);
+    return true;
+}
+
+/**
+ @brief runs the loop until nothing is ready, sleeping or polling
+
+ @details rethrows the first exception that escaped a spawned task
+ */
+void Executor::run() {
+    while (runOnce()) {
+    }
+    rethrowFirstError();
+}
+
+/**
+ @brief rethrows the first exception that escaped a spawned task, once
+ */
+void Executor::rethrowFirstError() {
+    if (firstError) {
+        rethrow_exception(std::exchange(firstError, nullptr));
+    }
+}
+
+/**
+ @brief gets the number of spawned tasks that haven't finished
+
+ @return (size_t) the in-flight task count
+ */
+size_t Executor::getLiveTaskCount() const {
+    return liveTasks;
+}
+
+/**
+ @brief gets the most spawned tasks that were in flight at once
+
+ @return (size_t) the peak in-flight task count
+ */
+size_t Executor::getPeakLiveTaskCount() const {
+    return peakLiveTasks;
+}
+
+/**
+ @brief gets the number of times the loop has resumed a coroutine
+
+ @return (unsigned long long) the resumption count
+ */
+unsigned long long Executor::getResumptionCount() const {
+    return resumptions;
+}
@@ -0,0 +1,196 @@
+//
+//  Executor.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include "Task.h"
+#include <coroutine>
+#include <deque>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ @brief single-threaded run loop for Task coroutines
+
+ @details everything runs on the thread that calls run: ready coroutines in FIFO order, then work deferred with whenIdle, then any sleeps that are due and background waits whose condition now holds. when nothing is ready the thread sleeps until the next timer or poll, so tens of thousands of suspended tasks cost only their frames. not thread-safe; other threads hand results back through state that an until() predicate polls
+ */
+class Executor {
+private:
+    struct Timer {
+        chrono::steady_clock::time_point when;
+        unsigned long long sequence;
+        coroutine_handle<> waiter;
+
+        bool operator>(const Timer& other) const {
+            return when != other.when ? when > other.when : sequence > other.sequence;
+        }
+    };
+
+    struct Poller {
+        function<bool()> isReady;
+        coroutine_handle<> waiter;
+    };
+
+    deque<coroutine_handle<>> ready;
+    deque<function<void()>> idleWork;
+    priority_queue<Timer, vector<Timer>, greater<Timer>> timers;
+    vector<Poller> pollers;
+    unsigned long long timerSequence;
+    chrono::milliseconds pollInterval;
+    size_t liveTasks;
+    size_t peakLiveTasks;
+    unsigned long long resumptions;
+    exception_ptr firstError;
+
+    // awaits a task without taking its result, so the owner can still read it
+    template <typename T>
+    struct Completion {
+        Task<T>& task;
+
+        bool await_ready() const noexcept {
+            return task.await_ready();
+        }
+
+        coroutine_handle<> await_suspend(coroutine_handle<> caller) noexcept {
+            return task.await_suspend(caller);
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    template <typename T>
+    Task<void> supervise(Task<T> task) {
+        try {
+            co_await task;
+        } catch (...) {
+            if (!firstError) {
+                firstError = current_exception();
+            }
+        }
+        liveTasks--;
+    }
+
+    template <typename T>
+    Task<void> signalWhenDone(Task<T>& task, bool& finished) {
+        co_await Completion<T>{task};
+        finished = true;
+    }
+
+public:
+    struct YieldAwaiter {
+        Executor& executor;
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(coroutine_handle<> waiter) {
+            executor.schedule(waiter);
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    struct SleepAwaiter {
+        Executor& executor;
+        chrono::steady_clock::time_point when;
+
+        bool await_ready() const noexcept {
+            return when <= chrono::steady_clock::now();
+        }
+
+        void await_suspend(coroutine_handle<> waiter) {
+            executor.timers.push({when, executor.timerSequence++, waiter});
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    struct PollAwaiter {
+        Executor& executor;
+        function<bool()> isReady;
+
+        bool await_ready() {
+            return isReady();
+        }
+
+        void await_suspend(coroutine_handle<> waiter) {
+            executor.pollers.push_back({std::move(isReady), waiter});
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    explicit Executor(chrono::milliseconds pollEvery = chrono::milliseconds(1));
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    void schedule(coroutine_handle<> waiter);
+    void whenIdle(function<void()> work);
+
+    YieldAwaiter yield();
+    SleepAwaiter sleepFor(chrono::steady_clock::duration delay);
+    SleepAwaiter sleepUntil(chrono::steady_clock::time_point when);
+    PollAwaiter until(function<bool()> isReady);
+
+    /**
+     @brief starts a task that runs on its own; its frame is freed when it finishes
+
+     @details an exception escaping the task is kept and rethrown by run
+
+     @param task the task to start
+     */
+    template <typename T>
+    void spawn(Task<T> task) {
+        liveTasks++;
+        if (liveTasks > peakLiveTasks) {
+            peakLiveTasks = liveTasks;
+        }
+        schedule(supervise(std::move(task)).detach());
+    }
+
+    /**
+     @brief runs the loop until one task finishes and returns its result
+
+     @details spawned tasks keep running alongside it and may still be pending on return
+
+     @param task the task to run
+
+     @return (T) what the task returned. its exception, or the first one from a spawned task, is rethrown
+     */
+    template <typename T>
+    T runUntilComplete(Task<T> task) {
+        bool finished = false;
+        schedule(signalWhenDone(task, finished).detach());
+        while (!finished && runOnce()) {
+        }
+        rethrowFirstError();
+        if (!finished) {
+            throw logic_error("task is waiting on something that will never happen");
+        }
+        return task.await_resume();
+    }
+
+    size_t runReady();
+    bool runOnce();
+    void run();
+    void rethrowFirstError();
+
+    size_t getLiveTaskCount() const;
+    size_t getPeakLiveTaskCount() const;
+    unsigned long long getResumptionCount() const;
+};
+
+#endif // EXECUTOR_H
@@ -0,0 +1,219 @@
+//
+//  IndexedHeap.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/5/25.
+//
+
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ @brief binary min-heap whose elements can be found, re-prioritized, and removed by key
+
+ @details keeps a key -> slot index next to the heap array so every operation is O(log n) and membership checks are O(1). the element with the smallest priority (according to Compare) is on top
+ */
+template <typename Key, typename Priority, typename Compare = less<Priority>>
+class IndexedHeap {
+private:
+    vector<pair<Key, Priority>> heap;
+    unordered_map<Key, size_t> positions;
+    Compare compare;
+
+    void place(size_t index, pair<Key, Priority> entry) {
+        positions[entry.first] = index;
+        heap[index] = std::move(entry);
+    }
+
+    void siftUp(size_t index) {
+        pair<Key, Priority> entry = std::move(heap[index]);
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            if (!compare(entry.second, heap[parent].second)) {
+                break;
+            }
+            place(index, std::move(heap[parent]));
+            index = parent;
+        }
+        place(index, std::move(entry));
+    }
+
+    void siftDown(size_t index) {
+        pair<Key, Priority> entry = std::move(heap[index]);
+        size_t count = heap.size();
+        while (true) {
+            size_t child = 2 * index + 1;
+            if (child >= count) {
+                break;
+            }
+            if (child + 1 < count && compare(heap[child + 1].second, heap[child].second)) {
+                child++;
+            }
+            if (!compare(heap[child].second, entry.second)) {
+                break;
+            }
+            place(index, std::move(heap[child]));
+            index = child;
+        }
+        place(index, std::move(entry));
+    }
+
+    void removeAt(size_t index) {
+        positions.erase(heap[index].first);
+        size_t last = heap.size() - 1;
+        if (index == last) {
+            heap.pop_back();
+            return;
+        }
+        Key moved = heap[last].first;
+        place(index, std::move(heap[last]));
+        heap.pop_back();
+        siftDown(index);
+        siftUp(positions[moved]);
+    }
+
+public:
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    size_t capacity() const { return heap.capacity(); }
+    size_t bucketCount() const { return positions.bucket_count(); }
+    bool contains(const Key& key) const { return positions.find(key) != positions.end(); }
+
+    const Key& topKey() const { return heap.front().first; }
+    const Priority& topPriority() const { return heap.front().second; }
+
+    /**
+     @brief inserts a key with the given priority
+
+     @return (bool) true if inserted, false if the key is already present
+     */
+    bool push(const Key& key, const Priority& priority) {
+        if (contains(key)) {
+            return false;
+        }
+        heap.emplace_back(key, priority);
+        positions[key] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+        return true;
+    }
+
+    /**
+     @brief removes and returns the key with the smallest priority
+
+     @details the heap must not be empty
+     */
+    Key pop() {
+        Key key = heap.front().first;
+        removeAt(0);
+        return key;
+    }
+
+    /**
+     @brief removes an arbitrary key
+
+     @return (bool) true if the key was present
+     */
+    bool erase(const Key& key) {
+        auto iter = positions.find(key);
+        if (iter == positions.end()) {
+            return false;
+        }
+        removeAt(iter->second);
+        return true;
+    }
+
+    /**
+     @brief changes the priority of a key already in the heap
+
+     @return (bool) true if the key was present
+     */
+    bool update(const Key& key, const Priority& priority) {
+        auto iter = positions.find(key);
+        if (iter == positions.end()) {
+            return false;
+        }
+        size_t index = iter->second;
+        heap[index].second = priority;
+        siftUp(index);
+        siftDown(positions[key]);
+        return true;
+    }
+
+    /**
+     @brief returns the priority of a key
+
+     @details the key must be present
+     */
+    const Priority& priorityOf(const Key& key) const {
+        return heap[positions.at(key)].second;
+    }
+
+    /**
+     @brief calls visit(key) for every key in pop order without changing the heap
+
+     @details walks the heap best-first, keeping only the slot indices of the next candidates, so no keys are copied and
+     nothing is sorted. O(n log n); the heap must not change during the walk
+     */
+    template <typename Visitor>
+    void forEachInOrder(Visitor&& visit) const {
+        if (heap.empty()) {
+            return;
+        }
+        auto later = [this](size_t a, size_t b) {
+            return compare(heap[b].second, heap[a].second);
+        };
+        vector<size_t> frontier(1, 0);
+        while (!frontier.empty()) {
+            pop_heap(frontier.begin(), frontier.end(), later);
+            size_t index = frontier.back();
+            frontier.pop_back();
+            visit(heap[index].first);
+            for (size_t child = 2 * index + 1; child <= 2 * index + 2 && child < heap.size(); child++) {
+                frontier.push_back(child);
+                push_heap(frontier.begin(), frontier.end(), later);
+            }
+        }
+    }
+
+    /**
+     @brief calls visit(key) for every key in heap order (not pop order)
+
+     @details allocates nothing; use forEachInOrder when pop order matters
+     */
+    template <typename Visitor>
+    void forEachKey(Visitor&& visit) const {
+        for (const auto& entry : heap) {
+            visit(entry.first);
+        }
+    }
+
+    /**
+     @brief replaces every priority with priorityFor(key, priority) and restores the heap
+
+     @details O(n): priorities are rewritten in place and the heap rebuilt bottom-up, instead of one update per key
+     */
+    template <typename Reprioritize>
+    void reprioritize(Reprioritize&& priorityFor) {
+        for (auto& entry : heap) {
+            entry.second = priorityFor(entry.first, entry.second);
+        }
+        for (size_t index = heap.size() / 2; index-- > 0;) {
+            siftDown(index);
+        }
+    }
+
+    void clear() {
+        heap.clear();
+        positions.clear();
+    }
+};
+
+#endif // INDEXED_HEAP_H
@@ -0,0 +1,206 @@
+//
+//  LoadClient.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/8/25.
+//
+
+#include "Protocol.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <algorithm>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+struct WorkerStats {
+    unsigned long long completed = 0;
+    unsigned long long failed = 0;
+    vector<double> latenciesMicros;
+};
+
+/**
+ @brief sends a whole buffer on a blocking socket
+
+ @param fd the socket
+ @param buffer the bytes to send
+
+ @return (bool) true if everything was sent
+ */
+bool sendAll(int fd, const string& buffer) {
+    size_t offset = 0;
+    while (offset < buffer.size()) {
+        ssize_t sent = send(fd, buffer.data() + offset, buffer.size() - offset, 0);
+        if (sent <= 0) {
+            return false;
+        }
+        offset += sent;
+    }
+    return true;
+}
+
+/**
+ @brief runs a list of commands on one connection, keeping up to `pipeline` requests in flight
+
+ @param fd the connected socket
+ @param commands the command lines to send
+ @param pipeline maximum number of unanswered requests
+ @param stats receives counts and per-request latencies
+
+ @return (bool) true if every response was received
+ */
+bool runCommands(int fd, const vector<string>& commands, size_t pipeline, WorkerStats& stats) {
+    deque<Clock::time_point> inFlight;
+    string outgoing;
+    string incoming;
+    size_t incomingOffset = 0;
+    size_t next = 0;
+    char chunk[65536];
+    string payload;
+
+    while (next < commands.size() || !inFlight.empty()) {
+        outgoing.clear();
+        while (next < commands.size() && inFlight.size() < pipeline) {
+            appendFrame(outgoing, commands[next++]);
+            inFlight.push_back(Clock::now());
+        }
+        if (!outgoing.empty() && !sendAll(fd, outgoing)) {
+            return false;
+        }
+
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return false;
+        }
+        incoming.append(chunk, received);
+
+        while (extractFrame(incoming, incomingOffset, payload) == FrameStatus::Complete) {
+            Clock::time_point now = Clock::now();
+            stats.latenciesMicros.push_back(chrono::duration<double, micro>(now - inFlight.front()).count());
+            inFlight.pop_front();
+            stats.completed++;
+            if (payload.empty() || payload[0] != STATUS_OK) {
+                stats.failed++;
+            }
+        }
+        if (incomingOffset == incoming.size()) {
+            incoming.clear();
+            incomingOffset = 0;
+        }
+    }
+    return true;
+}
+
+/**
+ @brief returns a percentile of a sorted list
+
+ @param sorted values in ascending order
+ @param fraction the percentile as a fraction (0.99 for p99)
+
+ @return (double) the value at that percentile
+ */
+double percentile(const vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1));
+    return sorted[index];
+}
+
+/**
+ @brief load generator for `university_system --serve`
+
+ @details usage: university_loadgen <address> [connections] [requests] [pipeline]. creates its own students and courses (prefixed LG), then sends a random ENROLL / DROP mix from every connection and reports requests per second and latency percentiles
+ */
+int main(int argc, const char * argv[]) {
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " <address> [connections=8] [requests=200000] [pipeline=32]" << endl;
+        return 1;
+    }
+    string address = argv[1];
+    size_t connections = argc > 2 ? stoul(argv[2]) : 8;
+    size_t totalRequests = argc > 3 ? stoul(argv[3]) : 200000;
+    size_t pipeline = argc > 4 ? stoul(argv[4]) : 32;
+    const int studentCount = 10000;
+    const int courseCount = 200;
+
+    int setupFd = connectToServer(address);
+    if (setupFd < 0) {
+        cout << "Error: Could not connect to " << address << endl;
+        return 1;
+    }
+    vector<string> setup;
+    for (int i = 0; i < courseCount; i++) {
+        setup.push_back("ADD_COURSE,LGC" + to_string(i) + ",Load Course " + to_string(i) + ",Dr. Load,50");
+    }
+    for (int i = 0; i < studentCount; i++) {
+        setup.push_back("ADD_STUDENT,LGS" + to_string(i) + ",Load Student " + to_string(i));
+    }
+    WorkerStats setupStats;
+    if (!runCommands(setupFd, setup, 256, setupStats)) {
+        cout << "Error: Setup failed" << endl;
+        return 1;
+    }
+    close(setupFd);
+
+    vector<WorkerStats> stats(connections);
+    vector<thread> workers;
+    atomic<bool> allConnected(true);
+    Clock::time_point start = Clock::now();
+    for (size_t w = 0; w < connections; w++) {
+        workers.emplace_back([&, w]() {
+            mt19937 rng(static_cast<unsigned>(w + 1));
+            uniform_int_distribution<int> pickStudent(0, studentCount - 1);
+            uniform_int_distribution<int> pickCourse(0, courseCount - 1);
+            vector<string> commands;
+            size_t share = totalRequests / connections + (w < totalRequests % connections ? 1 : 0);
+            for (size_t i = 0; i < share; i++) {
+                string verb = (rng() % 2 == 0) ? "ENROLL,LGS" : "DROP,LGS";
+                commands.push_back(verb + to_string(pickStudent(rng)) + ",LGC" + to_string(pickCourse(rng)));
+            }
+
+            int fd = connectToServer(address);
+            if (fd < 0 || !runCommands(fd, commands, pipeline, stats[w])) {
+                allConnected = false;
+            }
+            if (fd >= 0) {
+                close(fd);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<double> latencies;
+    unsigned long long completed = 0;
+    unsigned long long failed = 0;
+    for (const auto& stat : stats) {
+        completed += stat.completed;
+        failed += stat.failed;
+        latencies.insert(latencies.end(), stat.latenciesMicros.begin(), stat.latenciesMicros.end());
+    }
+    sort(latencies.begin(), latencies.end());
+
+    cout << fixed << setprecision(1);
+    cout << "Connections: " << connections << " | Pipeline: " << pipeline << endl;
+    cout << "Requests: " << completed << " (" << failed << " rejected by the system, e.g. full or not enrolled)" << endl;
+    cout << "Elapsed: " << seconds << " s" << endl;
+    cout << "Throughput: " << (completed / seconds) << " requests/sec" << endl;
+    cout << "Latency (us): p50 " << percentile(latencies, 0.50) << " | p99 " << percentile(latencies, 0.99) << " | max " << (latencies.empty() ? 0.0 : latencies.back()) << endl;
+    if (!allConnected) {
+        cout << "Warning: some connections failed before finishing" << endl;
+        return 1;
+    }
+    return 0;
+}
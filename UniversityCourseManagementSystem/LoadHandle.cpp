@@ -0,0 +1,143 @@
+//
+//  LoadHandle.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/4/25.
+//
+
+#include "LoadHandle.h"
+#include "UniversitySystem.h"
+
+/**
+ @brief default constructor for a LoadRecord
+
+ @details initializes an empty record with line number 0 and a valid capacity
+ */
+LoadRecord::LoadRecord() {
+    lineNumber = 0;
+    invalidCapacity = false;
+}
+
+/**
+ @brief constructs a handle for a background load of the given file
+
+ @details all progress counters start at zero. the worker thread is started by UniversitySystem::loadFromFileAsync
+
+ @param file the path of the file being loaded
+ */
+LoadHandle::LoadHandle(const string& file) : fileName(file), bytesRead(0), totalBytes(0), linesRead(0), errorCount(0), cancelRequested(false), done(false), opened(false), baseVersion(0) {}
+
+/**
+ @brief destroys the handle
+
+ @details requests cancellation and waits for the worker thread so it never outlives the staged system it writes to
+ */
+LoadHandle::~LoadHandle() {
+    cancel();
+    wait();
+}
+
+/**
+ @brief returns the file being loaded
+
+ @return (string) the file path
+ */
+string LoadHandle::getFileName() const {
+    return fileName;
+}
+
+/**
+ @brief returns the number of bytes consumed so far
+
+ @return (uint64_t) bytes read from the file
+ */
+uint64_t LoadHandle::getBytesRead() const {
+    return bytesRead.load(memory_order_relaxed);
+}
+
+/**
+ @brief returns the total size of the file
+
+ @return (uint64_t) file size in bytes, or 0 if it is not known yet
+ */
+uint64_t LoadHandle::getTotalBytes() const {
+    return totalBytes.load(memory_order_relaxed);
+}
+
+/**
+ @brief returns the number of lines read so far
+
+ @return (int) lines read, including comments and blank lines
+ */
+int LoadHandle::getLinesRead() const {
+    return linesRead.load(memory_order_relaxed);
+}
+
+/**
+ @brief returns the number of lines that could not be applied
+
+ @return (int) parse and apply errors seen so far
+ */
+int LoadHandle::getErrorCount() const {
+    return errorCount.load(memory_order_relaxed);
+}
+
+/**
+ @brief returns how far through the file the load is
+
+ @return (double) percentage between 0 and 100
+ */
+double LoadHandle::getProgressPercent() const {
+    uint64_t total = getTotalBytes();
+    if (total == 0) {
+        return isDone() ? 100.0 : 0.0;
+    }
+    return 100.0 * static_cast<double>(getBytesRead()) / static_cast<double>(total);
+}
+
+/**
+ @brief checks if the worker thread has finished
+
+ @return (bool) true once the staged system is ready (or the load was cancelled / failed to open)
+ */
+bool LoadHandle::isDone() const {
+    return done.load(memory_order_acquire);
+}
+
+/**
+ @brief checks if cancellation was requested
+
+ @return (bool) true if cancel() has been called
+ */
+bool LoadHandle::isCancelled() const {
+    return cancelRequested.load(memory_order_relaxed);
+}
+
+/**
+ @brief checks if the file could be opened
+
+ @details only meaningful once isDone() returns true
+
+ @return (bool) true if the file was opened
+ */
+bool LoadHandle::wasOpened() const {
+    return opened.load(memory_order_acquire);
+}
+
+/**
+ @brief requests that the worker stop at the next line
+
+ @details a cancelled load never changes the live system
+ */
+void LoadHandle::cancel() {
+    cancelRequested.store(true, memory_order_relaxed);
+}
+
+/**
+ @brief blocks until the worker thread finishes
+ */
+void LoadHandle::wait() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  LoadHandle.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/4/25.
+//
+
+#ifndef LOAD_HANDLE_H
+#define LOAD_HANDLE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <sstream>
+#include <cstdint>
+
+using namespace std;
+
+class UniversitySystem;
+
+struct LoadRecord {
+    string command;
+    vector<string> fields;
+    int lineNumber;
+    bool invalidCapacity;
+
+    LoadRecord();
+};
+
+class LoadHandle {
+    friend class UniversitySystem;
+private:
+    string fileName;
+    atomic<uint64_t> bytesRead;
+    atomic<uint64_t> totalBytes;
+    atomic<int> linesRead;
+    atomic<int> errorCount;
+    atomic<bool> cancelRequested;
+    atomic<bool> done;
+    atomic<bool> opened;
+
+    unique_ptr<UniversitySystem> staged;
+    unsigned long long baseVersion;
+    ostringstream messages;
+    thread worker;
+
+public:
+    explicit LoadHandle(const string& file);
+    ~LoadHandle();
+
+    LoadHandle(const LoadHandle&) = delete;
+    LoadHandle& operator=(const LoadHandle&) = delete;
+
+    string getFileName() const;
+    uint64_t getBytesRead() const;
+    uint64_t getTotalBytes() const;
+    int getLinesRead() const;
+    int getErrorCount() const;
+    double getProgressPercent() const;
+
+    bool isDone() const;
+    bool isCancelled() const;
+    bool wasOpened() const;
+
+    void cancel();
+    void wait();
+};
+
+#endif // LOAD_HANDLE_H
@@ -0,0 +1,129 @@
+//
+//  LotteryBench.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "UniversitySystem.h"
+#include "SeatLottery.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+/**
+ @brief builds a term with every student and course but no enrollments
+
+ @param system the term to fill
+ @param studentCount the number of students
+ @param courseCount the number of courses
+ @param capacity seats per course
+ */
+void buildTerm(UniversitySystem& system, int studentCount, int courseCount, int capacity) {
+    for (int c = 0; c < courseCount; c++) {
+        system.addCourse("C" + to_string(c), "Course " + to_string(c), "Dr. Instructor " + to_string(c % 97), capacity);
+    }
+    for (int s = 0; s < studentCount; s++) {
+        system.addStudent("S" + to_string(s), "Student Number " + to_string(s));
+    }
+}
+
+/**
+ @brief counts the students enrolled in their first choice
+
+ @param system the term
+ @param choices every student's ranked course codes
+
+ @return (int) the count
+ */
+int firstChoicesMet(const UniversitySystem& system, const vector<vector<string>>& choices) {
+    int met = 0;
+    for (size_t s = 0; s < choices.size(); s++) {
+        const Course* course = system.findCourse(choices[s].front());
+        met += course != nullptr && course->isStudentEnrolled("S" + to_string(s)) ? 1 : 0;
+    }
+    return met;
+}
+
+int main(int argc, const char * argv[]) {
+    int studentCount = argc > 1 ? stoi(argv[1]) : 50000;
+    int perStudent = argc > 2 ? stoi(argv[2]) : 5;
+    int courseCount = argc > 3 ? stoi(argv[3]) : 4000;
+    int capacity = argc > 4 ? stoi(argv[4]) : 50;
+    unsigned long long seed = argc > 5 ? stoull(argv[5]) : 2025;
+
+    // popularity is skewed towards low course numbers, so the popular courses are oversubscribed
+    mt19937_64 generator(seed);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    vector<vector<string>> choices(studentCount);
+    for (auto& ranked : choices) {
+        while (static_cast<int>(ranked.size()) < min(perStudent, courseCount)) {
+            double u = uniform(generator);
+            string courseCode = "C" + to_string(static_cast<int>(u * u * courseCount));
+            if (find(ranked.begin(), ranked.end(), courseCode) == ranked.end()) {
+                ranked.push_back(courseCode);
+            }
+        }
+    }
+    cout << "Students: " << studentCount << " | Choices each: " << perStudent << " | Courses: " << courseCount << " | Seats: " << courseCount * capacity << endl;
+    cout << fixed << setprecision(1);
+
+    ostream discard(nullptr);
+    {
+        UniversitySystem system;
+        system.setOutputStream(discard);
+        buildTerm(system, studentCount, courseCount, capacity);
+        Clock::time_point start = Clock::now();
+        for (int s = 0; s < studentCount; s++) {
+            for (const auto& courseCode : choices[s]) {
+                system.enrollStudentInCourse("S" + to_string(s), courseCode);
+            }
+        }
+        double millis = chrono::duration<double, milli>(Clock::now() - start).count();
+        cout << left << setw(24) << "first come" << right << setw(10) << millis << " ms | first choice met: " << firstChoicesMet(system, choices) << endl;
+    }
+
+    {
+        UniversitySystem system;
+        system.setOutputStream(discard);
+        buildTerm(system, studentCount, courseCount, capacity);
+        Clock::time_point start = Clock::now();
+        for (int s = 0; s < studentCount; s++) {
+            system.submitPreferences("S" + to_string(s), choices[s]);
+        }
+        double submitMillis = chrono::duration<double, milli>(Clock::now() - start).count();
+        start = Clock::now();
+        LotteryStats stats = system.closeRegistrationWindow(seed);
+        double closeMillis = chrono::duration<double, milli>(Clock::now() - start).count();
+        cout << left << setw(24) << "lottery submit" << right << setw(10) << submitMillis << " ms" << endl;
+        cout << left << setw(24) << "lottery close" << right << setw(10) << closeMillis << " ms | first choice met: " << firstChoicesMet(system, choices) << endl;
+        cout << "  proposals: " << stats.proposals << " | seats assigned: " << stats.seatsAssigned << " | enrolled: " << stats.enrolled
+             << " | waitlisted: " << stats.waitlisted << endl;
+    }
+
+    {
+        // the matching alone, without building or applying anything
+        SeatLottery lottery;
+        for (int c = 0; c < courseCount; c++) {
+            lottery.addCourse(capacity);
+        }
+        for (int s = 0; s < studentCount; s++) {
+            lottery.addStudent(perStudent);
+            for (const auto& courseCode : choices[s]) {
+                lottery.addChoice(static_cast<uint32_t>(stoi(courseCode.substr(1))), 0);
+            }
+        }
+        Clock::time_point start = Clock::now();
+        LotteryStats stats = lottery.run(seed);
+        double millis = chrono::duration<double, milli>(Clock::now() - start).count();
+        cout << left << setw(24) << "matching only" << right << setw(10) << millis << " ms | proposals: " << stats.proposals << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+//
+//  MemoryCheck.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "UniversitySystem.h"
+#include "MemoryReport.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <new>
+#include <memory>
+#include <cstdlib>
+
+using namespace std;
+
+/**
+ @brief an over-aligned type, so new and delete take the aligned overloads
+ */
+struct alignas(64) AlignedBlock {
+    char bytes[64];
+};
+
+/**
+ @brief allocates and frees through every kind of operator new and checks the counter comes back to where it started
+
+ @return (bool) true if the counted heap is unchanged after every pair
+ */
+bool checkOverloads() {
+    size_t baseline = MemoryReport::getCountedHeapBytes();
+    bool ok = true;
+
+    delete new int(1);
+    delete[] new int[16];
+    ok = ok && MemoryReport::getCountedHeapBytes() == baseline;
+
+    int* single = new (nothrow) int(2);
+    int* array = new (nothrow) int[16];
+    ok = ok && single && array && MemoryReport::getCountedHeapBytes() == baseline + sizeof(int) * 17;
+    ::operator delete(single, nothrow);
+    ::operator delete[](array, nothrow);
+    ok = ok && MemoryReport::getCountedHeapBytes() == baseline;
+
+    AlignedBlock* block = new AlignedBlock();
+    AlignedBlock* blocks = new AlignedBlock[4];
+    ok = ok && reinterpret_cast<uintptr_t>(block) % alignof(AlignedBlock) == 0 && reinterpret_cast<uintptr_t>(blocks) % alignof(AlignedBlock) == 0;
+    delete block;
+    delete[] blocks;
+    ok = ok && MemoryReport::getCountedHeapBytes() == baseline;
+
+    AlignedBlock* quiet = new (nothrow) AlignedBlock();
+    ok = ok && quiet && reinterpret_cast<uintptr_t>(quiet) % alignof(AlignedBlock) == 0;
+    ::operator delete(quiet, align_val_t(alignof(AlignedBlock)), nothrow);
+    void* sized = ::operator new[](100, align_val_t(128));
+    ok = ok && reinterpret_cast<uintptr_t>(sized) % 128 == 0;
+    ::operator delete[](sized, 100, align_val_t(128));
+    ok = ok && MemoryReport::getCountedHeapBytes() == baseline;
+    return ok;
+}
+
+int main(int argc, const char * argv[]) {
+    if (!MemoryReport::isCountingAllocations()) {
+        cerr << "Error: build with -DCOUNT_ALLOCATIONS to check the memory report" << endl;
+        return 1;
+    }
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <data file> [tolerance percent]" << endl;
+        return 1;
+    }
+    double tolerance = argc > 2 ? stod(argv[2]) : 5.0;
+
+    bool overloads = checkOverloads();
+    cout << "every operator new/delete pair balances: " << (overloads ? "yes" : "NO") << endl;
+
+    // a first load allocates the library's and the loader's one-time statics, which are never freed
+    ostream discard(nullptr);
+    {
+        UniversitySystem warmup;
+        warmup.setOutputStream(discard);
+        warmup.loadFromFile(argv[1]);
+    }
+
+    // the empty system's own allocations are not structures the report attributes, so they are measured first
+    size_t baseline = MemoryReport::getCountedHeapBytes();
+    unique_ptr<UniversitySystem> system = make_unique<UniversitySystem>();
+    system->setOutputStream(discard);
+    size_t empty = MemoryReport::getCountedHeapBytes();
+    size_t emptyEstimate = system->memoryReport().getTotalBytes();
+    bool loaded = system->loadFromFile(argv[1]);
+    size_t counted = MemoryReport::getCountedHeapBytes() - empty;
+    size_t estimated = system->memoryReport().getTotalBytes() - emptyEstimate;
+    double difference = counted == 0 ? 0 : 100.0 * (static_cast<double>(estimated) - static_cast<double>(counted)) / static_cast<double>(counted);
+    bool close = loaded && (difference < 0 ? -difference : difference) <= tolerance;
+    cout << fixed << setprecision(1);
+    cout << "loaded " << argv[1] << ": " << (loaded ? "yes" : "NO") << endl;
+    cout << "  counted live bytes:  " << setw(10) << counted << endl;
+    cout << "  estimated bytes:     " << setw(10) << estimated << " (" << showpos << difference << noshowpos << "%, allowed " << tolerance << "%)" << endl;
+
+    system.reset();
+    bool released = MemoryReport::getCountedHeapBytes() == baseline;
+    cout << "everything freed with the system:        " << (released ? "yes" : "NO") << endl;
+    return overloads && close && released ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+//
+//  MemoryReport.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/10/25.
+//
+
+#include "MemoryReport.h"
+#include <iomanip>
+
+#ifdef COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*
+ counting allocator mode: build with -DCOUNT_ALLOCATIONS to replace every replaceable global operator new/delete (plain,
+ array, nothrow, aligned and sized). every block carries a header whose last word holds its size so frees can be
+ subtracted, giving exact live and peak heap numbers to check the estimates against. over-aligned blocks get a header
+ as large as their alignment so the pointer handed out keeps it
+ */
+static atomic<size_t> countedBytes(0);
+static atomic<size_t> countedPeak(0);
+static atomic<size_t> countedAllocations(0);
+static const size_t ALLOCATION_HEADER = alignof(max_align_t) > sizeof(size_t) ? alignof(max_align_t) : sizeof(size_t);
+
+static size_t headerBytes(size_t alignment) {
+    return alignment > ALLOCATION_HEADER ? alignment : ALLOCATION_HEADER;
+}
+
+static void* countedAllocate(size_t size, size_t alignment, bool throwOnFailure) {
+    size_t header = headerBytes(alignment);
+    void* block;
+    if (alignment <= alignof(max_align_t)) {
+        block = malloc(size + header);
+    } else {
+        // aligned_alloc wants a size that is a multiple of the alignment
+        block = aligned_alloc(alignment, (size + header + alignment - 1) / alignment * alignment);
+    }
+    if (block == nullptr) {
+        if (throwOnFailure) {
+            throw bad_alloc();
+        }
+        return nullptr;
+    }
+    char* pointer = static_cast<char*>(block) + header;
+    *reinterpret_cast<size_t*>(pointer - sizeof(size_t)) = size;
+    size_t now = countedBytes.fetch_add(size) + size;
+    size_t peak = countedPeak.load();
+    while (now > peak && !countedPeak.compare_exchange_weak(peak, now)) {
+    }
+    countedAllocations++;
+    return pointer;
+}
+
+static void countedFree(void* pointer, size_t alignment) {
+    if (pointer == nullptr) {
+        return;
+    }
+    char* bytes = static_cast<char*>(pointer);
+    countedBytes.fetch_sub(*reinterpret_cast<size_t*>(bytes - sizeof(size_t)));
+    free(bytes - headerBytes(alignment));
+}
+
+static const size_t PLAIN = alignof(max_align_t);
+
+void* operator new(size_t size) { return countedAllocate(size, PLAIN, true); }
+void* operator new[](size_t size) { return countedAllocate(size, PLAIN, true); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return countedAllocate(size, PLAIN, false); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return countedAllocate(size, PLAIN, false); }
+void* operator new(size_t size, align_val_t alignment) { return countedAllocate(size, static_cast<size_t>(alignment), true); }
+void* operator new[](size_t size, align_val_t alignment) { return countedAllocate(size, static_cast<size_t>(alignment), true); }
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept { return countedAllocate(size, static_cast<size_t>(alignment), false); }
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept { return countedAllocate(size, static_cast<size_t>(alignment), false); }
+
+void operator delete(void* pointer) noexcept { countedFree(pointer, PLAIN); }
+void operator delete[](void* pointer) noexcept { countedFree(pointer, PLAIN); }
+void operator delete(void* pointer, size_t) noexcept { countedFree(pointer, PLAIN); }
+void operator delete[](void* pointer, size_t) noexcept { countedFree(pointer, PLAIN); }
+void operator delete(void* pointer, const nothrow_t&) noexcept { countedFree(pointer, PLAIN); }
+void operator delete[](void* pointer, const nothrow_t&) noexcept { countedFree(pointer, PLAIN); }
+void operator delete(void* pointer, align_val_t alignment) noexcept { countedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete[](void* pointer, align_val_t alignment) noexcept { countedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete(void* pointer, size_t, align_val_t alignment) noexcept { countedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete[](void* pointer, size_t, align_val_t alignment) noexcept { countedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete(void* pointer, align_val_t alignment, const nothrow_t&) noexcept { countedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete[](void* pointer, align_val_t alignment, const nothrow_t&) noexcept { countedFree(pointer, static_cast<size_t>(alignment)); }
+#endif
+
+/**
+ @brief constructs an empty MemoryUsage
+ */
+MemoryUsage::MemoryUsage() {
+    elements = 0;
+    nodeBytes = 0;
+    stringBytes = 0;
+    capacityBytes = 0;
+}
+
+/**
+ @brief constructs an empty MemoryUsage for a named structure
+
+ @param name the structure the bytes belong to
+ */
+MemoryUsage::MemoryUsage(const string& name) : MemoryUsage() {
+    structure = name;
+}
+
+/**
+ @brief gets all bytes attributed to the structure
+
+ @return (size_t) node, string and capacity bytes together
+ */
+size_t MemoryUsage::getTotalBytes() const {
+    return nodeBytes + stringBytes + capacityBytes;
+}
+
+/**
+ @brief adds a row for a structure
+
+ @param structure the name of the structure
+
+ @return (MemoryUsage&) the new row, to be filled in by the caller
+ */
+MemoryUsage& MemoryReport::add(const string& structure) {
+    rows.emplace_back(structure);
+    return rows.back();
+}
+
+/**
+ @brief gets every row of the report
+
+ @return (const deque<MemoryUsage>&) the rows in the order they were added. rows never move, so references returned by add stay valid
+ */
+const deque<MemoryUsage>& MemoryReport::getRows() const {
+    return rows;
+}
+
+/**
+ @brief gets the bytes attributed to every structure
+
+ @return (size_t) the sum of all rows
+ */
+size_t MemoryReport::getTotalBytes() const {
+    size_t total = 0;
+    for (const auto& row : rows) {
+        total += row.getTotalBytes();
+    }
+    return total;
+}
+
+/**
+ @brief prints the report as a table
+
+ @details when built with COUNT_ALLOCATIONS the exact heap numbers are printed below the estimates
+
+ @param os the stream to print to
+ */
+void MemoryReport::display(ostream& os) const {
+    os << left << setw(24) << "Structure" << right << setw(10) << "Elements" << setw(12) << "Nodes" << setw(12) << "Strings"
+       << setw(12) << "Capacity" << setw(12) << "Total" << endl;
+    for (const auto& row : rows) {
+        os << left << setw(24) << row.structure << right << setw(10) << row.elements << setw(12) << row.nodeBytes
+           << setw(12) << row.stringBytes << setw(12) << row.capacityBytes << setw(12) << row.getTotalBytes() << endl;
+    }
+    os << left << setw(80) << "Estimated total (bytes)" << right << setw(12) << getTotalBytes() << endl;
+    if (isCountingAllocations()) {
+        os << "Counted heap in use: " << getCountedHeapBytes() << " bytes (peak " << getCountedPeakBytes() << ", "
+           << getCountedAllocations() << " allocations)" << endl;
+    }
+    os << left;
+}
+
+/**
+ @brief checks if the counting allocator is compiled in
+
+ @return (bool) true when built with COUNT_ALLOCATIONS, false otherwise
+ */
+bool MemoryReport::isCountingAllocations() {
+#ifdef COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ @brief gets the exact number of heap bytes currently allocated by the process
+
+ @return (size_t) the live bytes, or 0 when the counting allocator is not compiled in
+ */
+size_t MemoryReport::getCountedHeapBytes() {
+#ifdef COUNT_ALLOCATIONS
+    return countedBytes.load();
+#else
+    return 0;
+#endif
+}
+
+/**
+ @brief gets the largest number of heap bytes allocated at once
+
+ @return (size_t) the peak bytes, or 0 when the counting allocator is not compiled in
+ */
+size_t MemoryReport::getCountedPeakBytes() {
+#ifdef COUNT_ALLOCATIONS
+    return countedPeak.load();
+#else
+    return 0;
+#endif
+}
+
+/**
+ @brief gets the number of allocations made so far
+
+ @return (size_t) the allocation count, or 0 when the counting allocator is not compiled in
+ */
+size_t MemoryReport::getCountedAllocations() {
+#ifdef COUNT_ALLOCATIONS
+    return countedAllocations.load();
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,107 @@
+//
+//  MemoryReport.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/10/25.
+//
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include <string>
+#include <deque>
+#include <iostream>
+#include <cstddef>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ @brief bytes attributed to one data structure
+
+ @details nodeBytes is the per-element allocation of node-based containers (tree or hash nodes including their bookkeeping pointers), stringBytes the heap buffers of strings too long for the small-string buffer, and capacityBytes contiguous storage such as vectors, deque chunks and hash bucket arrays, including unused capacity
+ */
+struct MemoryUsage {
+    string structure;
+    size_t elements;
+    size_t nodeBytes;
+    size_t stringBytes;
+    size_t capacityBytes;
+
+    MemoryUsage();
+    explicit MemoryUsage(const string& name);
+
+    size_t getTotalBytes() const;
+};
+
+class MemoryReport {
+private:
+    deque<MemoryUsage> rows;
+
+public:
+    MemoryUsage& add(const string& structure);
+
+    const deque<MemoryUsage>& getRows() const;
+    size_t getTotalBytes() const;
+    void display(ostream& os = cout) const;
+
+    static bool isCountingAllocations();
+    static size_t getCountedHeapBytes();
+    static size_t getCountedPeakBytes();
+    static size_t getCountedAllocations();
+};
+
+/** bookkeeping of one red-black tree node (color, parent, left, right) in front of its value */
+const size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+
+/** bookkeeping of one hash node (next pointer and cached hash) in front of its value */
+const size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+
+/**
+ @brief heap bytes owned by a string
+
+ @return (size_t) 0 while the text fits the small-string buffer, otherwise the allocated capacity plus the terminator
+ */
+inline size_t stringHeapBytes(const string& text) {
+    static const size_t inlineCapacity = string().capacity();
+    return text.capacity() > inlineCapacity ? text.capacity() + 1 : 0;
+}
+
+/**
+ @brief node bytes of a map or set, not counting heap owned by the values
+ */
+template <typename Tree>
+size_t treeNodeBytes(const Tree& tree) {
+    return tree.size() * (TREE_NODE_OVERHEAD + sizeof(typename Tree::value_type));
+}
+
+/**
+ @brief node bytes of an unordered_map or unordered_set, not counting the bucket array
+ */
+template <typename Table>
+size_t hashNodeBytes(const Table& table) {
+    return table.size() * (HASH_NODE_OVERHEAD + sizeof(typename Table::value_type));
+}
+
+/**
+ @brief bytes of the bucket array of an unordered_map or unordered_set
+ */
+template <typename Table>
+size_t hashBucketBytes(const Table& table) {
+    return table.bucket_count() * sizeof(void*);
+}
+
+/**
+ @brief bytes of the chunks and chunk map of a deque
+
+ @details assumes the common layout of 512-byte chunks (or one element per chunk for larger elements) and a chunk map of at least eight pointers
+ */
+template <typename Deque>
+size_t dequeBytes(const Deque& items) {
+    const size_t elementSize = sizeof(typename Deque::value_type);
+    const size_t perChunk = elementSize < 512 ? 512 / elementSize : 1;
+    const size_t chunks = items.size() / perChunk + 1;
+    return chunks * perChunk * elementSize + max<size_t>(8, chunks + 2) * sizeof(void*);
+}
+
+#endif // MEMORY_REPORT_H
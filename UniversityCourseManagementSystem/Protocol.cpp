@@ -0,0 +1,168 @@
+//
+//  Protocol.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/8/25.
+//
+
+#include "Protocol.h"
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+/**
+ @brief appends a length-prefixed frame to a buffer
+
+ @param buffer the buffer to append to
+ @param payload the frame contents
+ */
+void appendFrame(string& buffer, const string& payload) {
+    uint32_t length = static_cast<uint32_t>(payload.size());
+    buffer.push_back(static_cast<char>((length >> 24) & 0xFF));
+    buffer.push_back(static_cast<char>((length >> 16) & 0xFF));
+    buffer.push_back(static_cast<char>((length >> 8) & 0xFF));
+    buffer.push_back(static_cast<char>(length & 0xFF));
+    buffer.append(payload);
+}
+
+/**
+ @brief appends a response frame to a buffer
+
+ @details the payload is the status byte followed by the message, built in place without a temporary string
+
+ @param buffer the buffer to append to
+ @param success whether the command succeeded
+ @param message the command's output or error message
+ */
+void appendResponseFrame(string& buffer, bool success, const string& message) {
+    uint32_t length = static_cast<uint32_t>(message.size() + 1);
+    buffer.push_back(static_cast<char>((length >> 24) & 0xFF));
+    buffer.push_back(static_cast<char>((length >> 16) & 0xFF));
+    buffer.push_back(static_cast<char>((length >> 8) & 0xFF));
+    buffer.push_back(static_cast<char>(length & 0xFF));
+    buffer.push_back(success ? STATUS_OK : STATUS_ERROR);
+    buffer.append(message);
+}
+
+/**
+ @brief reads the next complete frame from a buffer
+
+ @details on success offset is moved past the frame. nothing is consumed if the frame is incomplete
+
+ @param buffer the received bytes
+ @param offset position of the next unread byte
+ @param payload receives the frame contents
+
+ @return (FrameStatus) Complete if a frame was read, Incomplete if more bytes are needed, Invalid if the length exceeds MAX_FRAME_SIZE
+ */
+FrameStatus extractFrame(const string& buffer, size_t& offset, string& payload) {
+    if (buffer.size() - offset < 4) {
+        return FrameStatus::Incomplete;
+    }
+
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(buffer.data() + offset);
+    uint32_t length = (static_cast<uint32_t>(header[0]) << 24) | (static_cast<uint32_t>(header[1]) << 16) |
+                      (static_cast<uint32_t>(header[2]) << 8) | static_cast<uint32_t>(header[3]);
+    if (length > MAX_FRAME_SIZE) {
+        return FrameStatus::Invalid;
+    }
+    if (buffer.size() - offset - 4 < length) {
+        return FrameStatus::Incomplete;
+    }
+
+    payload.assign(buffer, offset + 4, length);
+    offset += 4 + length;
+    return FrameStatus::Complete;
+}
+
+/**
+ @brief interprets a server address
+
+ @details anything containing a '/' is a Unix domain socket path (an optional "unix:" prefix is allowed). otherwise the address is a TCP port on 127.0.0.1, written as "7070", ":7070", or "tcp:7070"
+
+ @param address the address text
+ @param useTcp set to true for a TCP address
+ @param socketPath receives the Unix socket path
+ @param port receives the TCP port
+
+ @return (bool) true if the address is valid, false otherwise
+ */
+bool parseServerAddress(const string& address, bool& useTcp, string& socketPath, int& port) {
+    string text = address;
+    if (text.compare(0, 5, "unix:") == 0) {
+        socketPath = text.substr(5);
+        useTcp = false;
+        return !socketPath.empty() && socketPath.size() < sizeof(sockaddr_un().sun_path);
+    }
+    if (text.find('/') != string::npos) {
+        socketPath = text;
+        useTcp = false;
+        return socketPath.size() < sizeof(sockaddr_un().sun_path);
+    }
+    
+    if (text.compare(0, 4, "tcp:") == 0) {
+        text = text.substr(4);
+    }
+    if (!text.empty() && text[0] == ':') {
+        text = text.substr(1);
+    }
+    try {
+        size_t used = 0;
+        port = stoi(text, &used);
+        useTcp = true;
+        return used == text.size() && port > 0 && port < 65536;
+    } catch (const exception& e) {
+        return false;
+    }
+}
+
+/**
+ @brief opens a blocking client connection to a server
+
+ @param address the server address (see parseServerAddress)
+
+ @return (int) the connected socket, or -1 on failure
+ */
+int connectToServer(const string& address) {
+    bool useTcp = false;
+    string socketPath;
+    int port = 0;
+    if (!parseServerAddress(address, useTcp, socketPath, port)) {
+        return -1;
+    }
+    
+    int fd = -1;
+    int result = -1;
+    if (useTcp) {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        result = connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    } else {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+        result = connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    }
+    
+    if (result < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
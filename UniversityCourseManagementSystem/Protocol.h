@@ -0,0 +1,31 @@
+//
+//  Protocol.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/8/25.
+//
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+// Every message on the wire is a 4-byte big-endian payload length followed by the payload.
+// Requests carry one command line (see CommandProcessor). Responses start with a status byte.
+const uint32_t MAX_FRAME_SIZE = 1 << 20;
+const char STATUS_OK = '+';
+const char STATUS_ERROR = '-';
+
+enum class FrameStatus { Complete, Incomplete, Invalid };
+
+void appendFrame(string& buffer, const string& payload);
+void appendResponseFrame(string& buffer, bool success, const string& message);
+FrameStatus extractFrame(const string& buffer, size_t& offset, string& payload);
+
+bool parseServerAddress(const string& address, bool& useTcp, string& socketPath, int& port);
+int connectToServer(const string& address);
+
+#endif // PROTOCOL_H
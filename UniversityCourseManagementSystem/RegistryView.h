@@ -0,0 +1,56 @@
+//
+//  RegistryView.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/6/25.
+//
+
+#ifndef REGISTRY_VIEW_H
+#define REGISTRY_VIEW_H
+
+#include <cstddef>
+#include <iterator>
+
+using namespace std;
+
+/**
+ @brief read-only, non-owning view over the values of a map
+
+ @details behaves like a span over the registry: range-for yields const references to the stored Student or Course objects, so iterating copies and allocates nothing. the view is invalidated by any change to the underlying map
+ */
+template <typename Map>
+class RegistryView {
+private:
+    const Map* registry;
+
+public:
+    class iterator {
+    private:
+        typename Map::const_iterator position;
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = typename Map::mapped_type;
+        using difference_type = ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        explicit iterator(typename Map::const_iterator pos) : position(pos) {}
+
+        reference operator*() const { return position->second; }
+        pointer operator->() const { return &position->second; }
+        iterator& operator++() { ++position; return *this; }
+        iterator operator++(int) { iterator previous = *this; ++position; return previous; }
+        bool operator==(const iterator& other) const { return position == other.position; }
+        bool operator!=(const iterator& other) const { return position != other.position; }
+    };
+
+    explicit RegistryView(const Map& map) : registry(&map) {}
+
+    iterator begin() const { return iterator(registry->begin()); }
+    iterator end() const { return iterator(registry->end()); }
+    size_t size() const { return registry->size(); }
+    bool empty() const { return registry->empty(); }
+};
+
+#endif // REGISTRY_VIEW_H
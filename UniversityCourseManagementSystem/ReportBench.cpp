@@ -0,0 +1,157 @@
+//
+//  ReportBench.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "UniversitySystem.h"
+#include "ReportWriter.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+struct RunResult {
+    double seconds = 0;
+    unsigned long long bytes = 0;
+    unsigned long long writes = 0;
+};
+
+/**
+ @brief writes every roster the way the display functions did before ReportWriter: piecemeal stream inserts with endl on every line
+
+ @param system the term
+ @param os the stream to write to
+ */
+void legacyRosters(const UniversitySystem& system, ostream& os) {
+    system.forEachCourse([&](const Course& course) {
+        os << "\n=== Students for " << course.getTitle() << " (Code: " << course.getCourseCode() << ") ===" << endl;
+        os << "Enrolled Students (" << course.getCurrentEnrollment() << "):" << endl;
+        course.forEachEnrolledStudent([&](const string& studentID) {
+            os << " - " << studentID << endl;
+        });
+        os << "No students on waitlist" << endl;
+    });
+}
+
+/**
+ @brief writes every roster in the display layout through one ReportWriter
+
+ @param system the term
+ @param report the writer
+ */
+void bufferedRosters(const UniversitySystem& system, ReportWriter& report) {
+    system.forEachCourse([&](const Course& course) {
+        report << "\n=== Students for " << course.getTitle() << " (Code: " << course.getCourseCode() << ") ===\n";
+        course.displayEnrolledStudents(report);
+        course.displayWaitlist(report);
+    });
+}
+
+/**
+ @brief gets the size of a file
+
+ @param fileName the file
+
+ @return (unsigned long long) its size in bytes
+ */
+unsigned long long fileBytes(const string& fileName) {
+    ifstream file(fileName, ios::binary | ios::ate);
+    return file.is_open() ? static_cast<unsigned long long>(file.tellg()) : 0;
+}
+
+/**
+ @brief prints one result line
+
+ @param label the path measured
+ @param result its size, time and write count
+ */
+void printRow(const string& label, const RunResult& result) {
+    double megabytes = result.bytes / (1024.0 * 1024.0);
+    cout << left << setw(22) << label << right << setw(10) << megabytes << setw(10) << result.seconds * 1000 << setw(10)
+         << megabytes / result.seconds << setw(12) << result.writes << endl;
+}
+
+int main(int argc, const char * argv[]) {
+    int studentCount = argc > 1 ? stoi(argv[1]) : 100000;
+    int courseCount = argc > 2 ? stoi(argv[2]) : 2000;
+    int perStudent = argc > 3 ? stoi(argv[3]) : 10;
+    string outputFile = argc > 4 ? argv[4] : "university_report_bench.out";
+
+    UniversitySystem system;
+    ostream discard(nullptr);
+    system.setOutputStream(discard);
+    int capacity = perStudent * studentCount / courseCount * 2 + 1;
+    for (int c = 0; c < courseCount; c++) {
+        system.addCourse("C" + to_string(c), "Course " + to_string(c), "Dr. Instructor " + to_string(c % 97), capacity);
+    }
+    for (int s = 0; s < studentCount; s++) {
+        string studentID = "S" + to_string(s);
+        system.addStudent(studentID, "Student Number " + to_string(s));
+        for (int k = 0; k < perStudent; k++) {
+            system.enrollStudentInCourse(studentID, "C" + to_string((s * 7 + k * 131) % courseCount));
+        }
+    }
+    cout << "Students: " << studentCount << " | Courses: " << courseCount << " | Roster rows: " << studentCount * perStudent << endl;
+    cout << fixed << setprecision(1);
+    cout << left << setw(22) << "Path" << right << setw(10) << "MB" << setw(10) << "ms" << setw(10) << "MB/s" << setw(12) << "writes" << endl;
+
+    {
+        RunResult result;
+        Clock::time_point start = Clock::now();
+        {
+            ofstream file(outputFile, ios::trunc);
+            legacyRosters(system, file);
+        }
+        result.seconds = chrono::duration<double>(Clock::now() - start).count();
+        result.bytes = fileBytes(outputFile);
+        result.writes = studentCount * perStudent + 3ULL * courseCount;
+        printRow("endl per line", result);
+    }
+
+    {
+        RunResult result;
+        Clock::time_point start = Clock::now();
+        {
+            ofstream file(outputFile, ios::trunc);
+            ReportWriter report(file);
+            bufferedRosters(system, report);
+            report.flush();
+            result.bytes = report.getBytesWritten();
+            result.writes = report.getWriteCount();
+        }
+        result.seconds = chrono::duration<double>(Clock::now() - start).count();
+        printRow("display, buffered", result);
+    }
+
+    const pair<const char*, ReportFormat> layouts[] = {
+        {"rosters table (fd)", ReportFormat::Table}, {"rosters csv (fd)", ReportFormat::Csv}, {"rosters json (fd)", ReportFormat::Json}
+    };
+    for (const auto& layout : layouts) {
+        RunResult result;
+        Clock::time_point start = Clock::now();
+        int fd = open(outputFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        {
+            ReportWriter report(fd, layout.second);
+            system.reportRosters(report);
+            report.flush();
+            result.bytes = report.getBytesWritten();
+            result.writes = report.getWriteCount();
+        }
+        close(fd);
+        result.seconds = chrono::duration<double>(Clock::now() - start).count();
+        printRow(layout.first, result);
+    }
+
+    remove(outputFile.c_str());
+    return 0;
+}
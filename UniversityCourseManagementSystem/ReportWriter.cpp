@@ -0,0 +1,416 @@
+//
+//  ReportWriter.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "ReportWriter.h"
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+
+/**
+ @brief describes one table column
+
+ @param columnName the header text, also the JSON field name
+ @param columnWidth the column's width in table layout; longer cells push the rest of the row right
+ @param isNumeric true to right-align the column in table layout and write it unquoted in JSON
+ */
+ReportColumn::ReportColumn(const string& columnName, size_t columnWidth, bool isNumeric) : name(columnName), width(columnWidth), numeric(isNumeric) {
+}
+
+/**
+ @brief constructs a writer that hands full pages to a stream
+
+ @param target the stream; it is written once per page and flushed only by flush()
+ @param reportFormat the layout for tables
+ @param pageSize the buffer size that triggers a write
+ */
+ReportWriter::ReportWriter(ostream& target, ReportFormat reportFormat, size_t pageSize) {
+    os = &target;
+    fd = -1;
+    format = reportFormat;
+    pageBytes = pageSize > 0 ? pageSize : DEFAULT_PAGE_BYTES;
+    buffer.reserve(pageBytes + 1024);
+    healthy = true;
+    bytesWritten = 0;
+    writes = 0;
+    column = 0;
+    rows = 0;
+    inTable = false;
+}
+
+/**
+ @brief constructs a writer that writes full pages straight to a file descriptor
+
+ @param targetFd an open descriptor; the writer does not close it
+ @param reportFormat the layout for tables
+ @param pageSize the buffer size that triggers a write
+ */
+ReportWriter::ReportWriter(int targetFd, ReportFormat reportFormat, size_t pageSize) : ReportWriter(cout, reportFormat, pageSize) {
+    os = nullptr;
+    fd = targetFd;
+}
+
+/**
+ @brief closes an unfinished table and writes whatever is buffered
+ */
+ReportWriter::~ReportWriter() {
+    if (inTable) {
+        endTable();
+    }
+    flush();
+}
+
+ReportFormat ReportWriter::getFormat() const {
+    return format;
+}
+
+/**
+ @brief changes the layout used by the next table
+
+ @param reportFormat the layout
+ */
+void ReportWriter::setFormat(ReportFormat reportFormat) {
+    format = reportFormat;
+}
+
+/**
+ @brief hands the buffer to the target and empties it, keeping its capacity
+ */
+void ReportWriter::writePage() {
+    if (buffer.empty()) {
+        return;
+    }
+    if (os) {
+        os->write(buffer.data(), buffer.size());
+        healthy = healthy && os->good();
+        writes++;
+    } else {
+        const char* next = buffer.data();
+        size_t left = buffer.size();
+        while (left > 0 && healthy) {
+            ssize_t written = ::write(fd, next, left);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                healthy = false;
+                break;
+            }
+            next += written;
+            left -= written;
+            writes++;
+        }
+    }
+    bytesWritten += buffer.size();
+    buffer.clear();
+}
+
+void ReportWriter::maybeWritePage() {
+    if (buffer.size() >= pageBytes) {
+        writePage();
+    }
+}
+
+void ReportWriter::pad(size_t count) {
+    buffer.append(count, ' ');
+}
+
+ReportWriter& ReportWriter::operator<<(string_view text) {
+    buffer.append(text.data(), text.size());
+    maybeWritePage();
+    return *this;
+}
+
+ReportWriter& ReportWriter::operator<<(const string& text) {
+    return *this << string_view(text);
+}
+
+ReportWriter& ReportWriter::operator<<(const char* text) {
+    return *this << string_view(text);
+}
+
+ReportWriter& ReportWriter::operator<<(char character) {
+    buffer.push_back(character);
+    maybeWritePage();
+    return *this;
+}
+
+/**
+ @brief starts a table
+
+ @details table layout writes a title line, the column names and a rule; CSV writes the column names; JSON opens an object holding the title and a rows array
+
+ @param title the report's title
+ @param tableColumns the columns, in order
+ */
+void ReportWriter::beginTable(const string& title, const vector<ReportColumn>& tableColumns) {
+    if (inTable) {
+        endTable();
+    }
+    columns = tableColumns;
+    for (auto& tableColumn : columns) {
+        tableColumn.width = max(tableColumn.width, tableColumn.name.size());
+    }
+    column = 0;
+    rows = 0;
+    inTable = true;
+
+    if (format == ReportFormat::Table) {
+        buffer += "\n=== ";
+        buffer += title;
+        buffer += " ===\n";
+        for (size_t i = 0; i < columns.size(); i++) {
+            beginCell();
+            appendCell(columns[i].name, columns[i].numeric);
+            column++;
+        }
+        buffer += '\n';
+        for (size_t i = 0; i < columns.size(); i++) {
+            buffer.append(i > 0 ? 2 : 0, ' ');
+            buffer.append(columns[i].width, '-');
+        }
+        buffer += '\n';
+    } else if (format == ReportFormat::Csv) {
+        for (size_t i = 0; i < columns.size(); i++) {
+            if (i > 0) {
+                buffer += ',';
+            }
+            appendCsvField(columns[i].name);
+        }
+        buffer += '\n';
+    } else {
+        buffer += "{\"report\":\"";
+        appendEscapedJson(title);
+        buffer += "\",\"rows\":[";
+    }
+    column = 0;
+    maybeWritePage();
+}
+
+/**
+ @brief writes the separator that comes before the current cell
+ */
+void ReportWriter::beginCell() {
+    if (format == ReportFormat::Table) {
+        if (column > 0) {
+            buffer += "  ";
+        }
+    } else if (format == ReportFormat::Csv) {
+        if (column > 0) {
+            buffer += ',';
+        }
+    } else {
+        buffer += column > 0 ? "," : (rows > 0 ? ",\n{" : "\n{");
+        buffer += '"';
+        if (column < columns.size()) {
+            appendEscapedJson(columns[column].name);
+        }
+        buffer += "\":";
+    }
+}
+
+/**
+ @brief writes one cell's text in the current format
+
+ @param text the text
+ @param numeric true if the text is a number
+ */
+void ReportWriter::appendCell(string_view text, bool numeric) {
+    if (format == ReportFormat::Table) {
+        size_t width = column < columns.size() ? columns[column].width : 0;
+        size_t fill = width > text.size() ? width - text.size() : 0;
+        bool last = column + 1 >= columns.size();
+        if (numeric) {
+            pad(fill);
+        }
+        buffer.append(text.data(), text.size());
+        if (!numeric && !last) {
+            pad(fill);
+        }
+    } else if (format == ReportFormat::Csv) {
+        appendCsvField(text);
+    } else if (numeric) {
+        buffer.append(text.data(), text.size());
+    } else {
+        buffer += '"';
+        appendEscapedJson(text);
+        buffer += '"';
+    }
+}
+
+/**
+ @brief adds a text cell to the current row
+
+ @param text the cell
+
+ @return (ReportWriter&) this writer
+ */
+ReportWriter& ReportWriter::cell(string_view text) {
+    beginCell();
+    appendCell(text, false);
+    column++;
+    return *this;
+}
+
+/**
+ @brief adds a number cell to the current row
+
+ @param number the cell
+
+ @return (ReportWriter&) this writer
+ */
+ReportWriter& ReportWriter::cell(long long number) {
+    char digits[24];
+    auto result = to_chars(digits, digits + sizeof(digits), number);
+    beginCell();
+    appendCell(string_view(digits, result.ptr - digits), true);
+    column++;
+    return *this;
+}
+
+/**
+ @brief finishes the current row
+ */
+void ReportWriter::endRow() {
+    if (format == ReportFormat::Json) {
+        buffer += '}';
+    } else {
+        buffer += '\n';
+    }
+    column = 0;
+    rows++;
+    maybeWritePage();
+}
+
+/**
+ @brief finishes the table
+
+ @details table layout ends with a row count; JSON closes the rows array and the object
+ */
+void ReportWriter::endTable() {
+    if (column > 0) {
+        endRow();
+    }
+    if (format == ReportFormat::Table) {
+        *this << rows << (rows == 1 ? " row\n" : " rows\n");
+    } else if (format == ReportFormat::Json) {
+        buffer += rows > 0 ? "\n]}\n" : "]}\n";
+    }
+    inTable = false;
+    maybeWritePage();
+}
+
+/**
+ @brief appends a string with JSON escaping
+
+ @param text the raw text
+ */
+void ReportWriter::appendEscapedJson(string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+    for (char character : text) {
+        unsigned char byte = static_cast<unsigned char>(character);
+        if (character == '"' || character == '\\') {
+            buffer += '\\';
+            buffer += character;
+        } else if (character == '\n') {
+            buffer += "\\n";
+        } else if (character == '\t') {
+            buffer += "\\t";
+        } else if (character == '\r') {
+            buffer += "\\r";
+        } else if (byte < 0x20) {
+            buffer += "\\u00";
+            buffer += HEX[byte >> 4];
+            buffer += HEX[byte & 0xf];
+        } else {
+            buffer += character;
+        }
+    }
+}
+
+/**
+ @brief appends a CSV field, quoting it only if it holds a comma, quote or line break
+
+ @param text the raw text
+ */
+void ReportWriter::appendCsvField(string_view text) {
+    if (text.find_first_of(",\"\r\n") == string_view::npos) {
+        buffer.append(text.data(), text.size());
+        return;
+    }
+    buffer += '"';
+    for (char character : text) {
+        if (character == '"') {
+            buffer += '"';
+        }
+        buffer += character;
+    }
+    buffer += '"';
+}
+
+/**
+ @brief writes whatever is buffered to the target
+
+ @details a stream target is flushed too, so the text is visible outside the process
+
+ @return (bool) true if every write so far succeeded
+ */
+bool ReportWriter::flush() {
+    writePage();
+    if (os) {
+        os->flush();
+        healthy = healthy && os->good();
+    }
+    return healthy;
+}
+
+/**
+ @brief checks that every write so far succeeded
+
+ @return (bool) false once a write has failed
+ */
+bool ReportWriter::good() const {
+    return healthy;
+}
+
+/**
+ @brief gets the number of bytes handed to the target
+
+ @return (unsigned long long) the byte count, not counting what is still buffered
+ */
+unsigned long long ReportWriter::getBytesWritten() const {
+    return bytesWritten;
+}
+
+/**
+ @brief gets the number of writes made to the target
+
+ @return (unsigned long long) the write count
+ */
+unsigned long long ReportWriter::getWriteCount() const {
+    return writes;
+}
+
+/**
+ @brief parses a format name
+
+ @param name "table", "csv" or "json"
+ @param reportFormat receives the format
+
+ @return (bool) true if the name was recognized
+ */
+bool ReportWriter::parseFormat(const string& name, ReportFormat& reportFormat) {
+    if (name == "table") {
+        reportFormat = ReportFormat::Table;
+    } else if (name == "csv") {
+        reportFormat = ReportFormat::Csv;
+    } else if (name == "json") {
+        reportFormat = ReportFormat::Json;
+    } else {
+        return false;
+    }
+    return true;
+}
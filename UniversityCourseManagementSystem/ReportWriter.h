@@ -0,0 +1,111 @@
+//
+//  ReportWriter.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+#include <charconv>
+#include <type_traits>
+#include <cstddef>
+
+using namespace std;
+
+enum class ReportFormat {
+    Table,
+    Csv,
+    Json
+};
+
+struct ReportColumn {
+    string name;
+    size_t width;
+    bool numeric;
+
+    ReportColumn(const string& columnName, size_t columnWidth, bool isNumeric = false);
+};
+
+/**
+ @brief formats reports into a reusable buffer and writes it out a page at a time
+
+ @details text goes into one buffer that is handed to the target (a stream or a file descriptor) only when a page fills, on flush, or on destruction, so a report costs one write per page instead of one flush per line. free text is written with operator<<; tables are written with beginTable, cell, endRow and endTable and come out as aligned columns, CSV (RFC 4180 quoting) or a JSON object holding an array of rows, depending on the format. a writer is reusable: the buffer keeps its capacity across reports. not thread-safe
+ */
+class ReportWriter {
+public:
+    static constexpr size_t DEFAULT_PAGE_BYTES = 64 * 1024;
+
+private:
+    ostream* os;
+    int fd;
+    ReportFormat format;
+    size_t pageBytes;
+    string buffer;
+    bool healthy;
+    unsigned long long bytesWritten;
+    unsigned long long writes;
+
+    vector<ReportColumn> columns;
+    size_t column;
+    size_t rows;
+    bool inTable;
+
+    void writePage();
+    void maybeWritePage();
+    void pad(size_t count);
+    void appendEscapedJson(string_view text);
+    void appendCsvField(string_view text);
+    void beginCell();
+    void appendCell(string_view text, bool numeric);
+
+public:
+    explicit ReportWriter(ostream& target, ReportFormat reportFormat = ReportFormat::Table, size_t pageSize = DEFAULT_PAGE_BYTES);
+    explicit ReportWriter(int targetFd, ReportFormat reportFormat = ReportFormat::Table, size_t pageSize = DEFAULT_PAGE_BYTES);
+    ~ReportWriter();
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    ReportFormat getFormat() const;
+    void setFormat(ReportFormat reportFormat);
+
+    ReportWriter& operator<<(string_view text);
+    ReportWriter& operator<<(const string& text);
+    ReportWriter& operator<<(const char* text);
+    ReportWriter& operator<<(char character);
+
+    /**
+     @brief appends an integer without going through a stream
+
+     @param number the integer
+
+     @return (ReportWriter&) this writer
+     */
+    template <typename Integer, typename = enable_if_t<is_integral_v<Integer> && !is_same_v<Integer, char> && !is_same_v<Integer, bool>>>
+    ReportWriter& operator<<(Integer number) {
+        char digits[24];
+        auto result = to_chars(digits, digits + sizeof(digits), number);
+        return *this << string_view(digits, result.ptr - digits);
+    }
+
+    void beginTable(const string& title, const vector<ReportColumn>& tableColumns);
+    ReportWriter& cell(string_view text);
+    ReportWriter& cell(long long number);
+    void endRow();
+    void endTable();
+
+    bool flush();
+    bool good() const;
+    unsigned long long getBytesWritten() const;
+    unsigned long long getWriteCount() const;
+
+    static bool parseFormat(const string& name, ReportFormat& reportFormat);
+};
+
+#endif // REPORT_WRITER_H
@@ -0,0 +1,540 @@
+//
+//  RequestServer.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/8/25.
+//
+
+#include "RequestServer.h"
+#include "Protocol.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+volatile sig_atomic_t RequestServer::stopRequested = 0;
+
+// a connection isn't read while this much of its output is unsent, so a client that doesn't read its responses
+// can't make the server buffer them without limit
+static const size_t MAX_UNSENT_OUTPUT = 1 << 20;
+// unparsed input kept per connection; always room for one frame of the largest size
+static const size_t MAX_BUFFERED_INPUT = 2 * MAX_FRAME_SIZE;
+// requests taken from one connection per pass, so a deep pipeline can't crowd out the other clients
+static const size_t MAX_REQUESTS_PER_PASS = 64;
+
+/**
+ @brief default constructor for a Connection
+
+ @details starts with empty buffers and no socket, watched for reading only
+ */
+RequestServer::Connection::Connection() {
+    fd = -1;
+    inputOffset = 0;
+    outputOffset = 0;
+    wantsRead = true;
+    wantsWrite = false;
+    backlogged = false;
+    paused = false;
+    closing = false;
+}
+
+/**
+ @brief constructs a server for a system
+
+ @details nothing is opened until run is called. while the server exists the system's messages are returned to clients instead of being printed
+
+ @param target the system to serve
+ @param listenAddress a Unix socket path or a localhost TCP port (see parseServerAddress)
+ @param terms the terms TERM requests work on, or nullptr for none
+ */
+RequestServer::RequestServer(UniversitySystem& target, const string& listenAddress, TermRegistry* terms) : system(target), processor(target, terms), address(listenAddress) {
+    listenFd = -1;
+    pollerFd = -1;
+    requestsServed = 0;
+    batchesRun = 0;
+    largestBatch = 0;
+}
+
+/**
+ @brief closes every connection, the listener, and the Unix socket file
+ */
+RequestServer::~RequestServer() {
+    vector<int> open;
+    for (const auto& entry : connections) {
+        open.push_back(entry.first);
+    }
+    for (int fd : open) {
+        closeConnection(fd);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        bool useTcp = false;
+        string socketPath;
+        int port = 0;
+        if (parseServerAddress(address, useTcp, socketPath, port) && !useTcp) {
+            unlink(socketPath.c_str());
+        }
+    }
+    if (pollerFd >= 0) {
+        close(pollerFd);
+    }
+}
+
+/**
+ @brief asks a running server to stop after its current loop iteration
+
+ @details safe to call from a signal handler
+ */
+void RequestServer::requestStop() {
+    stopRequested = 1;
+}
+
+/**
+ @brief returns the number of requests answered so far
+
+ @return (unsigned long long) requests answered
+ */
+unsigned long long RequestServer::getRequestsServed() const {
+    return requestsServed;
+}
+
+/**
+ @brief returns the number of non-empty batches executed so far
+
+ @return (unsigned long long) batches executed
+ */
+unsigned long long RequestServer::getBatchesRun() const {
+    return batchesRun;
+}
+
+/**
+ @brief returns the size of the largest batch executed in one loop iteration
+
+ @return (size_t) requests in the largest batch
+ */
+size_t RequestServer::getLargestBatch() const {
+    return largestBatch;
+}
+
+/**
+ @brief sets a socket to non-blocking mode
+
+ @param fd the socket
+
+ @return (bool) true on success
+ */
+static bool makeNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/**
+ @brief creates, binds, and listens on the server socket
+
+ @return (bool) true if the server is listening, false otherwise
+ */
+bool RequestServer::openListener() {
+    bool useTcp = false;
+    string socketPath;
+    int port = 0;
+    if (!parseServerAddress(address, useTcp, socketPath, port)) {
+        cout << "Error: Invalid server address " << address << endl;
+        return false;
+    }
+
+    int result = -1;
+    if (useTcp) {
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (listenFd < 0) {
+            cout << "Error: Could not create socket: " << strerror(errno) << endl;
+            return false;
+        }
+        int reuse = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        result = ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    } else {
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) {
+            cout << "Error: Could not create socket: " << strerror(errno) << endl;
+            return false;
+        }
+        unlink(socketPath.c_str());
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+        result = ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    }
+
+    if (result < 0 || listen(listenFd, SOMAXCONN) < 0 || !makeNonBlocking(listenFd)) {
+        cout << "Error: Could not listen on " << address << ": " << strerror(errno) << endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    return true;
+}
+
+#ifdef __linux__
+
+/**
+ @brief registers or re-arms a socket with the event loop
+
+ @param fd the socket
+ @param wantRead wake up when the socket has data to read
+ @param wantWrite wake up when the socket becomes writable
+ @param isNew true the first time the socket is registered
+
+ @return (bool) true on success
+ */
+bool RequestServer::watch(int fd, bool wantRead, bool wantWrite, bool isNew) {
+    epoll_event event{};
+    event.events = (wantRead ? static_cast<uint32_t>(EPOLLIN) : 0u) | (wantWrite ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    event.data.fd = fd;
+    return epoll_ctl(pollerFd, isNew ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+/**
+ @brief removes a socket from the event loop
+
+ @param fd the socket
+ */
+void RequestServer::unwatch(int fd) {
+    epoll_ctl(pollerFd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+/**
+ @brief waits for socket activity
+
+ @param readable receives sockets with data to read (or a pending accept)
+ @param writable receives sockets that can take more output
+
+ @return (int) the number of events, or -1 on error
+ */
+int RequestServer::waitForEvents(vector<int>& readable, vector<int>& writable) {
+    epoll_event events[256];
+    int count = epoll_wait(pollerFd, events, 256, system.isCheckpointActive() || !backlog.empty() ? 0 : 500);
+    for (int i = 0; i < count; i++) {
+        if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            readable.push_back(events[i].data.fd);
+        }
+        if (events[i].events & EPOLLOUT) {
+            writable.push_back(events[i].data.fd);
+        }
+    }
+    return count;
+}
+
+#else
+
+// Portable fallback for platforms without epoll: the interest set is rebuilt from the connection table on every wait.
+
+bool RequestServer::watch(int fd, bool wantRead, bool wantWrite, bool isNew) {
+    return true;
+}
+
+void RequestServer::unwatch(int fd) {}
+
+int RequestServer::waitForEvents(vector<int>& readable, vector<int>& writable) {
+    vector<pollfd> fds;
+    fds.push_back({listenFd, POLLIN, 0});
+    for (const auto& entry : connections) {
+        fds.push_back({entry.first, static_cast<short>((entry.second.wantsRead ? POLLIN : 0) | (entry.second.wantsWrite ? POLLOUT : 0)), 0});
+    }
+    int count = poll(fds.data(), fds.size(), system.isCheckpointActive() || !backlog.empty() ? 0 : 500);
+    for (const auto& item : fds) {
+        if (item.revents & (POLLIN | POLLHUP | POLLERR)) {
+            readable.push_back(item.fd);
+        }
+        if (item.revents & POLLOUT) {
+            writable.push_back(item.fd);
+        }
+    }
+    return count;
+}
+
+#endif
+
+/**
+ @brief accepts every pending client connection
+ */
+void RequestServer::acceptClients() {
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        if (!makeNonBlocking(fd) || !watch(fd, true, false, true)) {
+            close(fd);
+            continue;
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        Connection& connection = connections[fd];
+        connection.fd = fd;
+    }
+}
+
+/**
+ @brief reads what a readable socket has into the connection's input buffer
+
+ @details stops once MAX_BUFFERED_INPUT bytes are waiting to be parsed; the rest stays in the socket until requests are taken. end of stream marks the connection for closing once its pending requests are answered
+
+ @param connection the connection to read from
+ */
+void RequestServer::readFrom(Connection& connection) {
+    char chunk[65536];
+    while (connection.input.size() - connection.inputOffset < MAX_BUFFERED_INPUT) {
+        ssize_t received = recv(connection.fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            connection.input.append(chunk, received);
+            continue;
+        }
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            connection.closing = true;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        break;
+    }
+}
+
+/**
+ @brief queues the complete request frames waiting in a connection's input buffer
+
+ @details pipelined requests are picked up together, up to MAX_REQUESTS_PER_PASS; if that many were taken the connection goes on the backlog so the rest are taken next pass without waiting for the socket. nothing is taken while more than MAX_UNSENT_OUTPUT bytes of responses are unsent: the connection is paused until flush gets below that. a malformed frame marks the connection for closing once its pending responses are written
+
+ @param connection the connection to take requests from
+ */
+void RequestServer::takeRequests(Connection& connection) {
+    if (connection.output.size() - connection.outputOffset > MAX_UNSENT_OUTPUT) {
+        connection.paused = true;
+        return;
+    }
+
+    string payload;
+    size_t taken = 0;
+    while (taken < MAX_REQUESTS_PER_PASS) {
+        FrameStatus status = extractFrame(connection.input, connection.inputOffset, payload);
+        if (status == FrameStatus::Complete) {
+            batch.push_back({connection.fd, payload});
+            taken++;
+            continue;
+        }
+        if (status == FrameStatus::Invalid) {
+            connection.closing = true;
+        }
+        break;
+    }
+    if (taken == MAX_REQUESTS_PER_PASS) {
+        connection.backlogged = true;
+        backlog.push_back(connection.fd);
+    }
+
+    if (connection.inputOffset == connection.input.size()) {
+        connection.input.clear();
+        connection.inputOffset = 0;
+    } else if (connection.inputOffset > 65536) {
+        connection.input.erase(0, connection.inputOffset);
+        connection.inputOffset = 0;
+    }
+}
+
+/**
+ @brief writes as much pending output as the socket accepts
+
+ @details re-arms the socket for write readiness if output is left over, and for reading only while the unsent output is under MAX_UNSENT_OUTPUT and the connection isn't closing. a paused connection goes back on the backlog once its output drains below the limit
+
+ @param connection the connection to write to
+ */
+void RequestServer::flush(Connection& connection) {
+    while (connection.outputOffset < connection.output.size()) {
+        ssize_t sent = send(connection.fd, connection.output.data() + connection.outputOffset, connection.output.size() - connection.outputOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.outputOffset += sent;
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        connection.closing = true;
+        connection.output.clear();
+        connection.outputOffset = 0;
+        break;
+    }
+
+    bool pending = connection.outputOffset < connection.output.size();
+    if (!pending) {
+        connection.output.clear();
+        connection.outputOffset = 0;
+    }
+    bool underLimit = connection.output.size() - connection.outputOffset <= MAX_UNSENT_OUTPUT;
+    if (connection.paused && underLimit) {
+        connection.paused = false;
+        if (!connection.backlogged) {
+            connection.backlogged = true;
+            backlog.push_back(connection.fd);
+        }
+    }
+    bool readable = underLimit && !connection.closing;
+    if (pending != connection.wantsWrite || readable != connection.wantsRead) {
+        connection.wantsWrite = pending;
+        connection.wantsRead = readable;
+        watch(connection.fd, readable, pending, false);
+    }
+}
+
+/**
+ @brief closes a client connection and forgets its buffers
+
+ @param fd the client socket
+ */
+void RequestServer::closeConnection(int fd) {
+    backlog.erase(remove(backlog.begin(), backlog.end(), fd), backlog.end());
+    unwatch(fd);
+    close(fd);
+    connections.erase(fd);
+}
+
+/**
+ @brief executes every request gathered in this loop iteration
+
+ @details requests from all clients run back to back in arrival order, and each connection's responses are appended to its output buffer so they go out with one send per client
+ */
+void RequestServer::runBatch() {
+    if (batch.empty()) {
+        return;
+    }
+
+    TraceSpan span("runBatch");
+    span.setArg("requests", batch.size());
+    for (const auto& request : batch) {
+        CommandResult result = processor.execute(request.payload);
+        auto iter = connections.find(request.fd);
+        if (iter != connections.end()) {
+            appendResponseFrame(iter->second.output, result.success, result.message);
+        }
+    }
+
+    requestsServed += batch.size();
+    batchesRun++;
+    if (batch.size() > largestBatch) {
+        largestBatch = batch.size();
+    }
+    batch.clear();
+}
+
+/**
+ @brief runs the event loop until requestStop is called
+
+ @details each iteration waits for socket activity, reads every ready client, takes the complete requests of those clients and of the backlog, executes them as one batch, then flushes the responses. the wait doesn't sleep while the backlog has connections
+
+ @return (bool) true if the server ran and shut down cleanly, false if it could not start
+ */
+bool RequestServer::run() {
+    stopRequested = 0;
+    if (!openListener()) {
+        return false;
+    }
+
+#ifdef __linux__
+    pollerFd = epoll_create1(0);
+    if (pollerFd < 0 || !watch(listenFd, true, false, true)) {
+        cout << "Error: Could not create event loop: " << strerror(errno) << endl;
+        return false;
+    }
+#endif
+
+    cout << "Serving on " << address << " (Ctrl-C to stop)" << endl;
+
+    vector<int> readable;
+    vector<int> writable;
+    vector<int> touched;
+    vector<int> waiting;
+    while (!stopRequested) {
+        readable.clear();
+        writable.clear();
+        touched.clear();
+        waiting.clear();
+
+        int count = waitForEvents(readable, writable);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            cout << "Error: Event loop failed: " << strerror(errno) << endl;
+            break;
+        }
+
+        for (int fd : readable) {
+            if (fd == listenFd) {
+                acceptClients();
+                continue;
+            }
+            auto iter = connections.find(fd);
+            if (iter != connections.end()) {
+                readFrom(iter->second);
+                if (!iter->second.backlogged) {
+                    iter->second.backlogged = true;
+                    backlog.push_back(fd);
+                }
+            }
+        }
+        waiting.swap(backlog);
+        for (int fd : waiting) {
+            auto iter = connections.find(fd);
+            if (iter != connections.end()) {
+                iter->second.backlogged = false;
+                takeRequests(iter->second);
+                touched.push_back(fd);
+            }
+        }
+
+        // the wait wakes at least every 500 ms, so holds expire on time even when no requests arrive. while a
+        // checkpoint is being captured it doesn't sleep at all, so the capture moves a slice per pass
+        system.expireHolds();
+        system.advanceCheckpoint();
+        runBatch();
+
+        for (int fd : writable) {
+            touched.push_back(fd);
+        }
+        for (int fd : touched) {
+            auto iter = connections.find(fd);
+            if (iter == connections.end()) {
+                continue;
+            }
+            flush(iter->second);
+            if (iter->second.closing && iter->second.output.empty() && !iter->second.backlogged) {
+                closeConnection(fd);
+            }
+        }
+    }
+
+    cout << "Server stopped after " << requestsServed << " requests in " << batchesRun << " batches (largest batch " << largestBatch << ")" << endl;
+    return true;
+}
@@ -0,0 +1,82 @@
+//
+//  RequestServer.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/8/25.
+//
+
+#ifndef REQUEST_SERVER_H
+#define REQUEST_SERVER_H
+
+#include "UniversitySystem.h"
+#include "CommandProcessor.h"
+#include <string>
+#include <map>
+#include <vector>
+#include <csignal>
+
+using namespace std;
+
+class RequestServer {
+private:
+    struct Connection {
+        int fd;
+        string input;
+        size_t inputOffset;
+        string output;
+        size_t outputOffset;
+        bool wantsRead;
+        bool wantsWrite;
+        bool backlogged;
+        bool paused;
+        bool closing;
+
+        Connection();
+    };
+
+    struct PendingRequest {
+        int fd;
+        string payload;
+    };
+
+    UniversitySystem& system;
+    CommandProcessor processor;
+    string address;
+    int listenFd;
+    int pollerFd;
+    map<int, Connection> connections;
+    vector<PendingRequest> batch;
+    vector<int> backlog;
+    unsigned long long requestsServed;
+    unsigned long long batchesRun;
+    size_t largestBatch;
+
+    static volatile sig_atomic_t stopRequested;
+
+    bool openListener();
+    bool watch(int fd, bool wantRead, bool wantWrite, bool isNew);
+    void unwatch(int fd);
+    int waitForEvents(vector<int>& readable, vector<int>& writable);
+    void acceptClients();
+    void readFrom(Connection& connection);
+    void takeRequests(Connection& connection);
+    void flush(Connection& connection);
+    void closeConnection(int fd);
+    void runBatch();
+
+public:
+    RequestServer(UniversitySystem& target, const string& listenAddress, TermRegistry* terms = nullptr);
+    ~RequestServer();
+
+    RequestServer(const RequestServer&) = delete;
+    RequestServer& operator=(const RequestServer&) = delete;
+
+    bool run();
+    static void requestStop();
+
+    unsigned long long getRequestsServed() const;
+    unsigned long long getBatchesRun() const;
+    size_t getLargestBatch() const;
+};
+
+#endif // REQUEST_SERVER_H
@@ -0,0 +1,113 @@
+//
+//  ScriptRunner.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/8/25.
+//
+
+#include "ScriptRunner.h"
+
+/**
+ @brief constructs a runner that executes scripts against a system
+
+ @param system the system to run commands against. it must outlive the runner
+ @param resultStream where the per-command results are written
+ @param terms the terms TERM commands work on, or nullptr for none
+ */
+ScriptRunner::ScriptRunner(UniversitySystem& system, ostream& resultStream, TermRegistry* terms) : processor(system, terms), results(resultStream) {
+    commandsRun = 0;
+    commandsFailed = 0;
+    pending.reserve(FLUSH_THRESHOLD * 2);
+}
+
+/**
+ @brief writes out any results still buffered
+ */
+ScriptRunner::~ScriptRunner() {
+    flushResults();
+}
+
+/**
+ @brief buffers one result line
+
+ @details the format is "line<TAB>OK|ERR<TAB>message". newlines, tabs and backslashes in the message are escaped so every command produces exactly one line
+
+ @param lineNumber the script line the command came from
+ @param result the outcome of the command
+ */
+void ScriptRunner::appendResult(int lineNumber, const CommandResult& result) {
+    pending += to_string(lineNumber);
+    pending += result.success ? "\tOK\t" : "\tERR\t";
+    for (char c : result.message) {
+        switch (c) {
+            case '\n': pending += "\\n"; break;
+            case '\t': pending += "\\t"; break;
+            case '\\': pending += "\\\\"; break;
+            case '\r': break;
+            default: pending += c; break;
+        }
+    }
+    pending += '\n';
+
+    if (pending.size() >= FLUSH_THRESHOLD) {
+        flushResults();
+    }
+}
+
+/**
+ @brief writes buffered results to the result stream in one call
+ */
+void ScriptRunner::flushResults() {
+    if (!pending.empty()) {
+        results.write(pending.data(), pending.size());
+        pending.clear();
+    }
+}
+
+/**
+ @brief runs every command in a script
+
+ @details each line is one command in the CommandProcessor syntax. blank lines and lines starting with '#' are skipped and produce no result. the result stream is only flushed when the buffer fills and at the end, so no prompt or per-line flush slows the run down
+
+ @param script the script to read commands from
+ */
+void ScriptRunner::run(istream& script) {
+    string line;
+    int lineNumber = 0;
+    while (getline(script, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        CommandResult result = processor.execute(line);
+        commandsRun++;
+        if (!result.success) {
+            commandsFailed++;
+        }
+        appendResult(lineNumber, result);
+    }
+    flushResults();
+    results.flush();
+}
+
+/**
+ @brief gets the number of commands executed so far
+
+ @return (unsigned long long) the number of commands
+ */
+unsigned long long ScriptRunner::getCommandsRun() const {
+    return commandsRun;
+}
+
+/**
+ @brief gets the number of commands that failed so far
+
+ @return (unsigned long long) the number of failed commands
+ */
+unsigned long long ScriptRunner::getCommandsFailed() const {
+    return commandsFailed;
+}
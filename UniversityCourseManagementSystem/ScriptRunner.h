@@ -0,0 +1,45 @@
+//
+//  ScriptRunner.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/8/25.
+//
+
+#ifndef SCRIPT_RUNNER_H
+#define SCRIPT_RUNNER_H
+
+#include "UniversitySystem.h"
+#include "CommandProcessor.h"
+#include <string>
+#include <istream>
+#include <ostream>
+
+using namespace std;
+
+class ScriptRunner {
+private:
+    CommandProcessor processor;
+    ostream& results;
+    string pending;
+    unsigned long long commandsRun;
+    unsigned long long commandsFailed;
+
+    static const size_t FLUSH_THRESHOLD = 1 << 16;
+
+    void appendResult(int lineNumber, const CommandResult& result);
+    void flushResults();
+
+public:
+    ScriptRunner(UniversitySystem& system, ostream& resultStream, TermRegistry* terms = nullptr);
+    ~ScriptRunner();
+
+    ScriptRunner(const ScriptRunner&) = delete;
+    ScriptRunner& operator=(const ScriptRunner&) = delete;
+
+    void run(istream& script);
+
+    unsigned long long getCommandsRun() const;
+    unsigned long long getCommandsFailed() const;
+};
+
+#endif // SCRIPT_RUNNER_H
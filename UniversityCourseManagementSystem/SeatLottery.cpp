@@ -0,0 +1,188 @@
+//
+//  SeatLottery.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "SeatLottery.h"
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <random>
+
+/**
+ @brief constructs an empty lottery
+ */
+SeatLottery::SeatLottery() {
+}
+
+/**
+ @brief adds a course to allocate
+
+ @param openSeats the seats the lottery may hand out; zero or less turns every proposal away
+
+ @return (uint32_t) the course's index, used by addChoice
+ */
+uint32_t SeatLottery::addCourse(int openSeats) {
+    seats.push_back(openSeats);
+    held.emplace_back();
+    turnedAway.emplace_back();
+    return static_cast<uint32_t>(seats.size() - 1);
+}
+
+/**
+ @brief adds a student; their choices follow with addChoice
+
+ @param maxCourses the most seats the student wants from this round
+
+ @return (uint32_t) the student's index
+ */
+uint32_t SeatLottery::addStudent(int maxCourses) {
+    loads.push_back(maxCourses);
+    firstChoice.push_back(choices.size());
+    return static_cast<uint32_t>(loads.size() - 1);
+}
+
+/**
+ @brief adds the next choice, in preference order, of the most recently added student
+
+ @details a course must appear at most once in a student's choices
+
+ @param course the course's index from addCourse
+ @param rank the student's waitlist policy rank at the course; lower ranks are admitted first
+ */
+void SeatLottery::addChoice(uint32_t course, int rank) {
+    choices.push_back({course, rank});
+}
+
+/**
+ @brief orders a student's claim on a course: policy rank first, then lottery number
+
+ @param student the student's index
+ @param rank the student's rank at the course
+
+ @return (uint64_t) the key; smaller keys are admitted first
+ */
+uint64_t SeatLottery::priorityKey(uint32_t student, int rank) const {
+    uint64_t biasedRank = static_cast<uint32_t>(rank) ^ 0x80000000u;
+    return (biasedRank << 32) | lotteryNumbers[student];
+}
+
+/**
+ @brief draws the lottery and runs deferred acceptance to completion
+
+ @details students who are turned away re-enter the queue and carry on from their next choice; a student already queued may be queued again, which costs only an empty turn
+
+ @param seed seeds the lottery draw; the same seed and input give the same allocation
+
+ @return (LotteryStats) the sizes of the input and the number of proposals, seats and rejections
+ */
+LotteryStats SeatLottery::run(unsigned long long seed) {
+    size_t studentCount = loads.size();
+    vector<uint32_t> draw(studentCount);
+    iota(draw.begin(), draw.end(), 0);
+    mt19937_64 generator(seed);
+    shuffle(draw.begin(), draw.end(), generator);
+    lotteryNumbers.assign(studentCount, 0);
+    for (size_t position = 0; position < studentCount; position++) {
+        lotteryNumbers[draw[position]] = static_cast<uint32_t>(position);
+    }
+
+    LotteryStats stats;
+    stats.students = studentCount;
+    stats.courses = seats.size();
+    stats.choices = choices.size();
+
+    vector<size_t> nextChoice(firstChoice);
+    vector<int> seatsHeld(studentCount, 0);
+    deque<uint32_t> proposers(draw.begin(), draw.end());
+    while (!proposers.empty()) {
+        uint32_t student = proposers.front();
+        proposers.pop_front();
+        size_t lastChoice = student + 1 < studentCount ? firstChoice[student + 1] : choices.size();
+        while (seatsHeld[student] < loads[student] && nextChoice[student] < lastChoice) {
+            const Choice& choice = choices[nextChoice[student]++];
+            stats.proposals++;
+            pair<uint64_t, uint32_t> claim(priorityKey(student, choice.rank), student);
+            vector<pair<uint64_t, uint32_t>>& admitted = held[choice.course];
+
+            if (seats[choice.course] <= 0) {
+                turnedAway[choice.course].push_back(claim);
+                continue;
+            }
+            if (admitted.size() < static_cast<size_t>(seats[choice.course])) {
+                admitted.push_back(claim);
+                push_heap(admitted.begin(), admitted.end());
+                seatsHeld[student]++;
+                continue;
+            }
+            if (!(claim < admitted.front())) {
+                turnedAway[choice.course].push_back(claim);
+                continue;
+            }
+
+            pop_heap(admitted.begin(), admitted.end());
+            pair<uint64_t, uint32_t> bumped = admitted.back();
+            admitted.back() = claim;
+            push_heap(admitted.begin(), admitted.end());
+            seatsHeld[student]++;
+            seatsHeld[bumped.second]--;
+            turnedAway[choice.course].push_back(bumped);
+            proposers.push_back(bumped.second);
+        }
+    }
+
+    for (size_t course = 0; course < seats.size(); course++) {
+        stats.seatsAssigned += held[course].size();
+        stats.rejections += turnedAway[course].size();
+    }
+    return stats;
+}
+
+/**
+ @brief gets the students a course admitted
+
+ @param course the course's index
+
+ @return (vector<uint32_t>) student indices, best priority first
+ */
+vector<uint32_t> SeatLottery::getAdmitted(uint32_t course) const {
+    vector<pair<uint64_t, uint32_t>> sorted(held[course]);
+    sort(sorted.begin(), sorted.end());
+    vector<uint32_t> students;
+    students.reserve(sorted.size());
+    for (const auto& claim : sorted) {
+        students.push_back(claim.second);
+    }
+    return students;
+}
+
+/**
+ @brief gets the students a course turned away, whether at once or after admitting them for a while
+
+ @param course the course's index
+
+ @return (vector<uint32_t>) student indices, best priority first; the order their waitlist should keep
+ */
+vector<uint32_t> SeatLottery::getTurnedAway(uint32_t course) const {
+    vector<pair<uint64_t, uint32_t>> sorted(turnedAway[course]);
+    sort(sorted.begin(), sorted.end());
+    vector<uint32_t> students;
+    students.reserve(sorted.size());
+    for (const auto& claim : sorted) {
+        students.push_back(claim.second);
+    }
+    return students;
+}
+
+/**
+ @brief gets a student's lottery number from the last run
+
+ @param student the student's index
+
+ @return (uint32_t) the number; lower numbers won ties
+ */
+uint32_t SeatLottery::getLotteryNumber(uint32_t student) const {
+    return lotteryNumbers[student];
+}
@@ -0,0 +1,71 @@
+//
+//  SeatLottery.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef SEAT_LOTTERY_H
+#define SEAT_LOTTERY_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ @brief counts from one run of the seat lottery
+ */
+struct LotteryStats {
+    size_t students = 0;
+    size_t courses = 0;
+    size_t choices = 0;
+    size_t proposals = 0;
+    size_t seatsAssigned = 0;
+    size_t rejections = 0;
+    size_t enrolled = 0;
+    size_t waitlisted = 0;
+};
+
+/**
+ @brief assigns seats for a whole registration window at once from ranked course preferences
+
+ @details student-proposing deferred acceptance over dense student and course indices. every student proposes to their choices in rank order until they hold as many seats as they asked for or run out of choices; a full course keeps the proposers it ranks best and turns the worst one away, who then proposes to their next choice. a course ranks students by their waitlist policy rank and breaks ties with one lottery number per student, drawn once from the seed, so the outcome is stable (no student and course both prefer each other to what they got) and depends on the seed, not on who submitted first. each choice is proposed at most once, so a run costs O(P log C) for P choices and seats per course C
+ */
+class SeatLottery {
+private:
+    struct Choice {
+        uint32_t course;
+        int rank;
+    };
+
+    // per course: open seats, then the tentatively admitted students as a max-heap of (priority key, student) with the worst on top
+    vector<int> seats;
+    vector<vector<pair<uint64_t, uint32_t>>> held;
+    vector<vector<pair<uint64_t, uint32_t>>> turnedAway;
+
+    // per student: seats wanted and the first of their choices, which are stored back to back in rank order
+    vector<int> loads;
+    vector<size_t> firstChoice;
+    vector<Choice> choices;
+    vector<uint32_t> lotteryNumbers;
+
+    uint64_t priorityKey(uint32_t student, int rank) const;
+
+public:
+    SeatLottery();
+
+    uint32_t addCourse(int openSeats);
+    uint32_t addStudent(int maxCourses);
+    void addChoice(uint32_t course, int rank);
+
+    LotteryStats run(unsigned long long seed);
+
+    vector<uint32_t> getAdmitted(uint32_t course) const;
+    vector<uint32_t> getTurnedAway(uint32_t course) const;
+    uint32_t getLotteryNumber(uint32_t student) const;
+};
+
+#endif // SEAT_LOTTERY_H
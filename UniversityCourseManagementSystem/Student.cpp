@@ -6,22 +6,23 @@
 //
 
 #include "Student.h"
-#include <iostream>
 
 /**
  @brief default constructor for the Student class
  
- @details initializes studentID and fullName to empty strings
+ @details initializes studentID, fullName, and major to empty strings and classStanding to 0 (unknown)
  */
 Student::Student() {
     studentID = "";
     fullName = "";
+    classStanding = 0;
+    major = "";
 }
 
 /**
  @brief paramaterized constructor for the Student class
  
- @details initializes studentID and fullName to the provided values
+ @details initializes studentID and fullName to the provided values. classStanding starts unknown (0) and major empty
  
  @param ID the student ID
  @param name the full name of the student
@@ -29,35 +30,66 @@ Student::Student() {
 Student::Student(const string& ID, const string& name) {
     studentID = ID;
     fullName = name;
+    classStanding = 0;
+    major = "";
 }
 
 /**
  @brief returns the student ID
  
- @return (string) the student ID
+ @return (const string&) the student ID
  */
-string Student::getStudentID() const {
+const string& Student::getStudentID() const {
     return studentID;
 }
 
 /**
  @brief returns the student's full name
  
- @return (string) the student's full name
+ @return (const string&) the student's full name
  */
-string Student::getFullName() const {
+const string& Student::getFullName() const {
     return fullName;
 }
 
+/**
+ @brief returns the student's class standing
+ 
+ @return (int) 1 for freshman through 4 for senior, or 0 if unknown
+ */
+int Student::getClassStanding() const {
+    return classStanding;
+}
+
+/**
+ @brief returns the student's major
+ 
+ @return (const string&) the department code of the major (e.g. "CS"), or an empty string if undeclared
+ */
+const string& Student::getMajor() const {
+    return major;
+}
+
 /**
  @brief returns the courses the student is enrolled in
  
- @return (set<string>) the set of strings representing the enrolled course codes
+ @details returns a reference, so iterating the schedule copies nothing. it stays valid until the student is changed or removed
+ 
+ @return (const set<string>&) the set of strings representing the enrolled course codes
  */
-set<string> Student::getEnrolledCourses() const {
+const set<string>& Student::getEnrolledCourses() const {
     return enrolledCourses;
 }
 
+/**
+ @brief returns the courses the student is waiting for a seat in
+ 
+ @return (const set<string>&) the set of course codes whose waitlist holds the student
+ */
+const set<string>& Student::getWaitlistedCourses() const {
+    return waitlistedCourses;
+}
+
 /**
  @brief sets the full name of the student to a new name
  
@@ -67,6 +99,30 @@ void Student::setFullName(const string& name) {
     fullName = name;
 }
 
+/**
+ @brief sets the student's class standing
+ 
+ @details values outside 0-4 are ignored
+ 
+ @param standing 1 for freshman through 4 for senior, or 0 if unknown
+ */
+void Student::setClassStanding(int standing) {
+    if (standing < 0 || standing > 4) {
+        return;
+    }
+    
+    classStanding = standing;
+}
+
+/**
+ @brief sets the student's major
+ 
+ @param majorCode the department code of the major, or an empty string if undeclared
+ */
+void Student::setMajor(const string& majorCode) {
+    major = majorCode;
+}
+
 /**
  @brief enrolls a student in a course
  
@@ -97,6 +153,43 @@ void Student::dropCourse(const string& courseCode) {
     enrolledCourses.erase(courseCode);
 }
 
+/**
+ @brief records that the student joined a course's waitlist
+ 
+ @details if the courseCode is empty, the operation is ignored
+ 
+ @param courseCode the course whose waitlist the student joined
+ */
+void Student::joinWaitlist(const string& courseCode) {
+    if (courseCode.empty()) {
+        return;
+    }
+    
+    waitlistedCourses.insert(courseCode);
+}
+
+/**
+ @brief records that the student left a course's waitlist
+ 
+ @details called when the student is promoted or the course is removed
+ 
+ @param courseCode the course whose waitlist the student left
+ */
+void Student::leaveWaitlist(const string& courseCode) {
+    waitlistedCourses.erase(courseCode);
+}
+
+/**
+ @brief checks if the student is waiting for a seat in a course
+ 
+ @param courseCode the course code to check
+ 
+ @return (bool) true if the student is on the course's waitlist, false otherwise
+ */
+bool Student::isWaitlistedFor(const string& courseCode) const {
+    return waitlistedCourses.find(courseCode) != waitlistedCourses.end();
+}
+
 /**
  @brief returns the number of courses the student is enrolled in
  
@@ -109,16 +202,28 @@ int Student::getEnrollmentCount() const {
 /**
  @brief displays the list of enrolled courses
  
- @details outputs a formatted list of all enrolled course codes to the console. if no courses are enrolled, it notifies the user in the console accordingly
+ @details outputs a formatted list of all enrolled course codes to the given stream. if no courses are enrolled, it notifies the user accordingly
+ 
+ @param os the stream to write to (defaults to the console)
+ */
+void Student::displayEnrolledCourses(ostream& os) const {
+    ReportWriter report(os);
+    displayEnrolledCourses(report);
+}
+
+/**
+ @brief displays the list of enrolled courses into a report
+ 
+ @param report the report to write to
  */
-void Student::displayEnrolledCourses() const {
+void Student::displayEnrolledCourses(ReportWriter& report) const {
     if (enrolledCourses.empty()){
-        cout << "No courses enrolled." << endl;
+        report << "No courses enrolled.\n";
         return;
     }
     
-    cout << "Enrolled Courses: " << endl;
+    report << "Enrolled Courses: \n";
     for (const auto& course : enrolledCourses) {
-        cout << " - " << course << endl;
+        report << " - " << course << '\n';
     }
 }
@@ -8,8 +8,10 @@
 #ifndef STUDENT_H
 #define STUDENT_H
 
+#include "ReportWriter.h"
 #include <string>
 #include <set>
+#include <iostream>
 
 using namespace std;
 
@@ -17,22 +19,42 @@ class Student {
 private:
     string studentID;
     string fullName;
+    int classStanding;
+    string major;
     set<string> enrolledCourses;
+    set<string> waitlistedCourses;
 public:
     Student();
     Student(const string& ID, const string& name);
     
-    string getStudentID() const;
-    string getFullName() const;
-    set<string> getEnrolledCourses() const;
+    const string& getStudentID() const;
+    const string& getFullName() const;
+    int getClassStanding() const;
+    const string& getMajor() const;
+    const set<string>& getEnrolledCourses() const;
+    const set<string>& getWaitlistedCourses() const;
+    
+    template <typename Visitor>
+    void forEachEnrolledCourse(Visitor&& visit) const {
+        for (const auto& courseCode : enrolledCourses) {
+            visit(courseCode);
+        }
+    }
     
     void setFullName(const string& name);
+    void setClassStanding(int standing);
+    void setMajor(const string& majorCode);
     
     void enrollInCourse(const string& courseCode);
     void dropCourse(const string& courseCode);
     
+    void joinWaitlist(const string& courseCode);
+    void leaveWaitlist(const string& courseCode);
+    bool isWaitlistedFor(const string& courseCode) const;
+    
     int getEnrollmentCount() const;
-    void displayEnrolledCourses() const;
+    void displayEnrolledCourses(ostream& os = cout) const;
+    void displayEnrolledCourses(ReportWriter& report) const;
 };
 
 #endif // STUDENT_H
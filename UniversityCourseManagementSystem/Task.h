@@ -0,0 +1,163 @@
+//
+//  Task.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef TASK_H
+#define TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+using namespace std;
+
+template <typename T>
+class Task;
+
+// state shared by every Task promise: who to resume when the coroutine finishes, and what it threw
+struct TaskPromiseBase {
+    coroutine_handle<> continuation;
+    exception_ptr error;
+    bool detached = false;
+
+    // resumes the awaiting coroutine directly (symmetric transfer), or frees a detached coroutine's frame
+    struct FinalAwaiter {
+        bool await_ready() noexcept {
+            return false;
+        }
+
+        template <typename Promise>
+        coroutine_handle<> await_suspend(coroutine_handle<Promise> finished) noexcept {
+            TaskPromiseBase& promise = finished.promise();
+            if (promise.continuation) {
+                return promise.continuation;
+            }
+            if (promise.detached) {
+                finished.destroy();
+            }
+            return noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    suspend_always initial_suspend() noexcept {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() noexcept {
+        return {};
+    }
+
+    void unhandled_exception() {
+        error = current_exception();
+    }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    optional<T> value;
+
+    Task<T> get_return_object();
+
+    template <typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T take() {
+        if (error) {
+            rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+
+    void return_void() {}
+
+    void take() {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+};
+
+/**
+ @brief a lazily started coroutine that produces a T
+
+ @details nothing runs until the task is awaited (or handed to Executor::spawn). awaiting starts it and suspends the caller until it finishes; the caller is then resumed directly, without a trip through the executor. exceptions thrown inside are rethrown from the co_await. move-only; the frame is destroyed with the Task, or by the coroutine itself once a detached task finishes
+ */
+template <typename T>
+class Task {
+public:
+    using promise_type = TaskPromise<T>;
+
+private:
+    coroutine_handle<promise_type> handle;
+
+public:
+    explicit Task(coroutine_handle<promise_type> coroutine) : handle(coroutine) {}
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept {
+        return !handle || handle.done();
+    }
+
+    coroutine_handle<> await_suspend(coroutine_handle<> caller) noexcept {
+        handle.promise().continuation = caller;
+        return handle;
+    }
+
+    T await_resume() {
+        return handle.promise().take();
+    }
+
+    /**
+     @brief gives up ownership of the frame so the coroutine frees itself when it finishes
+
+     @return (coroutine_handle<>) the handle to resume to start the task
+     */
+    coroutine_handle<> detach() {
+        handle.promise().detached = true;
+        return std::exchange(handle, nullptr);
+    }
+};
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+#endif // TASK_H
@@ -0,0 +1,280 @@
+//
+//  TermBench.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "TermRegistry.h"
+#include "TrafficRecorder.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+/**
+ @brief one enroll or drop against a term
+ */
+struct TermOperation {
+    bool enroll;
+    int student;
+    int course;
+};
+
+/**
+ @brief opens every term with its own courses, on top of one shared set of students
+
+ @param registry the registry to fill
+ @param termCount the number of terms
+ @param studentCount the number of master students
+ @param courseCount courses per term
+ */
+void buildRegistry(TermRegistry& registry, int termCount, int studentCount, int courseCount) {
+    for (int s = 0; s < studentCount; s++) {
+        registry.addStudent("S" + to_string(s), "Student Number " + to_string(s));
+    }
+    for (int t = 0; t < termCount; t++) {
+        registry.openTerm("T" + to_string(t));
+        registry.getTerm("T" + to_string(t))->with([&](UniversitySystem& system) {
+            for (int c = 0; c < courseCount; c++) {
+                system.addCourse("C" + to_string(c), "Course " + to_string(c), "Dr. Instructor " + to_string(c % 97), 20 + (c * 7 + t) % 40);
+            }
+        });
+    }
+}
+
+/**
+ @brief runs one term's operations the way a worker serving that term would
+
+ @details the partition is fetched once; every operation then takes only the partition's own lock
+
+ @param registry the registry
+ @param term the term to serve
+ @param operations the term's operations
+ */
+void serveTerm(TermRegistry& registry, const string& term, const vector<TermOperation>& operations) {
+    shared_ptr<TermPartition> partition = registry.getTerm(term);
+    for (const auto& operation : operations) {
+        partition->with([&](UniversitySystem& system) {
+            string studentID = "S" + to_string(operation.student);
+            string courseCode = "C" + to_string(operation.course);
+            return operation.enroll ? system.enrollStudentInCourse(studentID, courseCode) : system.dropStudentFromCourse(studentID, courseCode);
+        });
+    }
+}
+
+/**
+ @brief adds students to the master data, which reaches every term
+
+ @param registry the registry
+ @param count the number of students to add
+ */
+void addLateStudents(TermRegistry& registry, int count) {
+    for (int s = 0; s < count; s++) {
+        registry.addStudent("L" + to_string(s), "Late Student " + to_string(s));
+    }
+}
+
+/**
+ @brief gets the state digest of one term, paging it in if it is stored
+
+ @param registry the registry
+ @param term the term
+
+ @return (uint64_t) the digest
+ */
+uint64_t termDigest(TermRegistry& registry, const string& term) {
+    return registry.getTerm(term)->with([](const UniversitySystem& system) {
+        return system.stateDigest();
+    });
+}
+
+/**
+ @brief gets the state digest of every term
+
+ @param registry the registry
+ @param termCount the number of terms
+
+ @return (vector<uint64_t>) one digest per term
+ */
+vector<uint64_t> termDigests(TermRegistry& registry, int termCount) {
+    vector<uint64_t> digests;
+    for (int t = 0; t < termCount; t++) {
+        digests.push_back(termDigest(registry, "T" + to_string(t)));
+    }
+    return digests;
+}
+
+/**
+ @brief lists the students enrolled in a course of a resident term
+
+ @param registry the registry
+ @param term the term
+ @param courseCode the course
+
+ @return (vector<string>) the student IDs in roster order
+ */
+vector<string> residentRoster(TermRegistry& registry, const string& term, const string& courseCode) {
+    vector<string> roster;
+    registry.getTerm(term)->with([&](const UniversitySystem& system) {
+        system.findCourse(courseCode)->forEachEnrolledStudent([&](const string& studentID) {
+            roster.push_back(studentID);
+        });
+    });
+    return roster;
+}
+
+/**
+ @brief pages more terms than fit in memory through a term store and checks that each comes back unchanged
+
+ @details every term is filled while resident and its digest and one roster noted; opening the next term writes the least recently used ones back. every other term has a course split into sections, whose seats and shared waitlist have to come back as they were. each term is then paged in again, a cold roster is read straight from the store, and the store is closed and reopened as after a restart
+
+ @param termCount the number of terms to store
+ @param residentTerms the most terms kept in memory
+ @param cachePages the store's page cache size
+ @param studentCount the number of master students
+ @param courseCount courses per term
+ @param operations the operations of each term, reused round-robin
+
+ @return (bool) true if every check passed
+ */
+bool runStoreChecks(int termCount, size_t residentTerms, size_t cachePages, int studentCount, int courseCount, const vector<vector<TermOperation>>& operations) {
+    string storeFile = "university_term_bench.store";
+    remove(storeFile.c_str());
+    ostream discard(nullptr);
+    vector<uint64_t> digests;
+    vector<vector<string>> rosters;
+    Clock::time_point start = Clock::now();
+    bool ok = true;
+    {
+        TermRegistry registry;
+        registry.setOutputStream(discard);
+        ok = registry.attachStore(storeFile, residentTerms, cachePages);
+        buildRegistry(registry, 0, studentCount, courseCount);
+        for (int t = 0; t < termCount && ok; t++) {
+            string term = "T" + to_string(t);
+            registry.openTerm(term);
+            registry.getTerm(term)->with([&](UniversitySystem& system) {
+                for (int c = 0; c < courseCount; c++) {
+                    system.addCourse("C" + to_string(c), "Course " + to_string(c), "Dr. Instructor " + to_string(c % 97), 20 + (c * 7 + t) % 40);
+                }
+                // every other term splits C0 into sections, so a paged-in term must restore section seats and the shared waitlist
+                if (t % 2 == 0 && courseCount > 3) {
+                    system.addSection("C0", "C1");
+                    system.addSection("C0", "C2");
+                }
+            });
+            serveTerm(registry, term, operations[t % operations.size()]);
+            digests.push_back(termDigest(registry, term));
+            rosters.push_back(residentRoster(registry, term, "C0"));
+        }
+        double fillMillis = chrono::duration<double, milli>(Clock::now() - start).count();
+
+        TermStorageStats stats = registry.getStorageStats();
+        ok = ok && stats.residentTerms <= residentTerms && stats.storedTerms > 0;
+        pair<bool, vector<string>> coldRoster = registry.getRoster("T0", "C0");
+        ok = ok && !registry.isTermResident("T0") && coldRoster.first && coldRoster.second == rosters[0];
+
+        start = Clock::now();
+        bool pagedBack = termDigests(registry, termCount) == digests;
+        double pageMillis = chrono::duration<double, milli>(Clock::now() - start).count();
+        stats = registry.getStorageStats();
+        cout << "store: " << termCount << " terms, " << residentTerms << " resident, " << cachePages << " cached pages" << endl;
+        cout << "  filled and written back:  " << setw(10) << fillMillis << " ms" << endl;
+        cout << "  paged every term back in: " << setw(10) << pageMillis << " ms" << endl;
+        cout << "  page-ins: " << stats.pageIns << " | write-backs: " << stats.writeBacks << " | store pages: " << stats.storePages
+             << " | cache hits: " << stats.cache.hits << " | misses: " << stats.cache.misses << " | evictions: " << stats.cache.evictions << endl;
+        cout << "  terms match after paging: " << setw(10) << (pagedBack ? "yes" : "NO") << endl;
+        cout << "  cold roster matches:      " << setw(10) << (ok ? "yes" : "NO") << endl;
+        ok = ok && pagedBack && registry.detachStore();
+    }
+
+    // a restart: a new registry sees only what the store holds
+    TermRegistry reopened;
+    reopened.setOutputStream(discard);
+    bool restarted = reopened.attachStore(storeFile, residentTerms, cachePages) && reopened.getStudentCount() == studentCount &&
+                     static_cast<int>(reopened.getTermNames().size()) == termCount && termDigests(reopened, termCount) == digests;
+    cout << "  terms match after reopen: " << setw(10) << (restarted ? "yes" : "NO") << endl;
+    reopened.detachStore();
+    remove(storeFile.c_str());
+    return ok && restarted;
+}
+
+int main(int argc, const char * argv[]) {
+    int termCount = argc > 1 ? stoi(argv[1]) : 4;
+    int studentCount = argc > 2 ? stoi(argv[2]) : 20000;
+    int courseCount = argc > 3 ? stoi(argv[3]) : 400;
+    int operationsPerTerm = argc > 4 ? stoi(argv[4]) : 200000;
+    int storedTerms = argc > 5 ? stoi(argv[5]) : 12;
+    size_t residentTerms = argc > 6 ? stoul(argv[6]) : 3;
+    size_t cachePages = argc > 7 ? stoul(argv[7]) : 64;
+    int lateStudents = 2000;
+
+    vector<vector<TermOperation>> operations(termCount);
+    for (int t = 0; t < termCount; t++) {
+        mt19937 generator(2025 + t);
+        uniform_int_distribution<int> pickStudent(0, studentCount - 1);
+        uniform_int_distribution<int> pickCourse(0, courseCount - 1);
+        for (int i = 0; i < operationsPerTerm; i++) {
+            operations[t].push_back({generator() % 3 != 0, pickStudent(generator), pickCourse(generator)});
+        }
+    }
+    ostream discard(nullptr);
+    cout << "Terms: " << termCount << " | Students: " << studentCount << " | Courses per term: " << courseCount
+         << " | Operations per term: " << operationsPerTerm << " | Hardware threads: " << thread::hardware_concurrency() << endl;
+    cout << fixed << setprecision(1);
+
+    // one thread serves every term in turn
+    TermRegistry serial;
+    serial.setOutputStream(discard);
+    buildRegistry(serial, termCount, studentCount, courseCount);
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < termCount; t++) {
+        serveTerm(serial, "T" + to_string(t), operations[t]);
+    }
+    addLateStudents(serial, lateStudents);
+    double serialMillis = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    // one worker per term, while the master data changes underneath them
+    TermRegistry parallel;
+    parallel.setOutputStream(discard);
+    buildRegistry(parallel, termCount, studentCount, courseCount);
+    start = Clock::now();
+    vector<thread> workers;
+    for (int t = 0; t < termCount; t++) {
+        workers.emplace_back(serveTerm, ref(parallel), "T" + to_string(t), cref(operations[t]));
+    }
+    addLateStudents(parallel, lateStudents);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double parallelMillis = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    double totalOperations = static_cast<double>(termCount) * operationsPerTerm;
+    cout << "one thread:            " << setw(10) << serialMillis << " ms (" << setw(10) << totalOperations / serialMillis * 1000 << " ops/sec)" << endl;
+    cout << "one worker per term:   " << setw(10) << parallelMillis << " ms (" << setw(10) << totalOperations / parallelMillis * 1000 << " ops/sec)" << endl;
+    cout << "speedup:               " << setw(10) << serialMillis / parallelMillis << "x" << endl;
+
+    vector<uint64_t> expected = termDigests(serial, termCount);
+    bool matched = termDigests(parallel, termCount) == expected;
+    cout << "terms match serial:    " << setw(10) << (matched ? "yes" : "NO") << endl;
+
+    // a term saved, restored under another name and dropped leaves the others alone
+    string fileName = "university_term_bench.out";
+    bool roundTrip = parallel.saveTerm("T0", fileName) && parallel.restoreTerm("COPY", fileName);
+    unique_ptr<UniversitySystem> copy = parallel.snapshotTerm("COPY");
+    roundTrip = roundTrip && copy && copy->stateDigest() == expected[0] && parallel.dropTerm("COPY") && !parallel.getTerm("COPY");
+    roundTrip = roundTrip && termDigests(parallel, termCount) == expected && parallel.getStudentCount() == studentCount + lateStudents;
+    cout << "save/restore/drop:     " << setw(10) << (roundTrip ? "yes" : "NO") << endl;
+    remove(fileName.c_str());
+
+    bool stored = runStoreChecks(storedTerms, residentTerms, cachePages, studentCount, courseCount, operations);
+    return matched && roundTrip && stored ? 0 : 1;
+}
@@ -0,0 +1,762 @@
+//
+//  TermRegistry.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/7/25.
+//
+
+#include "TermRegistry.h"
+#include <limits>
+#include <set>
+
+/**
+ @brief default constructor for a StudentRecord
+
+ @details initializes every field to empty and the class standing to 0 (unknown)
+ */
+StudentRecord::StudentRecord() {
+    studentID = "";
+    fullName = "";
+    classStanding = 0;
+    major = "";
+}
+
+/**
+ @brief constructs a StudentRecord with an ID and name
+
+ @param ID the student ID
+ @param name the full name of the student
+ */
+StudentRecord::StudentRecord(const string& ID, const string& name) {
+    studentID = ID;
+    fullName = name;
+    classStanding = 0;
+    major = "";
+}
+
+/**
+ @brief constructs an empty partition for a term
+
+ @details the term's messages are discarded so partitions never share an output stream. a worker can redirect them with with([&](UniversitySystem& system) { system.setOutputStream(...); })
+
+ @param termName the name of the term (e.g. "2025FA")
+ */
+TermPartition::TermPartition(const string& termName) : term(termName), discard(nullptr), lastUsed(0) {
+    system.setOutputStream(discard);
+    storedVersion = numeric_limits<unsigned long long>::max();
+}
+
+/**
+ @brief returns the name of the term
+
+ @return (const string&) the term name
+ */
+const string& TermPartition::getTerm() const {
+    return term;
+}
+
+/**
+ @brief constructs an empty TermRegistry
+
+ @details messages from the registry and its partitions go to the console until setOutputStream is called. every term stays in memory until attachStore is called
+ */
+TermRegistry::TermRegistry() : useClock(0) {
+    out = &cout;
+    residentLimit = numeric_limits<size_t>::max();
+    pageIns = 0;
+    writeBacks = 0;
+}
+
+/**
+ @brief writes every changed term back to the attached store, if there is one
+ */
+TermRegistry::~TermRegistry() {
+    detachStore();
+}
+
+/**
+ @brief redirects registry messages to another stream
+
+ @details partitions keep their own streams
+
+ @param os the stream to write to. it must outlive the registry
+ */
+void TermRegistry::setOutputStream(ostream& os) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    out = &os;
+}
+
+/**
+ @brief adds one master student record to a term's system
+
+ @param system the term's system
+ @param record the master record
+ */
+void TermRegistry::applyStudentRecord(UniversitySystem& system, const StudentRecord& record) const {
+    system.addStudent(record.studentID, record.fullName);
+    if (record.classStanding != 0 || !record.major.empty()) {
+        system.setStudentProfile(record.studentID, record.classStanding, record.major);
+    }
+}
+
+/**
+ @brief adds every master student that a term's system does not have yet
+
+ @details caller must hold the registry lock and own the system exclusively
+
+ @param system the term's system
+ */
+void TermRegistry::seedStudents(UniversitySystem& system) const {
+    for (const auto& entry : studentMaster) {
+        if (!system.findStudent(entry.first)) {
+            applyStudentRecord(system, entry.second);
+        }
+    }
+}
+
+/**
+ @brief copies students that only exist in one partition into the master data and every other partition
+
+ @details used after a term was loaded from a file with its own STUDENT lines. takes the registry lock exclusively and then each partition lock in turn
+
+ @param source the partition that was just loaded
+ */
+void TermRegistry::adoptNewStudents(const TermPartition& source) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    
+    vector<StudentRecord> adopted;
+    source.with([&](const UniversitySystem& system) {
+        system.forEachStudent([&](const Student& student) {
+            if (studentMaster.find(student.getStudentID()) == studentMaster.end()) {
+                StudentRecord record(student.getStudentID(), student.getFullName());
+                record.classStanding = student.getClassStanding();
+                record.major = student.getMajor();
+                adopted.push_back(record);
+            }
+        });
+    });
+    
+    for (const auto& record : adopted) {
+        studentMaster[record.studentID] = record;
+    }
+    
+    for (const auto& entry : partitions) {
+        if (entry.second.get() == &source) {
+            continue;
+        }
+        entry.second->with([&](UniversitySystem& system) {
+            for (const auto& record : adopted) {
+                if (!system.findStudent(record.studentID)) {
+                    applyStudentRecord(system, record);
+                }
+            }
+        });
+    }
+}
+
+/**
+ @brief opens a new, empty term seeded with every master student
+
+ @param term the name of the term
+
+ @return (bool) true if the term was opened, false if the name is empty or already open
+ */
+bool TermRegistry::openTerm(const string& term) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    if (term.empty() || partitions.find(term) != partitions.end() || (store && store->hasTerm(term))) {
+        *out << "term is blank or already open -- can't open" << endl;
+        return false;
+    }
+    
+    auto partition = make_shared<TermPartition>(term);
+    seedStudents(partition->system);
+    partition->lastUsed.store(++useClock, memory_order_relaxed);
+    partitions[term] = partition;
+    evictColdTerms(term);
+    return true;
+}
+
+/**
+ @brief drops a term and all of its courses and enrollments
+
+ @details workers still holding the partition can finish their current work; the memory is released when the last holder lets go. a stored copy is erased too
+
+ @param term the name of the term
+
+ @return (bool) true if the term was dropped, false if it was not open
+ */
+bool TermRegistry::dropTerm(const string& term) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    bool dropped = partitions.erase(term) > 0;
+    if (store && store->eraseTerm(term)) {
+        dropped = true;
+    }
+    if (!dropped) {
+        *out << "term doesn't exist -- can't drop" << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ @brief returns the partition of a term
+
+ @details a worker thread fetches this once and then serves the term through TermPartition::with, so the registry lock is never on the enrollment path
+
+ @param term the name of the term
+
+ @return (shared_ptr<TermPartition>) the partition, or nullptr if the term is not open
+ */
+shared_ptr<TermPartition> TermRegistry::getTerm(const string& term) const {
+    {
+        shared_lock<shared_mutex> guard(registryMutex);
+        auto iter = partitions.find(term);
+        if (iter != partitions.end()) {
+            iter->second->lastUsed.store(++useClock, memory_order_relaxed);
+            return iter->second;
+        }
+        if (!store) {
+            return nullptr;
+        }
+    }
+    unique_lock<shared_mutex> guard(registryMutex);
+    return pageIn(term);
+}
+
+/**
+ @brief returns the names of every open term
+
+ @return (vector<string>) the term names in sorted order
+ */
+vector<string> TermRegistry::getTermNames() const {
+    shared_lock<shared_mutex> guard(registryMutex);
+    set<string> names;
+    for (const auto& entry : partitions) {
+        names.insert(entry.first);
+    }
+    if (store) {
+        for (const auto& term : store->getTermNames()) {
+            names.insert(term);
+        }
+    }
+    return vector<string>(names.begin(), names.end());
+}
+
+/**
+ @brief loads a data file into one term
+
+ @details courses and enrollments stay in the term. students that are new to the registry are added to the master data and to every other term
+
+ @param term the name of the term
+ @param fileName path to the data file
+
+ @return (bool) true if the file was loaded, false otherwise
+ */
+bool TermRegistry::loadTerm(const string& term, const string& fileName) {
+    shared_ptr<TermPartition> partition = getTerm(term);
+    if (!partition) {
+        *out << "term doesn't exist -- can't load" << endl;
+        return false;
+    }
+    
+    bool loaded = partition->with([&](UniversitySystem& system) {
+        return system.loadFromFile(fileName);
+    });
+    if (loaded) {
+        adoptNewStudents(*partition);
+    }
+    return loaded;
+}
+
+/**
+ @brief writes a term to a data file
+
+ @param term the name of the term
+ @param fileName path of the file to write
+
+ @return (bool) true if the file was written, false otherwise
+ */
+bool TermRegistry::saveTerm(const string& term, const string& fileName) const {
+    shared_ptr<TermPartition> partition = getTerm(term);
+    if (!partition) {
+        *out << "term doesn't exist -- can't save" << endl;
+        return false;
+    }
+    
+    return partition->with([&](const UniversitySystem& system) {
+        return system.saveToFile(fileName);
+    });
+}
+
+/**
+ @brief replaces a term with the contents of a saved data file
+
+ @details the file is loaded into a fresh partition before it is published, so workers see either the old term or the restored one. master students missing from the file are added afterwards
+
+ @param term the name of the term (opened if it does not exist)
+ @param fileName path to a file written by saveTerm
+
+ @return (bool) true if the term was restored, false otherwise
+ */
+bool TermRegistry::restoreTerm(const string& term, const string& fileName) {
+    if (term.empty()) {
+        *out << "term is blank -- can't restore" << endl;
+        return false;
+    }
+    
+    auto partition = make_shared<TermPartition>(term);
+    if (!partition->system.loadFromFile(fileName)) {
+        return false;
+    }
+    
+    {
+        unique_lock<shared_mutex> guard(registryMutex);
+        seedStudents(partition->system);
+        partition->lastUsed.store(++useClock, memory_order_relaxed);
+        partitions[term] = partition;
+    }
+    adoptNewStudents(*partition);
+    {
+        unique_lock<shared_mutex> guard(registryMutex);
+        evictColdTerms(term);
+    }
+    return true;
+}
+
+/**
+ @brief takes an in-memory point-in-time copy of a term
+
+ @param term the name of the term
+
+ @return (unique_ptr<UniversitySystem>) the copy (writing its messages to the console), or nullptr if the term is not open
+ */
+unique_ptr<UniversitySystem> TermRegistry::snapshotTerm(const string& term) const {
+    shared_ptr<TermPartition> partition = getTerm(term);
+    if (!partition) {
+        return nullptr;
+    }
+    
+    unique_ptr<UniversitySystem> copy = partition->with([](const UniversitySystem& system) {
+        return make_unique<UniversitySystem>(system);
+    });
+    copy->setOutputStream(cout);
+    return copy;
+}
+
+/**
+ @brief adds a student to the master data and to every open term
+
+ @param studentID the unique ID of the student
+ @param fullName the full name of the student
+
+ @return (bool) true if added, false if a field is blank or the ID already exists
+ */
+bool TermRegistry::addStudent(const string& studentID, const string& fullName) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    if (studentID.empty() || fullName.empty()) {
+        *out << "one of the fields is blank -- cannot add a new student" << endl;
+        return false;
+    }
+    if (studentMaster.find(studentID) != studentMaster.end()) {
+        *out << "student already exists" << endl;
+        return false;
+    }
+    
+    StudentRecord record(studentID, fullName);
+    studentMaster[studentID] = record;
+    for (const auto& entry : partitions) {
+        entry.second->with([&](UniversitySystem& system) {
+            applyStudentRecord(system, record);
+        });
+    }
+    return true;
+}
+
+/**
+ @brief renames a student in the master data and every open term
+
+ @param studentID the ID of the student
+ @param newName the new full name
+
+ @return (bool) true if updated, false if the student does not exist
+ */
+bool TermRegistry::updateStudent(const string& studentID, const string& newName) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    auto iter = studentMaster.find(studentID);
+    if (iter == studentMaster.end()) {
+        *out << "student doesn't exist -- can't update" << endl;
+        return false;
+    }
+    
+    iter->second.fullName = newName;
+    for (const auto& entry : partitions) {
+        entry.second->with([&](UniversitySystem& system) {
+            system.updateStudent(studentID, newName);
+        });
+    }
+    return true;
+}
+
+/**
+ @brief sets a student's class standing and major in the master data and every open term
+
+ @param studentID the ID of the student
+ @param classStanding 1 for freshman through 4 for senior, or 0 if unknown
+ @param major the department code of the major, or an empty string if undeclared
+
+ @return (bool) true if updated, false otherwise
+ */
+bool TermRegistry::setStudentProfile(const string& studentID, int classStanding, const string& major) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    auto iter = studentMaster.find(studentID);
+    if (iter == studentMaster.end()) {
+        *out << "student doesn't exist -- can't update" << endl;
+        return false;
+    }
+    if (classStanding < 0 || classStanding > 4) {
+        *out << "class standing must be between 0 and 4" << endl;
+        return false;
+    }
+    
+    iter->second.classStanding = classStanding;
+    iter->second.major = major;
+    for (const auto& entry : partitions) {
+        entry.second->with([&](UniversitySystem& system) {
+            system.setStudentProfile(studentID, classStanding, major);
+        });
+    }
+    return true;
+}
+
+/**
+ @brief removes a student from the master data and every open term
+
+ @param studentID the ID of the student
+
+ @return (bool) true if removed, false if the student does not exist
+ */
+bool TermRegistry::removeStudent(const string& studentID) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    if (studentMaster.erase(studentID) == 0) {
+        *out << "student doesn't exist -- can't remove" << endl;
+        return false;
+    }
+    
+    for (const auto& entry : partitions) {
+        entry.second->with([&](UniversitySystem& system) {
+            if (system.findStudent(studentID)) {
+                system.removeStudent(studentID);
+            }
+        });
+    }
+    return true;
+}
+
+/**
+ @brief looks up a student's master record
+
+ @param studentID the ID of the student
+
+ @return (pair<bool, StudentRecord>) (true, record) if found, (false, empty record) otherwise
+ */
+pair<bool, StudentRecord> TermRegistry::findStudent(const string& studentID) const {
+    shared_lock<shared_mutex> guard(registryMutex);
+    auto iter = studentMaster.find(studentID);
+    if (iter == studentMaster.end()) {
+        return make_pair(false, StudentRecord());
+    }
+    return make_pair(true, iter->second);
+}
+
+/**
+ @brief returns the number of students in the master data
+
+ @return (int) the number of students
+ */
+int TermRegistry::getStudentCount() const {
+    shared_lock<shared_mutex> guard(registryMutex);
+    return studentMaster.size();
+}
+
+/**
+ @brief brings a term's students in line with the master data after it was paged in
+
+ @details master changes are only applied to terms in memory, so a stored term catches up here: students removed from the master data are removed, renamed or re-profiled students are updated, and new master students are added. caller must hold the registry lock exclusively and own the system
+
+ @param system the paged-in term's system
+ */
+void TermRegistry::reconcileStudents(UniversitySystem& system) const {
+    vector<string> removed;
+    vector<const StudentRecord*> changed;
+    system.forEachStudent([&](const Student& student) {
+        auto iter = studentMaster.find(student.getStudentID());
+        if (iter == studentMaster.end()) {
+            removed.push_back(student.getStudentID());
+        } else if (iter->second.fullName != student.getFullName() || iter->second.classStanding != student.getClassStanding() ||
+                   iter->second.major != student.getMajor()) {
+            changed.push_back(&iter->second);
+        }
+    });
+    
+    system.removeStudents(removed);
+    for (const StudentRecord* record : changed) {
+        system.updateStudent(record->studentID, record->fullName);
+        system.setStudentProfile(record->studentID, record->classStanding, record->major);
+    }
+    seedStudents(system);
+}
+
+/**
+ @brief loads a stored term into memory
+
+ @details caller must hold the registry lock exclusively. the term is marked clean as read, so if reconciling with the master data changed it, it is written back when evicted. other terms may be evicted to stay within the resident limit
+
+ @param term the term name
+
+ @return (shared_ptr<TermPartition>) the partition, or nullptr if the term is neither in memory nor stored
+ */
+shared_ptr<TermPartition> TermRegistry::pageIn(const string& term) const {
+    auto iter = partitions.find(term);
+    if (iter != partitions.end()) {
+        iter->second->lastUsed.store(++useClock, memory_order_relaxed);
+        return iter->second;
+    }
+    
+    auto partition = make_shared<TermPartition>(term);
+    if (!store || !store->readTerm(term, partition->system)) {
+        return nullptr;
+    }
+    partition->storedVersion = partition->system.getVersion();
+    reconcileStudents(partition->system);
+    partition->lastUsed.store(++useClock, memory_order_relaxed);
+    partitions[term] = partition;
+    pageIns++;
+    evictColdTerms(term);
+    return partition;
+}
+
+/**
+ @brief writes a term to the store if it changed since it was last stored
+
+ @details caller must hold the registry lock exclusively; the partition's own lock is taken while it is written
+
+ @param partition the term
+
+ @return (bool) true if the stored copy is now current
+ */
+bool TermRegistry::writeBack(TermPartition& partition) const {
+    return partition.with([&](const UniversitySystem& system) {
+        if (system.getVersion() == partition.storedVersion) {
+            return true;
+        }
+        if (!store->writeTerm(partition.term, system)) {
+            return false;
+        }
+        partition.storedVersion = system.getVersion();
+        writeBacks++;
+        return true;
+    });
+}
+
+/**
+ @brief writes least recently used terms to the store and drops them from memory until at most residentLimit are left
+
+ @details caller must hold the registry lock exclusively. a term some worker still holds a shared_ptr to is never evicted, since the worker could still change it; neither is keep, the term the caller is about to return
+
+ @param keep the term to keep in memory
+ */
+void TermRegistry::evictColdTerms(const string& keep) const {
+    if (!store) {
+        return;
+    }
+    while (partitions.size() > residentLimit) {
+        auto victim = partitions.end();
+        for (auto iter = partitions.begin(); iter != partitions.end(); ++iter) {
+            if (iter->first == keep || iter->second.use_count() > 1) {
+                continue;
+            }
+            if (victim == partitions.end() || iter->second->lastUsed.load(memory_order_relaxed) < victim->second->lastUsed.load(memory_order_relaxed)) {
+                victim = iter;
+            }
+        }
+        if (victim == partitions.end() || !writeBack(*victim->second)) {
+            return;
+        }
+        partitions.erase(victim);
+    }
+}
+
+/**
+ @brief saves the master student records to the store
+
+ @details caller must hold the registry lock
+
+ @return (bool) true if written
+ */
+bool TermRegistry::writeStudentMaster() const {
+    map<string, string> records;
+    for (const auto& entry : studentMaster) {
+        records[entry.first] = to_string(entry.second.classStanding) + "," + entry.second.major + "," + entry.second.fullName;
+    }
+    return store->writeRecordSet("students", records);
+}
+
+/**
+ @brief keeps terms in an on-disk store so only the most recently used ones stay in memory
+
+ @details the store's master student records are merged in (records already in memory win), but no term is read until it is first used. from then on, whenever more than residentTerms terms are in memory the least recently used ones are written to the store and released; getTerm pages them back in on demand
+
+ @param fileName path of the store file, created if missing
+ @param residentTerms the most terms to keep in memory
+ @param cachePages the most 4 KB store pages to cache
+
+ @return (bool) true if the store was opened
+ */
+bool TermRegistry::attachStore(const string& fileName, size_t residentTerms, size_t cachePages) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    if (store) {
+        *out << "a term store is already attached" << endl;
+        return false;
+    }
+    auto opened = make_unique<TermStore>();
+    if (!opened->open(fileName, cachePages)) {
+        *out << "Error: Could not open term store " << fileName << endl;
+        return false;
+    }
+    
+    opened->readRecordSet("students", [&](const string& studentID, const string& value) {
+        if (studentMaster.find(studentID) != studentMaster.end()) {
+            return;
+        }
+        size_t first = value.find(',');
+        size_t second = value.find(',', first + 1);
+        if (first == string::npos || second == string::npos) {
+            return;
+        }
+        StudentRecord record(studentID, value.substr(second + 1));
+        record.classStanding = atoi(value.substr(0, first).c_str());
+        record.major = value.substr(first + 1, second - first - 1);
+        studentMaster[studentID] = record;
+    });
+    
+    store = std::move(opened);
+    residentLimit = max<size_t>(1, residentTerms);
+    evictColdTerms("");
+    return true;
+}
+
+/**
+ @brief writes every changed term and the master student records to the store, then closes it
+
+ @details terms in memory stay there; terms that were only in the store are no longer visible until the store is attached again
+
+ @return (bool) true if everything was written, false if a write failed or no store was attached
+ */
+bool TermRegistry::detachStore() {
+    unique_lock<shared_mutex> guard(registryMutex);
+    if (!store) {
+        return false;
+    }
+    bool ok = writeStudentMaster();
+    for (const auto& entry : partitions) {
+        ok = writeBack(*entry.second) && ok;
+    }
+    store->close();
+    store.reset();
+    residentLimit = numeric_limits<size_t>::max();
+    return ok;
+}
+
+/**
+ @brief writes a term to the store and drops it from memory now
+
+ @param term the term name
+
+ @return (bool) true if the term is now only on disk, false if there is no store, the term isn't in memory, a worker still holds it, or the write failed
+ */
+bool TermRegistry::archiveTerm(const string& term) {
+    unique_lock<shared_mutex> guard(registryMutex);
+    auto iter = partitions.find(term);
+    if (!store || iter == partitions.end()) {
+        *out << "term isn't in memory or no store is attached -- can't archive" << endl;
+        return false;
+    }
+    if (iter->second.use_count() > 1) {
+        *out << "term is in use -- can't archive" << endl;
+        return false;
+    }
+    if (!writeBack(*iter->second) || !writeStudentMaster()) {
+        *out << "Error: Could not write term " << term << " to the store" << endl;
+        return false;
+    }
+    partitions.erase(iter);
+    return true;
+}
+
+/**
+ @brief checks if a term is in memory
+
+ @param term the term name
+
+ @return (bool) true if the term is in memory, false if it is only stored or doesn't exist
+ */
+bool TermRegistry::isTermResident(const string& term) const {
+    shared_lock<shared_mutex> guard(registryMutex);
+    return partitions.find(term) != partitions.end();
+}
+
+/**
+ @brief lists the students enrolled in one course of a term
+
+ @details a stored term is answered with one lookup in the store instead of being paged in
+
+ @param term the term name
+ @param courseCode the course
+
+ @return (pair<bool, vector<string>>) (true, student IDs) if the course exists in the term, (false, empty) otherwise
+ */
+pair<bool, vector<string>> TermRegistry::getRoster(const string& term, const string& courseCode) const {
+    shared_ptr<TermPartition> partition;
+    {
+        shared_lock<shared_mutex> guard(registryMutex);
+        auto iter = partitions.find(term);
+        if (iter != partitions.end()) {
+            partition = iter->second;
+        } else if (store) {
+            return store->readRoster(term, courseCode);
+        }
+    }
+    vector<string> enrolled;
+    if (!partition) {
+        return make_pair(false, enrolled);
+    }
+    bool found = partition->with([&](const UniversitySystem& system) {
+        const Course* course = system.findCourse(courseCode);
+        if (course) {
+            course->forEachEnrolledStudent([&](const string& studentID) {
+                enrolled.push_back(studentID);
+            });
+        }
+        return course != nullptr;
+    });
+    return make_pair(found, enrolled);
+}
+
+/**
+ @brief gets paging counters and the store's cache counters
+
+ @return (TermStorageStats) the counters; store fields are zero without a store
+ */
+TermStorageStats TermRegistry::getStorageStats() const {
+    unique_lock<shared_mutex> guard(registryMutex);
+    TermStorageStats stats;
+    stats.residentTerms = partitions.size();
+    stats.pageIns = pageIns;
+    stats.writeBacks = writeBacks;
+    if (store) {
+        stats.storedTerms = store->getTermNames().size();
+        stats.storePages = store->getPageCount();
+        stats.cache = store->getCacheStats();
+    }
+    return stats;
+}
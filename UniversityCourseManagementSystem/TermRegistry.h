@@ -0,0 +1,134 @@
+//
+//  TermRegistry.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/7/25.
+//
+
+#ifndef TERM_REGISTRY_H
+#define TERM_REGISTRY_H
+
+#include "UniversitySystem.h"
+#include "TermStore.h"
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include <atomic>
+
+using namespace std;
+
+struct StudentRecord {
+    string studentID;
+    string fullName;
+    int classStanding;
+    string major;
+
+    StudentRecord();
+    StudentRecord(const string& ID, const string& name);
+};
+
+class TermPartition {
+    friend class TermRegistry;
+private:
+    string term;
+    mutable mutex partitionMutex;
+    ostream discard;
+    UniversitySystem system;
+    // paging state, changed only under the registry's exclusive lock (lastUsed also under its shared lock)
+    mutable atomic<unsigned long long> lastUsed;
+    unsigned long long storedVersion;
+
+public:
+    explicit TermPartition(const string& termName);
+
+    const string& getTerm() const;
+
+    /**
+     @brief runs an operation against this term's system
+
+     @details only this partition's own mutex is taken, so workers serving different terms never contend with each other
+
+     @param operation callable taking UniversitySystem&
+
+     @return whatever the operation returns
+     */
+    template <typename Operation>
+    auto with(Operation&& operation) -> decltype(operation(system)) {
+        lock_guard<mutex> guard(partitionMutex);
+        return operation(system);
+    }
+
+    template <typename Operation>
+    auto with(Operation&& operation) const -> decltype(operation(system)) {
+        lock_guard<mutex> guard(partitionMutex);
+        return operation(system);
+    }
+};
+
+struct TermStorageStats {
+    size_t residentTerms = 0;
+    size_t storedTerms = 0;
+    unsigned long long pageIns = 0;
+    unsigned long long writeBacks = 0;
+    size_t storePages = 0;
+    BufferPoolStats cache;
+};
+
+class TermRegistry {
+private:
+    mutable shared_mutex registryMutex;
+    map<string, StudentRecord> studentMaster;
+    // resident terms. mutable because a const lookup may page a stored term in, which callers can't observe
+    mutable map<string, shared_ptr<TermPartition>> partitions;
+    ostream* out;
+
+    unique_ptr<TermStore> store;
+    size_t residentLimit;
+    mutable atomic<unsigned long long> useClock;
+    mutable unsigned long long pageIns;
+    mutable unsigned long long writeBacks;
+
+    void seedStudents(UniversitySystem& system) const;
+    void applyStudentRecord(UniversitySystem& system, const StudentRecord& record) const;
+    void adoptNewStudents(const TermPartition& source);
+    void reconcileStudents(UniversitySystem& system) const;
+    shared_ptr<TermPartition> pageIn(const string& term) const;
+    bool writeBack(TermPartition& partition) const;
+    void evictColdTerms(const string& keep) const;
+    bool writeStudentMaster() const;
+
+public:
+    TermRegistry();
+    ~TermRegistry();
+
+    void setOutputStream(ostream& os);
+
+    bool attachStore(const string& fileName, size_t residentTerms = 4, size_t cachePages = 256);
+    bool detachStore();
+    bool archiveTerm(const string& term);
+    bool isTermResident(const string& term) const;
+    pair<bool, vector<string>> getRoster(const string& term, const string& courseCode) const;
+    TermStorageStats getStorageStats() const;
+
+    bool openTerm(const string& term);
+    bool dropTerm(const string& term);
+    shared_ptr<TermPartition> getTerm(const string& term) const;
+    vector<string> getTermNames() const;
+
+    bool loadTerm(const string& term, const string& fileName);
+    bool saveTerm(const string& term, const string& fileName) const;
+    bool restoreTerm(const string& term, const string& fileName);
+    unique_ptr<UniversitySystem> snapshotTerm(const string& term) const;
+
+    bool addStudent(const string& studentID, const string& fullName);
+    bool updateStudent(const string& studentID, const string& newName);
+    bool setStudentProfile(const string& studentID, int classStanding, const string& major);
+    bool removeStudent(const string& studentID);
+    pair<bool, StudentRecord> findStudent(const string& studentID) const;
+    int getStudentCount() const;
+};
+
+#endif // TERM_REGISTRY_H
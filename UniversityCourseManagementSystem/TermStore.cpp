@@ -0,0 +1,354 @@
+//
+//  TermStore.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "TermStore.h"
+#include <map>
+#include <sstream>
+
+// separates key parts; never appears in IDs, codes or term names
+static const char KEY_SEPARATOR = '\x1f';
+
+static const char STUDENT_ROWS = '1';
+static const char COURSE_ROWS = '2';
+static const char ROSTER_ROWS = '3';
+// waitlists load after every roster, as in writeSnapshot, so a shared waitlist never takes a section seat first
+static const char WAITLIST_ROWS = '4';
+
+// section links go in one course row keyed after every course code, so the courses they link are loaded first
+static const string SECTION_ROW_ID(1, '\xff');
+
+/**
+ @brief splits a data file line into its command and the next two fields
+
+ @param line the line
+ @param fields receives up to three fields
+
+ @return (size_t) the number of fields found
+ */
+static size_t leadingFields(const string& line, string fields[3]) {
+    size_t start = 0;
+    size_t found = 0;
+    while (found < 3 && start <= line.size()) {
+        size_t comma = line.find(',', start);
+        fields[found++] = line.substr(start, comma == string::npos ? string::npos : comma - start);
+        if (comma == string::npos) {
+            break;
+        }
+        start = comma + 1;
+    }
+    return found;
+}
+
+/**
+ @brief constructs a closed store
+ */
+TermStore::TermStore() {
+}
+
+string TermStore::catalogKey(const string& term) {
+    return string("T") + KEY_SEPARATOR + term;
+}
+
+string TermStore::rowPrefix(const string& term) {
+    return string("R") + KEY_SEPARATOR + term + KEY_SEPARATOR;
+}
+
+string TermStore::rowKey(const string& term, char kind, const string& ID) {
+    return rowPrefix(term) + kind + KEY_SEPARATOR + ID;
+}
+
+string TermStore::recordPrefix(const string& setName) {
+    return string("M") + KEY_SEPARATOR + setName + KEY_SEPARATOR;
+}
+
+/**
+ @brief opens (or creates) a store file
+
+ @param fileName path of the file
+ @param cachePages the most 4 KB pages kept in memory
+
+ @return (bool) true if the store is ready
+ */
+bool TermStore::open(const string& fileName, size_t cachePages) {
+    lock_guard<mutex> guard(storeMutex);
+    return tree.open(fileName, cachePages);
+}
+
+/**
+ @brief writes back every cached page and closes the file
+ */
+void TermStore::close() {
+    lock_guard<mutex> guard(storeMutex);
+    tree.close();
+}
+
+/**
+ @brief checks if a store file is open
+
+ @return (bool) true if open
+ */
+bool TermStore::isOpen() const {
+    lock_guard<mutex> guard(storeMutex);
+    return tree.isOpen();
+}
+
+/**
+ @brief removes every row of a term, but not its catalog entry
+
+ @details caller must hold the store lock
+
+ @param term the term
+
+ @return (bool) true if every row was removed
+ */
+bool TermStore::eraseRows(const string& term) {
+    vector<string> keys;
+    tree.scanPrefix(rowPrefix(term), [&](const string& key, const string&) {
+        keys.push_back(key);
+        return true;
+    });
+    bool ok = true;
+    for (const auto& key : keys) {
+        ok = tree.erase(key) && ok;
+    }
+    return ok;
+}
+
+/**
+ @brief stores a term, replacing any stored copy
+
+ @details the term is serialized with writeSnapshot and its lines are grouped into one row per student, course, roster and waitlist, plus one row holding every section link. roster rows start with a comment giving the number of enrolled students. waitlist rows are keyed after every roster row, so reading the term back enrolls everyone before anyone is waitlisted
+
+ @param term the term name
+ @param system the term's system; the caller must keep it from changing meanwhile
+
+ @return (bool) true if every row was written and flushed
+ */
+bool TermStore::writeTerm(const string& term, const UniversitySystem& system) {
+    if (term.empty() || term.find(KEY_SEPARATOR) != string::npos) {
+        return false;
+    }
+
+    stringstream snapshot;
+    system.writeSnapshot(snapshot);
+    map<string, string> rows;
+    string line;
+    string fields[3];
+    while (getline(snapshot, line)) {
+        if (line.empty() || line[0] == '#' || leadingFields(line, fields) < 2) {
+            continue;
+        }
+        string key;
+        if (fields[0] == "STUDENT" || fields[0] == "PROFILE") {
+            key = rowKey(term, STUDENT_ROWS, fields[1]);
+        } else if (fields[0] == "COURSE" || fields[0] == "POLICY") {
+            key = rowKey(term, COURSE_ROWS, fields[1]);
+        } else if (fields[0] == "SECTION") {
+            key = rowKey(term, COURSE_ROWS, SECTION_ROW_ID);
+        } else if (fields[0] == "ENROLL" && !fields[2].empty()) {
+            const Course* course = system.findCourse(fields[2]);
+            if (course == nullptr || !course->isStudentEnrolled(fields[1])) {
+                key = rowKey(term, WAITLIST_ROWS, fields[2]);
+            } else {
+                key = rowKey(term, ROSTER_ROWS, fields[2]);
+                if (rows.find(key) == rows.end()) {
+                    rows[key] = "# enrolled," + to_string(course->getEnrolledStudents().size()) + "\n";
+                }
+            }
+        } else {
+            continue;
+        }
+        rows[key] += line + "\n";
+    }
+
+    lock_guard<mutex> guard(storeMutex);
+    if (!tree.isOpen() || !eraseRows(term)) {
+        return false;
+    }
+    bool ok = true;
+    for (const auto& row : rows) {
+        ok = tree.put(row.first, row.second) && ok;
+    }
+    ok = tree.put(catalogKey(term), to_string(rows.size())) && ok;
+    return tree.flush() && ok;
+}
+
+/**
+ @brief loads a stored term into a system
+
+ @details reads every row of the term with one prefix scan and replays the lines with loadFromStream
+
+ @param term the term name
+ @param system the system to load into, normally empty
+
+ @return (bool) true if the term was stored and loaded
+ */
+bool TermStore::readTerm(const string& term, UniversitySystem& system) {
+    stringstream lines;
+    {
+        lock_guard<mutex> guard(storeMutex);
+        if (!tree.isOpen() || !tree.get(catalogKey(term)).first) {
+            return false;
+        }
+        tree.scanPrefix(rowPrefix(term), [&](const string&, const string& value) {
+            lines << value;
+            return true;
+        });
+    }
+    return system.loadFromStream(lines, "term store " + term);
+}
+
+/**
+ @brief removes a stored term
+
+ @param term the term name
+
+ @return (bool) true if the term was stored
+ */
+bool TermStore::eraseTerm(const string& term) {
+    lock_guard<mutex> guard(storeMutex);
+    if (!tree.isOpen() || !tree.erase(catalogKey(term))) {
+        return false;
+    }
+    eraseRows(term);
+    return tree.flush();
+}
+
+/**
+ @brief checks if a term is stored
+
+ @param term the term name
+
+ @return (bool) true if stored
+ */
+bool TermStore::hasTerm(const string& term) {
+    lock_guard<mutex> guard(storeMutex);
+    return tree.isOpen() && tree.get(catalogKey(term)).first;
+}
+
+/**
+ @brief lists every stored term without reading any of their rows
+
+ @return (vector<string>) the term names in sorted order
+ */
+vector<string> TermStore::getTermNames() {
+    lock_guard<mutex> guard(storeMutex);
+    vector<string> names;
+    string prefix = catalogKey("");
+    tree.scanPrefix(prefix, [&](const string& key, const string&) {
+        names.push_back(key.substr(prefix.size()));
+        return true;
+    });
+    return names;
+}
+
+/**
+ @brief reads the enrolled students of one stored course without loading its term
+
+ @param term the term name
+ @param courseCode the course
+
+ @return (pair<bool, vector<string>>) (true, student IDs in roster order) if the term is stored, (false, empty) otherwise. a stored course with nobody enrolled gives (true, empty)
+ */
+pair<bool, vector<string>> TermStore::readRoster(const string& term, const string& courseCode) {
+    vector<string> enrolled;
+    pair<bool, string> row;
+    {
+        lock_guard<mutex> guard(storeMutex);
+        if (!tree.isOpen() || !tree.get(catalogKey(term)).first) {
+            return make_pair(false, enrolled);
+        }
+        row = tree.get(rowKey(term, ROSTER_ROWS, courseCode));
+    }
+    if (!row.first) {
+        return make_pair(true, enrolled);
+    }
+
+    stringstream lines(row.second);
+    string line;
+    string fields[3];
+    size_t enrolledCount = 0;
+    while (getline(lines, line)) {
+        if (leadingFields(line, fields) < 2) {
+            continue;
+        }
+        if (fields[0] == "# enrolled") {
+            enrolledCount = stoul(fields[1]);
+        } else if (enrolled.size() < enrolledCount) {
+            enrolled.push_back(fields[1]);
+        }
+    }
+    return make_pair(true, enrolled);
+}
+
+/**
+ @brief replaces a named set of records
+
+ @param setName the set
+ @param records the records, by ID
+
+ @return (bool) true if every record was written and flushed
+ */
+bool TermStore::writeRecordSet(const string& setName, const map<string, string>& records) {
+    lock_guard<mutex> guard(storeMutex);
+    if (!tree.isOpen()) {
+        return false;
+    }
+    string prefix = recordPrefix(setName);
+    vector<string> stale;
+    tree.scanPrefix(prefix, [&](const string& key, const string&) {
+        if (records.find(key.substr(prefix.size())) == records.end()) {
+            stale.push_back(key);
+        }
+        return true;
+    });
+    bool ok = true;
+    for (const auto& key : stale) {
+        ok = tree.erase(key) && ok;
+    }
+    for (const auto& record : records) {
+        ok = tree.put(prefix + record.first, record.second) && ok;
+    }
+    return tree.flush() && ok;
+}
+
+/**
+ @brief reads every record of a named set in ID order
+
+ @param setName the set
+ @param visit callable taking (ID, value)
+
+ @return (size_t) the number of records read
+ */
+size_t TermStore::readRecordSet(const string& setName, const function<void(const string&, const string&)>& visit) {
+    lock_guard<mutex> guard(storeMutex);
+    string prefix = recordPrefix(setName);
+    return tree.scanPrefix(prefix, [&](const string& key, const string& value) {
+        visit(key.substr(prefix.size()), value);
+        return true;
+    });
+}
+
+/**
+ @brief gets the page cache's hit, miss, eviction and write counters
+
+ @return (BufferPoolStats) a copy of the counters
+ */
+BufferPoolStats TermStore::getCacheStats() const {
+    lock_guard<mutex> guard(storeMutex);
+    return tree.getBufferPool().getStats();
+}
+
+/**
+ @brief gets the size of the store file in pages
+
+ @return (size_t) the page count
+ */
+size_t TermStore::getPageCount() const {
+    lock_guard<mutex> guard(storeMutex);
+    return tree.getBufferPool().getPageCount();
+}
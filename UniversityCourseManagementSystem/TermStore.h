@@ -0,0 +1,62 @@
+//
+//  TermStore.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef TERM_STORE_H
+#define TERM_STORE_H
+
+#include "BPlusTree.h"
+#include "UniversitySystem.h"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <utility>
+#include <map>
+#include <functional>
+
+using namespace std;
+
+/**
+ @brief on-disk home for terms that are not kept in memory
+
+ @details each term is stored as rows of a BPlusTree, one per student, per course and per course roster, holding that entity's lines in the data file format. rows are keyed (term, kind, ID) so one prefix scan reads a term back in the order loadFromStream needs (students, then courses, then rosters), and one point lookup answers a roster query without reading the rest of the term. named record sets hold data that belongs to no term, such as the student master records. thread-safe; one mutex guards the tree and its buffer pool
+ */
+class TermStore {
+private:
+    mutable mutex storeMutex;
+    BPlusTree tree;
+
+    static string catalogKey(const string& term);
+    static string rowPrefix(const string& term);
+    static string rowKey(const string& term, char kind, const string& ID);
+    static string recordPrefix(const string& setName);
+    bool eraseRows(const string& term);
+
+public:
+    TermStore();
+
+    TermStore(const TermStore&) = delete;
+    TermStore& operator=(const TermStore&) = delete;
+
+    bool open(const string& fileName, size_t cachePages = 256);
+    void close();
+    bool isOpen() const;
+
+    bool writeTerm(const string& term, const UniversitySystem& system);
+    bool readTerm(const string& term, UniversitySystem& system);
+    bool eraseTerm(const string& term);
+    bool hasTerm(const string& term);
+    vector<string> getTermNames();
+    pair<bool, vector<string>> readRoster(const string& term, const string& courseCode);
+
+    bool writeRecordSet(const string& setName, const map<string, string>& records);
+    size_t readRecordSet(const string& setName, const function<void(const string&, const string&)>& visit);
+
+    BufferPoolStats getCacheStats() const;
+    size_t getPageCount() const;
+};
+
+#endif // TERM_STORE_H
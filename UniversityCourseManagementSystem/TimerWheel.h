@@ -0,0 +1,256 @@
+//
+//  TimerWheel.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/11/25.
+//
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ @brief hierarchical timing wheel that fires a payload once its expiry tick has passed
+
+ @details LEVELS wheels of SLOTS slots each; level l covers SLOTS^(l + 1) ticks. a timer sits in the lowest level whose window still contains both now and its expiry, and is moved down one level at a time as its window comes up (a "cascade"). scheduling and cancelling are O(1); advancing costs O(1) per tick plus O(1) amortized per timer, and runs of ticks with nothing in the lowest wheels are skipped in one step. timers live in one slab with intrusive lists, so handles stay valid until the timer fires or is cancelled. not thread-safe
+ */
+template <typename Payload>
+class TimerWheel {
+public:
+    using Handle = unsigned long long;
+
+private:
+    static constexpr unsigned LEVEL_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << LEVEL_BITS;
+    static constexpr unsigned LEVELS = 5;
+    static constexpr uint32_t DUE_LIST = LEVELS * SLOTS;
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Timer {
+        unsigned long long expiry = 0;
+        Payload payload = Payload();
+        uint32_t generation = 0;
+        uint32_t list = NONE;
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+    };
+
+    vector<Timer> timers;
+    vector<uint32_t> freeSlots;
+    vector<uint32_t> heads;
+    vector<size_t> levelCounts;
+    unsigned long long current;
+    size_t count;
+
+    void link(uint32_t index, uint32_t list) {
+        Timer& timer = timers[index];
+        timer.list = list;
+        timer.prev = NONE;
+        timer.next = heads[list];
+        if (heads[list] != NONE) {
+            timers[heads[list]].prev = index;
+        }
+        heads[list] = index;
+        levelCounts[list / SLOTS]++;
+    }
+
+    void unlink(uint32_t index) {
+        Timer& timer = timers[index];
+        if (timer.prev != NONE) {
+            timers[timer.prev].next = timer.next;
+        } else {
+            heads[timer.list] = timer.next;
+        }
+        if (timer.next != NONE) {
+            timers[timer.next].prev = timer.prev;
+        }
+        levelCounts[timer.list / SLOTS]--;
+        timer.list = NONE;
+    }
+
+    // files a timer by its expiry relative to the current tick
+    void place(uint32_t index) {
+        unsigned long long expiry = timers[index].expiry;
+        if (expiry <= current) {
+            link(index, DUE_LIST);
+            return;
+        }
+        for (unsigned level = 0; level + 1 < LEVELS; level++) {
+            unsigned shift = LEVEL_BITS * (level + 1);
+            if ((expiry >> shift) == (current >> shift)) {
+                link(index, level * SLOTS + ((expiry >> (LEVEL_BITS * level)) & (SLOTS - 1)));
+                return;
+            }
+        }
+        // the top wheel wraps: a slot comes up once per rotation, so anything further than one rotation out is parked in
+        // the current slot, which comes up last, and re-filed from there
+        unsigned topShift = LEVEL_BITS * (LEVELS - 1);
+        unsigned long long topSlot = (expiry >> topShift) - (current >> topShift) <= SLOTS ? (expiry >> topShift) : (current >> topShift);
+        link(index, (LEVELS - 1) * SLOTS + (topSlot & (SLOTS - 1)));
+    }
+
+    void release(uint32_t index) {
+        Timer& timer = timers[index];
+        timer.payload = Payload();
+        timer.generation++;
+        freeSlots.push_back(index);
+        count--;
+    }
+
+    vector<uint32_t> detach(uint32_t list) {
+        vector<uint32_t> detached;
+        while (heads[list] != NONE) {
+            uint32_t index = heads[list];
+            unlink(index);
+            detached.push_back(index);
+        }
+        return detached;
+    }
+
+    // fires every detached timer that is due and re-files the rest. payloads are moved out before visit runs, so visit may schedule or cancel timers
+    template <typename Visitor>
+    size_t fire(uint32_t list, Visitor& visit) {
+        size_t fired = 0;
+        for (uint32_t index : detach(list)) {
+            if (timers[index].expiry > current) {
+                place(index);
+                continue;
+            }
+            Payload payload = std::move(timers[index].payload);
+            release(index);
+            visit(payload);
+            fired++;
+        }
+        return fired;
+    }
+
+public:
+    explicit TimerWheel(unsigned long long startTick = 0) : heads(LEVELS * SLOTS + 1, NONE), levelCounts(LEVELS + 1, 0) {
+        current = startTick;
+        count = 0;
+    }
+
+    /**
+     @brief schedules a payload to fire once the wheel reaches a tick
+
+     @param expiryTick the tick to fire at. ticks already passed fire on the next advance
+     @param payload the value handed to the visitor when the timer fires
+
+     @return (Handle) a handle for cancel
+     */
+    Handle schedule(unsigned long long expiryTick, Payload payload) {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            index = static_cast<uint32_t>(timers.size());
+            timers.emplace_back();
+        }
+        timers[index].expiry = expiryTick;
+        timers[index].payload = std::move(payload);
+        place(index);
+        count++;
+        return (static_cast<Handle>(timers[index].generation) << 32) | index;
+    }
+
+    /**
+     @brief stops a timer from firing
+
+     @param handle a handle returned by schedule
+
+     @return (bool) true if the timer was pending, false if it already fired or was cancelled
+     */
+    bool cancel(Handle handle) {
+        uint32_t index = static_cast<uint32_t>(handle);
+        if (index >= timers.size() || timers[index].generation != static_cast<uint32_t>(handle >> 32) || timers[index].list == NONE) {
+            return false;
+        }
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    /**
+     @brief moves the wheel forward, firing every timer whose expiry tick is reached
+
+     @param targetTick the tick to advance to. earlier ticks are ignored
+     @param visit callable taking (Payload&), run once per fired timer
+
+     @return (size_t) the number of timers fired
+     */
+    template <typename Visitor>
+    size_t advance(unsigned long long targetTick, Visitor&& visit) {
+        size_t fired = fire(DUE_LIST, visit);
+        while (current < targetTick) {
+            // while the lowest k wheels are empty nothing fires or cascades until the next multiple of SLOTS^k, so jump to the tick before it
+            unsigned emptyLevels = 0;
+            while (emptyLevels < LEVELS && levelCounts[emptyLevels] == 0) {
+                emptyLevels++;
+            }
+            if (emptyLevels == LEVELS) {
+                current = targetTick;
+                break;
+            }
+            if (emptyLevels > 0) {
+                unsigned long long windowEnd = current | ((1ULL << (LEVEL_BITS * emptyLevels)) - 1);
+                current = windowEnd < targetTick ? windowEnd : targetTick;
+                if (current == targetTick) {
+                    break;
+                }
+            }
+
+            current++;
+            for (unsigned level = LEVELS - 1; level > 0; level--) {
+                unsigned long long span = 1ULL << (LEVEL_BITS * level);
+                if ((current & (span - 1)) == 0) {
+                    for (uint32_t index : detach(level * SLOTS + ((current >> (LEVEL_BITS * level)) & (SLOTS - 1)))) {
+                        place(index);
+                    }
+                }
+            }
+            // a cascade files timers expiring exactly now in the due list
+            fired += fire(DUE_LIST, visit);
+            fired += fire(static_cast<uint32_t>(current & (SLOTS - 1)), visit);
+        }
+        return fired;
+    }
+
+    /**
+     @brief gets the tick the wheel has advanced to
+
+     @return (unsigned long long) the current tick
+     */
+    unsigned long long getCurrentTick() const {
+        return current;
+    }
+
+    /**
+     @brief gets the number of pending timers
+
+     @return (size_t) the timer count
+     */
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     @brief gets the bytes held by the timer slab and slot heads
+
+     @return (size_t) the allocated bytes
+     */
+    size_t getMemoryBytes() const {
+        return timers.capacity() * sizeof(Timer) + freeSlots.capacity() * sizeof(uint32_t) + heads.capacity() * sizeof(uint32_t) + levelCounts.capacity() * sizeof(size_t);
+    }
+};
+
+#endif // TIMER_WHEEL_H
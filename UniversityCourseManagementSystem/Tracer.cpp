@@ -0,0 +1,315 @@
+//
+//  Tracer.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "Tracer.h"
+#include "ReportWriter.h"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <cstdio>
+
+/**
+ @brief the spans of one thread
+
+ @details only the owning thread writes. it fills the tail chunk, links a new chunk when it is full, and then publishes the new count, so a reader that loads the count sees every event and chunk link up to it
+ */
+struct TraceBuffer {
+    static constexpr size_t CHUNK_EVENTS = 4096;
+
+    struct Chunk {
+        TraceEvent events[CHUNK_EVENTS];
+        atomic<Chunk*> next{nullptr};
+    };
+
+    Chunk head;
+    Chunk* tail = &head;
+    size_t tailUsed = 0;
+    atomic<size_t> published{0};
+    atomic<size_t> dropped{0};
+    uint32_t threadId = 0;
+    // written by the owning thread before its first span and read under registryMutex
+    string threadName;
+
+    ~TraceBuffer() {
+        Chunk* chunk = head.next.load(memory_order_relaxed);
+        while (chunk != nullptr) {
+            Chunk* next = chunk->next.load(memory_order_relaxed);
+            delete chunk;
+            chunk = next;
+        }
+    }
+};
+
+atomic<bool> Tracer::enabled{false};
+
+static const chrono::steady_clock::time_point traceEpoch = chrono::steady_clock::now();
+static mutex registryMutex;
+static vector<unique_ptr<TraceBuffer>> traceBuffers;
+static set<string> internedText;
+static const size_t MAX_INTERNED = 4096;
+
+/**
+ @brief gets the calling thread's buffer, registering it the first time
+
+ @return (TraceBuffer&) the buffer; it outlives the thread
+ */
+static TraceBuffer& localBuffer() {
+    thread_local TraceBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+        lock_guard<mutex> guard(registryMutex);
+        traceBuffers.push_back(make_unique<TraceBuffer>());
+        buffer = traceBuffers.back().get();
+        buffer->threadId = static_cast<uint32_t>(traceBuffers.size());
+    }
+    return *buffer;
+}
+
+/**
+ @brief starts recording spans
+ */
+void Tracer::start() {
+    enabled.store(true, memory_order_relaxed);
+}
+
+/**
+ @brief stops recording spans; spans already begun are still recorded when they end
+ */
+void Tracer::stop() {
+    enabled.store(false, memory_order_relaxed);
+}
+
+/**
+ @brief reads the trace clock
+
+ @return (uint64_t) nanoseconds since the process started
+ */
+uint64_t Tracer::now() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - traceEpoch).count();
+}
+
+/**
+ @brief appends a finished span to the calling thread's buffer
+
+ @details once the thread holds MAX_EVENTS_PER_THREAD spans, further spans are counted as dropped instead
+
+ @param name what the span measured
+ @param detail extra text, or null
+ @param argName the label of the span's number, or null for none
+ @param argValue the span's number
+ @param startNanos when the span began, from now()
+ @param endNanos when the span ended, from now()
+ */
+void Tracer::record(const char* name, const char* detail, const char* argName, long long argValue, uint64_t startNanos, uint64_t endNanos) {
+    TraceBuffer& buffer = localBuffer();
+    size_t count = buffer.published.load(memory_order_relaxed);
+    if (count >= MAX_EVENTS_PER_THREAD) {
+        buffer.dropped.fetch_add(1, memory_order_relaxed);
+        return;
+    }
+    if (buffer.tailUsed == TraceBuffer::CHUNK_EVENTS) {
+        TraceBuffer::Chunk* chunk = new TraceBuffer::Chunk();
+        buffer.tail->next.store(chunk, memory_order_release);
+        buffer.tail = chunk;
+        buffer.tailUsed = 0;
+    }
+    buffer.tail->events[buffer.tailUsed++] = {name, detail, argName, argValue, startNanos, endNanos - startNanos};
+    buffer.published.store(count + 1, memory_order_release);
+}
+
+/**
+ @brief names the calling thread in the trace
+
+ @details ignored while tracing is off, so untraced threads never get a buffer
+
+ @param threadName the name shown for the thread's track
+ */
+void Tracer::setThreadName(const string& threadName) {
+    if (!isEnabled()) {
+        return;
+    }
+    TraceBuffer& buffer = localBuffer();
+    lock_guard<mutex> guard(registryMutex);
+    buffer.threadName = threadName;
+}
+
+/**
+ @brief gets a copy of a string that lives as long as the process, for use as a span detail
+
+ @details each thread keeps its own cache in front of the shared table, so a repeated string only takes the lock the first time a thread sees it. the table is capped, so text from clients can't grow it without bound
+
+ @param text the text
+
+ @return (const char*) the stable copy, or "other" once the table is full
+ */
+const char* Tracer::intern(const string& text) {
+    thread_local unordered_map<string, const char*> cache;
+    auto cached = cache.find(text);
+    if (cached != cache.end()) {
+        return cached->second;
+    }
+    const char* stable = "other";
+    {
+        lock_guard<mutex> guard(registryMutex);
+        auto found = internedText.find(text);
+        if (found != internedText.end()) {
+            stable = found->c_str();
+        } else if (internedText.size() < MAX_INTERNED) {
+            stable = internedText.insert(text).first->c_str();
+        }
+    }
+    if (cache.size() < MAX_INTERNED) {
+        cache.emplace(text, stable);
+    }
+    return stable;
+}
+
+/**
+ @brief counts the spans recorded so far on every thread
+
+ @return (size_t) the span count
+ */
+size_t Tracer::getEventCount() {
+    lock_guard<mutex> guard(registryMutex);
+    size_t total = 0;
+    for (const auto& buffer : traceBuffers) {
+        total += buffer->published.load(memory_order_acquire);
+    }
+    return total;
+}
+
+/**
+ @brief counts the spans lost because a thread's buffer was full
+
+ @return (size_t) the dropped span count
+ */
+size_t Tracer::getDroppedEvents() {
+    lock_guard<mutex> guard(registryMutex);
+    size_t total = 0;
+    for (const auto& buffer : traceBuffers) {
+        total += buffer->dropped.load(memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ @brief appends a JSON string literal
+
+ @param report the writer
+ @param text the raw text
+ */
+static void writeJsonString(ReportWriter& report, const char* text) {
+    static const char HEX[] = "0123456789abcdef";
+    report << '"';
+    for (const char* next = text; *next != '\0'; next++) {
+        unsigned char byte = static_cast<unsigned char>(*next);
+        if (*next == '"' || *next == '\\') {
+            report << '\\' << *next;
+        } else if (byte < 0x20) {
+            report << "\\u00" << HEX[byte >> 4] << HEX[byte & 0xf];
+        } else {
+            report << *next;
+        }
+    }
+    report << '"';
+}
+
+/**
+ @brief appends a trace clock reading in microseconds with nanosecond precision
+
+ @param report the writer
+ @param nanos the reading
+ */
+static void writeMicros(ReportWriter& report, uint64_t nanos) {
+    char digits[4] = {'0', '0', '0', '\0'};
+    uint64_t fraction = nanos % 1000;
+    for (int i = 2; i >= 0; i--) {
+        digits[i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+    report << nanos / 1000 << '.' << digits;
+}
+
+/**
+ @brief writes every span recorded so far as Chrome trace JSON
+
+ @details spans are "X" (complete) events in one process with a track per thread; named threads get a thread_name metadata event. threads may keep tracing meanwhile; their later spans are left out
+
+ @param report the writer to write to
+ */
+void Tracer::writeChromeTrace(ReportWriter& report) {
+    lock_guard<mutex> guard(registryMutex);
+    size_t dropped = 0;
+    bool first = true;
+    report << "{\"traceEvents\":[";
+    for (const auto& buffer : traceBuffers) {
+        dropped += buffer->dropped.load(memory_order_relaxed);
+        if (!buffer->threadName.empty()) {
+            report << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+            writeJsonString(report, buffer->threadName.c_str());
+            report << "}}";
+            first = false;
+        }
+
+        size_t count = buffer->published.load(memory_order_acquire);
+        const TraceBuffer::Chunk* chunk = &buffer->head;
+        for (size_t i = 0; i < count; i++) {
+            if (i > 0 && i % TraceBuffer::CHUNK_EVENTS == 0) {
+                chunk = chunk->next.load(memory_order_acquire);
+            }
+            const TraceEvent& event = chunk->events[i % TraceBuffer::CHUNK_EVENTS];
+            report << (first ? "\n" : ",\n") << "{\"name\":";
+            writeJsonString(report, event.name);
+            report << ",\"cat\":\"ucms\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+            writeMicros(report, event.startNanos);
+            report << ",\"dur\":";
+            writeMicros(report, event.durationNanos);
+            if (event.detail != nullptr || event.argName != nullptr) {
+                report << ",\"args\":{";
+                if (event.detail != nullptr) {
+                    report << "\"detail\":";
+                    writeJsonString(report, event.detail);
+                }
+                if (event.argName != nullptr) {
+                    report << (event.detail != nullptr ? "," : "");
+                    writeJsonString(report, event.argName);
+                    report << ':' << event.argValue;
+                }
+                report << '}';
+            }
+            report << '}';
+            first = false;
+        }
+    }
+    report << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << dropped << "}}\n";
+}
+
+/**
+ @brief writes every span recorded so far to a Chrome trace file
+
+ @param fileName path of the file to write
+
+ @return (bool) true if the file was written
+ */
+bool Tracer::writeChromeTrace(const string& fileName) {
+    ofstream file(fileName, ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    {
+        ReportWriter report(file);
+        writeChromeTrace(report);
+        if (!report.flush()) {
+            return false;
+        }
+    }
+    file.close();
+    return !file.fail();
+}
@@ -0,0 +1,137 @@
+//
+//  Tracer.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+class ReportWriter;
+
+/**
+ @brief one finished span: a named stretch of time on one thread
+
+ @details names, details and argument names are never copied, so they must be string literals or come from Tracer::intern
+ */
+struct TraceEvent {
+    const char* name;
+    const char* detail;
+    const char* argName;
+    long long argValue;
+    uint64_t startNanos;
+    uint64_t durationNanos;
+};
+
+/**
+ @brief process-wide span recorder that writes Chrome trace JSON
+
+ @details every thread appends its spans to its own buffer, a list of fixed-size chunks that only that thread writes to. a span is published by a release store of the thread's event count, so recording takes no lock and never waits for a reader, and writeChromeTrace can run while other threads keep tracing: it reads each buffer up to its published count. buffers are registered once per thread (the only locked step) and kept for the life of the process. while tracing is off a span costs one relaxed atomic load. the output opens in chrome://tracing and ui.perfetto.dev
+ */
+class Tracer {
+public:
+    static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+private:
+    static atomic<bool> enabled;
+
+    Tracer() = delete;
+
+public:
+    /**
+     @brief checks if spans are being recorded
+
+     @return (bool) true between start and stop
+     */
+    static bool isEnabled() {
+        return enabled.load(memory_order_relaxed);
+    }
+
+    static void start();
+    static void stop();
+    static uint64_t now();
+    static void record(const char* name, const char* detail, const char* argName, long long argValue, uint64_t startNanos, uint64_t endNanos);
+    static void setThreadName(const string& threadName);
+    static const char* intern(const string& text);
+
+    static size_t getEventCount();
+    static size_t getDroppedEvents();
+    static void writeChromeTrace(ReportWriter& report);
+    static bool writeChromeTrace(const string& fileName);
+};
+
+/**
+ @brief records the time from its construction to its destruction (or end()) as a span on the calling thread
+
+ @details does nothing if tracing was off when the span began. spans nest: a span begun inside another shows up beneath it
+ */
+class TraceSpan {
+private:
+    const char* name;
+    const char* detail;
+    const char* argName;
+    long long argValue;
+    uint64_t startNanos;
+    bool active;
+
+public:
+    /**
+     @brief begins a span
+
+     @param spanName what the span measures; a string literal
+     @param spanDetail extra text shown with the span, e.g. a command name; a literal, a Tracer::intern result or null
+     */
+    explicit TraceSpan(const char* spanName, const char* spanDetail = nullptr) : name(spanName), detail(spanDetail), argName(nullptr), argValue(0), startNanos(0) {
+        active = Tracer::isEnabled();
+        if (active) {
+            startNanos = Tracer::now();
+        }
+    }
+
+    ~TraceSpan() {
+        end();
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    /**
+     @brief attaches a number to the span, e.g. how many records it handled
+
+     @param numberName the number's label; a string literal
+     @param number the number
+     */
+    void setArg(const char* numberName, long long number) {
+        argName = numberName;
+        argValue = number;
+    }
+
+    /**
+     @brief sets the span's detail once it is known
+
+     @param spanDetail a literal, a Tracer::intern result or null
+     */
+    void setDetail(const char* spanDetail) {
+        detail = spanDetail;
+    }
+
+    /**
+     @brief ends the span before the end of its scope
+     */
+    void end() {
+        if (active) {
+            active = false;
+            Tracer::record(name, detail, argName, argValue, startNanos, Tracer::now());
+        }
+    }
+};
+
+#endif // TRACER_H
@@ -0,0 +1,152 @@
+//
+//  TrafficRecorder.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "TrafficRecorder.h"
+
+/**
+ @brief opens a traffic file for writing
+
+ @param path path of the traffic file; an existing file is replaced
+ */
+TrafficRecorder::TrafficRecorder(const string& path) : fileName(path), file(path, ios::trunc), writer(file), requests(0) {
+    startTime = chrono::steady_clock::now();
+}
+
+/**
+ @brief checks if the traffic file could be opened
+
+ @return (bool) true if it is open
+ */
+bool TrafficRecorder::isOpen() const {
+    return file.is_open();
+}
+
+/**
+ @brief returns the path of the traffic file
+
+ @return (string) the path
+ */
+string TrafficRecorder::getFileName() const {
+    return fileName;
+}
+
+/**
+ @brief returns the number of commands recorded so far
+
+ @return (unsigned long long) the request count
+ */
+unsigned long long TrafficRecorder::getRequestCount() const {
+    return requests;
+}
+
+/**
+ @brief writes the header and the starting state, and starts the request clock
+
+ @param stateText the system's state in the data file format
+ */
+void TrafficRecorder::begin(const string& stateText) {
+    writer << FORMAT_HEADER << '\n' << stateText << REQUESTS_MARKER << '\n';
+    startTime = chrono::steady_clock::now();
+}
+
+/**
+ @brief writes one command
+
+ @details RECORD commands control the recording itself and are left out
+
+ @param line the command line as received
+ @param success whether the command succeeded
+ @param arrived when the command was received
+ @param finished when its result was ready
+ */
+void TrafficRecorder::record(const string& line, bool success, chrono::steady_clock::time_point arrived, chrono::steady_clock::time_point finished) {
+    if (line.compare(0, 6, "RECORD") == 0) {
+        return;
+    }
+    long long offset = chrono::duration_cast<chrono::microseconds>(arrived - startTime).count();
+    long long latency = chrono::duration_cast<chrono::microseconds>(finished - arrived).count();
+    writer << offset << '\t' << latency << '\t' << (success ? '+' : '-') << '\t' << escapeLine(line) << '\n';
+    requests++;
+}
+
+/**
+ @brief writes the end line and closes the file
+
+ @param stateDigest the digest of the system's state after the last command
+
+ @return (bool) true if the whole file was written
+ */
+bool TrafficRecorder::finish(uint64_t stateDigest) {
+    writer << END_MARKER << '\t' << requests << '\t' << formatDigest(stateDigest) << '\n';
+    bool written = writer.flush();
+    file.close();
+    return written && !file.fail();
+}
+
+/**
+ @brief escapes a command line so it fits on one traffic file line
+
+ @param line the raw command line
+
+ @return (string) the line with backslash, tab, carriage return and line feed written as \\, \t, \r and \n
+ */
+string TrafficRecorder::escapeLine(const string& line) {
+    string text;
+    text.reserve(line.size());
+    for (char character : line) {
+        if (character == '\\') {
+            text += "\\\\";
+        } else if (character == '\t') {
+            text += "\\t";
+        } else if (character == '\r') {
+            text += "\\r";
+        } else if (character == '\n') {
+            text += "\\n";
+        } else {
+            text += character;
+        }
+    }
+    return text;
+}
+
+/**
+ @brief reverses escapeLine
+
+ @param text an escaped command line
+
+ @return (string) the raw command line
+ */
+string TrafficRecorder::unescapeLine(const string& text) {
+    string line;
+    line.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            line += text[i];
+            continue;
+        }
+        char code = text[++i];
+        line += code == 't' ? '\t' : (code == 'r' ? '\r' : (code == 'n' ? '\n' : code));
+    }
+    return line;
+}
+
+/**
+ @brief formats a state digest
+
+ @param digest the digest
+
+ @return (string) 16 lowercase hex digits
+ */
+string TrafficRecorder::formatDigest(uint64_t digest) {
+    static const char HEX[] = "0123456789abcdef";
+    string text(16, '0');
+    for (int i = 15; i >= 0; i--) {
+        text[i] = HEX[digest & 0xf];
+        digest >>= 4;
+    }
+    return text;
+}
@@ -0,0 +1,56 @@
+//
+//  TrafficRecorder.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef TRAFFIC_RECORDER_H
+#define TRAFFIC_RECORDER_H
+
+#include "ReportWriter.h"
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ @brief writes every command a system runs, with its timing and outcome, to a traffic file that TrafficReplay can run again
+
+ @details a traffic file is text. it starts with the system's state when recording began, in the data file format, then a "# requests" line, then one line per command: its arrival in microseconds since recording began, the time it took in microseconds, + or - for success or failure, and the command line with backslashes, tabs and line breaks escaped, separated by tabs. it ends with a "# end" line holding the request count and the digest of the final state. lines are buffered and written a page at a time
+ */
+class TrafficRecorder {
+public:
+    static constexpr const char* FORMAT_HEADER = "# University Course Management System traffic v1";
+    static constexpr const char* REQUESTS_MARKER = "# requests";
+    static constexpr const char* END_MARKER = "# end";
+
+private:
+    string fileName;
+    ofstream file;
+    ReportWriter writer;
+    chrono::steady_clock::time_point startTime;
+    unsigned long long requests;
+
+public:
+    explicit TrafficRecorder(const string& path);
+
+    TrafficRecorder(const TrafficRecorder&) = delete;
+    TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+    bool isOpen() const;
+    string getFileName() const;
+    unsigned long long getRequestCount() const;
+
+    void begin(const string& stateText);
+    void record(const string& line, bool success, chrono::steady_clock::time_point arrived, chrono::steady_clock::time_point finished);
+    bool finish(uint64_t stateDigest);
+
+    static string escapeLine(const string& line);
+    static string unescapeLine(const string& text);
+    static string formatDigest(uint64_t digest);
+};
+
+#endif // TRAFFIC_RECORDER_H
@@ -0,0 +1,308 @@
+//
+//  TrafficReplay.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#include "TrafficReplay.h"
+#include "TrafficRecorder.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+/**
+ @brief constructs an empty replay; load a traffic file before running it
+ */
+TrafficReplay::TrafficReplay() {
+    expectedRequests = 0;
+    expectedDigest = 0;
+    complete = false;
+    requestsRun = 0;
+    requestsSkipped = 0;
+    mismatches = 0;
+    finalDigest = 0;
+}
+
+/**
+ @brief parses one request line of a traffic file
+
+ @param text the line: offset, latency, + or - and the escaped command, separated by tabs
+ @param request where the parsed request is stored
+
+ @return (bool) true if the line is well formed
+ */
+bool TrafficReplay::parseRequest(const string& text, TrafficRequest& request) {
+    size_t first = text.find('\t');
+    size_t second = first == string::npos ? string::npos : text.find('\t', first + 1);
+    if (second == string::npos || second + 2 >= text.size() || text[second + 2] != '\t') {
+        return false;
+    }
+    char outcome = text[second + 1];
+    if (outcome != '+' && outcome != '-') {
+        return false;
+    }
+    try {
+        request.offsetMicros = stoll(text.substr(0, first));
+        request.latencyMicros = stoll(text.substr(first + 1, second - first - 1));
+    } catch (const exception&) {
+        return false;
+    }
+    request.success = outcome == '+';
+    request.line = TrafficRecorder::unescapeLine(text.substr(second + 3));
+    return true;
+}
+
+/**
+ @brief decides how a recorded command is replayed
+
+ @details SAVE, CHECKPOINT and TRACE only write files and change no state, so they are skipped, and so are TERM commands, which work on other terms than the recorded system. REPORT still runs, but into the processor's output instead of its file
+
+ @param line the recorded command line
+ @param replayed where the line to run is stored
+
+ @return (bool) true if the command should run, false to skip it
+ */
+bool TrafficReplay::prepareLine(const string& line, string& replayed) {
+    string command = line.substr(0, line.find(','));
+    while (!command.empty() && (command.back() == '\r' || command.back() == ' ')) {
+        command.pop_back();
+    }
+    if (command == "SAVE" || command == "CHECKPOINT" || command == "TRACE" || command == "RECORD" || command.compare(0, 4, "TERM") == 0) {
+        return false;
+    }
+    replayed = line;
+    if (command == "REPORT") {
+        size_t comma = 0;
+        for (int field = 0; field < 3 && comma != string::npos; field++) {
+            comma = line.find(',', comma + 1);
+        }
+        if (comma != string::npos) {
+            replayed = line.substr(0, comma);
+        }
+    }
+    return true;
+}
+
+/**
+ @brief reads a value from sorted samples
+
+ @param sorted the samples in ascending order
+ @param fraction which value, from 0 to 1
+
+ @return (long long) the sample at that rank, or 0 if there are none
+ */
+long long TrafficReplay::percentile(const vector<long long>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+/**
+ @brief reads a traffic file
+
+ @details a file whose recording was never stopped has no end line; it can still be replayed but there is no digest to check against
+
+ @param path path of the traffic file
+ @param errors where problems with the file are reported
+
+ @return (bool) true if the file was read, false if it can't be opened or isn't a traffic file
+ */
+bool TrafficReplay::load(const string& path, ostream& errors) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        errors << "Error: Could not open traffic file " << path << endl;
+        return false;
+    }
+    fileName = path;
+    stateText.clear();
+    requests.clear();
+    complete = false;
+
+    string line;
+    if (!getline(file, line) || line != TrafficRecorder::FORMAT_HEADER) {
+        errors << "Error: " << path << " is not a traffic file" << endl;
+        return false;
+    }
+    bool inRequests = false;
+    int lineNumber = 1;
+    while (getline(file, line)) {
+        lineNumber++;
+        if (!inRequests) {
+            if (line == TrafficRecorder::REQUESTS_MARKER) {
+                inRequests = true;
+            } else {
+                stateText += line;
+                stateText += '\n';
+            }
+            continue;
+        }
+        if (line.compare(0, 5, TrafficRecorder::END_MARKER) == 0) {
+            istringstream fields(line.substr(5));
+            string digest;
+            if (!(fields >> expectedRequests >> digest) || digest.size() != 16) {
+                errors << "Error: line " << lineNumber << " of " << path << " is not a valid end line" << endl;
+                return false;
+            }
+            expectedDigest = stoull(digest, nullptr, 16);
+            complete = true;
+            break;
+        }
+        TrafficRequest request;
+        if (!parseRequest(line, request)) {
+            errors << "Error: line " << lineNumber << " of " << path << " is not a valid request" << endl;
+            return false;
+        }
+        requests.push_back(std::move(request));
+    }
+    if (!inRequests) {
+        errors << "Error: " << path << " has no requests section" << endl;
+        return false;
+    }
+    if (!complete) {
+        errors << "Warning: " << path << " has no end line -- the recording was not stopped, so the final state can't be checked" << endl;
+    } else if (expectedRequests != requests.size()) {
+        errors << "Warning: " << path << " should hold " << expectedRequests << " requests but holds " << requests.size() << endl;
+    }
+    return true;
+}
+
+/**
+ @brief replays the loaded traffic against a fresh system and reports how it went
+
+ @details with original pacing each command waits for its recorded offset, and its latency counts from then, so falling behind shows up as latency the way queueing would. otherwise commands run back to back. seat holds expire by the wall clock, so traffic with holds may only reproduce at original pacing
+
+ @param originalPacing true to keep the recorded arrival times, false to replay as fast as possible
+ @param report where the summary is written
+
+ @return (bool) true if the final state matches the recorded digest
+ */
+bool TrafficReplay::run(bool originalPacing, ostream& report) {
+    requestsRun = 0;
+    requestsSkipped = 0;
+    mismatches = 0;
+    firstMismatch.clear();
+
+    UniversitySystem system;
+    ostream discard(nullptr);
+    system.setOutputStream(discard);
+    istringstream state(stateText);
+    system.loadFromStream(state, fileName);
+
+    vector<long long> recorded;
+    vector<long long> replayed;
+    recorded.reserve(requests.size());
+    replayed.reserve(requests.size());
+    chrono::steady_clock::time_point start;
+    double seconds = 0;
+    {
+        CommandProcessor processor(system);
+        string line;
+        start = chrono::steady_clock::now();
+        for (const auto& request : requests) {
+            if (!prepareLine(request.line, line)) {
+                requestsSkipped++;
+                continue;
+            }
+            chrono::steady_clock::time_point arrived = chrono::steady_clock::now();
+            if (originalPacing) {
+                // a sleep can overshoot by tens of microseconds, more than the gap between most recorded commands,
+                // so only long gaps are slept through and the last stretch is waited out
+                chrono::steady_clock::time_point scheduled = start + chrono::microseconds(request.offsetMicros);
+                if (scheduled - arrived > SLEEP_MARGIN) {
+                    this_thread::sleep_until(scheduled - SLEEP_MARGIN);
+                }
+                while (chrono::steady_clock::now() < scheduled) {
+                }
+                arrived = scheduled;
+            }
+            CommandResult result = processor.execute(line);
+            replayed.push_back(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - arrived).count());
+            recorded.push_back(request.latencyMicros);
+            requestsRun++;
+            if (result.success != request.success) {
+                if (mismatches == 0) {
+                    firstMismatch = request.line + " (recorded " + (request.success ? "OK" : "ERR") + ", replayed " + (result.success ? "OK" : "ERR") + ")";
+                }
+                mismatches++;
+            }
+        }
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    finalDigest = system.stateDigest();
+
+    sort(recorded.begin(), recorded.end());
+    sort(replayed.begin(), replayed.end());
+    report << requestsRun << " requests replayed, " << requestsSkipped << " skipped in " << fixed << setprecision(3) << seconds << "s";
+    if (seconds > 0) {
+        report << " (" << static_cast<long long>(requestsRun / seconds) << " requests/sec)";
+    }
+    report << (originalPacing ? " at the recorded pace" : " as fast as possible") << endl;
+    report << "latency (us)     p50        p90        p99        max" << endl;
+    report << "  recorded  " << setw(8) << percentile(recorded, 0.5) << "   " << setw(8) << percentile(recorded, 0.9) << "   "
+           << setw(8) << percentile(recorded, 0.99) << "   " << setw(8) << (recorded.empty() ? 0 : recorded.back()) << endl;
+    report << "  replayed  " << setw(8) << percentile(replayed, 0.5) << "   " << setw(8) << percentile(replayed, 0.9) << "   "
+           << setw(8) << percentile(replayed, 0.99) << "   " << setw(8) << (replayed.empty() ? 0 : replayed.back()) << endl;
+    report << mismatches << " outcomes differ from the recording";
+    if (mismatches > 0) {
+        report << ", first: " << firstMismatch;
+    }
+    report << endl;
+    if (!complete) {
+        report << "final state " << TrafficRecorder::formatDigest(finalDigest) << " (no recorded digest to compare)" << endl;
+    } else {
+        report << "final state " << TrafficRecorder::formatDigest(finalDigest) << (digestMatches() ? " matches" : " DIFFERS from") << " the recorded "
+               << TrafficRecorder::formatDigest(expectedDigest) << endl;
+    }
+    return digestMatches();
+}
+
+/**
+ @brief returns the number of requests in the loaded file
+
+ @return (size_t) the request count
+ */
+size_t TrafficReplay::getRequestCount() const {
+    return requests.size();
+}
+
+/**
+ @brief returns the number of requests the last run executed
+
+ @return (unsigned long long) the count
+ */
+unsigned long long TrafficReplay::getRequestsRun() const {
+    return requestsRun;
+}
+
+/**
+ @brief returns the number of requests the last run skipped because they only write files
+
+ @return (unsigned long long) the count
+ */
+unsigned long long TrafficReplay::getRequestsSkipped() const {
+    return requestsSkipped;
+}
+
+/**
+ @brief returns the number of requests whose outcome differed from the recording in the last run
+
+ @return (unsigned long long) the count
+ */
+unsigned long long TrafficReplay::getMismatches() const {
+    return mismatches;
+}
+
+/**
+ @brief checks the last run's final state against the recorded digest
+
+ @return (bool) true if the file has a digest and the state matched it
+ */
+bool TrafficReplay::digestMatches() const {
+    return complete && finalDigest == expectedDigest;
+}
@@ -0,0 +1,73 @@
+//
+//  TrafficReplay.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/12/25.
+//
+
+#ifndef TRAFFIC_REPLAY_H
+#define TRAFFIC_REPLAY_H
+
+#include "UniversitySystem.h"
+#include "CommandProcessor.h"
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include <chrono>
+
+using namespace std;
+
+/**
+ @brief one command read back from a traffic file
+ */
+struct TrafficRequest {
+    long long offsetMicros;
+    long long latencyMicros;
+    bool success;
+    string line;
+};
+
+/**
+ @brief runs the commands in a traffic file against a fresh system and checks it ends in the recorded state
+
+ @details the system starts from the state stored at the top of the file and every command goes through a CommandProcessor, the same path script and server commands take. commands are issued back to back, or at their recorded offsets so the original pacing and gaps are kept. commands that only write files (SAVE, CHECKPOINT, TRACE) are skipped so a replay never overwrites anything, TERM commands are skipped because they work on other terms than the recorded system, and REPORT runs without its file. the outcome of each command is compared with the recorded one, and the digest of the final state with the one on the end line
+ */
+class TrafficReplay {
+private:
+    string fileName;
+    string stateText;
+    vector<TrafficRequest> requests;
+    unsigned long long expectedRequests;
+    uint64_t expectedDigest;
+    bool complete;
+
+    unsigned long long requestsRun;
+    unsigned long long requestsSkipped;
+    unsigned long long mismatches;
+    string firstMismatch;
+    uint64_t finalDigest;
+
+    static constexpr chrono::microseconds SLEEP_MARGIN{1000};
+
+    static bool parseRequest(const string& text, TrafficRequest& request);
+    static bool prepareLine(const string& line, string& replayed);
+    static long long percentile(const vector<long long>& sorted, double fraction);
+
+public:
+    TrafficReplay();
+
+    TrafficReplay(const TrafficReplay&) = delete;
+    TrafficReplay& operator=(const TrafficReplay&) = delete;
+
+    bool load(const string& path, ostream& errors);
+    bool run(bool originalPacing, ostream& report);
+
+    size_t getRequestCount() const;
+    unsigned long long getRequestsRun() const;
+    unsigned long long getRequestsSkipped() const;
+    unsigned long long getMismatches() const;
+    bool digestMatches() const;
+};
+
+#endif // TRAFFIC_REPLAY_H
@@ -6,56 +6,65 @@
 //
 
 #include "UniversitySystem.h"
+#include "Tracer.h"
 #include <iostream>
+#include <iomanip>
 #include <sstream>
 #include <fstream>
-
+#include <ctime>
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace std;
 
 /**
- @brief constructs an ActivityLogEntry with the specified details
+ @brief constructs a UniversitySystem object
  
- @details initializes an activity log entry to track system operations like adding or removing students/courses
+ @details messages are written to the console until setOutputStream is called
+*/
+UniversitySystem::UniversitySystem() {
+    out = &cout;
+    version = 0;
+    catalogPending = 0;
+    holdClockStart = chrono::steady_clock::now();
+}
+
+/**
+ @brief redirects all messages and displays to another stream
  
- @param time the timestamp of the activity
- @param a the action taken
- @param ID the student ID involved in the action
- @param cc the course code involved in the action
- @param d additional details about the action
+ @param os the stream to write to. it must outlive the system
  */
-ActivityLogEntry::ActivityLogEntry(const string& time, const string& a, const string& ID, const string& cc, const string& d) {
-    timestamp = time;
-    action = a;
-    studentID = ID;
-    courseCode = cc;
-    details = d;
+void UniversitySystem::setOutputStream(ostream& os) {
+    out = &os;
 }
 
 /**
- @brief constructs a UniversitySystem object
-*/
-UniversitySystem::UniversitySystem() {}
+ @brief returns the stream messages and displays are written to
+ 
+ @return (ostream&) the stream
+ */
+ostream& UniversitySystem::getOutputStream() const {
+    return *out;
+}
 
 /**
- @brief returns the current system time as a formatted string
+ @brief returns the mutation counter of the system
  
- @details uses the system clock to generate a timestamp in the format YYYY-MM-DD HH:MM:SS
+ @details the counter goes up every time an activity is logged, so two equal values mean nothing changed in between
  
- @return (string) the current timestamp
+ @return (unsigned long long) the current version
  */
-string UniversitySystem::getCurrentTimestamp() const {
-    auto now = time(nullptr);
-    auto tm = *localtime(&now);
-    ostringstream oss;
-    oss << put_time(&tm, "%Y-%m-%d %H:&M:%S");
-    return oss.str();
+unsigned long long UniversitySystem::getVersion() const {
+    return version;
 }
 
 /**
  @brief logs a system activity
  
- @details creates an ActivityLogEntry and adds it to the log
+ @details appends an ActivityLogEntry to the indexed log and bumps the version
  
  @param action the type of activity performed
  @param studentID the student involved with the activity
@@ -63,8 +72,9 @@ string UniversitySystem::getCurrentTimestamp() const {
  @param details extra details about the activity
  */
 void UniversitySystem::logActivity(const string& action, const string& studentID, const string& courseCode, const string& details) {
-    string timestamp = getCurrentTimestamp();
-    activityLog.emplace_back(timestamp, action, studentID, courseCode, details);
+    TraceSpan span("logActivity");
+    activityLog.append(action, studentID, courseCode, details);
+    version++;
 }
 
 /**
@@ -79,16 +89,17 @@ void UniversitySystem::logActivity(const string& action, const string& studentID
  */
 bool UniversitySystem::addStudent(const string& studentID, const string& fullName) {
     if (studentID.empty() || fullName.empty()) {
-        cout << "one of the fields is blank -- cannot add a new student" << endl;
+        *out << "one of the fields is blank -- cannot add a new student" << endl;
         return false;
     }
     
     if (students.find(studentID) != students.end()){
-        cout << "student already exists" << endl;
+        *out << "student already exists" << endl;
         return false;
     }
     
     students[studentID] = Student(studentID, fullName);
+    noteNewStudent(studentID);
     logActivity("ADD STUDENT", studentID, "", "Added student: " + fullName);
     return true;
 }
@@ -103,27 +114,225 @@ bool UniversitySystem::addStudent(const string& studentID, const string& fullNam
  @return (bool) true if successfully removed, false if student not found
  */
 bool UniversitySystem::removeStudent(const string& studentID) {
+    TraceSpan span("removeStudent");
     auto iter = students.find(studentID);
     if (iter == students.end()) {
-        cout << "student doesn't exist -- can't remove" << endl;
+        *out << "student doesn't exist -- can't remove" << endl;
         return false;
     }
     
+    preserveStudent(studentID);
+    TraceSpan cascade("removeStudent.cascade");
     Student& student = iter->second;
-    set<string> enrolledCourses = student.getEnrolledCourses();
-    for (const auto& courseCode : enrolledCourses) {
-        auto courseIter = courses.find(courseCode);
+    for (const auto& courseCode : student.getWaitlistedCourses()) {
+        auto courseIter = findCourseEntryToChange(courseCode);
         if (courseIter != courses.end()) {
-            courseIter->second.dropStudent(studentID);
+            courseIter->second.withdrawFromWaitlist(studentID);
+            refreshStanding(courseIter->second);
+        }
+    }
+    
+    vector<Course*> freedCourses;
+    for (const auto& courseCode : student.getEnrolledCourses()) {
+        auto courseIter = findCourseEntryToChange(courseCode);
+        if (courseIter != courses.end() && courseIter->second.dropStudent(studentID)) {
+            freedCourses.push_back(&courseIter->second);
+        }
+    }
+    
+    for (auto holdIter = seatHolds.lower_bound(make_pair(studentID, string())); holdIter != seatHolds.end() && holdIter->first.first == studentID;) {
+        auto courseIter = findCourseEntryToChange(holdIter->first.second);
+        if (courseIter != courses.end() && courseIter->second.releaseSeat(studentID)) {
+            freedCourses.push_back(&courseIter->second);
         }
+        holdTimers.cancel(holdIter->second);
+        holdIter = seatHolds.erase(holdIter);
     }
     
+    cascade.end();
+    
     string studentName = student.getFullName();
+    preferences.erase(studentID);
     students.erase(iter);
     logActivity("REMOVE STUDENT", studentID, "", "Removed student: " + studentName);
+    
+    TraceSpan promote("removeStudent.promote");
+    promote.setArg("courses", freedCourses.size());
+    for (Course* course : freedCourses) {
+        promoteWaitlistedStudents(*course);
+    }
     return true;
 }
 
+/**
+ @brief removes many students in one pass
+ 
+ @details collects every (course, student) enrollment and waitlist edge of the removed students, sorts it by course, and detaches each course's group with a single course lookup. freed seats are then refilled by waitlist promotion and the whole batch is written as one REMOVE STUDENTS log entry. unknown IDs are skipped
+ 
+ @param studentIDs the IDs of the students to remove, in any order, duplicates allowed
+ 
+ @return (int) the number of students removed
+ */
+int UniversitySystem::removeStudents(const vector<string>& studentIDs) {
+    TraceSpan span("removeStudents");
+    TraceSpan collect("removeStudents.collect");
+    vector<string> ids(studentIDs);
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    
+    vector<map<string, Student>::iterator> targets;
+    targets.reserve(ids.size());
+    for (const auto& studentID : ids) {
+        auto iter = students.find(studentID);
+        if (iter != students.end()) {
+            preserveStudent(studentID);
+            targets.push_back(iter);
+        }
+    }
+    if (targets.empty()) {
+        *out << "no matching students -- nothing removed" << endl;
+        return 0;
+    }
+    
+    // (course code, student ID, still waiting?) for every edge touching a removed student
+    struct Edge {
+        const string* courseCode;
+        const string* studentID;
+        bool waitlisted;
+    };
+    vector<Edge> edges;
+    for (auto iter : targets) {
+        const Student& student = iter->second;
+        for (const auto& courseCode : student.getEnrolledCourses()) {
+            edges.push_back({&courseCode, &iter->first, false});
+        }
+        for (const auto& courseCode : student.getWaitlistedCourses()) {
+            edges.push_back({&courseCode, &iter->first, true});
+        }
+    }
+    sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+        return *a.courseCode < *b.courseCode;
+    });
+    collect.setArg("edges", edges.size());
+    collect.end();
+    
+    TraceSpan detach("removeStudents.detach");
+    vector<Course*> freedCourses;
+    int enrollmentsDropped = 0;
+    int waitlistEntriesDropped = 0;
+    auto courseIter = courses.end();
+    for (size_t i = 0; i < edges.size(); i++) {
+        if (i == 0 || *edges[i].courseCode != *edges[i - 1].courseCode) {
+            courseIter = findCourseEntryToChange(*edges[i].courseCode);
+            if (courseIter != courses.end()) {
+                freedCourses.push_back(&courseIter->second);
+            }
+        }
+        if (courseIter == courses.end()) {
+            continue;
+        }
+        
+        if (edges[i].waitlisted) {
+            waitlistEntriesDropped += courseIter->second.withdrawFromWaitlist(*edges[i].studentID);
+        } else {
+            enrollmentsDropped += courseIter->second.dropStudent(*edges[i].studentID);
+        }
+    }
+    
+    for (auto iter : targets) {
+        const string& studentID = iter->first;
+        for (auto holdIter = seatHolds.lower_bound(make_pair(studentID, string())); holdIter != seatHolds.end() && holdIter->first.first == studentID;) {
+            auto heldCourse = findCourseEntryToChange(holdIter->first.second);
+            if (heldCourse != courses.end() && heldCourse->second.releaseSeat(studentID)) {
+                freedCourses.push_back(&heldCourse->second);
+            }
+            holdTimers.cancel(holdIter->second);
+            holdIter = seatHolds.erase(holdIter);
+        }
+    }
+    
+    detach.end();
+    
+    TraceSpan erase("removeStudents.erase");
+    vector<string> removedIDs;
+    removedIDs.reserve(targets.size());
+    for (auto iter : targets) {
+        removedIDs.push_back(iter->first);
+        preferences.erase(iter->first);
+        students.erase(iter);
+    }
+    erase.setArg("students", removedIDs.size());
+    erase.end();
+    
+    logActivity("REMOVE STUDENTS", "", "", "Removed " + to_string(removedIDs.size()) + " students (" + summarizeKeys(removedIDs) + "), dropping " +
+                to_string(enrollmentsDropped) + " enrollments and " + to_string(waitlistEntriesDropped) + " waitlist entries");
+    
+    TraceSpan promote("removeStudents.promote");
+    promote.setArg("courses", freedCourses.size());
+    for (Course* course : freedCourses) {
+        promoteWaitlistedStudents(*course);
+    }
+    return removedIDs.size();
+}
+
+/**
+ @brief removes every student matching a predicate
+ 
+ @param predicate returns true for each student to remove
+ 
+ @return (int) the number of students removed
+ */
+int UniversitySystem::removeStudentsIf(const function<bool(const Student&)>& predicate) {
+    vector<string> matches;
+    for (const auto& entry : students) {
+        if (predicate(entry.second)) {
+            matches.push_back(entry.first);
+        }
+    }
+    return removeStudents(matches);
+}
+
+/**
+ @brief removes every student whose ID starts with a prefix
+ 
+ @details useful for purging a cohort (e.g. "S2021"). the matching IDs are found with one range scan of the registry
+ 
+ @param prefix the ID prefix; must not be empty
+ 
+ @return (int) the number of students removed
+ */
+int UniversitySystem::removeStudentsWithPrefix(const string& prefix) {
+    if (prefix.empty()) {
+        *out << "no prefix given -- nothing removed" << endl;
+        return 0;
+    }
+    
+    vector<string> matches;
+    for (auto iter = students.lower_bound(prefix); iter != students.end() && iter->first.compare(0, prefix.size(), prefix) == 0; ++iter) {
+        matches.push_back(iter->first);
+    }
+    return removeStudents(matches);
+}
+
+/**
+ @brief shortens a list of IDs or codes for a log message
+ 
+ @param keys the sorted keys
+ 
+ @return (string) all keys if there are a few, otherwise the first and last ones
+ */
+string UniversitySystem::summarizeKeys(const vector<string>& keys) {
+    const size_t shown = 5;
+    string summary;
+    if (keys.size() <= shown) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            summary += (i > 0 ? ", " : "") + keys[i];
+        }
+        return summary;
+    }
+    return keys.front() + " ... " + keys.back();
+}
+
 /**
  @brief updates a student's name
  
@@ -137,16 +346,57 @@ bool UniversitySystem::removeStudent(const string& studentID) {
 bool UniversitySystem::updateStudent(const string& studentID, const string& newName) {
     auto iter = students.find(studentID);
     if (iter == students.end()) {
-        cout << "student doesn't exist -- can't update" << endl;
+        *out << "student doesn't exist -- can't update" << endl;
         return false;
     }
     
     string oldName = iter->second.getFullName();
+    preserveStudent(studentID);
     iter->second.setFullName(newName);
     logActivity("UPDATE STUDENT", studentID, "", "Updated name from " + oldName + " to " + newName);
     return true;
 }
 
+/**
+ @brief sets the class standing and major of a student
+ 
+ @details the student's place on every waitlist they are on is recomputed under that course's policy
+ 
+ @param studentID the ID of the student
+ @param classStanding 1 for freshman through 4 for senior, or 0 if unknown
+ @param major the department code of the student's major, or an empty string if undeclared
+ 
+ @return (bool) true if updated, false otherwise
+ */
+bool UniversitySystem::setStudentProfile(const string& studentID, int classStanding, const string& major) {
+    auto iter = students.find(studentID);
+    if (iter == students.end()) {
+        *out << "student doesn't exist -- can't update" << endl;
+        return false;
+    }
+    
+    if (classStanding < 0 || classStanding > 4) {
+        *out << "class standing must be between 0 and 4" << endl;
+        return false;
+    }
+    
+    preserveStudent(studentID);
+    Student& student = iter->second;
+    student.setClassStanding(classStanding);
+    student.setMajor(major);
+    
+    for (const auto& courseCode : student.getWaitlistedCourses()) {
+        auto courseIter = findCourseEntryToChange(courseCode);
+        if (courseIter != courses.end()) {
+            Course& course = courseIter->second;
+            course.updateWaitlistRank(studentID, course.getWaitlistPolicy().rank(student, course));
+        }
+    }
+    
+    logActivity("UPDATE STUDENT", studentID, "", "Updated profile: standing " + to_string(classStanding) + ", major " + (major.empty() ? "undeclared" : major));
+    return true;
+}
+
 /**
  @brief returns a pointer to the student object
  
@@ -184,16 +434,18 @@ bool UniversitySystem::studentExists(const string& studentID) const {
  */
 bool UniversitySystem::addCourse(const string& courseCode, const string& title, const string& instructor, int capacity) {
     if (courseCode.empty() || title.empty() || instructor.empty()) {
-        cout << "cannot create a course, at least one field was blank" << endl;
+        *out << "cannot create a course, at least one field was blank" << endl;
         return false;
     }
     
-    if (courses.find(courseCode) != courses.end()) {
-        cout << "course already exists" << endl;
+    if (findCourseEntry(courseCode) != courses.end()) {
+        *out << "course already exists" << endl;
         return false;
     }
     
     courses[courseCode] = Course(courseCode, title, instructor, capacity);
+    noteNewCourse(courseCode);
+    leaderboard.refresh(courses[courseCode]);
     logActivity("ADD COURSE", "", courseCode, "Added course: " + title + " by " + instructor);
     return true;
 }
@@ -208,27 +460,200 @@ bool UniversitySystem::addCourse(const string& courseCode, const string& title,
  @return (bool) true if removed successfully, false otherwise
  */
 bool UniversitySystem::removeCourse(const string& courseCode) {
-    auto iter = courses.find(courseCode);
+    TraceSpan span("removeCourse");
+    TraceSpan lookup("removeCourse.lookup");
+    auto iter = findCourseEntryToChange(courseCode);
+    lookup.end();
     if (iter == courses.end()) {
-        cout << "course doesn't exist, can't remove" << endl;
+        *out << "course doesn't exist, can't remove" << endl;
         return false;
     }
     
     Course& course = iter->second;
-    set<string> enrolledStudents = course.getEnrolledStudents();
-    for (const auto& studentID : enrolledStudents) {
+    if (course.isSectioned()) {
+        // the sections go with their offering
+        return removeCourses({courseCode}) > 0;
+    }
+    TraceSpan cascade("removeCourse.cascade");
+    cascade.setArg("students", course.getCurrentEnrollment() + course.getWaitlistSize());
+    course.forEachEnrolledStudent([&](const string& studentID) {
         auto studentIter = students.find(studentID);
         if (studentIter != students.end()) {
             studentIter->second.dropCourse(courseCode);
         }
-    }
+    });
+    
+    course.forEachWaitlistedStudent([&](const string& studentID) {
+        auto studentIter = students.find(studentID);
+        if (studentIter != students.end()) {
+            studentIter->second.leaveWaitlist(courseCode);
+        }
+    });
+    
+    course.forEachSeatHolder([&](const string& studentID) {
+        discardHold(studentID, courseCode);
+    });
     
+    cascade.end();
+    
+    TraceSpan erase("removeCourse.erase");
     string courseTitle = course.getTitle();
     courses.erase(iter);
+    leaderboard.remove(courseCode);
+    erase.end();
     logActivity("REMOVE COURSE", "", courseCode, "Removed course: " + courseTitle);
+    TraceSpan forget("removeCourse.forgetSections");
+    forgetCourse(courseCode);
     return true;
 }
 
+/**
+ @brief removes many courses in one pass
+ 
+ @details collects every (student, course) enrollment and waitlist edge of the removed courses, sorts it by student, and detaches each student's group with a single student lookup. the whole batch is written as one REMOVE COURSES log entry. unknown codes are skipped
+ 
+ @param courseCodes the codes of the courses to remove, in any order, duplicates allowed
+ 
+ @return (int) the number of courses removed
+ */
+int UniversitySystem::removeCourses(const vector<string>& courseCodes) {
+    TraceSpan span("removeCourses");
+    TraceSpan lookup("removeCourses.lookup");
+    vector<string> codes(courseCodes);
+    for (const auto& courseCode : courseCodes) {
+        auto offeringIter = offerings.find(courseCode);
+        if (offeringIter != offerings.end()) {
+            offeringIter->second.forEachKey([&](const string& sectionCode) {
+                codes.push_back(sectionCode);
+            });
+        }
+    }
+    sort(codes.begin(), codes.end());
+    codes.erase(unique(codes.begin(), codes.end()), codes.end());
+    
+    vector<map<string, Course>::iterator> targets;
+    targets.reserve(codes.size());
+    for (const auto& courseCode : codes) {
+        auto iter = findCourseEntryToChange(courseCode);
+        if (iter != courses.end()) {
+            targets.push_back(iter);
+        }
+    }
+    lookup.setArg("courses", targets.size());
+    lookup.end();
+    if (targets.empty()) {
+        *out << "no matching courses -- nothing removed" << endl;
+        return 0;
+    }
+    
+    TraceSpan collect("removeCourses.collect");
+    struct Edge {
+        const string* studentID;
+        const string* courseCode;
+        bool waitlisted;
+    };
+    vector<Edge> edges;
+    for (auto iter : targets) {
+        const string* courseCode = &iter->first;
+        iter->second.forEachEnrolledStudent([&](const string& studentID) {
+            edges.push_back({&studentID, courseCode, false});
+        });
+        iter->second.forEachWaitlistedStudent([&](const string& studentID) {
+            edges.push_back({&studentID, courseCode, true});
+        });
+    }
+    sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+        return *a.studentID < *b.studentID;
+    });
+    collect.setArg("edges", edges.size());
+    collect.end();
+    
+    TraceSpan cascade("removeCourses.cascade");
+    int enrollmentsDropped = 0;
+    int waitlistEntriesDropped = 0;
+    auto studentIter = students.end();
+    for (size_t i = 0; i < edges.size(); i++) {
+        if (i == 0 || *edges[i].studentID != *edges[i - 1].studentID) {
+            studentIter = students.find(*edges[i].studentID);
+        }
+        if (studentIter == students.end()) {
+            continue;
+        }
+        
+        if (edges[i].waitlisted) {
+            studentIter->second.leaveWaitlist(*edges[i].courseCode);
+            waitlistEntriesDropped++;
+        } else {
+            studentIter->second.dropCourse(*edges[i].courseCode);
+            enrollmentsDropped++;
+        }
+    }
+    
+    cascade.end();
+    
+    TraceSpan erase("removeCourses.erase");
+    vector<string> removedCodes;
+    removedCodes.reserve(targets.size());
+    for (auto iter : targets) {
+        iter->second.forEachSeatHolder([&](const string& studentID) {
+            discardHold(studentID, iter->first);
+        });
+        removedCodes.push_back(iter->first);
+        leaderboard.remove(iter->first);
+        courses.erase(iter);
+    }
+    erase.end();
+    
+    logActivity("REMOVE COURSES", "", "", "Removed " + to_string(removedCodes.size()) + " courses (" + summarizeKeys(removedCodes) + "), dropping " +
+                to_string(enrollmentsDropped) + " enrollments and " + to_string(waitlistEntriesDropped) + " waitlist entries");
+    TraceSpan forget("removeCourses.forgetSections");
+    for (const auto& courseCode : removedCodes) {
+        forgetCourse(courseCode);
+    }
+    return removedCodes.size();
+}
+
+/**
+ @brief removes every course matching a predicate
+ 
+ @param predicate returns true for each course to remove
+ 
+ @return (int) the number of courses removed
+ */
+int UniversitySystem::removeCoursesIf(const function<bool(const Course&)>& predicate) {
+    materializeCatalog();
+    vector<string> matches;
+    for (const auto& entry : courses) {
+        if (predicate(entry.second)) {
+            matches.push_back(entry.first);
+        }
+    }
+    return removeCourses(matches);
+}
+
+/**
+ @brief removes every course whose code starts with a prefix
+ 
+ @details useful for retiring a department (e.g. "HIST"). the matching codes are found with one range scan of the registry
+ 
+ @param prefix the course code prefix; must not be empty
+ 
+ @return (int) the number of courses removed
+ */
+int UniversitySystem::removeCoursesWithPrefix(const string& prefix) {
+    if (prefix.empty()) {
+        *out << "no prefix given -- nothing removed" << endl;
+        return 0;
+    }
+    
+    materializeCatalog();
+    vector<string> matches;
+    for (auto iter = courses.lower_bound(prefix); iter != courses.end() && iter->first.compare(0, prefix.size(), prefix) == 0; ++iter) {
+        matches.push_back(iter->first);
+    }
+    return removeCourses(matches);
+}
+
 /**
  @brief updates course information
  
@@ -242,9 +667,9 @@ bool UniversitySystem::removeCourse(const string& courseCode) {
  @return (bool) true if course exists and is updated, false otherwise
  */
 bool UniversitySystem::updateCourse(const string& courseCode, const string& newTitle, const string& newInstructor, int newCapacity) {
-    auto iter = courses.find(courseCode);
+    auto iter = findCourseEntryToChange(courseCode);
     if (iter == courses.end()) {
-        cout << "course doesn't exist -- can't update" << endl;
+        *out << "course doesn't exist -- can't update" << endl;
         return false;
     }
     
@@ -264,416 +689,2681 @@ bool UniversitySystem::updateCourse(const string& courseCode, const string& newT
     }
     
     logActivity("UPDATE COURSE", "", courseCode, "Updated course from " + oldTitle + " to " + course.getTitle());
+    promoteWaitlistedStudents(course);
     return true;
 }
 
 /**
- @brief returns a pointer to a Course object
+ @brief changes how a course orders its waitlist
  
- @param courseCode the course code
- 
- @return (Course*) pointer to the Course object or null pointer if not found
- */
-Course* UniversitySystem::getCourse(const string& courseCode) {
-    auto iter = courses.find(courseCode);
-    return (iter != courses.end()) ? &(iter->second) : nullptr;
-}
-
-/**
- @brief checks if a course exists
+ @details everyone already waiting is re-ranked under the new policy and keeps their arrival order for ties. the policy name must be one of getWaitlistPolicyNames()
  
- @param courseCode the course code
+ @param courseCode the code of the course
+ @param policyName the name of the new policy
  
- @return (bool) true if course exists, false otherwise
+ @return (bool) true if the policy was changed, false otherwise
  */
-bool UniversitySystem::courseExists(const string& courseCode) const {
-    return courses.find(courseCode) != courses.end();
+bool UniversitySystem::setWaitlistPolicy(const string& courseCode, const string& policyName) {
+    auto iter = findCourseEntryToChange(courseCode);
+    if (iter == courses.end()) {
+        *out << "course doesn't exist -- can't update" << endl;
+        return false;
+    }
+    
+    shared_ptr<const WaitlistPolicy> policy = makeWaitlistPolicy(policyName);
+    if (!policy) {
+        *out << "unknown waitlist policy " << policyName << endl;
+        return false;
+    }
+    
+    Course& course = iter->second;
+    course.setWaitlistPolicy(policy);
+    course.rerankWaitlist([&](const string& studentID, int rank) {
+        auto studentIter = students.find(studentID);
+        return studentIter != students.end() ? policy->rank(studentIter->second, course) : rank;
+    });
+    
+    logActivity("UPDATE COURSE", "", courseCode, "Waitlist policy set to " + policy->getName());
+    return true;
 }
 
 /**
- @brief enrolls a student in a course
+ @brief makes an existing course one section of a multi-section offering
  
- @details updates both course and student records. logs the activity
+ @details the offering is an ordinary course whose seats then live in its sections: enrolling in the offering places the student in the least-loaded section with a seat, and once every section is full the offering's waitlist is shared by all of them, so a seat freed in any section goes to the head of that one waitlist. a course can be enrolled in directly as a section too, but only while it has a seat. a student holds a place in at most one section of an offering. an offering can only be split before anyone is enrolled in it
  
- @param studentID the student to enroll
- @param courseCode the course to enroll in
+ @param offeringCode the course students enroll in
+ @param sectionCode the course that becomes one of its sections
  
- @return (bool) true if enrolled successfully, false otherwise
+ @return (bool) true if the section was added, false otherwise
  */
-bool UniversitySystem::enrollStudentInCourse(const string& studentID, const string& courseCode) {
-    if (!studentExists(studentID) || !courseExists(courseCode)) {
-        cout << "either student or course doesn't exist -- can't enroll" << endl;
+bool UniversitySystem::addSection(const string& offeringCode, const string& sectionCode) {
+    Course* offering = getCourse(offeringCode);
+    Course* section = getCourse(sectionCode);
+    if (offering == nullptr || section == nullptr) {
+        *out << "either offering or section doesn't exist -- can't add section" << endl;
+        return false;
+    }
+    if (offeringCode == sectionCode || sectionOffering.count(offeringCode) > 0 || sectionOffering.count(sectionCode) > 0 || section->isSectioned()) {
+        *out << "a section belongs to exactly one offering and can't have sections of its own" << endl;
+        return false;
+    }
+    if (section->getWaitlistSize() > 0) {
+        *out << "section has its own waitlist -- can't add it" << endl;
+        return false;
+    }
+    if (!offering->isSectioned() && (offering->getCurrentEnrollment() > 0 || offering->getHeldSeats() > 0)) {
+        *out << "offering already has students enrolled -- can't split it into sections" << endl;
         return false;
     }
     
-    Student* student = getStudent(studentID);
-    Course* course = getCourse(courseCode);
-    
-    if (course->enrollStudent(studentID)) {
-        student->enrollInCourse(courseCode);
-        string details = "Enrolled " + student->getFullName() + " in " + course->getTitle();
-        logActivity("ENROLL", studentID, courseCode, details);
-        return true;
+    bool conflict = false;
+    auto checkStudent = [&](const string& studentID) {
+        conflict = conflict || hasSectionPlace(studentID, offeringCode);
+    };
+    section->forEachEnrolledStudent(checkStudent);
+    section->forEachSeatHolder(checkStudent);
+    if (conflict) {
+        *out << "a student of " << sectionCode << " is already in or waiting for " << offeringCode << " -- can't add section" << endl;
+        return false;
     }
     
-    return false;
+    preserveSections();
+    offerings[offeringCode].push(sectionCode, SectionLoad());
+    sectionOffering[sectionCode] = offeringCode;
+    refreshSectionLoad(*section);
+    if (!offering->isSectioned()) {
+        offering->setSectioned(true);
+        refreshStanding(*offering);
+    }
+    logActivity("ADD SECTION", "", sectionCode, "Added " + sectionCode + " as a section of " + offeringCode);
+    placeFromSharedWaitlist(*offering);
+    return true;
 }
 
 /**
- @brief drops a student from a course
+ @brief returns the sections of an offering
  
- @param studentID the student to drop
- @param courseCode the course to drop from
+ @param offeringCode the offering's course code
  
- @return (bool) true if dropped successfully, false otherwise
+ @return (vector<string>) the section codes in code order, empty if the course has no sections
  */
-bool UniversitySystem::dropStudentFromCourse(const string& studentID, const string& courseCode) {
-    if (!studentExists(studentID) || !courseExists(courseCode)) {
-        cout << "either student or course doesn't exist -- can't drop" << endl;
-        return false;
-    }
-    
-    Student* student = getStudent(studentID);
-    Course* course = getCourse(courseCode);
-    
-    if (course->dropStudent(studentID)) {
-        student->dropCourse(courseCode);
-        string details = "Dropped " + student->getFullName() + " from " + course->getTitle();
-        logActivity("DROP", studentID, courseCode, details);
-        return true;
+vector<string> UniversitySystem::getSections(const string& offeringCode) const {
+    vector<string> sections;
+    auto offeringIter = offerings.find(offeringCode);
+    if (offeringIter != offerings.end()) {
+        offeringIter->second.forEachKey([&](const string& sectionCode) {
+            sections.push_back(sectionCode);
+        });
+        sort(sections.begin(), sections.end());
     }
-    
-    return false;
+    return sections;
 }
 
 /**
- @brief lists all courses a student is enrolled in
+ @brief returns the offering a section belongs to
  
- @details displays course codes and names for a given student ID
+ @param sectionCode the section's course code
  
- @param studentID the ID of the student
+ @return (string) the offering's code, or an empty string if the course is not a section
  */
-void UniversitySystem::listStudentCourses(const string& studentID) const {
-    auto iter = students.find(studentID);
-    if (iter == students.end()) {
-        cout << "student not found" << endl;
-        return;
-    }
-    
-    const Student& student = iter->second;
-    cout << "\n=== Courses for " << student.getFullName() << " (ID: " << studentID << ") ===" << endl;
-    student.displayEnrolledCourses();
+string UniversitySystem::getSectionOffering(const string& sectionCode) const {
+    auto offeringIter = sectionOffering.find(sectionCode);
+    return offeringIter != sectionOffering.end() ? offeringIter->second : string();
 }
 
 /**
- @brief lists all students enrolled in a course
+ @brief finds a course in the registry, first building it from the catalog image if it is an unused image course
  
- @details includes both enrolled and waitlisted students
+ @details this is the only place image courses become Course objects, so a process pays for the courses it actually touches. building one is not a change anyone can observe, which is why it is allowed from const members and doesn't bump the version. a lookup never copies the course into a running checkpoint; paths that change it use findCourseEntryToChange or getCourse
  
- @param courseCode the course to list students for
+ @param courseCode the course code
+ 
+ @return (map<string, Course>::iterator) the course's entry, or courses.end() if there is no such course
  */
-void UniversitySystem::listCourseStudents(const string& courseCode) const {
+map<string, Course>::iterator UniversitySystem::findCourseEntry(const string& courseCode) const {
     auto iter = courses.find(courseCode);
-    if (iter == courses.end()) {
-        cout << "course not found" << endl;
-        return;
+    if (iter != courses.end()) {
+        return iter;
+    }
+    if (!catalog || catalogPending == 0) {
+        return iter;
+    }
+    pair<bool, size_t> found = catalog->findCourse(courseCode);
+    if (!found.first || catalogClaimed[found.second]) {
+        return iter;
     }
     
-    const Course& course = iter->second;
-    cout << "\n=== Students for " << course.getTitle() << " (Code: " << courseCode << ") ===" << endl;
-    course.displayEnrolledStudents();
-    course.displayWaitlist();
+    CatalogEntry entry = catalog->getCourse(found.second);
+    catalogClaimed[found.second] = true;
+    catalogPending--;
+    iter = courses.emplace(courseCode, Course(courseCode, string(entry.title), string(entry.instructorName), entry.capacity)).first;
+    noteNewCourse(courseCode);
+    leaderboard.refresh(iter->second);
+    return iter;
 }
 
 /**
- @brief displays all students in the system
+ @brief builds every unused catalog image course
  
- @details outputs each student's ID, name, and number of enrolled courses
+ @details called before anything that walks the whole registry (listings, snapshots, leaderboards, bulk removal), since those need every course to be a real entry
  */
-void UniversitySystem::displayAllStudents() const {
-    if (students.empty()) {
-        cout << "no students in the system" << endl;
+void UniversitySystem::materializeCatalog() const {
+    if (!catalog || catalogPending == 0) {
         return;
     }
-    
-    cout << "\n=== All Students ===" << endl;
-    for (const auto& pair : students) {
-        const Student& student = pair.second;
-        cout << "ID: " << student.getStudentID() << " | Name: " << student.getFullName() << " | Enrolled: " << student.getEnrollmentCount() << " courses" << endl;
+    auto hint = courses.begin();
+    for (size_t i = 0; i < catalogClaimed.size(); i++) {
+        if (catalogClaimed[i]) {
+            continue;
+        }
+        CatalogEntry entry = catalog->getCourse(i);
+        string courseCode(entry.courseCode);
+        hint = courses.lower_bound(courseCode);
+        hint = courses.emplace_hint(hint, courseCode, Course(courseCode, string(entry.title), string(entry.instructorName), entry.capacity));
+        noteNewCourse(courseCode);
+        leaderboard.refresh(hint->second);
+        catalogClaimed[i] = true;
     }
+    catalogPending = 0;
 }
 
 /**
- @brief displays all courses in the system
+ @brief finds a course that is about to change
  
- @details shows each course's code, title, instructor, enrollment status, and waitlist size
+ @details like findCourseEntry, but first copies the course into the running checkpoint if it hasn't reached it yet
+ 
+ @param courseCode the course code
+ 
+ @return (map<string, Course>::iterator) the course's entry, or courses.end() if there is no such course
  */
-void UniversitySystem::displayAllCourses() const {
-    if (courses.empty()) {
-        cout << "no courses in the system" << endl;
+map<string, Course>::iterator UniversitySystem::findCourseEntryToChange(const string& courseCode) {
+    auto iter = findCourseEntry(courseCode);
+    if (iter != courses.end()) {
+        preserveCourse(iter->second);
+    }
+    return iter;
+}
+
+/**
+ @brief returns a pointer to a Course object that is about to change
+ 
+ @details the course is copied into the running checkpoint first; read-only lookups use findCourse
+ 
+ @param courseCode the course code
+ 
+ @return (Course*) pointer to the Course object or null pointer if not found
+ */
+Course* UniversitySystem::getCourse(const string& courseCode) {
+    auto iter = findCourseEntryToChange(courseCode);
+    return (iter != courses.end()) ? &(iter->second) : nullptr;
+}
+
+/**
+ @brief checks if a course exists
+ 
+ @param courseCode the course code
+ 
+ @return (bool) true if course exists, false otherwise
+ */
+bool UniversitySystem::courseExists(const string& courseCode) const {
+    return findCourseEntry(courseCode) != courses.end();
+}
+
+/**
+ @brief enrolls a student in a course
+ 
+ @details updates both course and student records. logs the activity
+ 
+ @param studentID the student to enroll
+ @param courseCode the course to enroll in
+ 
+ @return (bool) true if enrolled successfully, false otherwise
+ */
+bool UniversitySystem::enrollStudentInCourse(const string& studentID, const string& courseCode) {
+    TraceSpan span("enrollStudentInCourse");
+    if (!studentExists(studentID) || !courseExists(courseCode)) {
+        *out << "either student or course doesn't exist -- can't enroll" << endl;
+        return false;
+    }
+    
+    Course* course = getCourse(courseCode);
+    bool enrolled = admitToCourse(*getStudent(studentID), *course);
+    refreshStanding(*course);
+    return enrolled;
+}
+
+/**
+ @brief enrolls several students in one course
+ 
+ @details the micro-batch form of enrollStudentInCourse: the course is looked up once and its leaderboard standing refreshed once, however many students are in the batch. students are admitted in the given order, so once the seats run out the rest are waitlisted exactly as if they had enrolled one at a time
+ 
+ @param courseCode the course to enroll in
+ @param studentIDs the students to enroll, in arrival order
+ 
+ @return (vector<bool>) one flag per student, true if that student was enrolled
+ */
+vector<bool> UniversitySystem::enrollStudentsInCourse(const string& courseCode, const vector<string>& studentIDs) {
+    vector<bool> results(studentIDs.size(), false);
+    Course* course = getCourse(courseCode);
+    if (course == nullptr) {
+        *out << "course doesn't exist -- can't enroll" << endl;
+        return results;
+    }
+    
+    for (size_t i = 0; i < studentIDs.size(); i++) {
+        Student* student = getStudent(studentIDs[i]);
+        if (student == nullptr) {
+            *out << "student " << studentIDs[i] << " doesn't exist -- can't enroll" << endl;
+            continue;
+        }
+        results[i] = admitToCourse(*student, *course);
+    }
+    refreshStanding(*course);
+    return results;
+}
+
+/**
+ @brief enrolls or waitlists a student once both records have been found
+ 
+ @details the caller refreshes the course's leaderboard standing, so a batch pays for it once
+ 
+ @param student the student to enroll
+ @param course the course to enroll in
+ @param quiet true to print nothing when the student is refused or waitlisted, for callers that report a summary instead
+ 
+ @return (bool) true if enrolled, false if waitlisted or refused
+ */
+bool UniversitySystem::admitToCourse(Student& student, Course& course, bool quiet) {
+    const string& studentID = student.getStudentID();
+    const string& courseCode = course.getCourseCode();
+    
+    if (course.isStudentEnrolled(studentID)) {
+        if (!quiet) {
+            *out << "Student already enrolled in course" << endl;
+        }
+        return false;
+    }
+    
+    if (student.isWaitlistedFor(courseCode)) {
+        if (!quiet) {
+            *out << "already on waitlist" << endl;
+        }
+        return false;
+    }
+    
+    if (course.isSeatHeldBy(studentID)) {
+        if (!quiet) {
+            *out << "student holds a seat -- confirm the hold instead" << endl;
+        }
+        return false;
+    }
+    
+    if (course.isSectioned()) {
+        if (findStudentSection(studentID, courseCode, false) != nullptr || findStudentSection(studentID, courseCode, true) != nullptr) {
+            if (!quiet) {
+                *out << "student already has a seat in a section of " << courseCode << endl;
+            }
+            return false;
+        }
+        Course* section = leastLoadedSection(courseCode);
+        if (section != nullptr) {
+            preserveCourse(*section);
+            bool enrolled = admitToCourse(student, *section, quiet);
+            refreshStanding(*section);
+            return enrolled;
+        }
+    }
+    
+    auto offeringIter = sectionOffering.find(courseCode);
+    if (offeringIter != sectionOffering.end()) {
+        if (hasSectionPlace(studentID, offeringIter->second)) {
+            if (!quiet) {
+                *out << "student is already in or waiting for a section of " << offeringIter->second << endl;
+            }
+            return false;
+        }
+        if (course.getAvailableSeats() == 0) {
+            if (!quiet) {
+                *out << "section is full -- enroll in " << offeringIter->second << " to join its waitlist" << endl;
+            }
+            return false;
+        }
+    }
+    
+    int priorityRank = course.getWaitlistPolicy().rank(student, course);
+    if (course.enrollStudent(studentID, priorityRank)) {
+        student.enrollInCourse(courseCode);
+        string details = "Enrolled " + student.getFullName() + " in " + course.getTitle();
+        logActivity("ENROLL", studentID, courseCode, details);
+        return true;
+    }
+    
+    if (course.isStudentWaitlisted(studentID)) {
+        student.joinWaitlist(courseCode);
+        if (!quiet) {
+            *out << "Added student to waitlist" << endl;
+        }
+    }
+    return false;
+}
+
+/**
+ @brief drops a student from a course
+ 
+ @param studentID the student to drop
+ @param courseCode the course to drop from
+ 
+ @return (bool) true if dropped successfully, false otherwise
+ */
+bool UniversitySystem::dropStudentFromCourse(const string& studentID, const string& courseCode) {
+    TraceSpan span("dropStudentFromCourse");
+    if (!studentExists(studentID) || !courseExists(courseCode)) {
+        *out << "either student or course doesn't exist -- can't drop" << endl;
+        return false;
+    }
+    
+    Student* student = getStudent(studentID);
+    Course* course = getCourse(courseCode);
+    Course* section = findStudentSection(studentID, courseCode, false);
+    if (section != nullptr) {
+        preserveCourse(*section);
+        course = section;
+    }
+    
+    if (course->dropStudent(studentID)) {
+        student->dropCourse(course->getCourseCode());
+        string details = "Dropped " + student->getFullName() + " from " + course->getTitle();
+        logActivity("DROP", studentID, course->getCourseCode(), details);
+        promoteWaitlistedStudents(*course);
+        return true;
+    }
+    
+    return false;
+}
+
+/**
+ @brief drops several students from one course
+ 
+ @details the micro-batch form of dropStudentFromCourse: the course is looked up once and its leaderboard standing refreshed once. each freed seat is still refilled from the waitlist before the next drop, so a student promoted by one drop can be dropped by a later one exactly as if the drops had come one at a time
+ 
+ @param courseCode the course to drop from
+ @param studentIDs the students to drop
+ 
+ @return (vector<bool>) one flag per student, true if that student was dropped
+ */
+vector<bool> UniversitySystem::dropStudentsFromCourse(const string& courseCode, const vector<string>& studentIDs) {
+    vector<bool> results(studentIDs.size(), false);
+    Course* course = getCourse(courseCode);
+    if (course == nullptr) {
+        *out << "course doesn't exist -- can't drop" << endl;
+        return results;
+    }
+    if (course->isSectioned()) {
+        // the students are spread over the sections, so each drop goes to its own section
+        for (size_t i = 0; i < studentIDs.size(); i++) {
+            results[i] = dropStudentFromCourse(studentIDs[i], courseCode);
+        }
+        return results;
+    }
+    
+    for (size_t i = 0; i < studentIDs.size(); i++) {
+        Student* student = getStudent(studentIDs[i]);
+        if (student == nullptr) {
+            *out << "student " << studentIDs[i] << " doesn't exist -- can't drop" << endl;
+            continue;
+        }
+        if (course->dropStudent(studentIDs[i])) {
+            student->dropCourse(courseCode);
+            logActivity("DROP", studentIDs[i], courseCode, "Dropped " + student->getFullName() + " from " + course->getTitle());
+            promoteWaitlistedStudents(*course, false);
+            results[i] = true;
+        }
+    }
+    refreshStanding(*course);
+    return results;
+}
+
+/**
+ @brief validates a whole schedule without changing anything
+ 
+ @details checks that the student exists, that no course is listed twice, and that every course exists, has an open seat, and neither enrolls nor waitlists the student. records each course's version stamp so commitSchedule can tell whether any of them changed in between
+ 
+ @param studentID the student to enroll
+ @param courseCodes the courses to enroll in
+ @param transaction filled in with the student and the courses' version stamps
+ 
+ @return (pair<bool, string>) true if every seat is available, otherwise false and the reason
+ */
+pair<bool, string> UniversitySystem::prepareSchedule(const string& studentID, const vector<string>& courseCodes, ScheduleTransaction& transaction) const {
+    transaction.studentID = studentID;
+    transaction.readSet.clear();
+    
+    const Student* student = findStudent(studentID);
+    if (student == nullptr) {
+        return make_pair(false, "student " + studentID + " doesn't exist");
+    }
+    if (courseCodes.empty()) {
+        return make_pair(false, "no courses given");
+    }
+    
+    for (const auto& courseCode : courseCodes) {
+        for (const auto& read : transaction.readSet) {
+            if (read.first == courseCode) {
+                return make_pair(false, courseCode + " is listed twice");
+            }
+        }
+        
+        const Course* course = findCourse(courseCode);
+        if (course == nullptr) {
+            return make_pair(false, "course " + courseCode + " doesn't exist");
+        }
+        if (course->isSectioned() && !student->isWaitlistedFor(courseCode)) {
+            if (hasSectionPlace(studentID, courseCode)) {
+                return make_pair(false, "already has a seat in a section of " + courseCode);
+            }
+            course = leastLoadedSection(courseCode);
+            if (course == nullptr) {
+                return make_pair(false, courseCode + " is full");
+            }
+        }
+        string conflict = scheduleConflict(*student, *course, transaction, transaction.readSet.size());
+        if (!conflict.empty()) {
+            return make_pair(false, conflict);
+        }
+        if (course->getAvailableSeats() == 0) {
+            return make_pair(false, courseCode + " is full");
+        }
+        transaction.readSet.emplace_back(course->getCourseCode(), course->getVersion());
+    }
+    return make_pair(true, "");
+}
+
+/**
+ @brief checks the rules a schedule seat must meet besides being open
+ 
+ @details the student must not already be enrolled, waitlisted or holding a seat in the course, and for a section must not already have a place in another section of its offering or list one earlier in the schedule. only reads the student's and the section's own records, so it is cheap enough to run again at commit
+ 
+ @param student the student
+ @param course the course or section the seat is in
+ @param transaction the schedule being checked
+ @param listed how many of the transaction's courses come before this one
+ 
+ @return (string) why the student can't take the seat, or an empty string if they can
+ */
+string UniversitySystem::scheduleConflict(const Student& student, const Course& course, const ScheduleTransaction& transaction, size_t listed) const {
+    const string& studentID = student.getStudentID();
+    const string& courseCode = course.getCourseCode();
+    string offeringCode = getSectionOffering(courseCode);
+    if (!offeringCode.empty()) {
+        if (hasSectionPlace(studentID, offeringCode)) {
+            return "already in or waiting for a section of " + offeringCode;
+        }
+        for (size_t i = 0; i < listed; i++) {
+            if (getSectionOffering(transaction.readSet[i].first) == offeringCode) {
+                return "two sections of " + offeringCode + " are listed";
+            }
+        }
+    }
+    if (course.isStudentEnrolled(studentID)) {
+        return "already enrolled in " + courseCode;
+    }
+    if (student.isWaitlistedFor(courseCode)) {
+        return "already on the waitlist for " + courseCode;
+    }
+    if (course.isSeatHeldBy(studentID)) {
+        return "already holding a seat in " + courseCode;
+    }
+    return "";
+}
+
+/**
+ @brief applies a prepared schedule if none of its courses changed since it was validated
+ 
+ @details optimistic: nothing is locked between prepare and commit. if any course in the read set was changed, removed or replaced, nothing is applied and the caller can prepare again. the student's own places can change without touching those courses (a seat taken in another section of an offering, say), so the per-student checks of prepareSchedule run again too. then every enrollment succeeds, since each course still has the open seat that was seen; should one not, the ones already made are undone, so there is never a partial schedule or a waitlist side effect
+ 
+ @param transaction a transaction filled in by prepareSchedule
+ 
+ @return (pair<bool, string>) true if the whole schedule was applied, otherwise false and the course that changed or the rule that now fails
+ */
+pair<bool, string> UniversitySystem::commitSchedule(const ScheduleTransaction& transaction) {
+    Student* student = getStudent(transaction.studentID);
+    if (student == nullptr || transaction.readSet.empty()) {
+        return make_pair(false, "nothing to commit for " + transaction.studentID);
+    }
+    
+    vector<Course*> targets;
+    for (size_t i = 0; i < transaction.readSet.size(); i++) {
+        const auto& read = transaction.readSet[i];
+        Course* course = getCourse(read.first);
+        if (course == nullptr || course->getVersion() != read.second) {
+            return make_pair(false, read.first + " changed since the schedule was checked");
+        }
+        string conflict = scheduleConflict(*student, *course, transaction, i);
+        if (!conflict.empty()) {
+            return make_pair(false, conflict);
+        }
+        targets.push_back(course);
+    }
+    
+    for (size_t i = 0; i < targets.size(); i++) {
+        if (targets[i]->enrollStudent(transaction.studentID)) {
+            continue;
+        }
+        targets[i]->withdrawFromWaitlist(transaction.studentID);
+        for (size_t undo = 0; undo < i; undo++) {
+            targets[undo]->dropStudent(transaction.studentID);
+        }
+        return make_pair(false, targets[i]->getCourseCode() + " had no open seat at commit");
+    }
+    for (Course* course : targets) {
+        student->enrollInCourse(course->getCourseCode());
+        refreshStanding(*course);
+        logActivity("ENROLL", transaction.studentID, course->getCourseCode(), "Enrolled " + student->getFullName() + " in " + course->getTitle() + " (schedule)");
+    }
+    return make_pair(true, "");
+}
+
+/**
+ @brief enrolls a student in every course of a schedule, or in none of them
+ 
+ @details never waitlists: if any course is full, missing, or already holds the student, nothing changes and the reason is printed
+ 
+ @param studentID the student to enroll
+ @param courseCodes the courses to enroll in
+ 
+ @return (bool) true if the student was enrolled in every course, false otherwise
+ */
+bool UniversitySystem::enrollSchedule(const string& studentID, const vector<string>& courseCodes) {
+    ScheduleTransaction transaction;
+    pair<bool, string> result = prepareSchedule(studentID, courseCodes, transaction);
+    if (result.first) {
+        result = commitSchedule(transaction);
+    }
+    if (!result.first) {
+        *out << "schedule not enrolled: " << result.second << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ @brief places a time-limited hold on an open seat
+ 
+ @details the held seat counts against capacity, so it can't be taken by another enrollment or a waitlist promotion. the hold must be confirmed before it expires; expireHolds releases it otherwise
+ 
+ @param studentID the student to hold the seat for
+ @param courseCode the course to hold a seat in
+ @param seconds how long the hold lasts
+ 
+ @return (bool) true if the seat was held, false otherwise
+ */
+bool UniversitySystem::placeHold(const string& studentID, const string& courseCode, int seconds) {
+    Student* student = getStudent(studentID);
+    Course* course = getCourse(courseCode);
+    if (student == nullptr || course == nullptr) {
+        *out << "either student or course doesn't exist -- can't hold a seat" << endl;
+        return false;
+    }
+    if (seconds <= 0) {
+        *out << "hold length must be positive" << endl;
+        return false;
+    }
+    if (course->isStudentEnrolled(studentID) || student->isWaitlistedFor(courseCode) || course->isSeatHeldBy(studentID)) {
+        *out << "student is already enrolled, waiting, or holding a seat" << endl;
+        return false;
+    }
+    string offeringCode = course->isSectioned() ? courseCode : getSectionOffering(courseCode);
+    if (!offeringCode.empty() && hasSectionPlace(studentID, offeringCode)) {
+        *out << "student is already in or waiting for a section of " << offeringCode << endl;
+        return false;
+    }
+    if (course->isSectioned()) {
+        course = leastLoadedSection(courseCode);
+        if (course == nullptr) {
+            *out << "no open seat to hold" << endl;
+            return false;
+        }
+        preserveCourse(*course);
+    }
+    if (!course->holdSeat(studentID)) {
+        *out << "no open seat to hold" << endl;
+        return false;
+    }
+    refreshSectionLoad(*course);
+    
+    const string& heldCode = course->getCourseCode();
+    chrono::steady_clock::time_point expiry = chrono::steady_clock::now() + chrono::seconds(seconds);
+    seatHolds[make_pair(studentID, heldCode)] = holdTimers.schedule(holdTickAt(expiry), make_pair(studentID, heldCode));
+    logActivity("HOLD", studentID, heldCode, "Held a seat in " + course->getTitle() + " for " + student->getFullName() + " for " + to_string(seconds) + "s");
+    return true;
+}
+
+/**
+ @brief turns a held seat into an enrollment
+ 
+ @param studentID the student holding the seat
+ @param requestedCode the course the seat is in, or its offering if it is a section
+ 
+ @return (bool) true if enrolled, false if there is no pending hold (it may have expired)
+ */
+bool UniversitySystem::confirmHold(const string& studentID, const string& requestedCode) {
+    expireHolds();
+    Course* heldSection = findStudentSection(studentID, requestedCode, true);
+    const string& courseCode = heldSection != nullptr ? heldSection->getCourseCode() : requestedCode;
+    auto holdIter = seatHolds.find(make_pair(studentID, courseCode));
+    if (holdIter == seatHolds.end()) {
+        *out << "no pending hold to confirm" << endl;
+        return false;
+    }
+    
+    Student* student = getStudent(studentID);
+    Course* course = getCourse(courseCode);
+    holdTimers.cancel(holdIter->second);
+    seatHolds.erase(holdIter);
+    course->confirmSeat(studentID);
+    student->enrollInCourse(courseCode);
+    refreshStanding(*course);
+    logActivity("ENROLL", studentID, courseCode, "Enrolled " + student->getFullName() + " in " + course->getTitle() + " (confirmed hold)");
+    return true;
+}
+
+/**
+ @brief gives a held seat back before it expires
+ 
+ @details the seat goes to the head of the waitlist, if anyone is waiting
+ 
+ @param studentID the student holding the seat
+ @param requestedCode the course the seat is in, or its offering if it is a section
+ 
+ @return (bool) true if a hold was released, false otherwise
+ */
+bool UniversitySystem::releaseHold(const string& studentID, const string& requestedCode) {
+    Course* heldSection = findStudentSection(studentID, requestedCode, true);
+    const string& courseCode = heldSection != nullptr ? heldSection->getCourseCode() : requestedCode;
+    auto holdIter = seatHolds.find(make_pair(studentID, courseCode));
+    if (holdIter == seatHolds.end()) {
+        *out << "no pending hold to release" << endl;
+        return false;
+    }
+    
+    holdTimers.cancel(holdIter->second);
+    seatHolds.erase(holdIter);
+    Course* course = getCourse(courseCode);
+    course->releaseSeat(studentID);
+    logActivity("RELEASE HOLD", studentID, courseCode, "Released held seat in " + course->getTitle());
+    promoteWaitlistedStudents(*course);
+    return true;
+}
+
+/**
+ @brief releases every hold whose time is up
+ 
+ @return (int) the number of holds released
+ */
+int UniversitySystem::expireHolds() {
+    return expireHolds(chrono::steady_clock::now());
+}
+
+/**
+ @brief releases every hold that expires by a given time and refills the freed seats from the waitlists
+ 
+ @details advances the hold timer wheel, so the cost depends on the holds that expire, not on the number of courses or pending holds
+ 
+ @param now the time to expire holds up to
+ 
+ @return (int) the number of holds released
+ */
+int UniversitySystem::expireHolds(chrono::steady_clock::time_point now) {
+    int expired = 0;
+    holdTimers.advance(holdTickAt(now), [&](const pair<string, string>& key) {
+        seatHolds.erase(key);
+        Course* course = getCourse(key.second);
+        if (course == nullptr || !course->releaseSeat(key.first)) {
+            return;
+        }
+        logActivity("HOLD EXPIRED", key.first, key.second, "Hold on a seat in " + course->getTitle() + " expired");
+        promoteWaitlistedStudents(*course);
+        expired++;
+    });
+    return expired;
+}
+
+/**
+ @brief returns the number of seats on hold
+ 
+ @return (size_t) the number of pending holds
+ */
+size_t UniversitySystem::getHoldCount() const {
+    return seatHolds.size();
+}
+
+/**
+ @brief records a student's ranked course choices for the registration window
+ 
+ @details nothing is enrolled yet: every submission waits for closeRegistrationWindow, which allocates the remaining seats to all of them at once, so the order and speed of submissions don't matter. a new submission replaces the student's earlier one
+ 
+ @param studentID the student
+ @param courseCodes the courses in preference order, most wanted first; a multi-section offering stands for any of its sections
+ @param maxCourses the most seats the student wants from the window; 0 for as many as they ranked
+ 
+ @return (bool) true if the choices were recorded, false otherwise
+ */
+bool UniversitySystem::submitPreferences(const string& studentID, const vector<string>& courseCodes, int maxCourses) {
+    if (!studentExists(studentID)) {
+        *out << "student doesn't exist -- can't submit preferences" << endl;
+        return false;
+    }
+    if (courseCodes.empty() || maxCourses < 0) {
+        *out << "no courses ranked or invalid course limit -- preferences not submitted" << endl;
+        return false;
+    }
+    for (size_t i = 0; i < courseCodes.size(); i++) {
+        if (!courseExists(courseCodes[i])) {
+            *out << "course " << courseCodes[i] << " doesn't exist -- preferences not submitted" << endl;
+            return false;
+        }
+        if (find(courseCodes.begin(), courseCodes.begin() + i, courseCodes[i]) != courseCodes.begin() + i) {
+            *out << courseCodes[i] << " is ranked twice -- preferences not submitted" << endl;
+            return false;
+        }
+    }
+    
+    CoursePreferences& entry = preferences[studentID];
+    entry.courseCodes = courseCodes;
+    entry.maxCourses = maxCourses;
+    logActivity("PREFERENCES", studentID, courseCodes.front(), "Ranked " + to_string(courseCodes.size()) + " courses, first choice " + courseCodes.front());
+    return true;
+}
+
+/**
+ @brief returns the number of students waiting for the registration window to close
+ 
+ @return (size_t) the number of submitted preference lists
+ */
+size_t UniversitySystem::getPendingPreferences() const {
+    return preferences.size();
+}
+
+/**
+ @brief closes the registration window: allocates the open seats to every submitted preference list at once and applies the result
+ 
+ @details the seats are matched with SeatLottery (deferred acceptance, ties broken by a seeded lottery), then applied: admitted students are enrolled, and a student a course turned away joins its waitlist, best priority first, only while their seats and waitlist entries from the window are fewer than the courses they asked for. those entries go to their highest-ranked choices. choices the student already has a place in are skipped. the per-student notices are replaced by one summary
+ 
+ @param seed seeds the lottery; the same seed and submissions give the same allocation
+ 
+ @return (LotteryStats) the counts from the matching and the enrollments and waitlist entries made
+ */
+LotteryStats UniversitySystem::closeRegistrationWindow(unsigned long long seed) {
+    TraceSpan span("closeRegistrationWindow");
+    expireHolds();
+    TraceSpan build("closeRegistrationWindow.build");
+    SeatLottery lottery;
+    map<string, uint32_t> courseIndex;
+    vector<Course*> lotteryCourses;
+    vector<Student*> lotteryStudents;
+    vector<int> limits;
+    vector<vector<uint32_t>> rankedCourses;
+    
+    auto openSeats = [&](const Course& course) {
+        if (!course.isSectioned()) {
+            return course.getAvailableSeats();
+        }
+        int open = 0;
+        for (const auto& sectionCode : getSections(course.getCourseCode())) {
+            const Course* section = findCourse(sectionCode);
+            open += section != nullptr ? section->getAvailableSeats() : 0;
+        }
+        return open;
+    };
+    
+    for (const auto& entry : preferences) {
+        const string& studentID = entry.first;
+        Student* student = getStudent(studentID);
+        if (student == nullptr) {
+            continue;
+        }
+        const CoursePreferences& choices = entry.second;
+        limits.push_back(choices.maxCourses > 0 ? choices.maxCourses : static_cast<int>(choices.courseCodes.size()));
+        lottery.addStudent(limits.back());
+        lotteryStudents.push_back(student);
+        rankedCourses.emplace_back();
+        for (const auto& courseCode : choices.courseCodes) {
+            Course* course = getCourse(courseCode);
+            if (course == nullptr || course->isStudentEnrolled(studentID) || course->isSeatHeldBy(studentID) || student->isWaitlistedFor(courseCode) ||
+                (course->isSectioned() && hasSectionPlace(studentID, courseCode))) {
+                continue;
+            }
+            auto indexIter = courseIndex.find(courseCode);
+            if (indexIter == courseIndex.end()) {
+                indexIter = courseIndex.emplace(courseCode, lottery.addCourse(openSeats(*course))).first;
+                lotteryCourses.push_back(course);
+            }
+            lottery.addChoice(indexIter->second, course->getWaitlistPolicy().rank(*student, *course));
+            rankedCourses.back().push_back(indexIter->second);
+        }
+    }
+    
+    build.end();
+    
+    TraceSpan match("closeRegistrationWindow.match");
+    LotteryStats stats = lottery.run(seed);
+    match.setArg("proposals", stats.proposals);
+    match.end();
+    
+    TraceSpan apply("closeRegistrationWindow.apply");
+    vector<int> places(lotteryStudents.size(), 0);
+    auto admit = [&](uint32_t studentIndex, Course& course) {
+        Student& student = *lotteryStudents[studentIndex];
+        if (admitToCourse(student, course, true)) {
+            stats.enrolled++;
+            places[studentIndex]++;
+        } else if (student.isWaitlistedFor(course.getCourseCode())) {
+            stats.waitlisted++;
+            places[studentIndex]++;
+        }
+    };
+    for (uint32_t index = 0; index < lotteryCourses.size(); index++) {
+        for (uint32_t studentIndex : lottery.getAdmitted(index)) {
+            admit(studentIndex, *lotteryCourses[index]);
+        }
+    }
+    
+    // the waitlist entries a student still has room for go to the best-ranked courses that turned them away
+    vector<vector<uint32_t>> turnedAwayFrom(lotteryStudents.size());
+    for (uint32_t index = 0; index < lotteryCourses.size(); index++) {
+        for (uint32_t studentIndex : lottery.getTurnedAway(index)) {
+            turnedAwayFrom[studentIndex].push_back(index);
+        }
+    }
+    set<pair<uint32_t, uint32_t>> waitlistPlaces;
+    for (uint32_t studentIndex = 0; studentIndex < lotteryStudents.size(); studentIndex++) {
+        int room = limits[studentIndex] - places[studentIndex];
+        const vector<uint32_t>& turnedAway = turnedAwayFrom[studentIndex];
+        for (size_t i = 0; i < rankedCourses[studentIndex].size() && room > 0; i++) {
+            uint32_t index = rankedCourses[studentIndex][i];
+            if (find(turnedAway.begin(), turnedAway.end(), index) != turnedAway.end()) {
+                waitlistPlaces.emplace(index, studentIndex);
+                room--;
+            }
+        }
+    }
+    for (uint32_t index = 0; index < lotteryCourses.size(); index++) {
+        Course& course = *lotteryCourses[index];
+        for (uint32_t studentIndex : lottery.getTurnedAway(index)) {
+            if (waitlistPlaces.count(make_pair(index, studentIndex)) > 0) {
+                admit(studentIndex, course);
+            }
+        }
+        refreshStanding(course);
+    }
+    apply.end();
+    
+    preferences.clear();
+    string summary = to_string(stats.students) + " students, " + to_string(stats.enrolled) + " seats assigned, " + to_string(stats.waitlisted) + " waitlist entries";
+    logActivity("LOTTERY", "", "", "Closed the registration window (seed " + to_string(seed) + "): " + summary);
+    *out << "Registration window closed: " << summary << endl;
+    return stats;
+}
+
+/**
+ @brief converts a time to a hold timer tick
+ 
+ @param when the time to convert
+ 
+ @return (unsigned long long) HOLD_TICK_MILLIS ticks since the system was created, rounded up so a hold never expires early
+ */
+unsigned long long UniversitySystem::holdTickAt(chrono::steady_clock::time_point when) const {
+    if (when <= holdClockStart) {
+        return 0;
+    }
+    long long millis = chrono::duration_cast<chrono::milliseconds>(when - holdClockStart).count();
+    return static_cast<unsigned long long>((millis + HOLD_TICK_MILLIS - 1) / HOLD_TICK_MILLIS);
+}
+
+/**
+ @brief forgets a hold and its timer without touching the course
+ 
+ @details used when the course itself is being removed
+ 
+ @param studentID the student holding the seat
+ @param courseCode the course the seat is in
+ */
+void UniversitySystem::discardHold(const string& studentID, const string& courseCode) {
+    auto holdIter = seatHolds.find(make_pair(studentID, courseCode));
+    if (holdIter != seatHolds.end()) {
+        holdTimers.cancel(holdIter->second);
+        seatHolds.erase(holdIter);
+    }
+}
+
+/**
+ @brief promotes waitlisted students into every free seat of a course
+ 
+ @details runs after any drop, student removal, or capacity change. each promoted student is enrolled on both sides of the relation and gets a PROMOTED log entry. costs O(k log n) for k promotions, no scan of the waitlist. for a section or a multi-section offering, the offering's shared waitlist is then placed into whichever sections have seats. the course's leaderboard standing is refreshed afterwards, so callers that changed its counts rely on this
+ 
+ @param course the course that may have free seats
+ @param refreshLeaderboard false to leave the leaderboard refresh to a caller that changes the course several times
+ 
+ @return (int) the number of students promoted
+ */
+int UniversitySystem::promoteWaitlistedStudents(Course& course, bool refreshLeaderboard) {
+    TraceSpan span("promoteWaitlistedStudents");
+    vector<string> promoted = course.promoteFromWaitlist();
+    const string& courseCode = course.getCourseCode();
+    
+    for (const auto& studentID : promoted) {
+        auto studentIter = students.find(studentID);
+        if (studentIter == students.end()) {
+            continue;
+        }
+        
+        Student& student = studentIter->second;
+        student.leaveWaitlist(courseCode);
+        student.enrollInCourse(courseCode);
+        logActivity("PROMOTED", studentID, courseCode, "Promoted " + student.getFullName() + " from the waitlist of " + course.getTitle());
+    }
+    
+    int placed = 0;
+    auto offeringIter = sectionOffering.find(courseCode);
+    if (offeringIter != sectionOffering.end()) {
+        refreshSectionLoad(course);
+        placed = placeFromSharedWaitlist(*getCourse(offeringIter->second));
+    } else if (course.isSectioned()) {
+        placed = placeFromSharedWaitlist(course);
+    }
+    
+    if (refreshLeaderboard) {
+        leaderboard.refresh(course);
+    }
+    span.setArg("promoted", promoted.size() + placed);
+    return promoted.size() + placed;
+}
+
+/**
+ @brief records a course's new counts everywhere they are ranked
+ 
+ @details refreshes the course's leaderboard standing and, if it is a section, its place in the offering's heap
+ 
+ @param course the course that changed
+ */
+void UniversitySystem::refreshStanding(Course& course) {
+    leaderboard.refresh(course);
+    refreshSectionLoad(course);
+}
+
+/**
+ @brief re-ranks a section in its offering's heap after its enrollment, holds or capacity changed
+ 
+ @details O(log s) for an offering with s sections; does nothing for a course that isn't a section
+ 
+ @param course the course that changed
+ */
+void UniversitySystem::refreshSectionLoad(const Course& course) {
+    auto sectionIter = sectionOffering.find(course.getCourseCode());
+    if (sectionIter == sectionOffering.end()) {
+        return;
+    }
+    SectionLoad load;
+    load.taken = course.getCurrentEnrollment() + course.getHeldSeats();
+    load.capacity = course.getCapacity();
+    load.sectionCode = course.getCourseCode();
+    offerings[sectionIter->second].update(course.getCourseCode(), load);
+}
+
+/**
+ @brief finds the section a new student of an offering should go to
+ 
+ @details reads the top of the offering's heap, so it is O(1)
+ 
+ @param offeringCode the offering's course code
+ 
+ @return (Course*) the least-loaded section with an open seat, or a null pointer if every section is full
+ */
+Course* UniversitySystem::leastLoadedSection(const string& offeringCode) const {
+    auto offeringIter = offerings.find(offeringCode);
+    if (offeringIter == offerings.end() || offeringIter->second.empty() || offeringIter->second.topPriority().isFull()) {
+        return nullptr;
+    }
+    auto sectionIter = findCourseEntry(offeringIter->second.topKey());
+    if (sectionIter == courses.end() || sectionIter->second.getAvailableSeats() == 0) {
+        return nullptr;
+    }
+    return &sectionIter->second;
+}
+
+/**
+ @brief finds the section of an offering where a student is enrolled or holds a seat
+ 
+ @param studentID the student
+ @param offeringCode the offering's course code
+ @param held false to look for an enrollment, true to look for a held seat
+ 
+ @return (Course*) the section, or a null pointer if there is none or the course has no sections
+ */
+Course* UniversitySystem::findStudentSection(const string& studentID, const string& offeringCode, bool held) const {
+    auto offeringIter = offerings.find(offeringCode);
+    if (offeringIter == offerings.end()) {
+        return nullptr;
+    }
+    Course* found = nullptr;
+    offeringIter->second.forEachKey([&](const string& sectionCode) {
+        auto sectionIter = findCourseEntry(sectionCode);
+        if (found == nullptr && sectionIter != courses.end() &&
+            (held ? sectionIter->second.isSeatHeldBy(studentID) : sectionIter->second.isStudentEnrolled(studentID))) {
+            found = &sectionIter->second;
+        }
+    });
+    return found;
+}
+
+/**
+ @brief checks if a student already has a place anywhere in an offering
+ 
+ @param studentID the student
+ @param offeringCode the offering's course code
+ 
+ @return (bool) true if the student is on the offering's waitlist or enrolled or holding a seat in one of its sections
+ */
+bool UniversitySystem::hasSectionPlace(const string& studentID, const string& offeringCode) const {
+    auto studentIter = students.find(studentID);
+    if (studentIter != students.end() && studentIter->second.isWaitlistedFor(offeringCode)) {
+        return true;
+    }
+    return findStudentSection(studentID, offeringCode, false) != nullptr || findStudentSection(studentID, offeringCode, true) != nullptr;
+}
+
+/**
+ @brief moves students from an offering's shared waitlist into its sections while any section has a seat
+ 
+ @details each student goes to whichever section is least loaded at that moment and gets a PROMOTED log entry against the section. O(k log s) for k placements
+ 
+ @param offering the offering
+ 
+ @return (int) the number of students placed
+ */
+int UniversitySystem::placeFromSharedWaitlist(Course& offering) {
+    const string& offeringCode = offering.getCourseCode();
+    int placed = 0;
+    while (offering.getWaitlistSize() > 0) {
+        Course* section = leastLoadedSection(offeringCode);
+        if (section == nullptr) {
+            break;
+        }
+        string studentID = offering.takeFromWaitlist();
+        auto studentIter = students.find(studentID);
+        if (studentIter == students.end()) {
+            continue;
+        }
+        preserveCourse(*section);
+        
+        Student& student = studentIter->second;
+        student.leaveWaitlist(offeringCode);
+        section->enrollStudent(studentID);
+        student.enrollInCourse(section->getCourseCode());
+        logActivity("PROMOTED", studentID, section->getCourseCode(), "Promoted " + student.getFullName() + " from the waitlist of " + offering.getTitle() + " into section " + section->getCourseCode());
+        refreshStanding(*section);
+        placed++;
+    }
+    if (placed > 0) {
+        leaderboard.refresh(offering);
+    }
+    return placed;
+}
+
+/**
+ @brief unlinks a removed course from the section tables
+ 
+ @details a removed offering takes its section links with it. removing an offering's last section turns it back into an ordinary course, whose own seats are then offered to its waitlist
+ 
+ @param courseCode the code of the course that was removed
+ */
+void UniversitySystem::forgetCourse(const string& courseCode) {
+    auto offeringIter = offerings.find(courseCode);
+    if (offeringIter != offerings.end() || sectionOffering.count(courseCode) > 0) {
+        preserveSections();
+    }
+    if (offeringIter != offerings.end()) {
+        offeringIter->second.forEachKey([&](const string& sectionCode) {
+            sectionOffering.erase(sectionCode);
+        });
+        offerings.erase(offeringIter);
+    }
+    
+    auto sectionIter = sectionOffering.find(courseCode);
+    if (sectionIter == sectionOffering.end()) {
+        return;
+    }
+    string offeringCode = sectionIter->second;
+    sectionOffering.erase(sectionIter);
+    offeringIter = offerings.find(offeringCode);
+    offeringIter->second.erase(courseCode);
+    if (!offeringIter->second.empty()) {
+        return;
+    }
+    offerings.erase(offeringIter);
+    Course* offering = getCourse(offeringCode);
+    if (offering != nullptr) {
+        offering->setSectioned(false);
+        promoteWaitlistedStudents(*offering);
+    }
+}
+
+/**
+ @brief lists all courses a student is enrolled in
+ 
+ @details displays course codes and names for a given student ID
+ 
+ @param studentID the ID of the student
+ */
+void UniversitySystem::listStudentCourses(const string& studentID) const {
+    auto iter = students.find(studentID);
+    if (iter == students.end()) {
+        *out << "student not found" << endl;
+        return;
+    }
+    
+    const Student& student = iter->second;
+    ReportWriter report(*out);
+    report << "\n=== Courses for " << student.getFullName() << " (ID: " << studentID << ") ===\n";
+    student.displayEnrolledCourses(report);
+}
+
+/**
+ @brief lists all students enrolled in a course
+ 
+ @details includes both enrolled and waitlisted students
+ 
+ @param courseCode the course to list students for
+ */
+void UniversitySystem::listCourseStudents(const string& courseCode) const {
+    auto iter = findCourseEntry(courseCode);
+    if (iter == courses.end()) {
+        *out << "course not found" << endl;
+        return;
+    }
+    
+    const Course& course = iter->second;
+    ReportWriter report(*out);
+    report << "\n=== Students for " << course.getTitle() << " (Code: " << courseCode << ") ===\n";
+    if (course.isSectioned()) {
+        for (const auto& sectionCode : getSections(courseCode)) {
+            auto sectionIter = courses.find(sectionCode);
+            if (sectionIter != courses.end()) {
+                report << "Section " << sectionCode << ": " << sectionIter->second.getCurrentEnrollment() << '/' << sectionIter->second.getCapacity() << " enrolled\n";
+            }
+        }
+    } else {
+        course.displayEnrolledStudents(report);
+    }
+    course.displayWaitlist(report);
+}
+
+/**
+ @brief displays all students in the system
+ 
+ @details outputs each student's ID, name, and number of enrolled courses
+ */
+void UniversitySystem::displayAllStudents() const {
+    if (students.empty()) {
+        *out << "no students in the system" << endl;
+        return;
+    }
+    
+    ReportWriter report(*out);
+    report << "\n=== All Students ===\n";
+    for (const auto& pair : students) {
+        const Student& student = pair.second;
+        report << "ID: " << student.getStudentID() << " | Name: " << student.getFullName() << " | Enrolled: " << student.getEnrollmentCount() << " courses\n";
+    }
+}
+
+/**
+ @brief displays all courses in the system
+ 
+ @details shows each course's code, title, instructor, enrollment status, and waitlist size
+ */
+void UniversitySystem::displayAllCourses() const {
+    materializeCatalog();
+    if (courses.empty()) {
+        *out << "no courses in the system" << endl;
+        return;
+    }
+    
+    ReportWriter report(*out);
+    report << "\n=== All Courses ===\n";
+    for (const auto& pair : courses) {
+        const Course& course = pair.second;
+        report << "Code: " << course.getCourseCode() << " | Title: " << course.getTitle() << " | Instructor: " << course.getInstructorName();
+        if (course.isSectioned()) {
+            report << " | Sections: " << offerings.at(course.getCourseCode()).size();
+        } else {
+            report << " | Enrollment: " << course.getCurrentEnrollment() << '/' << course.getCapacity();
+        }
+        report << " | Waitlist: " << course.getWaitlistSize() << '\n';
+    }
+}
+
+/**
+ @brief writes every student as a report table
+ 
+ @param report the report to write to; its format picks table, CSV or JSON
+ */
+void UniversitySystem::reportStudents(ReportWriter& report) const {
+    report.beginTable("All Students", {ReportColumn("ID", 10), ReportColumn("Name", 24), ReportColumn("Standing", 8, true), ReportColumn("Major", 16),
+                                       ReportColumn("Enrolled", 8, true), ReportColumn("Waitlisted", 10, true)});
+    for (const auto& pair : students) {
+        const Student& student = pair.second;
+        report.cell(student.getStudentID()).cell(student.getFullName()).cell(student.getClassStanding()).cell(student.getMajor())
+              .cell(student.getEnrollmentCount()).cell(static_cast<long long>(student.getWaitlistedCourses().size()));
+        report.endRow();
+    }
+    report.endTable();
+}
+
+/**
+ @brief writes every course as a report table
+ 
+ @param report the report to write to; its format picks table, CSV or JSON
+ */
+void UniversitySystem::reportCourses(ReportWriter& report) const {
+    materializeCatalog();
+    report.beginTable("All Courses", {ReportColumn("Code", 10), ReportColumn("Title", 32), ReportColumn("Instructor", 20), ReportColumn("Enrolled", 8, true),
+                                      ReportColumn("Capacity", 8, true), ReportColumn("Held", 4, true), ReportColumn("Waitlist", 8, true)});
+    for (const auto& pair : courses) {
+        const Course& course = pair.second;
+        report.cell(course.getCourseCode()).cell(course.getTitle()).cell(course.getInstructorName()).cell(course.getCurrentEnrollment())
+              .cell(course.getCapacity()).cell(course.getHeldSeats()).cell(course.getWaitlistSize());
+        report.endRow();
+    }
+    report.endTable();
+}
+
+/**
+ @brief writes every course's roster as one report table, one row per enrolled or waitlisted student
+ 
+ @details enrolled students come first in ID order with position 0, then the waitlist in order with positions from 1. names are left to the students report so a row never needs a registry lookup
+ 
+ @param report the report to write to; its format picks table, CSV or JSON
+ */
+void UniversitySystem::reportRosters(ReportWriter& report) const {
+    materializeCatalog();
+    report.beginTable("Course Rosters", {ReportColumn("Course", 10), ReportColumn("Student", 10), ReportColumn("Status", 10), ReportColumn("Position", 8, true)});
+    auto row = [&](const Course& course, const string& studentID, const char* status, long long position) {
+        report.cell(course.getCourseCode()).cell(studentID).cell(status).cell(position);
+        report.endRow();
+    };
+    for (const auto& pair : courses) {
+        const Course& course = pair.second;
+        course.forEachEnrolledStudent([&](const string& studentID) {
+            row(course, studentID, "enrolled", 0);
+        });
+        long long position = 1;
+        course.forEachWaitlisted([&](const string& studentID) {
+            row(course, studentID, "waitlisted", position++);
+        });
+    }
+    report.endTable();
+}
+
+/**
+ @brief writes a named report
+ 
+ @param kind "students", "courses" or "rosters"
+ @param report the report to write to
+ 
+ @return (bool) true if the kind was recognized
+ */
+bool UniversitySystem::writeReport(const string& kind, ReportWriter& report) const {
+    if (kind == "students") {
+        reportStudents(report);
+    } else if (kind == "courses") {
+        reportCourses(report);
+    } else if (kind == "rosters") {
+        reportRosters(report);
+    } else {
+        *out << "unknown report " << kind << " -- expected students, courses or rosters" << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ @brief writes a named report straight to a file, one write per buffered page
+ 
+ @param kind "students", "courses" or "rosters"
+ @param format the layout
+ @param fileName path of the file to write
+ 
+ @return (bool) true if the report was written, false otherwise
+ */
+bool UniversitySystem::saveReport(const string& kind, ReportFormat format, const string& fileName) const {
+    int fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        *out << "Error: Could not open file " << fileName << " for writing" << endl;
+        return false;
+    }
+    bool ok;
+    {
+        ReportWriter report(fd, format);
+        ok = writeReport(kind, report) && report.flush();
+    }
+    ok = ::close(fd) == 0 && ok;
+    if (!ok) {
+        *out << "Error: Could not write report to " << fileName << endl;
+    }
+    return ok;
+}
+
+/**
+ @brief prints one activity log entry
+ 
+ @param entry the entry to print
+ */
+void UniversitySystem::printActivity(const ActivityLogEntry& entry) const {
+    *out << "[" << entry.timestamp << "] " << entry.action;
+    if (!entry.studentID.empty()) {
+        *out << " - Student: " << entry.studentID;
+    }
+    if (!entry.courseCode.empty()) {
+        *out << " - Course: " << entry.courseCode;
+    }
+    *out << " - " << entry.details << endl;
+}
+
+/**
+ @brief displays all logged system activities
+ 
+ @details includes timestamp, action tyep, student ID (if applicable), course code (if applicable), and details
+ */
+void UniversitySystem::displayActivityLog() const {
+    if (activityLog.empty()) {
+        *out << "no activities logged" << endl;
+        return;
+    }
+    
+    *out << "\n=== Activity Log ===" << endl;
+    activityLog.query(ActivityQuery(), [&](const ActivityLogEntry& entry) {
+        printActivity(entry);
+    });
+}
+
+/**
+ @brief displays the most recent activities from the log
+ 
+ @details outputs the last `count` entries
+ 
+ @param count number of recent activities to show
+ */
+void UniversitySystem::displayRecentActivities(int count) const {
+    if (activityLog.empty()) {
+        *out << "no activities logged" << endl;
         return;
     }
-    
-    cout << "\n=== All Courses ===" << endl;
+    
+    *out << "\n=== Recent Activities (Last " << count << ") ===" << endl;
+    activityLog.forEachRecent(static_cast<size_t>(max(0, count)), [&](const ActivityLogEntry& entry) {
+        printActivity(entry);
+    });
+}
+
+/**
+ @brief displays the activities matching a query, oldest first
+ 
+ @details uses the log's indexes, so the work depends on the number of matches rather than the size of the log
+ 
+ @param query the student, course, action and time range to filter by. empty fields match anything
+ */
+void UniversitySystem::displayActivities(const ActivityQuery& query) const {
+    *out << "\n=== Matching Activities ===" << endl;
+    size_t found = activityLog.query(query, [&](const ActivityLogEntry& entry) {
+        printActivity(entry);
+    });
+    *out << found << " matching " << (found == 1 ? "activity" : "activities") << endl;
+}
+
+/**
+ @brief visits the activities matching a query without printing them
+ 
+ @param query the student, course, action and time range to filter by. empty fields match anything
+ @param visit called with each matching entry, oldest first
+ 
+ @return (size_t) the number of matching entries
+ */
+size_t UniversitySystem::queryActivities(const ActivityQuery& query, const function<void(const ActivityLogEntry&)>& visit) const {
+    return activityLog.query(query, visit);
+}
+
+/**
+ @brief looks up a student without copying it
+ 
+ @param studentID the ID of the student
+ 
+ @return (const Student*) pointer to the student or null pointer if not found. valid until the student registry changes
+ */
+const Student* UniversitySystem::findStudent(const string& studentID) const {
+    auto iter = students.find(studentID);
+    return (iter != students.end()) ? &(iter->second) : nullptr;
+}
+
+/**
+ @brief looks up a course without copying it
+ 
+ @param courseCode the course code
+ 
+ @return (const Course*) pointer to the course or null pointer if not found. valid until the course registry changes
+ */
+const Course* UniversitySystem::findCourse(const string& courseCode) const {
+    auto iter = findCourseEntry(courseCode);
+    return (iter != courses.end()) ? &(iter->second) : nullptr;
+}
+
+/**
+ @brief returns a read-only view over every student, in ID order
+ 
+ @return (RegistryView<map<string, Student>>) a non-owning view; iterating it copies nothing
+ */
+RegistryView<map<string, Student>> UniversitySystem::getStudents() const {
+    return RegistryView<map<string, Student>>(students);
+}
+
+/**
+ @brief returns a read-only view over every course, in code order
+ 
+ @return (RegistryView<map<string, Course>>) a non-owning view; iterating it copies nothing
+ */
+RegistryView<map<string, Course>> UniversitySystem::getCourses() const {
+    materializeCatalog();
+    return RegistryView<map<string, Course>>(courses);
+}
+
+/**
+ @brief searches for a student by full name
+ 
+ @param name the name to search
+ 
+ @return (pair<bool, string>) (true, studentID) if found, (false, "") otherwise
+ */
+pair<bool, string> UniversitySystem::searchStudentByName(const string& name) const {
+    for (const auto& pair : students) {
+        if (pair.second.getFullName() == name) {
+            return make_pair(true, pair.first);
+        }
+    }
+    return make_pair(false, "");
+}
+
+/**
+ @brief searches for a course by title
+ 
+ @details finds the match with the lowest course code
+ 
+ @param title the title to search
+ 
+ @return (pair<bool, string>) (true, courseCode) if found, (false, "") otherwise
+ */
+pair<bool, string> UniversitySystem::searchCourseByTitle(const string& title) const {
+    pair<bool, string> result = make_pair(false, "");
     for (const auto& pair : courses) {
-        const Course& course = pair.second;
-        cout << "Code: " << course.getCourseCode() << " | Title: " << course.getTitle() << " | Instructor: " << course.getInstructorName() << " | Enrollment: " << course.getCurrentEnrollment() << "/" << course.getCapacity() << " | Waitlist: " << course.getWaitlistSize() << endl;
+        if (pair.second.getTitle() == title) {
+            result = make_pair(true, pair.first);
+            break;
+        }
+    }
+    // unused catalog courses are searched in place rather than built
+    for (size_t i = 0; catalog && i < catalogClaimed.size(); i++) {
+        if (catalogClaimed[i]) {
+            continue;
+        }
+        CatalogEntry entry = catalog->getCourse(i);
+        if (entry.title == title) {
+            if (!result.first || entry.courseCode < result.second) {
+                result = make_pair(true, string(entry.courseCode));
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ @brief returns all students taught by a specific instructor
+ 
+ @param instructor the instructor name to filter by
+ 
+ @return (map<string, string>) of student IDs to names for students taught by the instructor
+ */
+map<string, string> UniversitySystem::getStudentsByInstructor(const string& instructor) const {
+    map<string, string> result;
+    
+    forEachStudentOfInstructor(instructor, [&](const Student& student) {
+        result.emplace(student.getStudentID(), student.getFullName());
+    });
+    
+    return result;
+}
+
+/**
+ @brief returns the total number of students in the system
+ 
+ @return (int) total number of students
+ */
+int UniversitySystem::getTotalStudents() const {
+    return students.size();
+}
+
+/**
+ @brief returns the total number of courses in the system
+ 
+ @return (int) total number of courses
+ */
+int UniversitySystem::getTotalCourses() const {
+    return courses.size() + catalogPending;
+}
+
+/**
+ @brief returns the total number of student-course enrollments
+ 
+ @return (int) total enrollments across all students
+ */
+int UniversitySystem::getTotalEnrollments() const {
+    int total = 0;
+    for (const auto& pair : students) {
+        total += pair.second.getEnrollmentCount();
+    }
+    return total;
+}
+
+/**
+ @brief gets the leaderboard kept up to date with every course's enrollment, waitlist and capacity
+ 
+ @return (const CourseLeaderboard&) the leaderboard
+ */
+const CourseLeaderboard& UniversitySystem::getLeaderboard() const {
+    materializeCatalog();
+    return leaderboard;
+}
+
+/**
+ @brief prints one leaderboard line
+ 
+ @param os the stream to print to
+ @param rank the position of the course in its list, starting at 1
+ @param standing the course's counts
+ */
+static void printStanding(ostream& os, size_t rank, const CourseStanding& standing) {
+    os << setw(3) << rank << ". " << standing.courseCode;
+    if (standing.seatsRanked) {
+        os << " | Enrollment: " << standing.enrolled << "/" << standing.capacity << " (" << fixed << setprecision(0) << standing.getFillRatio() * 100 << "%)";
+    } else {
+        os << " | Seats in sections";
+    }
+    os << " | Waitlist: " << standing.waitlisted << endl;
+}
+
+/**
+ @brief displays the most oversubscribed, most enrolled and emptiest courses
+ 
+ @details read straight from the leaderboard, so it costs O(count) per list no matter how many courses exist
+ 
+ @param count the number of courses in each list
+ */
+void UniversitySystem::displayLeaderboards(int count) const {
+    materializeCatalog();
+    size_t k = static_cast<size_t>(max(0, count));
+    const pair<const char*, vector<CourseStanding>> lists[] = {
+        {"Longest Waitlists", leaderboard.longestWaitlists(k)},
+        {"Most Enrolled", leaderboard.mostEnrolled(k)},
+        {"Emptiest Courses", leaderboard.emptiest(k)}
+    };
+    for (const auto& list : lists) {
+        *out << "\n=== " << list.first << " (Top " << k << ") ===" << endl;
+        if (list.second.empty()) {
+            *out << "no courses" << endl;
+        }
+        for (size_t i = 0; i < list.second.size(); i++) {
+            printStanding(*out, i + 1, list.second[i]);
+        }
+    }
+}
+
+/**
+ @brief displays every course filled below a threshold, emptiest first
+ 
+ @param ratio the threshold as a fraction of capacity, e.g. 0.25 for under 25% full
+ */
+void UniversitySystem::displayCoursesBelowFill(double ratio) const {
+    materializeCatalog();
+    vector<CourseStanding> matches = leaderboard.belowFill(ratio);
+    *out << "\n=== Courses Under " << fixed << setprecision(0) << ratio * 100 << "% Full ===" << endl;
+    for (size_t i = 0; i < matches.size(); i++) {
+        printStanding(*out, i + 1, matches[i]);
+    }
+    *out << matches.size() << " " << (matches.size() == 1 ? "course" : "courses") << endl;
+}
+
+/**
+ @brief displays system-wide statistics
+ 
+ @details includes total students, courses, enrollments, and average enrollment per course
+ */
+void UniversitySystem::displaySystemStatistics() const {
+    *out << "\n=== System Statistics ===" << endl;
+    *out << "Total Students: " << getTotalStudents() << endl;
+    *out << "Total Courses: " << getTotalCourses() << endl;
+    *out << "Total Enrollments: " << getTotalEnrollments() << endl;
+    *out << "Total Activities Logged: " << activityLog.size() << endl;
+    if (activityLog.getArchivedCount() > 0) {
+        *out << "Archived Activities: " << activityLog.getArchivedCount() << " in " << activityLog.getArchiveBlockCount() << " blocks ("
+             << activityLog.getArchiveMemoryBytes() / 1024 << " KB)" << endl;
+    }
+    
+    if (!seatHolds.empty()) {
+        *out << "Seats on Hold: " << seatHolds.size() << endl;
+    }
+    
+    if (getTotalCourses() > 0) {
+        double avgEnrollments = static_cast<double>(getTotalEnrollments()) / getTotalCourses();
+        *out << "Average Enrollments per Course: " << fixed << setprecision(2) << avgEnrollments << endl;
+    }
+    
+    *out << "\n--- Memory Usage (bytes) ---" << endl;
+    memoryReport().display(*out);
+}
+
+/**
+ @brief attributes the memory used by the system to each data structure
+ 
+ @details walks the registries, rosters, waitlists and live log once without allocating anything besides the report. byte counts are estimates from container sizes, capacities and node layouts; build with -DCOUNT_ALLOCATIONS to print exact heap totals next to them
+ 
+ @return (MemoryReport) one row each for the student and course registries, schedules, rosters, waitlists, the course leaderboard, seat holds, and the activity log
+ */
+MemoryReport UniversitySystem::memoryReport() const {
+    MemoryReport report;
+    
+    MemoryUsage& studentRegistry = report.add("students");
+    MemoryUsage& schedules = report.add("student schedules");
+    studentRegistry.elements = students.size();
+    studentRegistry.nodeBytes = treeNodeBytes(students);
+    for (const auto& entry : students) {
+        const Student& student = entry.second;
+        studentRegistry.stringBytes += stringHeapBytes(entry.first) + stringHeapBytes(student.getStudentID()) +
+                                       stringHeapBytes(student.getFullName()) + stringHeapBytes(student.getMajor());
+        for (const auto* courseSet : {&student.getEnrolledCourses(), &student.getWaitlistedCourses()}) {
+            schedules.elements += courseSet->size();
+            schedules.nodeBytes += treeNodeBytes(*courseSet);
+            for (const auto& courseCode : *courseSet) {
+                schedules.stringBytes += stringHeapBytes(courseCode);
+            }
+        }
+    }
+    
+    MemoryUsage& courseRegistry = report.add("courses");
+    MemoryUsage& rosters = report.add("course rosters");
+    MemoryUsage& waitlists = report.add("course waitlists");
+    courseRegistry.elements = courses.size();
+    courseRegistry.nodeBytes = treeNodeBytes(courses);
+    for (const auto& entry : courses) {
+        const Course& course = entry.second;
+        courseRegistry.stringBytes += stringHeapBytes(entry.first) + stringHeapBytes(course.getCourseCode()) +
+                                      stringHeapBytes(course.getTitle()) + stringHeapBytes(course.getInstructorName());
+        rosters.elements += course.getEnrolledStudents().size();
+        rosters.nodeBytes += treeNodeBytes(course.getEnrolledStudents());
+        for (const auto& studentID : course.getEnrolledStudents()) {
+            rosters.stringBytes += stringHeapBytes(studentID);
+        }
+        course.accountWaitlistMemory(waitlists);
+    }
+    leaderboard.accountMemory(report);
+    
+    // the image itself is shared with every process that maps it; only the claim bits are this process's
+    if (catalog) {
+        MemoryUsage& image = report.add("catalog image claims");
+        image.elements = catalogClaimed.size();
+        image.capacityBytes = catalogClaimed.capacity() / 8;
+    }
+    
+    // each hold is a map key, a timer payload and an entry in the course's hold set
+    MemoryUsage& holds = report.add("seat holds");
+    holds.elements = seatHolds.size();
+    holds.nodeBytes = treeNodeBytes(seatHolds) + seatHolds.size() * (TREE_NODE_OVERHEAD + sizeof(string));
+    holds.capacityBytes = holdTimers.getMemoryBytes();
+    for (const auto& entry : seatHolds) {
+        holds.stringBytes += 3 * stringHeapBytes(entry.first.first) + 2 * stringHeapBytes(entry.first.second);
+    }
+    
+    activityLog.accountMemory(report);
+    return report;
+}
+
+/**
+ @brief parses one line of a data file into a LoadRecord
+ 
+ @details splits the line on commas according to its command. blank lines and comments produce no record
+ 
+ @param line the raw line from the file
+ @param lineNumber the 1-based line number, kept for warnings
+ @param record the record to fill in
+ 
+ @return (bool) true if the line holds a command, false if it should be skipped
+ */
+bool UniversitySystem::parseLoadLine(const string& line, int lineNumber, LoadRecord& record) const {
+    // Skip empty lines and comments
+    if (line.empty() || line[0] == '#') {
+        return false;
+    }
+    
+    stringstream ss(line);
+    record.lineNumber = lineNumber;
+    getline(ss, record.command, ',');
+    
+    if (record.command == "STUDENT") {
+        record.fields.resize(2);
+        getline(ss, record.fields[0], ',');
+        getline(ss, record.fields[1]);
+    }
+    else if (record.command == "COURSE") {
+        record.fields.resize(4);
+        getline(ss, record.fields[0], ',');
+        getline(ss, record.fields[1], ',');
+        getline(ss, record.fields[2], ',');
+        getline(ss, record.fields[3]);
+        
+        if (!record.fields[3].empty()) {
+            try {
+                stoi(record.fields[3]);
+            } catch (const exception& e) {
+                record.invalidCapacity = true;
+            }
+        }
+    }
+    else if (record.command == "ENROLL" || record.command == "POLICY" || record.command == "SECTION") {
+        record.fields.resize(2);
+        getline(ss, record.fields[0], ',');
+        getline(ss, record.fields[1]);
+    }
+    else if (record.command == "PROFILE") {
+        record.fields.resize(3);
+        getline(ss, record.fields[0], ',');
+        getline(ss, record.fields[1], ',');
+        getline(ss, record.fields[2]);
+    }
+    
+    return true;
+}
+
+/**
+ @brief applies one parsed line of a data file to the system
+ 
+ @details prints the same warnings as the interactive operations when a line cannot be applied. an ENROLL line that puts the student on the course's waitlist counts as applied
+ 
+ @param record the parsed line
+ @param counts running totals of what has been loaded
+ 
+ @return (bool) true if the line was applied, false otherwise
+ */
+bool UniversitySystem::applyLoadRecord(const LoadRecord& record, LoadCounts& counts) {
+    if (record.command == "STUDENT") {
+        const string& studentID = record.fields[0];
+        if (addStudent(studentID, record.fields[1])) {
+            counts.studentsLoaded++;
+            return true;
+        }
+        *out << "Warning: Could not add student " << studentID << " (line " << record.lineNumber << ")" << endl;
+        return false;
+    }
+    
+    if (record.command == "COURSE") {
+        const string& courseCode = record.fields[0];
+        int capacity = 30; // default capacity
+        if (record.invalidCapacity) {
+            *out << "Warning: Invalid capacity for course " << courseCode << ", using default 30 (line " << record.lineNumber << ")" << endl;
+        } else if (!record.fields[3].empty()) {
+            capacity = stoi(record.fields[3]);
+        }
+        
+        if (addCourse(courseCode, record.fields[1], record.fields[2], capacity)) {
+            counts.coursesLoaded++;
+            return true;
+        }
+        *out << "Warning: Could not add course " << courseCode << " (line " << record.lineNumber << ")" << endl;
+        return false;
+    }
+    
+    if (record.command == "ENROLL") {
+        const string& studentID = record.fields[0];
+        const string& courseCode = record.fields[1];
+        const Student* student = findStudent(studentID);
+        bool wasWaitlisted = student != nullptr && student->isWaitlistedFor(courseCode);
+        if (enrollStudentInCourse(studentID, courseCode)) {
+            counts.enrollmentsLoaded++;
+            return true;
+        }
+        // a saved full course lists its waitlisted students after the enrolled ones, so they land back on the waitlist
+        if (!wasWaitlisted && student != nullptr && student->isWaitlistedFor(courseCode)) {
+            counts.waitlistsLoaded++;
+            return true;
+        }
+        *out << "Warning: Could not enroll student " << studentID << " in course " << courseCode << " (line " << record.lineNumber << ")" << endl;
+        return false;
+    }
+    
+    if (record.command == "PROFILE") {
+        const string& studentID = record.fields[0];
+        int standing = -1;
+        try {
+            standing = stoi(record.fields[1]);
+        } catch (const exception& e) {
+            standing = -1;
+        }
+        if (setStudentProfile(studentID, standing, record.fields[2])) {
+            return true;
+        }
+        *out << "Warning: Could not set profile for student " << studentID << " (line " << record.lineNumber << ")" << endl;
+        return false;
+    }
+    
+    if (record.command == "POLICY") {
+        const string& courseCode = record.fields[0];
+        if (setWaitlistPolicy(courseCode, record.fields[1])) {
+            return true;
+        }
+        *out << "Warning: Could not set waitlist policy for course " << courseCode << " (line " << record.lineNumber << ")" << endl;
+        return false;
+    }
+    
+    if (record.command == "SECTION") {
+        if (addSection(record.fields[0], record.fields[1])) {
+            return true;
+        }
+        *out << "Warning: Could not add section " << record.fields[1] << " to course " << record.fields[0] << " (line " << record.lineNumber << ")" << endl;
+        return false;
+    }
+    
+    *out << "Warning: Unknown command '" << record.command << "' on line " << record.lineNumber << endl;
+    return false;
+}
+
+/**
+ @brief prints and logs the totals of a finished load
+ 
+ @param fileName the file that was loaded
+ @param counts the totals gathered while loading
+ */
+void UniversitySystem::reportLoadSummary(const string& fileName, const LoadCounts& counts) {
+    *out << "Load complete:" << endl;
+    *out << "  Students loaded: " << counts.studentsLoaded << endl;
+    *out << "  Courses loaded: " << counts.coursesLoaded << endl;
+    *out << "  Enrollments loaded: " << counts.enrollmentsLoaded << endl;
+    *out << "  Waitlist entries loaded: " << counts.waitlistsLoaded << endl;
+    
+    logActivity("LOAD_FILE", "", "", "Loaded " + to_string(counts.studentsLoaded) + " students, " +
+                to_string(counts.coursesLoaded) + " courses, " + to_string(counts.enrollmentsLoaded) + " enrollments, " + to_string(counts.waitlistsLoaded) + " waitlist entries from " + fileName);
+}
+
+/**
+ @brief uses a mapped catalog image as this system's course catalog
+ 
+ @details the image's courses count as existing right away, but each one only becomes a Course (this process's private copy, holding its roster, waitlist and holds) the first time it is used. every process attaching the same image shares its pages, so N workers keep one physical copy of the unused catalog and start without parsing anything. the system must not have any courses yet
+ 
+ @param image an open image; kept alive by the system
+ 
+ @return (bool) true if attached, false if the image isn't open or the system already has courses
+ */
+bool UniversitySystem::attachCatalog(shared_ptr<const CatalogImage> image) {
+    if (!image || !image->isOpen()) {
+        *out << "catalog image isn't open -- can't attach" << endl;
+        return false;
+    }
+    if (!courses.empty() || catalogPending > 0) {
+        *out << "system already has courses -- can't attach a catalog image" << endl;
+        return false;
+    }
+    
+    catalog = image;
+    catalogClaimed.assign(image->getCourseCount(), false);
+    catalogPending = image->getCourseCount();
+    logActivity("ATTACH CATALOG", "", "", "Attached catalog image with " + to_string(catalogPending) + " courses");
+    return true;
+}
+
+/**
+ @brief writes every course's code, title, instructor and capacity as a catalog image other processes can attach
+ 
+ @details enrollments, waitlists and waitlist policies are not part of the image
+ 
+ @param fileName path of the image to write
+ 
+ @return (bool) true if written, false otherwise
+ */
+bool UniversitySystem::saveCatalogImage(const string& fileName) const {
+    materializeCatalog();
+    vector<CatalogEntry> entries;
+    entries.reserve(courses.size());
+    for (const auto& entry : courses) {
+        CatalogEntry catalogEntry;
+        catalogEntry.courseCode = entry.second.getCourseCode();
+        catalogEntry.title = entry.second.getTitle();
+        catalogEntry.instructorName = entry.second.getInstructorName();
+        catalogEntry.capacity = entry.second.getCapacity();
+        entries.push_back(catalogEntry);
+    }
+    if (!CatalogImage::write(fileName, entries)) {
+        *out << "Error: Could not write catalog image " << fileName << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ @brief counts attached catalog image courses that haven't been used yet
+ 
+ @return (size_t) courses still only in the shared mapping
+ */
+size_t UniversitySystem::getUnusedCatalogCourses() const {
+    return catalogPending;
+}
+
+/**
+ @brief loads student, course, and enrollment data from a file
+ 
+ @details parses a CSV-style filie and updates system state accordingly. lines must begin with STUDENT, COURSE, ENROLL, PROFILE, or POLICY
+ 
+ @param fileName path to the file to load
+ 
+ @return (bool) true if loading succeeds, false otherwise
+ */
+bool UniversitySystem::loadFromFile(const string& fileName) {
+    ifstream file(fileName);
+    if (!file.is_open()) {
+        *out << "Error: Could not open file " << fileName << endl;
+        return false;
     }
+    
+    return loadFromStream(file, fileName);
+}
+
+/**
+ @brief loads data file lines from any stream
+ 
+ @details the same format and messages as loadFromFile; used to rebuild a system from lines that were never a file, such as a term paged in from a TermStore
+ 
+ @param in the stream to read
+ @param sourceName the name to report the load under
+ 
+ @return (bool) true once the stream has been read
+ */
+bool UniversitySystem::loadFromStream(istream& in, const string& sourceName) {
+    TraceSpan span("loadFromStream");
+    LoadCounts counts;
+    
+    *out << "Loading data from " << sourceName << "..." << endl;
+    int lines = loadLines(in, counts, nullptr);
+    span.setArg("lines", lines);
+    
+    reportLoadSummary(sourceName, counts);
+    return true;
 }
 
 /**
- @brief displays all logged system activities
+ @brief reads, parses and applies data file lines until the stream ends
  
- @details includes timestamp, action tyep, student ID (if applicable), course code (if applicable), and details
+ @details the line loop shared by loadFromStream and background loads. lines are read and parsed a block at a time, then applied, so a trace shows parsing and applying as separate spans. parsing prints nothing, so messages come out in the same order as line by line. with a handle, progress is reported after every line read, failed records are counted, and reading stops once the load is cancelled
+ 
+ @param in the stream to read
+ @param counts the tallies to add to
+ @param handle the background load to report to, or a null pointer
+ 
+ @return (int) the number of lines read
  */
-void UniversitySystem::displayActivityLog() const {
-    if (activityLog.empty()) {
-        cout << "no activities logged" << endl;
-        return;
-    }
-    
-    cout << "\n=== Activity Log ===" << endl;
-    for (const auto& entry : activityLog) {
-        cout << "[" << entry.timestamp << "] " << entry.action;
-        if (!entry.studentID.empty()) {
-            cout << " - Student: " << entry.studentID;
+int UniversitySystem::loadLines(istream& in, LoadCounts& counts, LoadHandle* handle) {
+    static const size_t LOAD_BLOCK_LINES = 4096;
+    string line;
+    int lineNumber = 0;
+    vector<LoadRecord> block;
+    block.reserve(LOAD_BLOCK_LINES);
+    bool more = true;
+    while (more) {
+        TraceSpan parse("loadFromStream.parse");
+        block.clear();
+        while (block.size() < LOAD_BLOCK_LINES && (more = (handle == nullptr || !handle->isCancelled()) && getline(in, line))) {
+            lineNumber++;
+            if (handle != nullptr) {
+                handle->bytesRead.fetch_add(line.size() + 1, memory_order_relaxed);
+                handle->linesRead.store(lineNumber, memory_order_relaxed);
+            }
+            block.emplace_back();
+            if (!parseLoadLine(line, lineNumber, block.back())) {
+                block.pop_back();
+            }
         }
-        if (!entry.courseCode.empty()) {
-            cout << " - Course: " << entry.courseCode;
+        parse.setArg("records", block.size());
+        parse.end();
+        
+        TraceSpan apply("loadFromStream.apply");
+        apply.setArg("records", block.size());
+        for (const auto& record : block) {
+            if (!applyLoadRecord(record, counts) && handle != nullptr) {
+                handle->errorCount.fetch_add(1, memory_order_relaxed);
+            }
         }
-        cout << " - " << entry.details << endl;
     }
+    return lineNumber;
 }
 
 /**
- @brief displays the most recent activities from the log
+ @brief appends a student's data file lines: STUDENT, then PROFILE if the student has one
  
- @details outputs the last `count` entries
+ @param text the text to append to
+ @param student the student
+ */
+static void appendStudentLines(string& text, const Student& student) {
+    text += "STUDENT,";
+    text += student.getStudentID();
+    text += ',';
+    text += student.getFullName();
+    text += '\n';
+    if (student.getClassStanding() != 0 || !student.getMajor().empty()) {
+        text += "PROFILE,";
+        text += student.getStudentID();
+        text += ',';
+        text += to_string(student.getClassStanding());
+        text += ',';
+        text += student.getMajor();
+        text += '\n';
+    }
+}
+
+/**
+ @brief appends a course's definition lines: COURSE, then POLICY if it doesn't use the default policy
  
- @param count number of recent activities to show
+ @param text the text to append to
+ @param course the course
  */
-void UniversitySystem::displayRecentActivities(int count) const {
-    if (activityLog.empty()) {
-        cout << "no activities logged" << endl;
-        return;
+static void appendCourseLines(string& text, const Course& course) {
+    text += "COURSE,";
+    text += course.getCourseCode();
+    text += ',';
+    text += course.getTitle();
+    text += ',';
+    text += course.getInstructorName();
+    text += ',';
+    text += to_string(course.getCapacity());
+    text += '\n';
+    if (course.getWaitlistPolicy().getName() != defaultWaitlistPolicy()->getName()) {
+        text += "POLICY,";
+        text += course.getCourseCode();
+        text += ',';
+        text += course.getWaitlistPolicy().getName();
+        text += '\n';
+    }
+}
+
+/**
+ @brief appends an ENROLL line for each student enrolled in a course
+ 
+ @param text the text to append to
+ @param course the course
+ 
+ @return (size_t) the number of lines appended
+ */
+static size_t appendEnrollmentLines(string& text, const Course& course) {
+    size_t lines = 0;
+    course.forEachEnrolledStudent([&](const string& studentID) {
+        text += "ENROLL,";
+        text += studentID;
+        text += ',';
+        text += course.getCourseCode();
+        text += '\n';
+        lines++;
+    });
+    return lines;
+}
+
+/**
+ @brief appends an ENROLL line for each student on a course's waitlist, in waitlist order
+ 
+ @param text the text to append to
+ @param course the course
+ 
+ @return (size_t) the number of lines appended
+ */
+static size_t appendWaitlistLines(string& text, const Course& course) {
+    size_t lines = 0;
+    course.forEachWaitlisted([&](const string& studentID) {
+        text += "ENROLL,";
+        text += studentID;
+        text += ',';
+        text += course.getCourseCode();
+        text += '\n';
+        lines++;
+    });
+    return lines;
+}
+
+static const char SNAPSHOT_HEADER[] = "# University Course Management System snapshot\n";
+
+/**
+ @brief writes the students, courses, enrollments, and waitlists to a stream in the data file format
+ 
+ @details students and courses come first, then the section links, then every enrolled student, then every waitlisted student in waitlist order, so loading the output into an empty system rebuilds the same rosters and waitlists
+ 
+ @param os the stream to write to
+ */
+void UniversitySystem::writeSnapshot(ostream& os) const {
+    TraceSpan span("writeSnapshot");
+    materializeCatalog();
+    os << SNAPSHOT_HEADER;
+    string text;
+    TraceSpan studentPhase("writeSnapshot.students");
+    for (const auto& entry : students) {
+        text.clear();
+        appendStudentLines(text, entry.second);
+        os << text;
     }
+    studentPhase.end();
     
-    cout << "\n=== Recent Activities (Last " << count << ") ===" << endl;
-    int start = max(0, static_cast<int>(activityLog.size()) - count);
-    for (int i = start; i < activityLog.size(); i++) {
-        const auto& entry = activityLog[i];
-        cout << "[" << entry.timestamp << "] " << entry.action;
-        if (!entry.studentID.empty()) {
-            cout << " - Student: " << entry.studentID;
-        }
-        if (!entry.courseCode.empty()) {
-            cout << " - Course: " << entry.courseCode;
-        }
-        cout << " - " << entry.details << endl;
+    TraceSpan coursePhase("writeSnapshot.courses");
+    for (const auto& entry : courses) {
+        text.clear();
+        appendCourseLines(text, entry.second);
+        os << text;
+    }
+    
+    for (const auto& entry : sectionOffering) {
+        os << "SECTION," << entry.second << "," << entry.first << "\n";
+    }
+    coursePhase.end();
+    
+    TraceSpan rosterPhase("writeSnapshot.rosters");
+    for (const auto& entry : courses) {
+        text.clear();
+        appendEnrollmentLines(text, entry.second);
+        os << text;
+    }
+    
+    for (const auto& entry : courses) {
+        text.clear();
+        appendWaitlistLines(text, entry.second);
+        os << text;
     }
 }
 
 /**
- @brief searches for a student by full name
+ @brief saves the system to a data file that loadFromFile can read back
  
- @param name the name to search
+ @param fileName path of the file to write
  
- @return (pair<bool, string>) (true, studentID) if found, (false, "") otherwise
+ @return (bool) true if the file was written, false otherwise
  */
-pair<bool, string> UniversitySystem::searchStudentByName(const string& name) const {
-    for (const auto& pair : students) {
-        if (pair.second.getFullName() == name) {
-            return make_pair(true, pair.first);
-        }
+bool UniversitySystem::saveToFile(const string& fileName) const {
+    ofstream file(fileName);
+    if (!file.is_open()) {
+        *out << "Error: Could not open file " << fileName << " for writing" << endl;
+        return false;
     }
-    return make_pair(false, "");
+    
+    writeSnapshot(file);
+    file.close();
+    return !file.fail();
 }
 
 /**
- @brief searches for a course by title
+ @brief starts loading a data file on a background thread
  
- @param title the title to search
+ @details the file is applied to a private copy of the system, so the live system keeps serving requests and never shows a half-loaded state. call finishLoad once the handle reports done to swap the loaded state in. the copy is taken here, on the calling thread, because the live system can't be read from another thread while it keeps changing: it deep-copies every registry and the activity log, which for a system built from 100,000 data lines takes about a fifth as long as loading them
  
- @return (pair<bool, string>) (true, courseCode) if found, (false, "") otherwise
+ @param fileName path to the file to load
+ 
+ @return (shared_ptr<LoadHandle>) handle used to watch progress, cancel, and finish the load
  */
-pair<bool, string> UniversitySystem::searchCourseByTitle(const string& title) const {
-    for (const auto& pair : courses) {
-        if (pair.second.getTitle() == title) {
-            return make_pair(true, pair.first);
-        }
+shared_ptr<LoadHandle> UniversitySystem::loadFromFileAsync(const string& fileName) {
+    auto handle = make_shared<LoadHandle>(fileName);
+    handle->staged = make_unique<UniversitySystem>(*this);
+    handle->staged->out = &handle->messages;
+    handle->staged->checkpoint.reset();
+    handle->staged->recorder.reset();
+    handle->baseVersion = version;
+    
+    LoadHandle* target = handle.get();
+    handle->worker = thread([target]() {
+        target->staged->runBackgroundLoad(*target);
+    });
+    return handle;
+}
+
+/**
+ @brief worker body of loadFromFileAsync
+ 
+ @details runs on the staged copy. progress counters are updated after every line and cancellation is checked before each one. the parsed records aren't kept: if finishLoad has to re-apply the file, it reads it again
+ 
+ @param handle the handle to report progress to
+ */
+void UniversitySystem::runBackgroundLoad(LoadHandle& handle) {
+    Tracer::setThreadName("background load");
+    TraceSpan span("runBackgroundLoad");
+    ifstream file(handle.fileName, ios::binary);
+    if (!file.is_open()) {
+        *out << "Error: Could not open file " << handle.fileName << endl;
+        handle.done.store(true, memory_order_release);
+        return;
     }
-    return make_pair(false, "");
+    handle.opened.store(true, memory_order_release);
+    
+    file.seekg(0, ios::end);
+    handle.totalBytes.store(static_cast<uint64_t>(file.tellg()), memory_order_relaxed);
+    file.seekg(0, ios::beg);
+    
+    LoadCounts counts;
+    *out << "Loading data from " << handle.fileName << "..." << endl;
+    loadLines(file, counts, &handle);
+    
+    if (!handle.isCancelled()) {
+        reportLoadSummary(handle.fileName, counts);
+    }
+    handle.done.store(true, memory_order_release);
 }
 
 /**
- @brief returns all students taught by a specific instructor
+ @brief swaps the result of a background load into the live system
  
- @param instructor the instructor name to filter by
+ @details blocks until the worker is done. if nothing changed in the live system since the load started, the staged copy replaces it in one step. otherwise the staged copy is dropped and the file is read again and applied on top of the live state, so no concurrent change is lost. cancelled loads leave the system untouched
  
- @return (map<string, string>) of student IDs to names for students taught by the instructor
+ @param handle the handle returned by loadFromFileAsync
+ 
+ @return (bool) true if the loaded data was applied, false if the load was cancelled or the file could not be opened
  */
-map<string, string> UniversitySystem::getStudentsByInstructor(const string& instructor) const {
-    map<string, string> result;
+bool UniversitySystem::finishLoad(LoadHandle& handle) {
+    TraceSpan span("finishLoad");
+    handle.wait();
+    if (!handle.staged) {
+        return false;
+    }
     
-    for (const auto& coursePair : courses) {
-        if (coursePair.second.getInstructorName() == instructor) {
-            set<string> enrolledStudents = coursePair.second.getEnrolledStudents();
-            for (const auto& studentID : enrolledStudents) {
-                auto studentIter = students.find(studentID);
-                if (studentIter != students.end()) {
-                    result[studentID] = studentIter->second.getFullName();
-                }
-            }
+    if (handle.isCancelled() || !handle.wasOpened()) {
+        *out << handle.messages.str();
+        if (handle.isCancelled()) {
+            *out << "Load of " << handle.fileName << " cancelled -- no changes made" << endl;
         }
+        handle.staged.reset();
+        return false;
     }
     
-    return result;
+    if (handle.baseVersion == version) {
+        *out << handle.messages.str();
+        finishCheckpoint();
+        ostream* liveOut = out;
+        shared_ptr<CheckpointHandle> liveCheckpoint = checkpoint;
+        shared_ptr<TrafficRecorder> liveRecorder = recorder;
+        *this = std::move(*handle.staged);
+        out = liveOut;
+        checkpoint = liveCheckpoint;
+        recorder = liveRecorder;
+    } else {
+        handle.staged.reset();
+        *out << "System changed while " << handle.fileName << " was loading -- re-applying " << handle.getLinesRead() << " lines" << endl;
+        ifstream file(handle.fileName);
+        if (!file.is_open()) {
+            *out << "Error: Could not open file " << handle.fileName << endl;
+            return false;
+        }
+        LoadCounts counts;
+        loadLines(file, counts, nullptr);
+        reportLoadSummary(handle.fileName, counts);
+    }
+    
+    handle.staged.reset();
+    return true;
 }
 
 /**
- @brief returns the total number of students in the system
+ @brief copies a student's data file lines into the running checkpoint before the student changes
  
- @return (int) total number of students
+ @details nothing is copied if no checkpoint is running, the walk already passed the student, the student was added after the checkpoint began, or an earlier change already copied it
+ 
+ @param studentID the student about to change or be removed
  */
-int UniversitySystem::getTotalStudents() const {
-    return students.size();
+void UniversitySystem::preserveStudent(const string& studentID) const {
+    if (!checkpoint || !checkpoint->isStudentPending(studentID) || checkpoint->newStudents.count(studentID) > 0 ||
+        checkpoint->preservedStudents.count(studentID) > 0) {
+        return;
+    }
+    auto iter = students.find(studentID);
+    if (iter == students.end()) {
+        return;
+    }
+    string lines;
+    appendStudentLines(lines, iter->second);
+    checkpoint->preservedStudents.emplace(studentID, std::move(lines));
+    checkpoint->recordsPreserved.fetch_add(1, memory_order_relaxed);
 }
 
 /**
- @brief returns the total number of courses in the system
+ @brief copies a course into the running checkpoint before it changes
  
- @return (int) total number of courses
+ @details called from findCourseEntryToChange and getCourse, and for sections the const section lookups hand out, on every path that enrolls, drops, waitlists, updates, removes or holds. nothing is copied once every phase has passed the course, or if it was added after the checkpoint began or is already copied
+ 
+ @param course the course about to change or be removed
  */
-int UniversitySystem::getTotalCourses() const {
-    return courses.size();
+void UniversitySystem::preserveCourse(const Course& course) const {
+    if (!checkpoint) {
+        return;
+    }
+    const string& courseCode = course.getCourseCode();
+    if (!checkpoint->isCoursePending(courseCode) || checkpoint->newCourses.count(courseCode) > 0 ||
+        checkpoint->preservedCourses.count(courseCode) > 0) {
+        return;
+    }
+    checkpoint->preservedCourses.emplace(courseCode, course);
+    checkpoint->recordsPreserved.fetch_add(1, memory_order_relaxed);
 }
 
 /**
- @brief returns the total number of student-course enrollments
+ @brief copies the section links into the running checkpoint before they change
  
- @return (int) total enrollments across all students
+ @details the links are small and captured in one step, so they are copied whole
  */
-int UniversitySystem::getTotalEnrollments() const {
-    int total = 0;
-    for (const auto& pair : students) {
-        total += pair.second.getEnrollmentCount();
+void UniversitySystem::preserveSections() const {
+    if (!checkpoint || !checkpoint->areSectionsPending() || checkpoint->preservedSections) {
+        return;
     }
-    return total;
+    checkpoint->preservedSections = make_unique<map<string, string>>(sectionOffering);
+    checkpoint->recordsPreserved.fetch_add(sectionOffering.size(), memory_order_relaxed);
 }
 
 /**
- @brief displays system-wide statistics
+ @brief marks a student added after the running checkpoint began, so the walk leaves it out
  
- @details includes total students, courses, enrollments, and average enrollment per course
+ @param studentID the new student
  */
-void UniversitySystem::displaySystemStatistics() const {
-    cout << "\n=== System Statistics ===" << endl;
-    cout << "Total Students: " << getTotalStudents() << endl;
-    cout << "Total Courses: " << getTotalCourses() << endl;
-    cout << "Total Enrollments: " << getTotalEnrollments() << endl;
-    cout << "Total Activities Logged: " << activityLog.size() << endl;
-    
-    if (getTotalCourses() > 0) {
-        double avgEnrollments = static_cast<double>(getTotalEnrollments()) / getTotalCourses();
-        cout << "Average Enrollments per Course: " << fixed << setprecision(2) << avgEnrollments << endl;
+void UniversitySystem::noteNewStudent(const string& studentID) const {
+    if (checkpoint && checkpoint->isStudentPending(studentID)) {
+        checkpoint->newStudents.insert(studentID);
     }
 }
 
 /**
- @brief loads student, course, and enrollment data from a file
+ @brief marks a course added after the running checkpoint began, so the walk leaves it out
  
- @details parses a CSV-style filie and updates system state accordingly. lines must begin with STUDENT, COURSE, or ENROLL
+ @param courseCode the new course
+ */
+void UniversitySystem::noteNewCourse(const string& courseCode) const {
+    if (checkpoint && checkpoint->isCoursePending(courseCode)) {
+        checkpoint->newCourses.insert(courseCode);
+    }
+}
+
+/**
+ @brief captures the next slice of a checkpoint and hands it to the writer thread
  
- @param fileName path to the file to load
+ @details walks the live records after the phase's cursor together with the copies of records that changed, in key order. a copy stands in for its live record and records added since the checkpoint began are skipped. a course's whole roster or waitlist goes into one slice, so a slice can run over the budget by the size of the largest course
  
- @return (bool) true if loading succeeds, false otherwise
+ @param handle the checkpoint
+ @param recordBudget the number of records (or roster lines) to capture
  */
-bool UniversitySystem::loadFromFile(const string& fileName) {
-    ifstream file(fileName);
-        if (!file.is_open()) {
-            cout << "Error: Could not open file " << fileName << endl;
-            return false;
+void UniversitySystem::captureCheckpoint(CheckpointHandle& handle, size_t recordBudget) const {
+    using Phase = CheckpointHandle::Phase;
+    string text;
+    size_t spent = 0;
+    size_t records = 0;
+    if (handle.phase == Phase::Students && !handle.phaseStarted) {
+        text += SNAPSHOT_HEADER;
+    }
+    
+    // the walk releases copies as it passes them; what is left here are marks for records added and removed again
+    auto nextPhase = [&]() {
+        if (handle.phase == Phase::Students) {
+            handle.newStudents.clear();
+        } else if (handle.phase == Phase::Sections) {
+            handle.preservedSections.reset();
+        } else if (handle.phase == Phase::Waitlists) {
+            handle.newCourses.clear();
         }
-        
-        string line;
-        int lineNumber = 0;
-        int studentsLoaded = 0;
-        int coursesLoaded = 0;
-        int enrollmentsLoaded = 0;
-        
-    cout << "Loading data from " << fileName << "..." << endl;
-        
-        while (getline(file, line)) {
-            lineNumber++;
-            
-            // Skip empty lines and comments
-            if (line.empty() || line[0] == '#') {
-                continue;
-            }
-            
-            // Parse the line
-            stringstream ss(line);
-            string command;
-            getline(ss, command, ',');
-            
-            if (command == "STUDENT") {
-                string studentID, fullName;
-                getline(ss, studentID, ',');
-                getline(ss, fullName);
-                
-                if (addStudent(studentID, fullName)) {
-                    studentsLoaded++;
-                } else {
-                    cout << "Warning: Could not add student " << studentID << " (line " << lineNumber << ")" << endl;
-                }
-            }
-            else if (command == "COURSE") {
-                string courseCode, title, instructor, capacityStr;
-                getline(ss, courseCode, ',');
-                getline(ss, title, ',');
-                getline(ss, instructor, ',');
-                getline(ss, capacityStr);
-                
-                int capacity = 30; // default capacity
-                if (!capacityStr.empty()) {
-                    try {
-                        capacity = stoi(capacityStr);
-                    } catch (const exception& e) {
-                        cout << "Warning: Invalid capacity for course " << courseCode << ", using default 30 (line " << lineNumber << ")" << endl;
+        handle.phase = static_cast<Phase>(static_cast<int>(handle.phase) + 1);
+        handle.phaseStarted = false;
+        handle.cursor.clear();
+    };
+    
+    while (spent < recordBudget && handle.phase != Phase::Done) {
+        if (handle.phase == Phase::Students) {
+            auto live = handle.phaseStarted ? students.upper_bound(handle.cursor) : students.begin();
+            auto kept = handle.phaseStarted ? handle.preservedStudents.upper_bound(handle.cursor) : handle.preservedStudents.begin();
+            while (spent < recordBudget && (live != students.end() || kept != handle.preservedStudents.end())) {
+                if (kept != handle.preservedStudents.end() && (live == students.end() || !(live->first < kept->first))) {
+                    text += kept->second;
+                    handle.cursor = kept->first;
+                    if (live != students.end() && live->first == kept->first) {
+                        ++live;
                     }
-                }
-                
-                if (addCourse(courseCode, title, instructor, capacity)) {
-                    coursesLoaded++;
+                    kept = handle.preservedStudents.erase(kept);
                 } else {
-                    cout << "Warning: Could not add course " << courseCode << " (line " << lineNumber << ")" << endl;
+                    if (handle.newStudents.erase(live->first) == 0) {
+                        appendStudentLines(text, live->second);
+                    }
+                    handle.cursor = live->first;
+                    ++live;
                 }
+                handle.phaseStarted = true;
+                spent++;
+                records++;
+            }
+            if (live == students.end() && kept == handle.preservedStudents.end()) {
+                nextPhase();
             }
-            else if (command == "ENROLL") {
-                string studentID, courseCode;
-                getline(ss, studentID, ',');
-                getline(ss, courseCode);
-                
-                if (enrollStudentInCourse(studentID, courseCode)) {
-                    enrollmentsLoaded++;
+        } else if (handle.phase == Phase::Sections) {
+            const map<string, string>& links = handle.preservedSections ? *handle.preservedSections : sectionOffering;
+            for (const auto& entry : links) {
+                text += "SECTION," + entry.second + "," + entry.first + "\n";
+            }
+            spent += max<size_t>(links.size(), 1);
+            records += links.size();
+            nextPhase();
+        } else {
+            auto capture = [&](const Course& course) -> size_t {
+                if (handle.phase == Phase::Courses) {
+                    appendCourseLines(text, course);
+                    return 1;
+                }
+                size_t lines = handle.phase == Phase::Enrollments ? appendEnrollmentLines(text, course) : appendWaitlistLines(text, course);
+                return max<size_t>(lines, 1);
+            };
+            auto live = handle.phaseStarted ? courses.upper_bound(handle.cursor) : courses.begin();
+            auto kept = handle.phaseStarted ? handle.preservedCourses.upper_bound(handle.cursor) : handle.preservedCourses.begin();
+            while (spent < recordBudget && (live != courses.end() || kept != handle.preservedCourses.end())) {
+                if (kept != handle.preservedCourses.end() && (live == courses.end() || !(live->first < kept->first))) {
+                    spent += capture(kept->second);
+                    handle.cursor = kept->first;
+                    if (live != courses.end() && live->first == kept->first) {
+                        ++live;
+                    }
+                    // the waitlist walk is the last to read a course, so its copy is released as the walk passes it
+                    kept = handle.phase == Phase::Waitlists ? handle.preservedCourses.erase(kept) : next(kept);
                 } else {
-                    cout << "Warning: Could not enroll student " << studentID << " in course " << courseCode << " (line " << lineNumber << ")" << endl;
+                    bool isNew = handle.phase == Phase::Waitlists ? handle.newCourses.erase(live->first) > 0 : handle.newCourses.count(live->first) > 0;
+                    spent += isNew ? 1 : capture(live->second);
+                    handle.cursor = live->first;
+                    ++live;
                 }
+                handle.phaseStarted = true;
+                records++;
             }
-            else {
-                cout << "Warning: Unknown command '" << command << "' on line " << lineNumber << endl;
+            if (live == courses.end() && kept == handle.preservedCourses.end()) {
+                nextPhase();
             }
         }
-        
-        file.close();
-        
-        cout << "Load complete:" << endl;
-        cout << "  Students loaded: " << studentsLoaded << endl;
-        cout << "  Courses loaded: " << coursesLoaded << endl;
-        cout << "  Enrollments loaded: " << enrollmentsLoaded << endl;
-        
-        logActivity("LOAD_FILE", "", "", "Loaded " + to_string(studentsLoaded) + " students, " +
-                    to_string(coursesLoaded) + " courses, " + to_string(enrollmentsLoaded) + " enrollments from " + fileName);
-        
-        return true;
+    }
+    
+    handle.recordsCaptured.fetch_add(records, memory_order_relaxed);
+    handle.submit(std::move(text), handle.phase == Phase::Done);
+}
+
+/**
+ @brief starts a checkpoint: a point-in-time image of the system written to a data file in the background
+ 
+ @details nothing is copied up front. the image is captured a slice at a time by advanceCheckpoint while the system keeps taking changes, and records are copied only if they change before the capture reaches them, so the longest pause is one slice rather than the whole system. the file is written by a background thread and renamed into place once complete, in the same format as saveToFile. only one checkpoint runs at a time, and a new one waits until the previous file is written
+ 
+ @param fileName path of the file to write
+ 
+ @return (shared_ptr<CheckpointHandle>) handle used to watch progress, or a null pointer if the checkpoint couldn't start
+ */
+shared_ptr<CheckpointHandle> UniversitySystem::beginCheckpoint(const string& fileName) {
+    if (fileName.empty()) {
+        *out << "no file given -- can't start a checkpoint" << endl;
+        return nullptr;
+    }
+    if (isCheckpointActive() || (checkpoint && !checkpoint->isDone())) {
+        *out << "checkpoint to " << checkpoint->getFileName() << " is still running -- can't start another" << endl;
+        return nullptr;
+    }
+    
+    // catalog image courses become real entries now, so the walk sees a complete registry
+    materializeCatalog();
+    checkpoint = make_shared<CheckpointHandle>(fileName);
+    logActivity("CHECKPOINT", "", "", "Started checkpoint to " + fileName);
+    return checkpoint;
+}
+
+/**
+ @brief captures the next slice of the running checkpoint
+ 
+ @details call this between requests. when the last slice is captured the writer thread finishes the file on its own
+ 
+ @param recordBudget roughly how many records to capture; a course's roster or waitlist always goes into one slice
+ 
+ @return (bool) true if a slice was captured, false if no checkpoint is running
+ */
+bool UniversitySystem::advanceCheckpoint(size_t recordBudget) {
+    if (!isCheckpointActive()) {
+        return false;
+    }
+    
+    TraceSpan span("advanceCheckpoint");
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    captureCheckpoint(*checkpoint, recordBudget);
+    uint64_t micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    checkpoint->slices.fetch_add(1, memory_order_relaxed);
+    if (micros > checkpoint->longestSliceMicros.load(memory_order_relaxed)) {
+        checkpoint->longestSliceMicros.store(micros, memory_order_relaxed);
+    }
+    
+    if (!isCheckpointActive()) {
+        logActivity("CHECKPOINT", "", "", "Captured checkpoint to " + checkpoint->getFileName() + ": " + to_string(checkpoint->getRecordsCaptured()) +
+                    " records in " + to_string(checkpoint->getSliceCount()) + " slices, " + to_string(checkpoint->getRecordsPreserved()) +
+                    " copied before a change, longest slice " + to_string(checkpoint->getLongestSliceMicros()) + " us");
+    }
+    return true;
+}
+
+/**
+ @brief captures whatever is left of the running checkpoint in one step
+ 
+ @details used before the system is replaced or shut down; the writer thread still finishes the file in the background
+ 
+ @return (bool) true if a checkpoint was running
+ */
+bool UniversitySystem::finishCheckpoint() {
+    return advanceCheckpoint(numeric_limits<size_t>::max());
+}
+
+/**
+ @brief checks if a checkpoint is still being captured
+ 
+ @return (bool) true until the last slice is captured
+ */
+bool UniversitySystem::isCheckpointActive() const {
+    return checkpoint && checkpoint->phase != CheckpointHandle::Phase::Done;
+}
+
+/**
+ @brief returns the running checkpoint, or the last one if none is running
+ 
+ @return (shared_ptr<CheckpointHandle>) the handle, or a null pointer if no checkpoint was ever started
+ */
+shared_ptr<CheckpointHandle> UniversitySystem::getCheckpoint() const {
+    return checkpoint;
+}
+
+/**
+ @brief computes a digest of the system's state
+ 
+ @details a 64-bit FNV-1a hash of writeSnapshot's output, so two systems with the same students, courses, sections, rosters and waitlists (in waitlist order) have the same digest. the activity log and seat holds are not included
+ 
+ @return (uint64_t) the digest
+ */
+uint64_t UniversitySystem::stateDigest() const {
+    ostringstream text;
+    writeSnapshot(text);
+    uint64_t hash = 14695981039346656037ULL;
+    for (char character : text.str()) {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ @brief starts recording the commands run against this system to a traffic file
+ 
+ @details the file starts with the current state, so replaying it needs nothing else. commands are recorded by CommandProcessor as they run
+ 
+ @param fileName path of the traffic file
+ 
+ @return (bool) true if recording started, false if already recording or the file couldn't be opened
+ */
+bool UniversitySystem::startRecording(const string& fileName) {
+    if (recorder) {
+        *out << "already recording to " << recorder->getFileName() << endl;
+        return false;
+    }
+    auto target = make_shared<TrafficRecorder>(fileName);
+    if (!target->isOpen()) {
+        *out << "Error: Could not open file " << fileName << " for writing" << endl;
+        return false;
+    }
+    
+    ostringstream state;
+    writeSnapshot(state);
+    target->begin(state.str());
+    recorder = target;
+    logActivity("RECORD", "", "", "Started recording traffic to " + fileName);
+    return true;
+}
+
+/**
+ @brief stops recording and ends the traffic file with the digest of the current state
+ 
+ @return (bool) true if a recording was stopped and its file fully written
+ */
+bool UniversitySystem::stopRecording() {
+    if (!recorder) {
+        *out << "not recording" << endl;
+        return false;
+    }
+    bool written = recorder->finish(stateDigest());
+    logActivity("RECORD", "", "", "Recorded " + to_string(recorder->getRequestCount()) + " requests to " + recorder->getFileName());
+    recorder.reset();
+    return written;
+}
+
+/**
+ @brief checks if commands are being recorded
+ 
+ @return (bool) true between startRecording and stopRecording
+ */
+bool UniversitySystem::isRecording() const {
+    return recorder != nullptr;
+}
+
+/**
+ @brief adds one command to the traffic file, if recording
+ 
+ @param line the command line as received
+ @param success whether it succeeded
+ @param arrived when it was received
+ @param finished when its result was ready
+ */
+void UniversitySystem::recordRequest(const string& line, bool success, chrono::steady_clock::time_point arrived, chrono::steady_clock::time_point finished) {
+    if (recorder) {
+        recorder->record(line, success, arrived, finished);
+    }
 }
@@ -10,29 +10,121 @@
 
 #include "Student.h"
 #include "Course.h"
+#include "LoadHandle.h"
+#include "RegistryView.h"
+#include "ActivityLog.h"
+#include "CourseLeaderboard.h"
+#include "TimerWheel.h"
+#include "CatalogImage.h"
+#include "SeatLottery.h"
+#include "CheckpointHandle.h"
+#include "TrafficRecorder.h"
 #include <string>
 #include <map>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <iostream>
 #include <utility>
+#include <vector>
+#include <functional>
+#include <chrono>
 
 using namespace std;
 
-struct ActivityLogEntry {
-    string timestamp;
-    string action;
+/**
+ @brief a validated, not yet applied request to enroll one student in several courses
+
+ @details the read set holds the version stamp each course had when the schedule was validated. committing re-checks those stamps and the student's own places, so changes to other courses never invalidate the transaction
+ */
+struct ScheduleTransaction {
     string studentID;
-    string courseCode;
-    string details;
+    vector<pair<string, unsigned long long>> readSet;
+};
+
+/**
+ @brief one student's ranked course choices for the registration window
+ */
+struct CoursePreferences {
+    vector<string> courseCodes;
+    int maxCourses = 0;
+};
+
+/**
+ @brief how full one section of a multi-section course is, as ordered in the offering's placement heap
+
+ @details sections with an open seat come first, least full (by enrolled plus held over capacity) on top; ties go to the lower section code so placement is deterministic
+ */
+struct SectionLoad {
+    int taken = 0;
+    int capacity = 0;
+    string sectionCode;
+    
+    bool isFull() const {
+        return taken >= capacity;
+    }
     
-    ActivityLogEntry(const string& time, const string& a, const string& ID, const string& cc, const string& d);
+    bool operator<(const SectionLoad& other) const {
+        if (isFull() != other.isFull()) {
+            return !isFull();
+        }
+        long long mine = static_cast<long long>(taken) * max(other.capacity, 1);
+        long long theirs = static_cast<long long>(other.taken) * max(capacity, 1);
+        if (mine != theirs) {
+            return mine < theirs;
+        }
+        return sectionCode < other.sectionCode;
+    }
 };
 
 class UniversitySystem {
 private:
     map<string, Student> students;
-    map<string, Course> courses;
-    deque<ActivityLogEntry> activityLog;
+    // mutable so const lookups can bring a catalog image course into the registry; see materializeCourse
+    mutable map<string, Course> courses;
+    ActivityLog activityLog;
+    mutable CourseLeaderboard leaderboard;
+    ostream* out;
+    unsigned long long version;
+    
+    // pending seat holds, keyed (student ID, course code); each has a timer that fires the same key
+    static const int HOLD_TICK_MILLIS = 10;
+    TimerWheel<pair<string, string>> holdTimers;
+    map<pair<string, string>, TimerWheel<pair<string, string>>::Handle> seatHolds;
+    chrono::steady_clock::time_point holdClockStart;
+    
+    // courses of an attached catalog image stay in the shared mapping until first used; only then does this
+    // process build its own Course, which holds the mutable enrollment state. claimed marks image courses that
+    // were built or removed
+    shared_ptr<const CatalogImage> catalog;
+    mutable vector<bool> catalogClaimed;
+    mutable size_t catalogPending;
+    
+    // multi-section courses: each offering's sections in a heap ordered by load, so placing a student in the
+    // least-loaded section is O(1) and re-ranking one after a change is O(log s). the offering course itself
+    // holds no seats and its waitlist is shared by every section
+    map<string, IndexedHeap<string, SectionLoad>> offerings;
+    map<string, string> sectionOffering;
+    
+    // ranked choices submitted during the registration window, allocated together by closeRegistrationWindow
+    map<string, CoursePreferences> preferences;
+    
+    // the checkpoint being captured, if any. records it hasn't reached yet are copied into it before they change
+    shared_ptr<CheckpointHandle> checkpoint;
+    
+    // where the commands run against this system are recorded, if anywhere
+    shared_ptr<TrafficRecorder> recorder;
+    
+    struct LoadCounts {
+        int studentsLoaded = 0;
+        int coursesLoaded = 0;
+        int enrollmentsLoaded = 0;
+        int waitlistsLoaded = 0;
+    };
     
-    string getCurrentTimestamp() const;
+    map<string, Course>::iterator findCourseEntry(const string& courseCode) const;
+    map<string, Course>::iterator findCourseEntryToChange(const string& courseCode);
+    void materializeCatalog() const;
     Student* getStudent(const string& studentID);
     Course* getCourse(const string& courseCode);
     int getTotalStudents() const;
@@ -40,37 +132,165 @@ private:
     int getTotalEnrollments() const;
     
     void logActivity(const string& action, const string& studentID, const string& courseCode, const string& details);
+    void printActivity(const ActivityLogEntry& entry) const;
     bool studentExists(const string& studentID) const;
     bool courseExists(const string& courseCode) const;
     
+    bool admitToCourse(Student& student, Course& course, bool quiet = false);
+    string scheduleConflict(const Student& student, const Course& course, const ScheduleTransaction& transaction, size_t listed) const;
+    int promoteWaitlistedStudents(Course& course, bool refreshLeaderboard = true);
+    void refreshStanding(Course& course);
+    void refreshSectionLoad(const Course& course);
+    Course* leastLoadedSection(const string& offeringCode) const;
+    Course* findStudentSection(const string& studentID, const string& offeringCode, bool held) const;
+    bool hasSectionPlace(const string& studentID, const string& offeringCode) const;
+    int placeFromSharedWaitlist(Course& offering);
+    void forgetCourse(const string& courseCode);
+    unsigned long long holdTickAt(chrono::steady_clock::time_point when) const;
+    void discardHold(const string& studentID, const string& courseCode);
+    static string summarizeKeys(const vector<string>& keys);
+    
+    bool parseLoadLine(const string& line, int lineNumber, LoadRecord& record) const;
+    bool applyLoadRecord(const LoadRecord& record, LoadCounts& counts);
+    void reportLoadSummary(const string& fileName, const LoadCounts& counts);
+    int loadLines(istream& in, LoadCounts& counts, LoadHandle* handle);
+    void runBackgroundLoad(LoadHandle& handle);
+    
+    void preserveStudent(const string& studentID) const;
+    void preserveCourse(const Course& course) const;
+    void preserveSections() const;
+    void noteNewStudent(const string& studentID) const;
+    void noteNewCourse(const string& courseCode) const;
+    void captureCheckpoint(CheckpointHandle& handle, size_t recordBudget) const;
+    
 public:
     UniversitySystem();
     
+    void setOutputStream(ostream& os);
+    ostream& getOutputStream() const;
+    unsigned long long getVersion() const;
+    
     bool addStudent(const string& studentID, const string& fullName);
     bool removeStudent(const string& studentID);
+    int removeStudents(const vector<string>& studentIDs);
+    int removeStudentsIf(const function<bool(const Student&)>& predicate);
+    int removeStudentsWithPrefix(const string& prefix);
     bool updateStudent(const string& studentID, const string& newName);
+    bool setStudentProfile(const string& studentID, int classStanding, const string& major);
         
     bool addCourse(const string& courseCode, const string& title, const string& instructor, int capacity = 30);
     bool removeCourse(const string& courseCode);
+    int removeCourses(const vector<string>& courseCodes);
+    int removeCoursesIf(const function<bool(const Course&)>& predicate);
+    int removeCoursesWithPrefix(const string& prefix);
     bool updateCourse(const string& courseCode, const string& newTitle, const string& newInstructor, int newCapacity = -1);
+    bool setWaitlistPolicy(const string& courseCode, const string& policyName);
+    bool addSection(const string& offeringCode, const string& sectionCode);
+    vector<string> getSections(const string& offeringCode) const;
+    string getSectionOffering(const string& sectionCode) const;
     
     bool enrollStudentInCourse(const string& studentID, const string& courseCode);
     bool dropStudentFromCourse(const string& studentID, const string& courseCode);
+    vector<bool> enrollStudentsInCourse(const string& courseCode, const vector<string>& studentIDs);
+    vector<bool> dropStudentsFromCourse(const string& courseCode, const vector<string>& studentIDs);
+    pair<bool, string> prepareSchedule(const string& studentID, const vector<string>& courseCodes, ScheduleTransaction& transaction) const;
+    pair<bool, string> commitSchedule(const ScheduleTransaction& transaction);
+    bool enrollSchedule(const string& studentID, const vector<string>& courseCodes);
+    
+    bool placeHold(const string& studentID, const string& courseCode, int seconds = 300);
+    bool confirmHold(const string& studentID, const string& courseCode);
+    bool releaseHold(const string& studentID, const string& courseCode);
+    int expireHolds();
+    int expireHolds(chrono::steady_clock::time_point now);
+    size_t getHoldCount() const;
+    
+    bool submitPreferences(const string& studentID, const vector<string>& courseCodes, int maxCourses = 0);
+    size_t getPendingPreferences() const;
+    LotteryStats closeRegistrationWindow(unsigned long long seed);
     
     void listStudentCourses(const string& studentID) const;
     void listCourseStudents(const string& courseCode) const;
     void displayAllStudents() const;
     void displayAllCourses() const;
+    void reportStudents(ReportWriter& report) const;
+    void reportCourses(ReportWriter& report) const;
+    void reportRosters(ReportWriter& report) const;
+    bool writeReport(const string& kind, ReportWriter& report) const;
+    bool saveReport(const string& kind, ReportFormat format, const string& fileName) const;
     void displayActivityLog() const;
     void displayRecentActivities(int count = 10) const;
+    void displayActivities(const ActivityQuery& query) const;
+    size_t queryActivities(const ActivityQuery& query, const function<void(const ActivityLogEntry&)>& visit) const;
+    
+    const Student* findStudent(const string& studentID) const;
+    const Course* findCourse(const string& courseCode) const;
+    RegistryView<map<string, Student>> getStudents() const;
+    RegistryView<map<string, Course>> getCourses() const;
+    
+    template <typename Visitor>
+    void forEachStudent(Visitor&& visit) const {
+        for (const auto& entry : students) {
+            visit(entry.second);
+        }
+    }
+    
+    template <typename Visitor>
+    void forEachCourse(Visitor&& visit) const {
+        materializeCatalog();
+        for (const auto& entry : courses) {
+            visit(entry.second);
+        }
+    }
+    
+    template <typename Visitor>
+    void forEachStudentOfInstructor(const string& instructor, Visitor&& visit) const {
+        materializeCatalog();
+        for (const auto& entry : courses) {
+            if (entry.second.getInstructorName() != instructor) {
+                continue;
+            }
+            entry.second.forEachEnrolledStudent([&](const string& studentID) {
+                auto studentIter = students.find(studentID);
+                if (studentIter != students.end()) {
+                    visit(studentIter->second);
+                }
+            });
+        }
+    }
     
     pair<bool, string> searchStudentByName(const string& name) const;
     pair<bool, string> searchCourseByTitle(const string& title) const;
     map<string, string> getStudentsByInstructor(const string& instructor) const;
     
+    const CourseLeaderboard& getLeaderboard() const;
+    void displayLeaderboards(int count = 10) const;
+    void displayCoursesBelowFill(double ratio) const;
+    
     void displaySystemStatistics() const;
+    MemoryReport memoryReport() const;
+    
+    bool attachCatalog(shared_ptr<const CatalogImage> image);
+    bool saveCatalogImage(const string& fileName) const;
+    size_t getUnusedCatalogCourses() const;
     
     bool loadFromFile(const string& fileName);
+    bool loadFromStream(istream& in, const string& sourceName);
+    bool saveToFile(const string& fileName) const;
+    void writeSnapshot(ostream& os) const;
+    shared_ptr<LoadHandle> loadFromFileAsync(const string& fileName);
+    bool finishLoad(LoadHandle& handle);
+    
+    shared_ptr<CheckpointHandle> beginCheckpoint(const string& fileName);
+    bool advanceCheckpoint(size_t recordBudget = 256);
+    bool finishCheckpoint();
+    bool isCheckpointActive() const;
+    shared_ptr<CheckpointHandle> getCheckpoint() const;
+    
+    uint64_t stateDigest() const;
+    bool startRecording(const string& fileName);
+    bool stopRecording();
+    bool isRecording() const;
+    void recordRequest(const string& line, bool success, chrono::steady_clock::time_point arrived, chrono::steady_clock::time_point finished);
 };
 
 #endif // UNIVERSITY_SYSTEM_H
@@ -0,0 +1,168 @@
+//
+//  WaitlistPolicy.cpp
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/5/25.
+//
+
+#include "WaitlistPolicy.h"
+#include "Student.h"
+#include "Course.h"
+
+/**
+ @brief default constructor for WaitlistPriority
+
+ @details rank 0 and sequence 0
+ */
+WaitlistPriority::WaitlistPriority() {
+    rank = 0;
+    sequence = 0;
+}
+
+/**
+ @brief constructs a WaitlistPriority
+
+ @param r the rank from the course's policy (lower is served first)
+ @param seq the order in which the student joined the waitlist
+ */
+WaitlistPriority::WaitlistPriority(int r, unsigned long long seq) {
+    rank = r;
+    sequence = seq;
+}
+
+/**
+ @brief orders priorities by rank, then by arrival
+
+ @details the sequence tie-break keeps students with equal rank in first-come order
+
+ @param other the priority to compare with
+
+ @return (bool) true if this priority is served before the other
+ */
+bool WaitlistPriority::operator<(const WaitlistPriority& other) const {
+    if (rank != other.rank) {
+        return rank < other.rank;
+    }
+    return sequence < other.sequence;
+}
+
+/**
+ @brief virtual destructor for WaitlistPolicy
+ */
+WaitlistPolicy::~WaitlistPolicy() {}
+
+/**
+ @brief returns the policy name
+
+ @return (string) "FIFO"
+ */
+string FirstComePolicy::getName() const {
+    return "FIFO";
+}
+
+/**
+ @brief gives every student the same rank so the waitlist stays first-come, first-served
+
+ @return (int) always 0
+ */
+int FirstComePolicy::rank(const Student&, const Course&) const {
+    return 0;
+}
+
+/**
+ @brief returns the policy name
+
+ @return (string) "STANDING"
+ */
+string ClassStandingPolicy::getName() const {
+    return "STANDING";
+}
+
+/**
+ @brief ranks seniors ahead of juniors, juniors ahead of sophomores, and so on
+
+ @details students without a class standing are served last
+
+ @return (int) the rank for the student
+ */
+int ClassStandingPolicy::rank(const Student& student, const Course&) const {
+    return -student.getClassStanding();
+}
+
+/**
+ @brief returns the policy name
+
+ @return (string) "MAJOR"
+ */
+string MajorPolicy::getName() const {
+    return "MAJOR";
+}
+
+/**
+ @brief ranks students majoring in the course's department ahead of everyone else
+
+ @return (int) 0 for majors, 1 otherwise
+ */
+int MajorPolicy::rank(const Student& student, const Course& course) const {
+    return (!student.getMajor().empty() && student.getMajor() == course.getDepartment()) ? 0 : 1;
+}
+
+/**
+ @brief returns the policy name
+
+ @return (string) "STANDING_MAJOR"
+ */
+string StandingThenMajorPolicy::getName() const {
+    return "STANDING_MAJOR";
+}
+
+/**
+ @brief ranks by class standing first, and by major within the same standing
+
+ @return (int) the rank for the student
+ */
+int StandingThenMajorPolicy::rank(const Student& student, const Course& course) const {
+    return ClassStandingPolicy().rank(student, course) * 2 + MajorPolicy().rank(student, course);
+}
+
+/**
+ @brief returns the shared first-come policy every course starts with
+
+ @return (shared_ptr<const WaitlistPolicy>) the FIFO policy
+ */
+shared_ptr<const WaitlistPolicy> defaultWaitlistPolicy() {
+    static const shared_ptr<const WaitlistPolicy> fifo = make_shared<FirstComePolicy>();
+    return fifo;
+}
+
+/**
+ @brief creates a policy from its name
+
+ @param name one of the names returned by getWaitlistPolicyNames
+
+ @return (shared_ptr<const WaitlistPolicy>) the policy, or nullptr if the name is unknown
+ */
+shared_ptr<const WaitlistPolicy> makeWaitlistPolicy(const string& name) {
+    if (name == "FIFO") {
+        return defaultWaitlistPolicy();
+    }
+    if (name == "STANDING") {
+        return make_shared<ClassStandingPolicy>();
+    }
+    if (name == "MAJOR") {
+        return make_shared<MajorPolicy>();
+    }
+    if (name == "STANDING_MAJOR") {
+        return make_shared<StandingThenMajorPolicy>();
+    }
+    return nullptr;
+}
+
+/**
+ @brief lists the built-in waitlist policies
+
+ @return (vector<string>) the policy names accepted by makeWaitlistPolicy
+ */
+vector<string> getWaitlistPolicyNames() {
+    return {"FIFO", "STANDING", "MAJOR", "STANDING_MAJOR"};
+}
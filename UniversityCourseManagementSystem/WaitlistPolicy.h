@@ -0,0 +1,66 @@
+//
+//  WaitlistPolicy.h
+//  University Course Management System
+//
+//  Created by Violet Chaffee on 8/5/25.
+//
+
+#ifndef WAITLIST_POLICY_H
+#define WAITLIST_POLICY_H
+
+#include <string>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+class Student;
+class Course;
+
+struct WaitlistPriority {
+    int rank;
+    unsigned long long sequence;
+
+    WaitlistPriority();
+    WaitlistPriority(int r, unsigned long long seq);
+
+    bool operator<(const WaitlistPriority& other) const;
+};
+
+class WaitlistPolicy {
+public:
+    virtual ~WaitlistPolicy();
+
+    virtual string getName() const = 0;
+    virtual int rank(const Student& student, const Course& course) const = 0;
+};
+
+class FirstComePolicy : public WaitlistPolicy {
+public:
+    string getName() const override;
+    int rank(const Student& student, const Course& course) const override;
+};
+
+class ClassStandingPolicy : public WaitlistPolicy {
+public:
+    string getName() const override;
+    int rank(const Student& student, const Course& course) const override;
+};
+
+class MajorPolicy : public WaitlistPolicy {
+public:
+    string getName() const override;
+    int rank(const Student& student, const Course& course) const override;
+};
+
+class StandingThenMajorPolicy : public WaitlistPolicy {
+public:
+    string getName() const override;
+    int rank(const Student& student, const Course& course) const override;
+};
+
+shared_ptr<const WaitlistPolicy> makeWaitlistPolicy(const string& name);
+shared_ptr<const WaitlistPolicy> defaultWaitlistPolicy();
+vector<string> getWaitlistPolicyNames();
+
+#endif // WAITLIST_POLICY_H
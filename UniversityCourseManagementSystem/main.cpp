@@ -6,7 +6,20 @@
 //
 
 #include "UniversitySystem.h"
+#include "RequestServer.h"
+#include "ScriptRunner.h"
+#include "TrafficReplay.h"
+#include "TermRegistry.h"
+#include "Analytics.h"
+#include "Tracer.h"
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <csignal>
+#include <cstring>
 
 using namespace std;
 
@@ -37,10 +50,26 @@ void displayMenu() {
     cout << "18. Update Course" << endl;
     cout << "19. Load Data from File" << endl;
     cout << "20. Demo Mode (Run all features)" << endl;
-    cout << "21.  Exit" << endl;
+    cout << "21. Search Activity Log" << endl;
+    cout << "22. Course Leaderboards" << endl;
+    cout << "23. Term Analytics" << endl;
+    cout << "24. Enroll Student in Schedule" << endl;
+    cout << "25. Seat Holds" << endl;
+    cout << "26. Exit" << endl;
     cout << "Enter your choice: ";
 }
 
+/**
+ @brief prints the progress of a background file load
+ 
+ @param load the handle of the running load
+ */
+void displayLoadProgress(const LoadHandle& load) {
+    cout << "[Loading " << load.getFileName() << ": " << fixed << setprecision(1) << load.getProgressPercent() << "% | "
+         << load.getLinesRead() << " lines | " << load.getBytesRead() << "/" << load.getTotalBytes() << " bytes | "
+         << load.getErrorCount() << " errors]" << endl;
+}
+
 /**
  @brief clears invalid input from the input buffer
 
@@ -182,18 +211,220 @@ void demoMode(UniversitySystem& system) {
     cout << "\n=== DEMO COMPLETE ===" << endl;
 }
 
+/**
+ @brief signal handler that stops a running request server
+ 
+ @param signalNumber the signal received
+ */
+void handleStopSignal([[maybe_unused]] int signalNumber) {
+    RequestServer::requestStop();
+}
+
+/**
+ @brief runs the system as a request server until interrupted
+ 
+ @details optionally loads a data file first. responses never print to the console; only start-up and shutdown messages do
+ 
+ @param system the system to serve
+ @param terms the terms TERM requests work on
+ @param address a Unix socket path or a localhost TCP port
+ 
+ @return (int) the process exit code
+ */
+int serveMode(UniversitySystem& system, TermRegistry& terms, const string& address) {
+    signal(SIGINT, handleStopSignal);
+    signal(SIGTERM, handleStopSignal);
+    signal(SIGPIPE, SIG_IGN);
+    
+    RequestServer server(system, address, &terms);
+    return server.run() ? 0 : 1;
+}
+
+/**
+ @brief runs a command script without the menu
+ 
+ @details results go to stdout as one "line<TAB>OK|ERR<TAB>message" line per command; a summary goes to stderr so it never mixes with the results
+ 
+ @param system the system to run the script against
+ @param terms the terms TERM commands work on
+ @param fileName the script file, or "-" to read from stdin
+ 
+ @return (int) 0 if every command succeeded, 2 if any failed, 1 if the script could not be opened
+ */
+int scriptMode(UniversitySystem& system, TermRegistry& terms, const string& fileName) {
+    ios::sync_with_stdio(false);
+    
+    ifstream file;
+    if (fileName != "-") {
+        file.open(fileName);
+        if (!file.is_open()) {
+            cerr << "Error: Could not open script " << fileName << endl;
+            return 1;
+        }
+    }
+    istream& script = fileName == "-" ? cin : file;
+    
+    auto start = chrono::steady_clock::now();
+    unsigned long long commands = 0;
+    unsigned long long failures = 0;
+    {
+        ScriptRunner runner(system, cout, &terms);
+        runner.run(script);
+        commands = runner.getCommandsRun();
+        failures = runner.getCommandsFailed();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    cerr << commands << " commands, " << failures << " failed in " << fixed << setprecision(3) << seconds << "s";
+    if (seconds > 0) {
+        cerr << " (" << static_cast<long long>(commands / seconds) << " commands/sec)";
+    }
+    cerr << endl;
+    return failures == 0 ? 0 : 2;
+}
+
+/**
+ @brief replays a traffic file against a fresh system
+ 
+ @details the summary goes to stderr, like script mode's
+ 
+ @param fileName the traffic file, written by --record or RECORD
+ @param originalPacing true to keep the recorded arrival times, false to replay as fast as possible
+ 
+ @return (int) 0 if the final state matches the recording, 3 if it doesn't or can't be checked, 1 if the file could not be read
+ */
+int replayMode(const string& fileName, bool originalPacing) {
+    TrafficReplay replay;
+    if (!replay.load(fileName, cerr)) {
+        return 1;
+    }
+    return replay.run(originalPacing, cerr) ? 0 : 3;
+}
+
+/**
+ @brief ends a recording started by --record or RECORD, if one is still running
+ 
+ @param system the system being recorded
+ @param status the exit status to pass through
+ 
+ @return (int) status
+ */
+int finishRecording(UniversitySystem& system, int status) {
+    if (system.isRecording()) {
+        system.setOutputStream(cerr);
+        system.stopRecording();
+    }
+    return status;
+}
+
+/**
+ @brief writes the spans recorded since --trace to its file
+ 
+ @param traceFile the file named by --trace, or empty if tracing wasn't asked for
+ @param status the exit status to pass through
+ 
+ @return (int) status
+ */
+int finishTrace(const string& traceFile, int status) {
+    if (traceFile.empty()) {
+        return status;
+    }
+    Tracer::stop();
+    if (Tracer::writeChromeTrace(traceFile)) {
+        cerr << Tracer::getEventCount() << " trace spans written to " << traceFile << endl;
+    } else {
+        cerr << "Error: Could not write trace " << traceFile << endl;
+    }
+    return status;
+}
+
 /**
  @brief entry point of the application
  
- @details initializes the UniversitySystem and displays a menu loop for user interaction
+ @details initializes the UniversitySystem and displays a menu loop for user interaction. with --serve <address> [--load <file>] it runs as a request server instead, and with --script <file | -> it runs a command script and exits; both also take TERM commands, which work on a registry of separate terms, and --term-store <file> keeps those terms in an on-disk store with only the most recently used in memory. --catalog <image> starts from a shared catalog image and --save-catalog <image> writes the courses loaded so far as one. --trace <file> records spans from that point on and writes them as Chrome trace JSON on exit. --record <file> records every script or server command to a traffic file, and --replay <file> [--realtime] runs one against a fresh system and checks it ends in the recorded state
  */
 int main(int argc, const char * argv[]) {
     UniversitySystem system;
+    TermRegistry terms;
+    
+    string serveAddress;
+    string scriptFile;
+    string traceFile;
+    string recordFile;
+    string replayFile;
+    bool realtime = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceFile = argv[++i];
+            Tracer::start();
+            Tracer::setThreadName("main");
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordFile = argv[++i];
+        } else if (strcmp(argv[i], "--term-store") == 0 && i + 1 < argc) {
+            if (!terms.attachStore(argv[++i])) {
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayFile = argv[++i];
+        } else if (strcmp(argv[i], "--realtime") == 0) {
+            realtime = true;
+        } else if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+            serveAddress = argv[++i];
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            scriptFile = argv[++i];
+        } else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc) {
+            system.loadFromFile(argv[++i]);
+        } else if (strcmp(argv[i], "--catalog") == 0 && i + 1 < argc) {
+            auto image = make_shared<CatalogImage>();
+            if (!image->open(argv[++i]) || !system.attachCatalog(image)) {
+                cout << "Error: Could not attach catalog image " << argv[i] << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--save-catalog") == 0 && i + 1 < argc) {
+            if (!system.saveCatalogImage(argv[++i])) {
+                return 1;
+            }
+        } else {
+            cout << "Usage: " << argv[0] << " [--catalog <image>] [--load <file>] [--save-catalog <image>] [--serve <socket path | port> | --script <file | ->] [--trace <file>] [--record <file>] [--term-store <file>]" << endl;
+            cout << "       " << argv[0] << " --replay <file> [--realtime] [--trace <file>]" << endl;
+            return 1;
+        }
+    }
+    if (!replayFile.empty()) {
+        return finishTrace(traceFile, replayMode(replayFile, realtime));
+    }
+    if (!recordFile.empty() && !system.startRecording(recordFile)) {
+        return 1;
+    }
+    if (!scriptFile.empty()) {
+        return finishTrace(traceFile, finishRecording(system, scriptMode(system, terms, scriptFile)));
+    }
+    if (!serveAddress.empty()) {
+        return finishTrace(traceFile, finishRecording(system, serveMode(system, terms, serveAddress)));
+    }
+    
+    shared_ptr<LoadHandle> pendingLoad;
     int choice;
     
     do {
+        if (pendingLoad && pendingLoad->isDone()) {
+            string filename = pendingLoad->getFileName();
+            if (system.finishLoad(*pendingLoad)) {
+                cout << "Data loaded successfully from " << filename << endl;
+            } else {
+                cout << "Failed to load data from " << filename << endl;
+            }
+            pendingLoad.reset();
+        }
+        if (pendingLoad) {
+            displayLoadProgress(*pendingLoad);
+        }
         displayMenu();
         choice = getIntInput("");
+        int expired = system.expireHolds();
+        if (expired > 0) {
+            cout << expired << " seat hold(s) expired" << endl;
+        }
 
         switch (choice) {
             case 1: { // Add Student
@@ -303,8 +534,11 @@ int main(int argc, const char * argv[]) {
                 break;
             }
             case 15: { // Remove Student
-                string studentID = getStringInput("Enter student ID to remove: ");
-                if (system.removeStudent(studentID)) {
+                string studentID = getStringInput("Enter student ID to remove (end with * to remove every ID with that prefix): ");
+                if (studentID.size() > 1 && studentID.back() == '*') {
+                    int removed = system.removeStudentsWithPrefix(studentID.substr(0, studentID.size() - 1));
+                    cout << removed << " students removed" << endl;
+                } else if (system.removeStudent(studentID)) {
                     cout << "Student removed successfully!" << endl;
                 } else {
                     cout << "Failed to remove student. Student not found" << endl;
@@ -312,8 +546,11 @@ int main(int argc, const char * argv[]) {
                 break;
             }
             case 16: { // Remove Course
-                string courseCode = getStringInput("Enter course code to remove: ");
-                if (system.removeCourse(courseCode)) {
+                string courseCode = getStringInput("Enter course code to remove (end with * to remove every code with that prefix): ");
+                if (courseCode.size() > 1 && courseCode.back() == '*') {
+                    int removed = system.removeCoursesWithPrefix(courseCode.substr(0, courseCode.size() - 1));
+                    cout << removed << " courses removed" << endl;
+                } else if (system.removeCourse(courseCode)) {
                     cout << "Course removed successfully!" << endl;
                 } else {
                     cout << "Failed to remove course. Course not found" << endl;
@@ -343,19 +580,113 @@ int main(int argc, const char * argv[]) {
                 break;
             }
             case 19: { // Load Data from File
-                string filename = getStringInput("Enter filename to load from: ");
-                if (system.loadFromFile(filename)) {
-                    cout << "Data loaded successfully from " << filename << endl;
-                } else {
-                    cout << "Failed to load data from " << filename << endl;
+                if (pendingLoad) {
+                    displayLoadProgress(*pendingLoad);
+                    string answer = getStringInput("A load is already running. Cancel it? (y/n): ");
+                    if (answer == "y" || answer == "Y") {
+                        pendingLoad->cancel();
+                        system.finishLoad(*pendingLoad);
+                        pendingLoad.reset();
+                    }
+                    break;
                 }
+                string filename = getStringInput("Enter filename to load from: ");
+                pendingLoad = system.loadFromFileAsync(filename);
+                cout << "Loading " << filename << " in the background -- progress is shown above the menu" << endl;
                 break;
             }
             case 20: { // Demo Mode (Run all features)
                 demoMode(system);
                 break;
             }
-            case 21: { // Exit
+            case 21: { // Search Activity Log
+                ActivityQuery query;
+                query.studentID = getStringInput("Student ID (blank for any): ");
+                query.courseCode = getStringInput("Course code (blank for any): ");
+                query.action = getStringInput("Action, e.g. DROP (blank for any): ");
+                string from = getStringInput("From YYYY-MM-DD [HH:MM:SS] (blank for any): ");
+                string to = getStringInput("To YYYY-MM-DD [HH:MM:SS] (blank for any): ");
+                if ((!from.empty() && !ActivityLog::parseTimestamp(from, query.from)) ||
+                    (!to.empty() && !ActivityLog::parseTimestamp(to, query.to, true))) {
+                    cout << "Invalid date. Use YYYY-MM-DD or YYYY-MM-DD HH:MM:SS" << endl;
+                    break;
+                }
+                system.displayActivities(query);
+                break;
+            }
+            case 22: { // Course Leaderboards
+                int count = getIntInput("Enter number of courses per list: ");
+                system.displayLeaderboards(count);
+                int percent = getIntInput("Also list courses under what % full? (0 to skip): ");
+                if (percent > 0) {
+                    system.displayCoursesBelowFill(percent / 100.0);
+                }
+                break;
+            }
+            case 23: { // Term Analytics
+                AnalyticsEngine analytics;
+                vector<string> names = analytics.getAggregationNames();
+                for (size_t i = 0; i < names.size(); i++) {
+                    cout << (i + 1) << ". " << names[i] << endl;
+                }
+                int pick = getIntInput("Enter report number (0 for all): ");
+                if (pick < 0 || pick > static_cast<int>(names.size())) {
+                    cout << "Invalid report number" << endl;
+                    break;
+                }
+                AnalyticsSnapshot snapshot = AnalyticsSnapshot::capture(system);
+                if (pick == 0) {
+                    for (const auto& result : analytics.runAll(snapshot)) {
+                        result.display();
+                    }
+                } else {
+                    analytics.run(names[pick - 1], snapshot).second.display();
+                }
+                break;
+            }
+            case 24: { // Enroll Student in Schedule
+                string studentID = getStringInput("Enter student ID: ");
+                string line = getStringInput("Enter course codes separated by spaces: ");
+                istringstream codes(line);
+                vector<string> courseCodes;
+                string courseCode;
+                while (codes >> courseCode) {
+                    courseCodes.push_back(courseCode);
+                }
+                if (system.enrollSchedule(studentID, courseCodes)) {
+                    cout << "Student enrolled in all " << courseCodes.size() << " courses!" << endl;
+                } else {
+                    cout << "No changes made" << endl;
+                }
+                break;
+            }
+            case 25: { // Seat Holds
+                string action = getStringInput("Hold, confirm, or release? (h/c/r): ");
+                string studentID = getStringInput("Enter student ID: ");
+                string courseCode = getStringInput("Enter course code: ");
+                if (action == "h" || action == "H") {
+                    int minutes = getIntInput("Hold for how many minutes? ");
+                    if (system.placeHold(studentID, courseCode, minutes * 60)) {
+                        cout << "Seat held for " << minutes << " minutes -- confirm it before then" << endl;
+                    }
+                } else if (action == "c" || action == "C") {
+                    if (system.confirmHold(studentID, courseCode)) {
+                        cout << "Hold confirmed -- student enrolled!" << endl;
+                    }
+                } else if (action == "r" || action == "R") {
+                    if (system.releaseHold(studentID, courseCode)) {
+                        cout << "Hold released" << endl;
+                    }
+                } else {
+                    cout << "Invalid choice" << endl;
+                }
+                break;
+            }
+            case 26: { // Exit
+                if (pendingLoad) {
+                    pendingLoad->cancel();
+                    pendingLoad->wait();
+                }
                 cout << "Thanks for using the University Course Management System!" << endl;
                 break;
             }
@@ -363,7 +694,7 @@ int main(int argc, const char * argv[]) {
                 cout << "Invalid choice. Please try again" << endl;
                 break;
         }
-    } while (choice != 21);
+    } while (choice != 26);
     
-    return 0;
+    return finishTrace(traceFile, finishRecording(system, 0));
 }